@@ -79,6 +79,10 @@ enum options_client
   OPT_SLAP_COMMIT,
   OPT_SLAP_DETACH,
   OPT_SLAP_NO_DROP,
+  OPT_SLAP_COMPRESSION_ALGORITHM,
+  OPT_SLAP_LATENCY,
+  OPT_SLAP_REPORT_INTERVAL,
+  OPT_SLAP_JSON,
   OPT_MYSQL_REPLACE_INTO, OPT_BASE64_OUTPUT_MODE, OPT_SERVER_ID,
   OPT_FIX_TABLE_NAMES, OPT_FIX_DB_NAMES, OPT_SSL_VERIFY_SERVER_CERT,
   OPT_AUTO_VERTICAL_OUTPUT,
@@ -92,6 +96,7 @@ enum options_client
   OPT_REPORT_PROGRESS,
   OPT_SKIP_ANNOTATE_ROWS_EVENTS,
   OPT_SSL_CRL, OPT_SSL_CRLPATH,
+  OPT_DUMP_CHUNK_ROWS,
   OPT_MAX_CLIENT_OPTION /* should be always the last */
 };
 
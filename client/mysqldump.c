@@ -50,6 +50,7 @@
 #include <stdarg.h>
 
 #include "client_priv.h"
+#include <my_pthread.h>
 #include "mysql.h"
 #include "mysql_version.h"
 #include "mysqld_error.h"
@@ -139,6 +140,8 @@ static ulong opt_compatible_mode= 0;
 static uint opt_mysql_port= 0, opt_master_data;
 static uint opt_slave_data;
 static uint opt_use_gtid;
+static uint opt_use_threads= 0;
+static ulonglong opt_chunk_rows= 0;
 static uint my_end_arg;
 static char * opt_mysql_unix_port=0;
 static int   first_error=0;
@@ -239,6 +242,13 @@ static struct my_option my_long_options[] =
   {"character-sets-dir", OPT_CHARSETS_DIR,
    "Directory for character set files.", &charsets_dir,
    &charsets_dir, 0, GET_STR, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+  {"chunk-rows", OPT_DUMP_CHUNK_ROWS,
+   "With --tab, split the data of a table that has more than this many "
+   "rows and an integer primary key into primary key ranges of about "
+   "this many rows, each written to its own file tbl_name.N.txt. "
+   "0 means never split.",
+   &opt_chunk_rows, &opt_chunk_rows, 0, GET_ULL, REQUIRED_ARG,
+   0, 0, ULONGLONG_MAX, 0, 0, 0},
   {"comments", 'i', "Write additional information.",
    &opt_comments, &opt_comments, 0, GET_BOOL, NO_ARG,
    1, 0, 0, 0, 0, 0},
@@ -526,6 +536,12 @@ static struct my_option my_long_options[] =
   {"tz-utc", OPT_TZ_UTC,
     "SET TIME_ZONE='+00:00' at top of dump to allow dumping of TIMESTAMP data when a server has data in different time zones or data is being moved between servers with different time zones.",
     &opt_tz_utc, &opt_tz_utc, 0, GET_BOOL, NO_ARG, 1, 0, 0, 0, 0, 0},
+  {"use-threads", OPT_USE_THREADS,
+   "Write the data files of --tab over this many connections in parallel. "
+   "With --single-transaction all connections read the same consistent "
+   "snapshot.",
+   &opt_use_threads, &opt_use_threads, 0, GET_UINT, REQUIRED_ARG,
+   0, 0, 256, 0, 0, 0},
 #ifndef DONT_ALLOW_USER_CHANGE
   {"user", 'u', "User for login if not current user.",
    &current_user, &current_user, 0, GET_STR, REQUIRED_ARG,
@@ -553,6 +569,7 @@ static const char *load_default_groups[]=
 { "mysqldump", "client", "client-server", "client-mariadb", 0 };
 
 static void maybe_exit(int error);
+static void wait_for_dump_workers();
 static void die(int error, const char* reason, ...);
 static void maybe_die(int error, const char* reason, ...);
 static void write_header(FILE *sql_file, char *db_name);
@@ -1022,6 +1039,12 @@ static int get_options(int *argc, char ***argv)
             my_progname_short);
     return(EX_USAGE);
   }
+  if (opt_use_threads && !path)
+  {
+    fprintf(stderr, "%s: --use-threads can only be used with --tab.\n",
+            my_progname_short);
+    return(EX_USAGE);
+  }
   if (strcmp(default_charset, charset_info->csname) &&
       !(charset_info= get_charset_by_csname(default_charset,
                                             MY_CS_PRIMARY, MYF(MY_WME))))
@@ -1627,70 +1650,60 @@ static void maybe_exit(int error)
 
 
 /*
-  db_connect -- connects to the host and selects DB.
+  connect_to_server -- opens a connection and sets up the session for dumping.
 */
 
-static int connect_to_db(char *host, char *user,char *passwd)
+static int connect_to_server(MYSQL *mysql_con, char *host, char *user,
+                             char *passwd)
 {
   char buff[20+FN_REFLEN];
-  DBUG_ENTER("connect_to_db");
+  DBUG_ENTER("connect_to_server");
 
-  verbose_msg("-- Connecting to %s...\n", host ? host : "localhost");
-  mysql_init(&mysql_connection);
+  mysql_init(mysql_con);
   if (opt_compress)
-    mysql_options(&mysql_connection,MYSQL_OPT_COMPRESS,NullS);
+    mysql_options(mysql_con,MYSQL_OPT_COMPRESS,NullS);
 #ifdef HAVE_OPENSSL
   if (opt_use_ssl)
   {
-    mysql_ssl_set(&mysql_connection, opt_ssl_key, opt_ssl_cert, opt_ssl_ca,
+    mysql_ssl_set(mysql_con, opt_ssl_key, opt_ssl_cert, opt_ssl_ca,
                   opt_ssl_capath, opt_ssl_cipher);
-    mysql_options(&mysql_connection, MYSQL_OPT_SSL_CRL, opt_ssl_crl);
-    mysql_options(&mysql_connection, MYSQL_OPT_SSL_CRLPATH, opt_ssl_crlpath);
+    mysql_options(mysql_con, MYSQL_OPT_SSL_CRL, opt_ssl_crl);
+    mysql_options(mysql_con, MYSQL_OPT_SSL_CRLPATH, opt_ssl_crlpath);
   }
-  mysql_options(&mysql_connection,MYSQL_OPT_SSL_VERIFY_SERVER_CERT,
+  mysql_options(mysql_con,MYSQL_OPT_SSL_VERIFY_SERVER_CERT,
                 (char*)&opt_ssl_verify_server_cert);
 #endif
   if (opt_protocol)
-    mysql_options(&mysql_connection,MYSQL_OPT_PROTOCOL,(char*)&opt_protocol);
+    mysql_options(mysql_con,MYSQL_OPT_PROTOCOL,(char*)&opt_protocol);
 #ifdef HAVE_SMEM
   if (shared_memory_base_name)
-    mysql_options(&mysql_connection,MYSQL_SHARED_MEMORY_BASE_NAME,shared_memory_base_name);
+    mysql_options(mysql_con,MYSQL_SHARED_MEMORY_BASE_NAME,shared_memory_base_name);
 #endif
-  mysql_options(&mysql_connection, MYSQL_SET_CHARSET_NAME, default_charset);
+  mysql_options(mysql_con, MYSQL_SET_CHARSET_NAME, default_charset);
 
   if (opt_plugin_dir && *opt_plugin_dir)
-    mysql_options(&mysql_connection, MYSQL_PLUGIN_DIR, opt_plugin_dir);
+    mysql_options(mysql_con, MYSQL_PLUGIN_DIR, opt_plugin_dir);
 
   if (opt_default_auth && *opt_default_auth)
-    mysql_options(&mysql_connection, MYSQL_DEFAULT_AUTH, opt_default_auth);
+    mysql_options(mysql_con, MYSQL_DEFAULT_AUTH, opt_default_auth);
 
-  mysql_options(&mysql_connection, MYSQL_OPT_CONNECT_ATTR_RESET, 0);
-  mysql_options4(&mysql_connection, MYSQL_OPT_CONNECT_ATTR_ADD,
+  mysql_options(mysql_con, MYSQL_OPT_CONNECT_ATTR_RESET, 0);
+  mysql_options4(mysql_con, MYSQL_OPT_CONNECT_ATTR_ADD,
                  "program_name", "mysqldump");
-  mysql= &mysql_connection;          /* So we can mysql_close() it properly */
-  if (!mysql_real_connect(&mysql_connection,host,user,passwd,
+  if (!mysql_real_connect(mysql_con,host,user,passwd,
                           NULL,opt_mysql_port,opt_mysql_unix_port, 0))
   {
-    DB_error(&mysql_connection, "when trying to connect");
+    DB_error(mysql_con, "when trying to connect");
     DBUG_RETURN(1);
   }
-  if ((mysql_get_server_version(&mysql_connection) < 40100) ||
-      (opt_compatible_mode & 3))
-  {
-    /* Don't dump SET NAMES with a pre-4.1 server (bug#7997).  */
-    opt_set_charset= 0;
-
-    /* Don't switch charsets for 4.1 and earlier.  (bug#34192). */
-    server_supports_switching_charsets= FALSE;
-  } 
   /*
     As we're going to set SQL_MODE, it would be lost on reconnect, so we
     cannot reconnect.
   */
-  mysql->reconnect= 0;
+  mysql_con->reconnect= 0;
   my_snprintf(buff, sizeof(buff), "/*!40100 SET @@SQL_MODE='%s' */",
               compatible_mode_normal_str);
-  if (mysql_query_with_error_report(mysql, 0, buff))
+  if (mysql_query_with_error_report(mysql_con, 0, buff))
     DBUG_RETURN(1);
   /*
     set time_zone to UTC to allow dumping date types between servers with
@@ -1699,10 +1712,35 @@ static int connect_to_db(char *host, char *user,char *passwd)
   if (opt_tz_utc)
   {
     my_snprintf(buff, sizeof(buff), "/*!40103 SET TIME_ZONE='+00:00' */");
-    if (mysql_query_with_error_report(mysql, 0, buff))
+    if (mysql_query_with_error_report(mysql_con, 0, buff))
       DBUG_RETURN(1);
   }
   DBUG_RETURN(0);
+} /* connect_to_server */
+
+
+/*
+  db_connect -- connects to the host and selects DB.
+*/
+
+static int connect_to_db(char *host, char *user,char *passwd)
+{
+  DBUG_ENTER("connect_to_db");
+
+  verbose_msg("-- Connecting to %s...\n", host ? host : "localhost");
+  mysql= &mysql_connection;          /* So we can mysql_close() it properly */
+  if (connect_to_server(&mysql_connection, host, user, passwd))
+    DBUG_RETURN(1);
+  if ((mysql_get_server_version(&mysql_connection) < 40100) ||
+      (opt_compatible_mode & 3))
+  {
+    /* Don't dump SET NAMES with a pre-4.1 server (bug#7997).  */
+    opt_set_charset= 0;
+
+    /* Don't switch charsets for 4.1 and earlier.  (bug#34192). */
+    server_supports_switching_charsets= FALSE;
+  } 
+  DBUG_RETURN(0);
 } /* connect_to_db */
 
 
@@ -1716,6 +1754,207 @@ static void dbDisconnect(char *host)
 } /* dbDisconnect */
 
 
+/*
+  The data files of --tab can be written by a pool of worker threads.
+
+  The main thread builds one SELECT ... INTO OUTFILE per table, or per
+  primary key range of a big table (see --chunk-rows), and queues it.
+  Each worker runs the queued queries over a connection of its own.  The
+  worker connections are opened before the dump starts, so that with
+  --single-transaction they start their transactions under the same
+  FLUSH TABLES WITH READ LOCK as the main connection and all read the
+  same snapshot.  The lock is released before any data is dumped.
+*/
+
+typedef struct st_dump_job
+{
+  struct st_dump_job *next;
+  char query[1];
+} DUMP_JOB;
+
+static MYSQL *worker_mysql= 0;
+static pthread_t *worker_threads= 0;
+static uint workers_connected= 0, workers_started= 0;
+static DUMP_JOB *dump_jobs= 0, **dump_jobs_last= &dump_jobs;
+static uint dump_jobs_running= 0;
+static my_bool dump_jobs_closed= 0;
+static int worker_error= 0;
+static pthread_mutex_t dump_jobs_mutex;
+static pthread_cond_t dump_jobs_cond;
+
+
+static int connect_dump_workers(char *host, char *user, char *passwd)
+{
+  DBUG_ENTER("connect_dump_workers");
+  verbose_msg("-- Opening %u worker connections...\n", opt_use_threads);
+  if (!(worker_mysql= (MYSQL*) my_malloc(opt_use_threads * sizeof(MYSQL),
+                                         MYF(MY_WME))) ||
+      !(worker_threads= (pthread_t*) my_malloc(opt_use_threads *
+                                               sizeof(pthread_t),
+                                               MYF(MY_WME))))
+    die(EX_EOM, "Couldn't allocate memory");
+  pthread_mutex_init(&dump_jobs_mutex, NULL);
+  pthread_cond_init(&dump_jobs_cond, NULL);
+  for (; workers_connected < opt_use_threads; workers_connected++)
+  {
+    if (connect_to_server(worker_mysql + workers_connected, host, user,
+                          passwd))
+    {
+      mysql_close(worker_mysql + workers_connected);
+      DBUG_RETURN(1);
+    }
+  }
+  DBUG_RETURN(0);
+}
+
+
+pthread_handler_t dump_worker(void *arg)
+{
+  MYSQL *mysql_con= (MYSQL*) arg;
+  DUMP_JOB *job;
+
+  mysql_thread_init();
+  pthread_mutex_lock(&dump_jobs_mutex);
+  for (;;)
+  {
+    int error;
+    while (!dump_jobs && !dump_jobs_closed)
+      pthread_cond_wait(&dump_jobs_cond, &dump_jobs_mutex);
+    if (!(job= dump_jobs))
+      break;
+    if (!(dump_jobs= job->next))
+      dump_jobs_last= &dump_jobs;
+    dump_jobs_running++;
+    pthread_mutex_unlock(&dump_jobs_mutex);
+
+    error= mysql_query(mysql_con, job->query);
+
+    pthread_mutex_lock(&dump_jobs_mutex);
+    if (error)
+    {
+      fprintf(stderr, "%s: Got error: %d: \"%s\" when executing "
+              "'SELECT INTO OUTFILE'\n", my_progname_short,
+              mysql_errno(mysql_con), mysql_error(mysql_con));
+      fflush(stderr);
+      if (!worker_error)
+        worker_error= EX_MYSQLERR;
+      if (!ignore_errors)
+      {
+        /* Don't start new jobs, the main thread is going to exit */
+        DUMP_JOB *next;
+        for (; dump_jobs; dump_jobs= next)
+        {
+          next= dump_jobs->next;
+          my_free(dump_jobs);
+        }
+        dump_jobs_last= &dump_jobs;
+      }
+    }
+    my_free(job);
+    dump_jobs_running--;
+    pthread_cond_broadcast(&dump_jobs_cond);
+  }
+  pthread_mutex_unlock(&dump_jobs_mutex);
+  mysql_thread_end();
+  return 0;
+}
+
+
+static void start_dump_workers()
+{
+  for (; workers_started < workers_connected; workers_started++)
+  {
+    if (pthread_create(worker_threads + workers_started, NULL, dump_worker,
+                       worker_mysql + workers_started))
+      die(EX_MYSQLERR, "Could not create thread");
+  }
+}
+
+
+/*
+  Queue a query for the workers, or run it here if there are none.
+*/
+
+static void run_dump_query(DYNAMIC_STRING *query)
+{
+  DUMP_JOB *job;
+
+  if (!workers_started)
+  {
+    if (mysql_real_query(mysql, query->str, query->length))
+      DB_error(mysql, "when executing 'SELECT INTO OUTFILE'");
+    return;
+  }
+  if (!(job= (DUMP_JOB*) my_malloc(sizeof(DUMP_JOB) + query->length,
+                                   MYF(MY_WME))))
+    die(EX_EOM, "Couldn't allocate memory");
+  memcpy(job->query, query->str, query->length + 1);
+  job->next= 0;
+  pthread_mutex_lock(&dump_jobs_mutex);
+  if (worker_error && !ignore_errors)
+  {
+    pthread_mutex_unlock(&dump_jobs_mutex);
+    my_free(job);
+    wait_for_dump_workers();
+    return;
+  }
+  *dump_jobs_last= job;
+  dump_jobs_last= &job->next;
+  pthread_cond_signal(&dump_jobs_cond);
+  pthread_mutex_unlock(&dump_jobs_mutex);
+}
+
+
+/*
+  Wait until the workers have run all queued queries.  Must be called
+  before the locks that make the dump consistent are released.
+*/
+
+static void wait_for_dump_workers()
+{
+  int error;
+
+  if (!workers_started)
+    return;
+  pthread_mutex_lock(&dump_jobs_mutex);
+  while (dump_jobs || dump_jobs_running)
+    pthread_cond_wait(&dump_jobs_cond, &dump_jobs_mutex);
+  error= worker_error;
+  worker_error= 0;
+  pthread_mutex_unlock(&dump_jobs_mutex);
+  if (error)
+    maybe_exit(error);
+}
+
+
+static void end_dump_workers()
+{
+  uint i;
+
+  if (!worker_mysql)
+    return;
+  if (workers_started)
+  {
+    wait_for_dump_workers();
+    pthread_mutex_lock(&dump_jobs_mutex);
+    dump_jobs_closed= 1;
+    pthread_cond_broadcast(&dump_jobs_cond);
+    pthread_mutex_unlock(&dump_jobs_mutex);
+    for (i= 0; i < workers_started; i++)
+      pthread_join(worker_threads[i], NULL);
+  }
+  for (i= 0; i < workers_connected; i++)
+    mysql_close(worker_mysql + i);
+  pthread_mutex_destroy(&dump_jobs_mutex);
+  pthread_cond_destroy(&dump_jobs_cond);
+  my_free(worker_threads);
+  my_free(worker_mysql);
+  worker_threads= 0;
+  worker_mysql= 0;
+  workers_started= workers_connected= 0;
+}
+
+
 static void unescape(FILE *file,char *pos,uint length)
 {
   char *tmp;
@@ -3498,6 +3737,224 @@ static char *alloc_query_str(ulong size)
 }
 
 
+/*
+  Build the SELECT ... INTO OUTFILE query that writes the --tab data
+  file 'name' from table 'from', restricted to 'range' if it is not NULL.
+*/
+
+static void build_outfile_query(DYNAMIC_STRING *query_string,
+                                const char *name, const char *ext,
+                                const char *from, const char *range)
+{
+  char filename[FN_REFLEN], tmp_path[FN_REFLEN];
+
+  /*
+    Convert the path to native os format
+    and resolve to the full filepath.
+  */
+  convert_dirname(tmp_path,path,NullS);    
+  my_load_path(tmp_path, tmp_path, NULL);
+  fn_format(filename, name, tmp_path, ext, MYF(MY_UNPACK_FILENAME));
+
+  /* Must delete the file that 'INTO OUTFILE' will write to */
+  my_delete(filename, MYF(0));
+
+  /* convert to a unix path name to stick into the query */
+  to_unix_path(filename);
+
+  /* now build the query string */
+
+  dynstr_set_checked(query_string, "SELECT /*!40001 SQL_NO_CACHE */ * INTO OUTFILE '");
+  dynstr_append_checked(query_string, filename);
+  dynstr_append_checked(query_string, "'");
+
+  dynstr_append_checked(query_string, " /*!50138 CHARACTER SET ");
+  dynstr_append_checked(query_string, default_charset == mysql_universal_client_charset ?
+                                      my_charset_bin.name : /* backward compatibility */
+                                      default_charset);
+  dynstr_append_checked(query_string, " */");
+
+  if (fields_terminated || enclosed || opt_enclosed || escaped)
+    dynstr_append_checked(query_string, " FIELDS");
+  
+  add_load_option(query_string, " TERMINATED BY ", fields_terminated);
+  add_load_option(query_string, " ENCLOSED BY ", enclosed);
+  add_load_option(query_string, " OPTIONALLY ENCLOSED BY ", opt_enclosed);
+  add_load_option(query_string, " ESCAPED BY ", escaped);
+  add_load_option(query_string, " LINES TERMINATED BY ", lines_terminated);
+
+  dynstr_append_checked(query_string, " FROM ");
+  dynstr_append_checked(query_string, from);
+
+  if (where && range)
+  {
+    dynstr_append_checked(query_string, " WHERE (");
+    dynstr_append_checked(query_string, where);
+    dynstr_append_checked(query_string, ") AND ");
+    dynstr_append_checked(query_string, range);
+  }
+  else if (where || range)
+  {
+    dynstr_append_checked(query_string, " WHERE ");
+    dynstr_append_checked(query_string, where ? where : range);
+  }
+
+  if (order_by)
+  {
+    dynstr_append_checked(query_string, " ORDER BY ");
+    dynstr_append_checked(query_string, order_by);
+  }
+}
+
+
+/*
+  Find out how to split the data of a table for --chunk-rows.
+
+  SYNOPSIS
+    get_chunk_key()
+    table       table name
+    result_table quoted table name
+    key         buffer for the quoted name of the primary key column
+    min, max    smallest and biggest key value, as unsigned numbers
+                that sort like the key values
+    is_unsigned set if the key is unsigned
+
+  RETURN
+    number of chunks, 1 if the table should not be split
+*/
+
+static ulonglong get_chunk_key(const char *table, const char *result_table,
+                               char *key, ulonglong *min, ulonglong *max,
+                               my_bool *is_unsigned)
+{
+  char buff[NAME_LEN*8+64], show_name_buff[FN_REFLEN];
+  MYSQL_RES *res;
+  MYSQL_ROW row;
+  MYSQL_FIELD *field;
+  ulonglong rows= 0, chunks= 1;
+
+  /* SHOW KEYS returns the PRIMARY key first */
+  my_snprintf(buff, sizeof(buff), "SHOW KEYS FROM %s", result_table);
+  if (mysql_query(mysql, buff) || !(res= mysql_store_result(mysql)))
+    return 1;
+  if ((row= mysql_fetch_row(res)) && !strcmp(row[2], "PRIMARY") &&
+      (mysql_num_rows(res) == 1 ||
+       !(row= mysql_fetch_row(res)) || strcmp(row[2], "PRIMARY")))
+  {
+    mysql_data_seek(res, 0);
+    row= mysql_fetch_row(res);
+    quote_name(row[4], key, 1);
+    rows= 1;
+  }
+  mysql_free_result(res);
+  if (!rows)
+    return 1;
+
+  /* Rows is the 5th column of SHOW TABLE STATUS, an estimate for InnoDB */
+  my_snprintf(buff, sizeof(buff), "SHOW TABLE STATUS LIKE %s",
+              quote_for_like(table, show_name_buff));
+  if (mysql_query(mysql, buff) || !(res= mysql_store_result(mysql)))
+    return 1;
+  rows= (row= mysql_fetch_row(res)) && row[4] ? strtoull(row[4], NULL, 10) : 0;
+  mysql_free_result(res);
+  if (rows <= opt_chunk_rows)
+    return 1;
+
+  my_snprintf(buff, sizeof(buff), "SELECT MIN(%s), MAX(%s) FROM %s",
+              key, key, result_table);
+  if (mysql_query(mysql, buff) || !(res= mysql_store_result(mysql)))
+    return 1;
+  field= mysql_fetch_field(res);
+  if ((row= mysql_fetch_row(res)) && row[0] && row[1] &&
+      (field->type == MYSQL_TYPE_TINY || field->type == MYSQL_TYPE_SHORT ||
+       field->type == MYSQL_TYPE_INT24 || field->type == MYSQL_TYPE_LONG ||
+       field->type == MYSQL_TYPE_LONGLONG))
+  {
+    *is_unsigned= MY_TEST(field->flags & UNSIGNED_FLAG);
+    if (*is_unsigned)
+    {
+      *min= strtoull(row[0], NULL, 10);
+      *max= strtoull(row[1], NULL, 10);
+    }
+    else
+    {
+      /* Flip the sign bit, so that the values sort as unsigned numbers */
+      *min= (ulonglong) strtoll(row[0], NULL, 10) ^ (1ULL << 63);
+      *max= (ulonglong) strtoll(row[1], NULL, 10) ^ (1ULL << 63);
+    }
+    chunks= rows / opt_chunk_rows + 1;
+    if (chunks > *max - *min)
+      chunks= MY_MAX(*max - *min, 1);
+  }
+  mysql_free_result(res);
+  return chunks;
+}
+
+
+/*
+  Write the --tab data file(s) of a table.
+
+  A table with an integer primary key and more than --chunk-rows rows
+  is split into primary key ranges of about equal size, written to
+  tbl_name.1.txt, tbl_name.2.txt, ... so that they can be dumped and
+  loaded in parallel.  The first and the last range are open ended, so
+  that rows inserted after the MIN()/MAX() lookup are not missed.
+*/
+
+static void dump_table_data_files(const char *table, const char *db,
+                                  const char *result_table)
+{
+  char from[NAME_LEN*4+8], db_buff[NAME_LEN*2+3];
+  char key[NAME_LEN*2+3], name[FN_REFLEN], range[NAME_LEN*4+64];
+  char low[22], high[22];
+  DYNAMIC_STRING query_string;
+  ulonglong chunks= 1, min= 0, max= 0, step, i;
+  my_bool is_unsigned= 0;
+
+  strxmov(from, quote_name(db, db_buff, 1), ".", result_table, NullS);
+  init_dynamic_string_checked(&query_string, "", 1024, 1024);
+
+  if (opt_chunk_rows)
+    chunks= get_chunk_key(table, result_table, key, &min, &max, &is_unsigned);
+
+  if (chunks <= 1)
+  {
+    build_outfile_query(&query_string, table, ".txt", from, NULL);
+    run_dump_query(&query_string);
+    dynstr_free(&query_string);
+    return;
+  }
+
+  verbose_msg("-- Splitting %s into %llu chunks\n", result_table, chunks);
+  step= (max - min) / chunks;
+  for (i= 0; i < chunks; i++)
+  {
+    ulonglong bound= min + i * step;
+    if (is_unsigned)
+    {
+      ullstr(bound, low);
+      ullstr(bound + step, high);
+    }
+    else
+    {
+      longlong10_to_str((longlong) (bound ^ (1ULL << 63)), low, -10);
+      longlong10_to_str((longlong) ((bound + step) ^ (1ULL << 63)), high, -10);
+    }
+    if (i == 0)
+      my_snprintf(range, sizeof(range), "%s < %s", key, high);
+    else if (i == chunks - 1)
+      my_snprintf(range, sizeof(range), "%s >= %s", key, low);
+    else
+      my_snprintf(range, sizeof(range), "%s >= %s AND %s < %s",
+                  key, low, key, high);
+    my_snprintf(name, sizeof(name), "%s.%llu.txt", table, i + 1);
+    build_outfile_query(&query_string, name, "", from, range);
+    run_dump_query(&query_string);
+  }
+  dynstr_free(&query_string);
+}
+
+
 /*
 
  SYNOPSIS
@@ -3590,66 +4047,7 @@ static void dump_table(char *table, char *db)
   init_dynamic_string_checked(&query_string, "", 1024, 1024);
 
   if (path)
-  {
-    char filename[FN_REFLEN], tmp_path[FN_REFLEN];
-
-    /*
-      Convert the path to native os format
-      and resolve to the full filepath.
-    */
-    convert_dirname(tmp_path,path,NullS);    
-    my_load_path(tmp_path, tmp_path, NULL);
-    fn_format(filename, table, tmp_path, ".txt", MYF(MY_UNPACK_FILENAME));
-
-    /* Must delete the file that 'INTO OUTFILE' will write to */
-    my_delete(filename, MYF(0));
-
-    /* convert to a unix path name to stick into the query */
-    to_unix_path(filename);
-
-    /* now build the query string */
-
-    dynstr_append_checked(&query_string, "SELECT /*!40001 SQL_NO_CACHE */ * INTO OUTFILE '");
-    dynstr_append_checked(&query_string, filename);
-    dynstr_append_checked(&query_string, "'");
-
-    dynstr_append_checked(&query_string, " /*!50138 CHARACTER SET ");
-    dynstr_append_checked(&query_string, default_charset == mysql_universal_client_charset ?
-                                         my_charset_bin.name : /* backward compatibility */
-                                         default_charset);
-    dynstr_append_checked(&query_string, " */");
-
-    if (fields_terminated || enclosed || opt_enclosed || escaped)
-      dynstr_append_checked(&query_string, " FIELDS");
-    
-    add_load_option(&query_string, " TERMINATED BY ", fields_terminated);
-    add_load_option(&query_string, " ENCLOSED BY ", enclosed);
-    add_load_option(&query_string, " OPTIONALLY ENCLOSED BY ", opt_enclosed);
-    add_load_option(&query_string, " ESCAPED BY ", escaped);
-    add_load_option(&query_string, " LINES TERMINATED BY ", lines_terminated);
-
-    dynstr_append_checked(&query_string, " FROM ");
-    dynstr_append_checked(&query_string, result_table);
-
-    if (where)
-    {
-      dynstr_append_checked(&query_string, " WHERE ");
-      dynstr_append_checked(&query_string, where);
-    }
-
-    if (order_by)
-    {
-      dynstr_append_checked(&query_string, " ORDER BY ");
-      dynstr_append_checked(&query_string, order_by);
-    }
-
-    if (mysql_real_query(mysql, query_string.str, query_string.length))
-    {
-      DB_error(mysql, "when executing 'SELECT INTO OUTFILE'");
-      dynstr_free(&query_string);
-      DBUG_VOID_RETURN;
-    }
-  }
+    dump_table_data_files(table, db, result_table);
   else
   {
     print_comment(md_result_file, 0,
@@ -4580,6 +4978,13 @@ static int dump_all_tables_in_db(char *database)
     }
   }
 
+  /*
+    The table locks are released below, or replaced by the ones of
+    dump_events_for_db() and dump_routines_for_db(): the workers must be
+    done with the tables first.
+  */
+  wait_for_dump_workers();
+
   if (opt_single_transaction && mysql_get_server_version(mysql) >= 50500)
   {
     verbose_msg("-- Releasing savepoint...\n");
@@ -4870,6 +5275,13 @@ static int dump_selected_tables(char *db, char **table_names, int tables)
     }
   }
 
+  /*
+    The table locks are released below, or replaced by the ones of
+    dump_events_for_db() and dump_routines_for_db(): the workers must be
+    done with the tables first.
+  */
+  wait_for_dump_workers();
+
   if (opt_single_transaction && mysql_get_server_version(mysql) >= 50500)
   {
     verbose_msg("-- Releasing savepoint...\n");
@@ -5886,6 +6298,9 @@ int main(int argc, char **argv)
     free_resources();
     exit(EX_MYSQLERR);
   }
+  if (opt_use_threads &&
+      connect_dump_workers(current_host, current_user, opt_password))
+    goto err;
   if (!path)
     write_header(md_result_file, *argv);
 
@@ -5899,14 +6314,18 @@ int main(int argc, char **argv)
   if (opt_slave_data && do_stop_slave_sql(mysql))
     goto err;
 
-  if (opt_single_transaction && opt_master_data)
+  if (opt_single_transaction && opt_master_data && !opt_use_threads)
   {
     /* See if we can avoid FLUSH TABLES WITH READ LOCK (MariaDB 5.3+). */
     consistent_binlog_pos= check_consistent_binlog_pos(NULL, NULL);
   }
 
+  /*
+    The worker connections must start their transactions under the read
+    lock, for them to see the same snapshot as the main connection.
+  */
   if ((opt_lock_all_tables || (opt_master_data && !consistent_binlog_pos) ||
-       (opt_single_transaction && flush_logs)) &&
+       (opt_single_transaction && (flush_logs || opt_use_threads))) &&
       do_flush_tables_read_lock(mysql))
     goto err;
 
@@ -5937,6 +6356,13 @@ int main(int argc, char **argv)
 
   if (opt_single_transaction && start_transaction(mysql))
     goto err;
+  if (opt_single_transaction)
+  {
+    uint i;
+    for (i= 0; i < workers_connected; i++)
+      if (start_transaction(worker_mysql + i))
+        goto err;
+  }
 
   /* Add 'STOP SLAVE to beginning of dump */
   if (opt_slave_apply && add_stop_slave())
@@ -5954,6 +6380,9 @@ int main(int argc, char **argv)
   if (opt_single_transaction && do_unlock_tables(mysql)) /* unlock but no commit! */
     goto err;
 
+  if (opt_use_threads)
+    start_dump_workers();
+
   if (opt_alltspcs)
     dump_all_tablespaces();
 
@@ -5998,6 +6427,8 @@ int main(int argc, char **argv)
     }
   }
 
+  end_dump_workers();
+
   /* add 'START SLAVE' to end of dump */
   if (opt_slave_apply && add_slave_statements())
     goto err;
@@ -6028,6 +6459,7 @@ int main(int argc, char **argv)
   my_free(shared_memory_base_name);
 #endif
 
+  end_dump_workers();
   dbDisconnect(current_host);
   if (!path)
     write_footer(md_result_file);
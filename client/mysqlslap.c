@@ -56,6 +56,14 @@
               --iterations=5 --query=query.sql --create=create.sql \
               --delimiter=";"
 
+  Measure the latency of each query and the number of queries run in each
+  second, with 1, 8 and 64 clients, and write the results for all three
+  to a JSON file:
+
+    mysqlslap --concurrency=1,8,64 --iterations=3 \
+              --query=query.sql --create=create.sql --delimiter=";" \
+              --latency --report-interval=1 --json=results.json
+
 TODO:
   Add language for better tests
   String length for files and those put on the command line are not
@@ -71,6 +79,15 @@
 #define HUGE_STRING_LENGTH 8196
 #define RAND_STRING_SIZE 126
 
+/*
+  Latency histogram: the latencies in microseconds below
+  2 * LATENCY_SUB_BUCKETS have a bucket each, above that every power of
+  two is split into LATENCY_SUB_BUCKETS buckets, so the value of a bucket
+  is within 1/LATENCY_SUB_BUCKETS of the latencies counted in it
+*/
+#define LATENCY_SUB_BUCKETS 64
+#define LATENCY_BUCKETS 2048
+
 /* Types */
 #define SELECT_TYPE 0
 #define UPDATE_TYPE 1
@@ -89,6 +106,7 @@
 #include <sys/wait.h>
 #endif
 #include <ctype.h>
+#include <my_atomic.h>
 #include <welcome_copyright_notice.h>   /* ORACLE_WELCOME_COPYRIGHT_NOTICE */
 
 #ifdef __WIN__
@@ -124,6 +142,14 @@ static char *host= NULL, *opt_password= NULL, *user= NULL,
             *opt_mysql_unix_port= NULL,
             *opt_init_command= NULL;
 static char *opt_plugin_dir= 0, *opt_default_auth= 0;
+static char *opt_compression_algorithm= 0;
+
+static const char *compression_algorithm_names[]= { "zlib", "lz4", NullS };
+static TYPELIB compression_algorithm_typelib=
+{
+  array_elements(compression_algorithm_names) - 1, "",
+  compression_algorithm_names, NULL
+};
 
 const char *delimiter= "\n";
 
@@ -132,6 +158,7 @@ const char *create_schema_string= "mysqlslap";
 static my_bool opt_preserve= TRUE, opt_no_drop= FALSE;
 static my_bool debug_info_flag= 0, debug_check_flag= 0;
 static my_bool opt_only_print= FALSE;
+static my_bool opt_latency= FALSE;
 static my_bool opt_compress= FALSE, tty_password= FALSE,
                opt_silent= FALSE,
                auto_generate_sql_autoincrement= FALSE,
@@ -146,6 +173,7 @@ static unsigned long connect_flags= CLIENT_MULTI_RESULTS |
 static int verbose, delimiter_length;
 static uint commit_rate;
 static uint detach_rate;
+static uint opt_report_interval;
 const char *num_int_cols_opt;
 const char *num_char_cols_opt;
 
@@ -171,6 +199,12 @@ uint *concurrency;
 const char *default_dbug_option="d:t:o,/tmp/mysqlslap.trace";
 const char *opt_csv_str;
 File csv_file;
+const char *opt_json_str;
+File json_file;
+static my_bool json_first_run= TRUE;
+
+/* Number of queries run by all clients, sampled by --report-interval */
+static volatile int64 queries_done;
 
 static uint opt_protocol= 0;
 
@@ -201,12 +235,26 @@ struct option_string {
   option_string *next;
 };
 
+typedef struct latency_histogram latency_histogram;
+
+struct latency_histogram {
+  ulonglong count[LATENCY_BUCKETS];
+  ulonglong total;
+  ulonglong sum;
+  ulonglong min;
+  ulonglong max;
+};
+
 typedef struct stats stats;
 
 struct stats {
   long int timing;
   uint users;
   unsigned long long rows;
+  /* Queries run in each --report-interval, the last one may be shorter */
+  ulonglong *interval_queries;
+  uint intervals;
+  long int last_interval_timing;
 };
 
 typedef struct thread_context thread_context;
@@ -214,6 +262,7 @@ typedef struct thread_context thread_context;
 struct thread_context {
   statement *stmt;
   ulonglong limit;
+  latency_histogram *latency;
 };
 
 typedef struct conclusions conclusions;
@@ -228,6 +277,7 @@ struct conclusions {
   /* The following are not used yet */
   unsigned long long max_rows;
   unsigned long long min_rows;
+  latency_histogram *latency;
 };
 
 static option_string *engine_options= NULL;
@@ -237,8 +287,9 @@ static statement *create_statements= NULL,
                  *query_statements= NULL;
 
 /* Prototypes */
-void print_conclusions(conclusions *con);
+void print_conclusions(conclusions *con, stats *sptr);
 void print_conclusions_csv(conclusions *con);
+void print_conclusions_json(conclusions *con, stats *sptr);
 void generate_stats(conclusions *con, option_string *eng, stats *sptr);
 uint parse_comma(const char *string, uint **range);
 uint parse_delimiter(const char *script, statement **stmt, char delm);
@@ -254,7 +305,7 @@ static int drop_primary_key_list(void);
 static int create_schema(MYSQL *mysql, const char *db, statement *stmt, 
               option_string *engine_stmt);
 static int run_scheduler(stats *sptr, statement *stmts, uint concur, 
-                         ulonglong limit);
+                         ulonglong limit, latency_histogram *latency);
 pthread_handler_t run_task(void *p);
 void statement_cleanup(statement *stmt);
 void option_cleanup(option_string *stmt);
@@ -292,10 +343,89 @@ static int gettimeofday(struct timeval *tp, void *tzp)
 }
 #endif
 
+static uint latency_bucket(ulonglong value)
+{
+  uint shift= 0;
+  while ((value >> shift) >= 2 * LATENCY_SUB_BUCKETS)
+    shift++;
+  if (shift > LATENCY_BUCKETS / LATENCY_SUB_BUCKETS - 2)
+    return LATENCY_BUCKETS - 1;
+  return shift * LATENCY_SUB_BUCKETS + (uint) (value >> shift);
+}
+
+
+/* The highest latency that is counted in a bucket */
+static ulonglong latency_bucket_value(uint bucket)
+{
+  uint shift= bucket < 2 * LATENCY_SUB_BUCKETS ?
+              0 : bucket / LATENCY_SUB_BUCKETS - 1;
+  return ((ulonglong) (bucket - shift * LATENCY_SUB_BUCKETS + 1) << shift) - 1;
+}
+
+
+static void latency_add(latency_histogram *h, ulonglong value)
+{
+  h->count[latency_bucket(value)]++;
+  if (!h->total || value < h->min)
+    h->min= value;
+  if (value > h->max)
+    h->max= value;
+  h->total++;
+  h->sum+= value;
+}
+
+
+static void latency_merge(latency_histogram *to, const latency_histogram *from)
+{
+  uint x;
+  if (!from->total)
+    return;
+  for (x= 0; x < LATENCY_BUCKETS; x++)
+    to->count[x]+= from->count[x];
+  if (!to->total || from->min < to->min)
+    to->min= from->min;
+  if (from->max > to->max)
+    to->max= from->max;
+  to->total+= from->total;
+  to->sum+= from->sum;
+}
+
+
+/* Queries per second run in the given --report-interval of an iteration */
+static ulonglong interval_rate(const stats *sptr, uint interval)
+{
+  long int timing= interval + 1 < sptr->intervals
+                   ? (long int) opt_report_interval * 1000
+                   : sptr->last_interval_timing;
+  return sptr->interval_queries[interval] * 1000 / MY_MAX(timing, 1);
+}
+
+
+/* The latency that permille thousandths of the queries did not exceed */
+static ulonglong latency_percentile(const latency_histogram *h, uint permille)
+{
+  ulonglong rank= (h->total * permille + 999) / 1000, seen= 0;
+  uint x;
+  if (!h->total)
+    return 0;
+  if (!rank)
+    rank= 1;
+  for (x= 0; x < LATENCY_BUCKETS; x++)
+  {
+    if ((seen+= h->count[x]) >= rank)
+      return MY_MIN(latency_bucket_value(x), h->max);
+  }
+  return h->max;
+}
+
+
 void set_mysql_connect_options(MYSQL *mysql)
 {
   if (opt_compress)
     mysql_options(mysql,MYSQL_OPT_COMPRESS,NullS);
+  if (opt_compression_algorithm)
+    mysql_options(mysql, MYSQL_OPT_COMPRESSION_ALGORITHM,
+                  opt_compression_algorithm);
 #ifdef HAVE_OPENSSL
   if (opt_use_ssl)
   {
@@ -382,6 +512,18 @@ int main(int argc, char **argv)
   pthread_mutex_init(&sleeper_mutex, NULL);
   pthread_cond_init(&sleep_threshhold, NULL);
 
+  if (opt_json_str)
+  {
+    char buffer[HUGE_STRING_LENGTH];
+    snprintf(buffer, HUGE_STRING_LENGTH,
+             "{\n  \"version\": \"%s\",\n  \"server_version\": \"%s\",\n"
+             "  \"report_interval\": %u,\n  \"runs\": [",
+             SLAP_VERSION,
+             opt_only_print ? "" : mysql_get_server_info(&mysql),
+             opt_report_interval);
+    my_write(json_file, (uchar*) buffer, (uint)strlen(buffer), MYF(0));
+  }
+
   /* Main iterations loop */
   eptr= engine_options;
   do
@@ -411,6 +553,13 @@ int main(int argc, char **argv)
 
   } while (eptr ? (eptr= eptr->next) : 0);
 
+  if (opt_json_str)
+  {
+    my_write(json_file, (uchar*) "\n  ]\n}\n", 7, MYF(0));
+    if (opt_json_str[0] != '-')
+      my_close(json_file, MYF(0));
+  }
+
   pthread_mutex_destroy(&counter_mutex);
   pthread_cond_destroy(&count_threshhold);
   pthread_mutex_destroy(&sleeper_mutex);
@@ -453,6 +602,10 @@ void concurrency_loop(MYSQL *mysql, uint current, option_string *eptr)
 
   bzero(&conclusion, sizeof(conclusions));
 
+  if (opt_latency)
+    conclusion.latency= (latency_histogram *)
+      my_malloc(sizeof(latency_histogram), MYF(MY_ZEROFILL|MY_FAE|MY_WME));
+
   if (auto_actual_queries)
     client_limit= auto_actual_queries;
   else if (num_of_query)
@@ -507,7 +660,8 @@ void concurrency_loop(MYSQL *mysql, uint current, option_string *eptr)
     if (pre_statements)
       run_statements(mysql, pre_statements);
 
-    run_scheduler(sptr, query_statements, current, client_limit); 
+    run_scheduler(sptr, query_statements, current, client_limit,
+                  conclusion.latency);
     
     if (post_statements)
       run_statements(mysql, post_statements);
@@ -527,10 +681,15 @@ void concurrency_loop(MYSQL *mysql, uint current, option_string *eptr)
   generate_stats(&conclusion, eptr, head_sptr);
 
   if (!opt_silent)
-    print_conclusions(&conclusion);
+    print_conclusions(&conclusion, head_sptr);
   if (opt_csv_str)
     print_conclusions_csv(&conclusion);
+  if (opt_json_str)
+    print_conclusions_json(&conclusion, head_sptr);
 
+  for (x= 0, sptr= head_sptr; x < iterations; x++, sptr++)
+    my_free(sptr->interval_queries);
+  my_free(conclusion.latency);
   my_free(head_sptr);
 
 }
@@ -590,6 +749,11 @@ static struct my_option my_long_options[] =
   {"compress", 'C', "Use compression in server/client protocol.",
     &opt_compress, &opt_compress, 0, GET_BOOL, NO_ARG, 0, 0, 0,
     0, 0, 0},
+  {"compression-algorithm", OPT_SLAP_COMPRESSION_ALGORITHM,
+    "Compression algorithm to use, implies --compress. One of lz4 (the "
+    "default; zlib is used if the server does not support lz4) or zlib.",
+    &opt_compression_algorithm, &opt_compression_algorithm, 0, GET_STR,
+    REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
   {"concurrency", 'c', "Number of clients to simulate for query to run.",
    (char**) &concurrency_str, (char**) &concurrency_str, 0, GET_STR,
     REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
@@ -642,6 +806,15 @@ static struct my_option my_long_options[] =
    GET_STR, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
   {"iterations", 'i', "Number of times to run the tests.", &iterations,
     &iterations, 0, GET_UINT, REQUIRED_ARG, 1, 0, 0, 0, 0, 0},
+  {"json", OPT_SLAP_JSON,
+    "Write the results, including the query latency percentiles and the "
+    "throughput of each --report-interval, as JSON to the named file or to "
+    "stdout if no file is named. Implies --latency.",
+    NULL, NULL, 0, GET_STR, OPT_ARG, 0, 0, 0, 0, 0, 0},
+  {"latency", OPT_SLAP_LATENCY,
+    "Measure the latency of each query and report its minimum, average, "
+    "maximum and 50th, 95th, 99th and 99.9th percentiles.",
+    &opt_latency, &opt_latency, 0, GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
   {"no-drop", OPT_SLAP_NO_DROP, "Do not drop the schema after the test.",
    &opt_no_drop, &opt_no_drop, 0, GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
   {"number-char-cols", 'x', 
@@ -696,6 +869,11 @@ static struct my_option my_long_options[] =
   {"query", 'q', "Query to run or file containing query to run.",
     &user_supplied_query, &user_supplied_query,
     0, GET_STR, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+  {"report-interval", OPT_SLAP_REPORT_INTERVAL,
+    "Count the queries run by all clients every this many seconds and report "
+    "the throughput of each interval. 0 disables it.",
+    &opt_report_interval, &opt_report_interval, 0, GET_UINT, REQUIRED_ARG,
+    0, 0, 3600, 0, 0, 0},
 #ifdef HAVE_SMEM
   {"shared-memory-base-name", OPT_SHARED_MEMORY_BASE_NAME,
     "Base name of shared memory.", &shared_memory_base_name,
@@ -773,6 +951,12 @@ get_one_option(int optid, const struct my_option *opt __attribute__((unused)),
     opt_protocol= MYSQL_PROTOCOL_PIPE;
 #endif
     break;
+  case OPT_SLAP_COMPRESSION_ALGORITHM:
+    opt_compression_algorithm= (char*) compression_algorithm_names[
+      find_type_or_exit(argument, &compression_algorithm_typelib,
+                        opt->name) - 1];
+    opt_compress= TRUE;
+    break;
   case OPT_MYSQL_PROTOCOL:
     opt_protocol= find_type_or_exit(argument, &sql_protocol_typelib,
                                     opt->name);
@@ -786,6 +970,11 @@ get_one_option(int optid, const struct my_option *opt __attribute__((unused)),
       argument= (char *)"-"; /* use stdout */
     opt_csv_str= argument;
     break;
+  case OPT_SLAP_JSON:
+    if (!argument)
+      argument= (char *)"-"; /* use stdout */
+    opt_json_str= argument;
+    break;
 #include <sslopt-case.h>
   case 'V':
     print_version();
@@ -1258,6 +1447,27 @@ get_options(int *argc,char ***argv)
     }
   }
 
+  if (opt_json_str)
+  {
+    opt_latency= TRUE;
+
+    if (opt_json_str[0] == '-')
+    {
+      opt_silent= TRUE;
+      json_file= my_fileno(stdout);
+    }
+    else
+    {
+      if ((json_file= my_open(opt_json_str, O_CREAT|O_WRONLY|O_TRUNC, MYF(0)))
+          == -1)
+      {
+        fprintf(stderr,"%s: Could not open json file: %s\n",
+                my_progname, opt_json_str);
+        exit(1);
+      }
+    }
+  }
+
   if (opt_only_print)
     opt_silent= TRUE;
 
@@ -1755,17 +1965,22 @@ run_statements(MYSQL *mysql, statement *stmt)
 }
 
 static int
-run_scheduler(stats *sptr, statement *stmts, uint concur, ulonglong limit)
+run_scheduler(stats *sptr, statement *stmts, uint concur, ulonglong limit,
+              latency_histogram *latency)
 {
   uint x;
   struct timeval start_time, end_time;
   thread_context con;
   pthread_t mainthread;            /* Thread descriptor */
   pthread_attr_t attr;          /* Thread attributes */
+  ulonglong interval_start, queries_reported= 0;
+  uint max_intervals= 0;
   DBUG_ENTER("run_scheduler");
 
   con.stmt= stmts;
   con.limit= limit;
+  con.latency= latency;
+  queries_done= 0;
 
   pthread_attr_init(&attr);
   pthread_attr_setdetachstate(&attr,
@@ -1798,17 +2013,51 @@ run_scheduler(stats *sptr, statement *stmts, uint concur, ulonglong limit)
   pthread_mutex_unlock(&sleeper_mutex);
 
   gettimeofday(&start_time, NULL);
+  interval_start= microsecond_interval_timer();
 
   /*
     We loop until we know that all children have cleaned up.
+    With --report-interval we also wake up at the end of each interval
+    to count the queries the clients ran in it.
   */
   pthread_mutex_lock(&counter_mutex);
   while (thread_counter)
   {
     struct timespec abstime;
 
-    set_timespec(abstime, 3);
-    pthread_cond_timedwait(&count_threshhold, &counter_mutex, &abstime);
+    if (opt_report_interval)
+    {
+      ulonglong interval_end= interval_start +
+                              opt_report_interval * 1000000ULL;
+      ulonglong now= microsecond_interval_timer(), done;
+      if (now < interval_end)
+      {
+        set_timespec_nsec(abstime, (interval_end - now) * 1000ULL);
+        pthread_cond_timedwait(&count_threshhold, &counter_mutex, &abstime);
+        now= microsecond_interval_timer();
+        if (thread_counter && now < interval_end)
+          continue;
+      }
+      if (sptr->intervals == max_intervals)
+      {
+        max_intervals= max_intervals * 2 + 16;
+        sptr->interval_queries= (ulonglong *)
+          my_realloc(sptr->interval_queries,
+                     max_intervals * sizeof(ulonglong),
+                     MYF(MY_ALLOW_ZERO_PTR|MY_FAE|MY_WME));
+      }
+      done= (ulonglong) my_atomic_load64_explicit(&queries_done,
+                                                  MY_MEMORY_ORDER_RELAXED);
+      sptr->interval_queries[sptr->intervals++]= done - queries_reported;
+      sptr->last_interval_timing= (long int) ((now - interval_start) / 1000);
+      queries_reported= done;
+      interval_start= now;
+    }
+    else
+    {
+      set_timespec(abstime, 3);
+      pthread_cond_timedwait(&count_threshhold, &counter_mutex, &abstime);
+    }
   }
   pthread_mutex_unlock(&counter_mutex);
 
@@ -1833,6 +2082,8 @@ pthread_handler_t run_task(void *p)
   MYSQL_ROW row;
   statement *ptr;
   thread_context *con= (thread_context *)p;
+  latency_histogram *latency= NULL;
+  ulonglong query_start= 0;
 
   DBUG_ENTER("run_task");
   DBUG_PRINT("info", ("task script \"%s\"", con->stmt ? con->stmt->string : ""));
@@ -1872,6 +2123,10 @@ pthread_handler_t run_task(void *p)
     printf("connected!\n");
   queries= 0;
 
+  if (con->latency)
+    latency= (latency_histogram *)
+      my_malloc(sizeof(latency_histogram), MYF(MY_ZEROFILL|MY_FAE|MY_WME));
+
   commit_counter= 0;
   if (commit_rate)
     run_query(mysql, "SET AUTOCOMMIT=0", strlen("SET AUTOCOMMIT=0"));
@@ -1895,6 +2150,9 @@ pthread_handler_t run_task(void *p)
           goto end;
       }
 
+      if (latency)
+        query_start= microsecond_interval_timer();
+
       /* 
         We have to execute differently based on query type. This should become a function.
       */
@@ -1959,6 +2217,11 @@ pthread_handler_t run_task(void *p)
       } while(mysql_next_result(mysql) == 0);
       queries++;
 
+      if (latency)
+        latency_add(latency, microsecond_interval_timer() - query_start);
+      if (opt_report_interval)
+        my_atomic_add64_explicit(&queries_done, 1, MY_MEMORY_ORDER_RELAXED);
+
       if (commit_rate && (++commit_counter == commit_rate))
       {
         commit_counter= 0;
@@ -1982,6 +2245,11 @@ pthread_handler_t run_task(void *p)
   mysql_thread_end();
 
   pthread_mutex_lock(&counter_mutex);
+  if (latency)
+  {
+    latency_merge(con->latency, latency);
+    my_free(latency);
+  }
   thread_counter--;
   pthread_cond_signal(&count_threshhold);
   pthread_mutex_unlock(&counter_mutex);
@@ -2145,8 +2413,10 @@ parse_comma(const char *string, uint **range)
 }
 
 void
-print_conclusions(conclusions *con)
+print_conclusions(conclusions *con, stats *sptr)
 {
+  unsigned int x, y;
+
   printf("Benchmark\n");
   if (con->engine)
     printf("\tRunning for engine %s\n", con->engine);
@@ -2158,6 +2428,23 @@ print_conclusions(conclusions *con)
                     con->max_timing / 1000, con->max_timing % 1000);
   printf("\tNumber of clients running queries: %d\n", con->users);
   printf("\tAverage number of queries per client: %llu\n", con->avg_rows); 
+  if (con->latency && con->latency->total)
+  {
+    latency_histogram *h= con->latency;
+    printf("\tQuery latency: min %llu us, avg %llu us, max %llu us\n",
+           h->min, h->sum / h->total, h->max);
+    printf("\tQuery latency percentiles: 50%% %llu us, 95%% %llu us, "
+           "99%% %llu us, 99.9%% %llu us\n",
+           latency_percentile(h, 500), latency_percentile(h, 950),
+           latency_percentile(h, 990), latency_percentile(h, 999));
+  }
+  for (x= 0; opt_report_interval && x < iterations; x++, sptr++)
+  {
+    printf("\tQueries per second every %u seconds:", opt_report_interval);
+    for (y= 0; y < sptr->intervals; y++)
+      printf(" %llu", interval_rate(sptr, y));
+    printf("\n");
+  }
   printf("\n");
 }
 
@@ -2180,6 +2467,81 @@ print_conclusions_csv(conclusions *con)
   my_write(csv_file, (uchar*) buffer, (uint)strlen(buffer), MYF(0));
 }
 
+static void
+json_append_string(DYNAMIC_STRING *str, const char *value)
+{
+  dynstr_append_mem(str, "\"", 1);
+  for (; value && *value; value++)
+  {
+    if (*value == '"' || *value == '\\')
+      dynstr_append_mem(str, "\\", 1);
+    dynstr_append_mem(str, value, 1);
+  }
+  dynstr_append_mem(str, "\"", 1);
+}
+
+void
+print_conclusions_json(conclusions *con, stats *sptr)
+{
+  char buffer[HUGE_STRING_LENGTH];
+  DYNAMIC_STRING run;
+  unsigned int x, y;
+
+  init_dynamic_string(&run, json_first_run ? "\n    {" : ",\n    {",
+                      HUGE_STRING_LENGTH, HUGE_STRING_LENGTH);
+  json_first_run= FALSE;
+
+  dynstr_append(&run, "\"engine\": ");
+  json_append_string(&run, con->engine);
+  dynstr_append(&run, ", \"load_type\": ");
+  json_append_string(&run, auto_generate_sql_type ? auto_generate_sql_type :
+                     "query");
+  snprintf(buffer, HUGE_STRING_LENGTH,
+           ", \"clients\": %u, \"iterations\": %u,"
+           "\n     \"avg_seconds\": %ld.%03ld, \"min_seconds\": %ld.%03ld,"
+           " \"max_seconds\": %ld.%03ld, \"queries_per_client\": %llu",
+           con->users, iterations,
+           con->avg_timing / 1000, con->avg_timing % 1000,
+           con->min_timing / 1000, con->min_timing % 1000,
+           con->max_timing / 1000, con->max_timing % 1000,
+           con->avg_rows);
+  dynstr_append(&run, buffer);
+
+  if (con->latency)
+  {
+    latency_histogram *h= con->latency;
+    snprintf(buffer, HUGE_STRING_LENGTH,
+             ",\n     \"latency_us\": {\"count\": %llu, \"min\": %llu,"
+             " \"avg\": %llu, \"max\": %llu, \"p50\": %llu, \"p95\": %llu,"
+             " \"p99\": %llu, \"p99_9\": %llu}",
+             h->total, h->min, h->total ? h->sum / h->total : 0, h->max,
+             latency_percentile(h, 500), latency_percentile(h, 950),
+             latency_percentile(h, 990), latency_percentile(h, 999));
+    dynstr_append(&run, buffer);
+  }
+
+  if (opt_report_interval)
+  {
+    dynstr_append(&run, ",\n     \"queries_per_second\": [");
+    for (x= 0; x < iterations; x++, sptr++)
+    {
+      dynstr_append(&run, x ? ", [" : "[");
+      for (y= 0; y < sptr->intervals; y++)
+      {
+        snprintf(buffer, HUGE_STRING_LENGTH, y ? ", %llu" : "%llu",
+                 interval_rate(sptr, y));
+        dynstr_append(&run, buffer);
+      }
+      dynstr_append(&run, "]");
+    }
+    dynstr_append(&run, "]");
+  }
+
+  dynstr_append(&run, "}");
+  my_write(json_file, (uchar*) run.str, run.length, MYF(0));
+  dynstr_free(&run);
+}
+
 void
 generate_stats(conclusions *con, option_string *eng, stats *sptr)
 {
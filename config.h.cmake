@@ -472,6 +472,8 @@
 
 #cmakedefine HAVE_SOLARIS_STYLE_GETHOST 1
 
+#cmakedefine HAVE_CLMUL_INSTRUCTION 1
+
 #cmakedefine MY_ATOMIC_MODE_DUMMY 1
 #cmakedefine HAVE_GCC_ATOMIC_BUILTINS 1
 #cmakedefine HAVE_SOLARIS_ATOMIC 1
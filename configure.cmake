@@ -656,6 +656,29 @@ int main()
 }"
 HAVE_SELECT)
 
+#
+# Check whether the compiler can generate PCLMULQDQ code for a single
+# function, used by the hardware accelerated CRC32 in mysys
+#
+IF(CMAKE_SYSTEM_PROCESSOR MATCHES "x86_64|amd64|AMD64|i.86")
+  CHECK_C_SOURCE_COMPILES("
+  #include <cpuid.h>
+  #include <smmintrin.h>
+  #include <wmmintrin.h>
+  __attribute__((target(\"sse4.1,pclmul\")))
+  static int f(__m128i a, __m128i b)
+  {
+    return _mm_extract_epi32(_mm_clmulepi64_si128(a, b, 0x00), 1);
+  }
+  int main()
+  {
+    unsigned int eax, ebx, ecx, edx;
+    __get_cpuid(1, &eax, &ebx, &ecx, &edx);
+    return f(_mm_cvtsi32_si128(1), _mm_cvtsi32_si128(2));
+  }"
+  HAVE_CLMUL_INSTRUCTION)
+ENDIF()
+
 #
 # Check if timespec has ts_sec and ts_nsec fields
 #
@@ -109,6 +109,20 @@ typedef struct st_heap_block
 
 struct st_heap_info;			/* For referense */
 
+/*
+  A column whose data is not stored in the row but in a chain of chunks,
+  see hp_record.c. The row keeps only the length of the data.
+*/
+
+typedef struct st_hp_columndef
+{
+  enum en_fieldtype type;		/* FIELD_VARCHAR or FIELD_BLOB */
+  uint offset;				/* Offset of the column in the record */
+  uint length;				/* Length of the column in the record */
+  uint length_bytes;			/* Bytes used for the length of data */
+  uint pack_offset;			/* Offset of the length in the row */
+} HP_COLUMNDEF;
+
 typedef struct st_hp_keydef		/* Key definition with open */
 {
   uint flag;				/* HA_NOSAME | HA_NULL_PART_KEY */
@@ -133,7 +147,9 @@ typedef struct st_hp_keydef		/* Key definition with open */
 typedef struct st_heap_share
 {
   HP_BLOCK block;
+  HP_BLOCK chunk_block;			/* Chunks of the column data */
   HP_KEYDEF  *keydef;
+  HP_COLUMNDEF *columndef;		/* Columns stored in chunks */
   ulonglong data_length,index_length,max_table_size;
   ulonglong auto_increment;
   ulong min_records,max_records;	/* Params to open */
@@ -143,12 +159,16 @@ typedef struct st_heap_share
   uint key_stat_version;                /* version to indicate insert/delete */
   uint key_version;                     /* Updated on key change */
   uint file_version;                    /* Update on clear */
-  uint reclength;			/* Length of one record */
+  uint reclength;			/* Length of one row */
+  uint org_reclength;			/* Length of the unpacked record */
   uint changed;
   uint keys,max_key_length;
+  uint columns;				/* Columns stored in chunks */
+  ulong chunks;				/* Allocated chunks, used or free */
   uint currently_disabled_keys;    /* saved value from "keys" when disabled */
   uint open_count;
   uchar *del_link;			/* Link to next block with del. rec */
+  uchar *chunk_del_link;		/* Link to next free chunk */
   char * name;			/* Name of "memory-file" */
   time_t create_time;
   THR_LOCK lock;
@@ -173,6 +193,9 @@ typedef struct st_heap_info
   uint opt_flag,update;
   uchar *lastkey;			/* Last used key with rkey */
   uchar *recbuf;                         /* Record buffer for rb-tree keys */
+  uchar *rec_buff;                      /* Row packed for heap_write() */
+  uchar *blob_buff;                     /* Blob data of the last read row */
+  size_t blob_buff_length;
   enum ha_rkey_function last_find_flag;
   TREE_ELEMENT *parents[MAX_TREE_HEIGHT+1];
   TREE_ELEMENT **last_pos;
@@ -188,6 +211,8 @@ typedef struct st_heap_info
 typedef struct st_heap_create_info
 {
   HP_KEYDEF *keydef;
+  HP_COLUMNDEF *columndef;		/* Columns to store in chunks */
+  uint columns;
   uint auto_key;                        /* keynr [1 - maxkey] for auto key */
   uint auto_key_type;
   uint keys;
@@ -217,6 +242,7 @@ extern int heap_update(HP_INFO *info,const uchar *old,const uchar *newdata);
 extern int heap_rrnd(HP_INFO *info,uchar *buf,uchar *pos);
 extern int heap_scan_init(HP_INFO *info);
 extern int heap_scan(register HP_INFO *info, uchar *record);
+extern int heap_scan_restart(HP_INFO *info, uchar *record, ulong pos);
 extern int heap_delete(HP_INFO *info,const uchar *buff);
 extern int heap_info(HP_INFO *info,HEAPINFO *x,int flag);
 extern int heap_create(const char *name,
@@ -744,6 +744,10 @@ extern my_bool radixsort_is_appliccable(uint n_items, size_t size_of_element);
 extern void my_string_ptr_sort(uchar *base,uint items,size_t size);
 extern void radixsort_for_str_ptr(uchar* base[], uint number_of_elements,
 				  size_t size_of_element,uchar *buffer[]);
+extern my_bool msd_radixsort_is_applicable(uint n_items,
+                                           size_t size_of_element);
+extern void msd_radixsort_for_str_ptr(uchar* base[], uint number_of_elements,
+                                      size_t size_of_element,uchar *buffer[]);
 extern qsort_t my_qsort(void *base_ptr, size_t total_elems, size_t size,
                         qsort_cmp cmp);
 extern qsort_t my_qsort2(void *base_ptr, size_t total_elems, size_t size,
@@ -867,6 +871,9 @@ extern char *strmake_root(MEM_ROOT *root,const char *str,size_t len);
 extern void *memdup_root(MEM_ROOT *root,const void *str, size_t len);
 extern my_bool my_compress(uchar *, size_t *, size_t *);
 extern my_bool my_uncompress(uchar *, size_t , size_t *);
+extern const my_bool my_have_lz4_compress;
+extern my_bool my_lz4_compress(uchar *, size_t *, size_t *);
+extern my_bool my_lz4_uncompress(uchar *, size_t , size_t *);
 extern uchar *my_compress_alloc(const uchar *packet, size_t *len,
                                 size_t *complen);
 extern void *my_az_allocator(void *dummy, unsigned int items, unsigned int size);
@@ -878,6 +885,7 @@ extern int unpackfrm(uchar **, size_t *, const uchar *);
 
 extern ha_checksum my_checksum(ha_checksum crc, const uchar *mem,
                                size_t count);
+extern void my_checksum_init(void);
 #ifndef DBUG_OFF
 extern void my_debug_put_break_here(void);
 #else
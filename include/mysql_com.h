@@ -278,6 +278,22 @@ enum enum_server_command
                                                & ~CLIENT_COMPRESS) \
                                                & ~CLIENT_SSL_VERIFY_SERVER_CERT)
 
+/*
+  MariaDB extended capabilities, bits 32-63 of the capabilities.
+
+  The 32 bits above are shared with MySQL, which keeps assigning them, so
+  MariaDB specific capabilities go here. Bits 32-63 are sent in the last
+  4 bytes of the reserved filler of the server handshake packet and of
+  the client reply (4.1 protocol), which older servers and clients fill
+  with zeros and ignore.
+*/
+
+/*
+  With CLIENT_COMPRESS: can use LZ4 instead of zlib for the compressed
+  protocol. Used when both the client and the server set it.
+*/
+#define MARIADB_CLIENT_COMPRESS_LZ4 (1ULL << 63)
+
 /**
   Is raised when a multi-statement transaction
   has been started, either explicitly, by means
@@ -380,7 +396,8 @@ typedef struct st_net {
   char net_skip_rest_factor;
   my_bool thread_specific_malloc;
   my_bool compress;
-  my_bool unused3; /* Please remove with the next incompatible ABI change. */
+  /* MY_COMPRESS_ZLIB or MY_COMPRESS_LZ4, if compress is set */
+  unsigned char compress_algorithm;
   /*
     Pointer to query object in query cache, do not equal NULL (0) for
     queries in cache that have not stored its results yet
@@ -584,6 +601,8 @@ typedef struct st_udf_init
   /* Constants when using compression */
 #define NET_HEADER_SIZE 4		/* standard header size */
 #define COMP_HEADER_SIZE 3		/* compression header extra size */
+#define MY_COMPRESS_ZLIB 0		/* NET::compress_algorithm values */
+#define MY_COMPRESS_LZ4 1		/* both have MARIADB_CLIENT_COMPRESS_LZ4 */
 
   /* Prototypes to password functions */
 
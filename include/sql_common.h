@@ -44,6 +44,8 @@ struct st_mysql_options_extention {
   struct mysql_async_context *async_context;
   HASH connection_attributes;
   size_t connection_attributes_length;
+  /* MYSQL_OPT_COMPRESSION_ALGORITHM "zlib": don't offer LZ4 */
+  my_bool compress_zlib_only;
 };
 
 typedef struct st_mysql_methods
@@ -14,12 +14,45 @@
    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
 
 
-#include <my_global.h>
-#include <my_sys.h>
+#include "mysys_priv.h"
 #include <zlib.h>
 
 ulong my_crc_dbug_check= ~0;               /* Cannot happen */
 
+typedef uint32 (*my_crc32_func)(uint32 crc, const uchar *pos, size_t length);
+
+static uint32 my_crc32_zlib(uint32 crc, const uchar *pos, size_t length)
+{
+  return (uint32) crc32((uint) crc, pos, (uint) length);
+}
+
+/*
+  The CRC32 implementation used by my_checksum(). It starts out as the
+  portable zlib one and is switched to a hardware accelerated one by
+  my_checksum_init() if the CPU supports it; both compute the same value.
+*/
+static my_crc32_func my_crc32= my_crc32_zlib;
+
+
+/*
+  Select the fastest CRC32 implementation available on this CPU.
+
+  SYNOPSIS
+    my_checksum_init()
+
+  NOTES
+    Called from my_init(). my_checksum() works before this is called,
+    it just uses the portable implementation.
+*/
+
+void my_checksum_init(void)
+{
+#ifdef HAVE_CLMUL_INSTRUCTION
+  if (my_crc32_pclmul_available())
+    my_crc32= my_crc32_pclmul;
+#endif
+}
+
 /*
   Calculate a long checksum for a memoryblock.
 
@@ -32,7 +65,7 @@ ulong my_crc_dbug_check= ~0;               /* Cannot happen */
 
 ha_checksum my_checksum(ha_checksum crc, const uchar *pos, size_t length)
 {
-  crc= (ha_checksum) crc32((uint)crc, pos, (uint) length);
+  crc= (ha_checksum) my_crc32((uint32) crc, pos, length);
   DBUG_PRINT("info", ("crc: %lu", (ulong) crc));
   if ((ulong)crc == my_crc_dbug_check)
     my_debug_put_break_here();
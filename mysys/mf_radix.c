@@ -58,3 +58,124 @@ void radixsort_for_str_ptr(uchar **base, uint number_of_elements, size_t size_of
   next:;
   }
 }
+
+
+/*
+  Most significant digit first radixsort for pointers to fixed length
+  strings, compared as with memcmp().
+
+  Unlike radixsort_for_str_ptr() it only looks at the bytes needed to
+  tell the strings apart, so it is suitable for long keys, like the
+  normalized multi-column keys of filesort, where a comparison sort
+  spends most of its time in memcmp() on common prefixes.
+  Groups smaller than MSD_RADIX_MIN_GROUP are sorted by insertion sort
+  on the rest of the string.  Needs an extra buffer of
+  number_of_elements pointers.
+
+  Bytes common to a group are skipped one pass over the group at a time,
+  so very long strings with long common prefixes, like keys of TEXT
+  columns with a big max_sort_length, are sorted faster by memcmp() in
+  a comparison sort.  Strings longer than MSD_RADIX_MAX_LENGTH are left
+  to it.
+*/
+
+#define MSD_RADIX_MIN_GROUP 32
+#define MSD_RADIX_MAX_LENGTH 2048
+
+my_bool msd_radixsort_is_applicable(uint n_items, size_t size_of_element)
+{
+  return size_of_element > 0 && size_of_element <= MSD_RADIX_MAX_LENGTH &&
+         n_items >= 100;
+}
+
+
+static void msd_insertion_sort(uchar **base, uint number_of_elements,
+                               size_t offset, size_t length)
+{
+  uchar **end= base + number_of_elements, **ptr, **pos, *key;
+  for (ptr= base + 1 ; ptr < end ; ptr++)
+  {
+    key= *ptr;
+    for (pos= ptr ;
+         pos > base && memcmp(pos[-1] + offset, key + offset, length) > 0 ;
+         pos--)
+      *pos= pos[-1];
+    *pos= key;
+  }
+}
+
+
+/*
+  Sort the strings in base, which are all equal in the first 'offset'
+  bytes.  To keep the recursion depth below log2(number_of_elements),
+  all groups except the largest are sorted by recursion and the largest
+  one by the loop.
+*/
+
+static void msd_radixsort(uchar **base, uint number_of_elements,
+                          size_t offset, size_t size_of_element,
+                          uchar **buffer)
+{
+  uchar **end, **ptr;
+  uint32 count[256], sum, tmp, group_start, group_end;
+  uint i, largest;
+
+  for (;;)
+  {
+    if (number_of_elements < MSD_RADIX_MIN_GROUP)
+    {
+      if (offset < size_of_element)
+        msd_insertion_sort(base, number_of_elements, offset,
+                           size_of_element - offset);
+      return;
+    }
+    end= base + number_of_elements;
+
+    /* Skip bytes that are the same in all strings */
+    for (;; offset++)
+    {
+      if (offset == size_of_element)
+        return;                                 /* All strings are equal */
+      bzero((uchar*) count, sizeof(count));
+      for (ptr= base ; ptr < end ; ptr++)
+        count[ptr[0][offset]]++;
+      if (count[base[0][offset]] != number_of_elements)
+        break;
+    }
+
+    /* Turn the counts into group starts and distribute */
+    largest= 0;
+    for (i= 0, sum= 0 ; i < 256 ; i++)
+    {
+      if (count[i] > count[largest])
+        largest= i;
+      tmp= count[i];
+      count[i]= sum;
+      sum+= tmp;
+    }
+    for (ptr= base ; ptr < end ; ptr++)
+      buffer[count[ptr[0][offset]]++]= *ptr;
+    memcpy(base, buffer, number_of_elements * sizeof(uchar*));
+
+    /* count[i] is now the end of group i */
+    offset++;
+    for (i= 0, group_start= 0 ; i < 256 ; group_start= group_end, i++)
+    {
+      group_end= count[i];
+      if (i != largest && group_end - group_start > 1)
+        msd_radixsort(base + group_start, group_end - group_start, offset,
+                      size_of_element, buffer + group_start);
+    }
+    group_start= largest ? count[largest-1] : 0;
+    base+= group_start;
+    buffer+= group_start;
+    number_of_elements= count[largest] - group_start;
+  }
+}
+
+
+void msd_radixsort_for_str_ptr(uchar **base, uint number_of_elements,
+                               size_t size_of_element, uchar **buffer)
+{
+  msd_radixsort(base, number_of_elements, 0, size_of_element, buffer);
+}
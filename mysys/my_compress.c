@@ -22,6 +22,9 @@
 #include <m_string.h>
 #endif
 #include <zlib.h>
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif
 
 /*
    This replaces the packet with a compressed packet
@@ -203,4 +206,91 @@ my_bool my_uncompress(uchar *packet, size_t len, size_t *complen)
   DBUG_RETURN(0);
 }
 
+
+/*
+  LZ4 variants of my_compress() and my_uncompress(), used by the
+  compressed protocol when both the client and the server support it.
+  They take the same arguments and keep the same packet format: only
+  the algorithm used for the compressed data differs. LZ4 is much
+  faster than zlib but compresses less.
+
+  Without LZ4 support my_have_lz4_compress is FALSE and the functions
+  always fail.
+*/
+
+#ifdef HAVE_LZ4
+const my_bool my_have_lz4_compress= TRUE;
+#else
+const my_bool my_have_lz4_compress= FALSE;
+#endif
+
+my_bool my_lz4_compress(uchar *packet, size_t *len, size_t *complen)
+{
+  DBUG_ENTER("my_lz4_compress");
+#ifdef HAVE_LZ4
+  if (*len < MIN_COMPRESS_LENGTH)
+  {
+    *complen=0;
+    DBUG_PRINT("note",("Packet too short: Not compressed"));
+  }
+  else
+  {
+    uchar *compbuf;
+    int res;
+
+    if (!(compbuf= (uchar *) my_malloc(*len, MYF(MY_WME))))
+      DBUG_RETURN(1);				/* Not enough memory */
+    /* Give up as soon as the packet does not get shorter */
+    res= LZ4_compress_limitedOutput((const char*) packet, (char*) compbuf,
+                                    (int) *len, (int) *len - 1);
+    if (res <= 0)
+    {
+      *complen= 0;
+      DBUG_PRINT("note",("Packet got longer on compression; Not compressed"));
+    }
+    else
+    {
+      *complen= *len;
+      *len= (size_t) res;
+      memcpy(packet, compbuf, *len);
+    }
+    my_free(compbuf);
+  }
+  DBUG_RETURN(0);
+#else
+  DBUG_RETURN(1);
+#endif
+}
+
+
+my_bool my_lz4_uncompress(uchar *packet, size_t len, size_t *complen)
+{
+  DBUG_ENTER("my_lz4_uncompress");
+#ifdef HAVE_LZ4
+  if (*complen)					/* If compressed */
+  {
+    uchar *compbuf= (uchar *) my_malloc(*complen,MYF(MY_WME));
+    int res;
+    if (!compbuf)
+      DBUG_RETURN(1);				/* Not enough memory */
+
+    res= LZ4_decompress_safe((const char*) packet, (char*) compbuf,
+                             (int) len, (int) *complen);
+    if (res < 0 || (size_t) res != *complen)
+    {						/* Probably wrong packet */
+      DBUG_PRINT("error",("Can't uncompress packet, error: %d",res));
+      my_free(compbuf);
+      DBUG_RETURN(1);
+    }
+    memcpy(packet, compbuf, *complen);
+    my_free(compbuf);
+  }
+  else
+    *complen= len;
+  DBUG_RETURN(0);
+#else
+  DBUG_RETURN(1);
+#endif
+}
+
 #endif /* HAVE_COMPRESS */
@@ -0,0 +1,180 @@
+/* Copyright (c) 2015, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/*
+  CRC32 (the zlib polynomial 0x04C11DB7, bit reflected) using the
+  PCLMULQDQ carry-less multiplication instruction, based on
+
+  "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+   Instruction", V. Gopal, E. Ozturk et al., Intel, 2009.
+
+  The buffer is folded 64 bytes at a time into four 128 bit
+  accumulators, which are then folded into one, reduced to 64 bits and
+  finally Barrett reduced to the 32 bit CRC. The tail that is not a
+  multiple of 16 bytes is handled by the table driven zlib code.
+
+  The functions are compiled with a target attribute, so the rest of
+  mysys does not need to be built with -mpclmul; my_crc32_pclmul() must
+  only be called when my_crc32_pclmul_available() returns TRUE.
+*/
+
+#include "mysys_priv.h"
+#include <zlib.h>
+
+#ifdef HAVE_CLMUL_INSTRUCTION
+
+#include <cpuid.h>
+#include <smmintrin.h>
+#include <wmmintrin.h>
+
+#define CLMUL_MIN_LENGTH 64
+
+/* cpuid(1).ecx feature bits */
+#define CPUID_ECX_PCLMULQDQ (1U << 1)
+#define CPUID_ECX_SSE41     (1U << 19)
+
+/**
+  Check whether the CPU supports the instructions used by
+  my_crc32_pclmul().
+*/
+
+my_bool my_crc32_pclmul_available(void)
+{
+  unsigned int eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    return FALSE;
+  return (ecx & (CPUID_ECX_PCLMULQDQ | CPUID_ECX_SSE41)) ==
+         (CPUID_ECX_PCLMULQDQ | CPUID_ECX_SSE41);
+}
+
+
+/**
+  Fold a buffer whose length is a multiple of 16 and at least 64 bytes.
+
+  @param crc  the CRC register, i.e. the bit inverted CRC value
+  @return the CRC register after processing the buffer
+*/
+
+__attribute__((target("sse4.1,pclmul")))
+static uint32 crc32_fold(uint32 crc, const uchar *buf, size_t len)
+{
+  /* Constants for the bit reflected domain, see the end of the paper */
+  const __m128i k1k2= _mm_set_epi64x(0x01c6e41596ULL, 0x0154442bd4ULL);
+  const __m128i k3k4= _mm_set_epi64x(0x00ccaa009eULL, 0x01751997d0ULL);
+  const __m128i k5k0= _mm_set_epi64x(0, 0x0163cd6124ULL);
+  const __m128i poly= _mm_set_epi64x(0x01f7011641ULL, 0x01db710641ULL);
+  const __m128i mask32= _mm_setr_epi32(~0, 0, ~0, 0);
+  __m128i x1, x2, x3, x4, x5, x6, x7, x8;
+
+  x1= _mm_loadu_si128((const __m128i*) (buf + 0x00));
+  x2= _mm_loadu_si128((const __m128i*) (buf + 0x10));
+  x3= _mm_loadu_si128((const __m128i*) (buf + 0x20));
+  x4= _mm_loadu_si128((const __m128i*) (buf + 0x30));
+  x1= _mm_xor_si128(x1, _mm_cvtsi32_si128((int) crc));
+  buf+= 64;
+  len-= 64;
+
+  /* Fold 64 bytes at a time into the four accumulators */
+  while (len >= 64)
+  {
+    x5= _mm_clmulepi64_si128(x1, k1k2, 0x00);
+    x6= _mm_clmulepi64_si128(x2, k1k2, 0x00);
+    x7= _mm_clmulepi64_si128(x3, k1k2, 0x00);
+    x8= _mm_clmulepi64_si128(x4, k1k2, 0x00);
+
+    x1= _mm_clmulepi64_si128(x1, k1k2, 0x11);
+    x2= _mm_clmulepi64_si128(x2, k1k2, 0x11);
+    x3= _mm_clmulepi64_si128(x3, k1k2, 0x11);
+    x4= _mm_clmulepi64_si128(x4, k1k2, 0x11);
+
+    x1= _mm_xor_si128(_mm_xor_si128(x1, x5),
+                      _mm_loadu_si128((const __m128i*) (buf + 0x00)));
+    x2= _mm_xor_si128(_mm_xor_si128(x2, x6),
+                      _mm_loadu_si128((const __m128i*) (buf + 0x10)));
+    x3= _mm_xor_si128(_mm_xor_si128(x3, x7),
+                      _mm_loadu_si128((const __m128i*) (buf + 0x20)));
+    x4= _mm_xor_si128(_mm_xor_si128(x4, x8),
+                      _mm_loadu_si128((const __m128i*) (buf + 0x30)));
+    buf+= 64;
+    len-= 64;
+  }
+
+  /* Fold the accumulators into one */
+  x5= _mm_clmulepi64_si128(x1, k3k4, 0x00);
+  x1= _mm_clmulepi64_si128(x1, k3k4, 0x11);
+  x1= _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+  x5= _mm_clmulepi64_si128(x1, k3k4, 0x00);
+  x1= _mm_clmulepi64_si128(x1, k3k4, 0x11);
+  x1= _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+  x5= _mm_clmulepi64_si128(x1, k3k4, 0x00);
+  x1= _mm_clmulepi64_si128(x1, k3k4, 0x11);
+  x1= _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+  /* Fold the remaining 16 byte blocks */
+  while (len >= 16)
+  {
+    x5= _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1= _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1= _mm_xor_si128(_mm_xor_si128(x1, x5),
+                      _mm_loadu_si128((const __m128i*) buf));
+    buf+= 16;
+    len-= 16;
+  }
+
+  /* Reduce 128 bits to 64 bits */
+  x2= _mm_clmulepi64_si128(x1, k3k4, 0x10);
+  x1= _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+  x2= _mm_srli_si128(x1, 4);
+  x1= _mm_and_si128(x1, mask32);
+  x1= _mm_clmulepi64_si128(x1, k5k0, 0x00);
+  x1= _mm_xor_si128(x1, x2);
+
+  /* Barrett reduction to 32 bits */
+  x2= _mm_and_si128(x1, mask32);
+  x2= _mm_clmulepi64_si128(x2, poly, 0x10);
+  x2= _mm_and_si128(x2, mask32);
+  x2= _mm_clmulepi64_si128(x2, poly, 0x00);
+  x1= _mm_xor_si128(x1, x2);
+
+  return (uint32) _mm_extract_epi32(x1, 1);
+}
+
+
+/**
+  Calculate CRC32 with the same result as zlib's crc32().
+
+  @param crc  start value, as returned by a previous call or 0
+  @param pos  data
+  @param len  length of the data
+*/
+
+uint32 my_crc32_pclmul(uint32 crc, const uchar *pos, size_t len)
+{
+  if (len >= CLMUL_MIN_LENGTH)
+  {
+    size_t chunk= len & ~(size_t) 15;
+    crc= ~crc32_fold(~crc, pos, chunk);
+    pos+= chunk;
+    len-= chunk;
+  }
+  if (len)
+    crc= (uint32) crc32((uint) crc, pos, (uint) len);
+  return crc;
+}
+
+#endif /* HAVE_CLMUL_INSTRUCTION */
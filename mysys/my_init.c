@@ -114,6 +114,7 @@ my_bool my_init(void)
     DBUG_PROCESS((char*) (my_progname ? my_progname : "unknown"));
     my_time_init();
     my_win_init();
+    my_checksum_init();
     DBUG_PRINT("exit", ("home: '%s'", home_dir));
 #ifdef __WIN__
     win32_init_tcp_ip();
@@ -92,6 +92,12 @@ size_t sf_malloc_usable_size(void *ptr, my_bool *is_thread_specific);
 
 void my_error_unregister_all(void);
 
+#ifdef HAVE_CLMUL_INSTRUCTION
+/* my_crc32_pclmul.c exports, used by my_checksum() */
+my_bool my_crc32_pclmul_available(void);
+uint32 my_crc32_pclmul(uint32 crc, const uchar *pos, size_t len);
+#endif
+
 #ifdef _WIN32
 #include <sys/stat.h>
 /* my_winfile.c exports, should not be used outside mysys */
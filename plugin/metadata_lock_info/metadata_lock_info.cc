@@ -116,6 +116,49 @@ int i_s_metadata_lock_info_fill_row(
   DBUG_RETURN(0);
 }
 
+/*
+  Locks granted using the fast path are only counted per lock type, their
+  owners are not known. They are shown with THREAD_ID 0 and no
+  LOCK_DURATION, one row per lock. MDL_SHARED_HIGH_PRIO locks are shown
+  as MDL_SHARED.
+*/
+int i_s_metadata_lock_info_fill_fast_path_row(
+  const MDL_key *mdl_key,
+  enum_mdl_type mdl_type,
+  uint count,
+  void *arg
+) {
+  st_i_s_metadata_param *param = (st_i_s_metadata_param *) arg;
+  THD *thd = param->thd;
+  TABLE *table = param->table;
+  MDL_key::enum_mdl_namespace mdl_namespace = mdl_key->mdl_namespace();
+  DBUG_ENTER("i_s_metadata_lock_info_fill_fast_path_row");
+  while (count--)
+  {
+    table->field[0]->store((longlong) 0, TRUE);
+    table->field[1]->set_notnull();
+    table->field[1]->store(
+      metadata_lock_info_lock_mode[(int) mdl_type].str,
+      metadata_lock_info_lock_mode[(int) mdl_type].length,
+      system_charset_info);
+    table->field[2]->set_null();
+    table->field[3]->set_notnull();
+    table->field[3]->store(
+      metadata_lock_info_lock_name[(int) mdl_namespace].str,
+      metadata_lock_info_lock_name[(int) mdl_namespace].length,
+      system_charset_info);
+    table->field[4]->set_notnull();
+    table->field[4]->store(mdl_key->db_name(),
+      mdl_key->db_name_length(), system_charset_info);
+    table->field[5]->set_notnull();
+    table->field[5]->store(mdl_key->name(),
+      mdl_key->name_length(), system_charset_info);
+    if (schema_table_store_record(thd, table))
+      DBUG_RETURN(1);
+  }
+  DBUG_RETURN(0);
+}
+
 int i_s_metadata_lock_info_fill_table(
   THD *thd,
   TABLE_LIST *tables,
@@ -125,7 +168,13 @@ int i_s_metadata_lock_info_fill_table(
   DBUG_ENTER("i_s_metadata_lock_info_fill_table");
   param.table = tables->table;
   param.thd = thd;
-  DBUG_RETURN(mdl_iterate(i_s_metadata_lock_info_fill_row, &param));
+  /*
+    Our own locks granted using the fast path are moved to the lists
+    seen by mdl_iterate(), so they are shown with their owner.
+  */
+  thd->mdl_context.materialize_fast_path_locks();
+  DBUG_RETURN(mdl_iterate(i_s_metadata_lock_info_fill_row, &param,
+                          i_s_metadata_lock_info_fill_fast_path_row));
 }
 
 static int i_s_metadata_lock_info_init(
@@ -48,7 +48,9 @@ class Accessible_Query_Cache : public Query_cache {
   {
     return &this->queries;
   }
-} *qc;
+};
+
+static Query_cache_instances *qc;
 
 bool schema_table_store_record(THD *thd, TABLE *table);
 
@@ -70,18 +72,13 @@ static ST_FIELD_INFO qc_info_fields[]=
   {0, 0, MYSQL_TYPE_STRING, 0, 0, 0, 0}
 };
 
-static int qc_info_fill_table(THD *thd, TABLE_LIST *tables,
-                                              COND *cond)
+static int qc_info_fill_instance(THD *thd, TABLE *table,
+                                 Accessible_Query_Cache *qc)
 {
   int status= 1;
   CHARSET_INFO *scs= system_charset_info;
-  TABLE *table= tables->table;
   HASH *queries = qc->get_queries();
 
-  /* one must have PROCESS privilege to see others' queries */
-  if (check_global_access(thd, PROCESS_ACL, true))
-    return 0;
-
   if (qc->try_lock(thd))
     return 0; // QC is or is being disabled
 
@@ -168,6 +165,22 @@ static int qc_info_fill_table(THD *thd, TABLE_LIST *tables,
   return status;
 }
 
+static int qc_info_fill_table(THD *thd, TABLE_LIST *tables,
+                                              COND *cond)
+{
+  /* one must have PROCESS privilege to see others' queries */
+  if (check_global_access(thd, PROCESS_ACL, true))
+    return 0;
+
+  for (uint i= 0; i < qc->instance_count(); i++)
+  {
+    if (qc_info_fill_instance(thd, tables->table,
+                              (Accessible_Query_Cache *) qc->instance(i)))
+      return 1;
+  }
+  return 0;
+}
+
 static int qc_info_plugin_init(void *p)
 {
   ST_SCHEMA_TABLE *schema= (ST_SCHEMA_TABLE *)p;
@@ -176,10 +189,11 @@ static int qc_info_plugin_init(void *p)
   schema->fill_table= qc_info_fill_table;
 
 #ifdef _WIN32
-  qc = (Accessible_Query_Cache *)
-    GetProcAddress(GetModuleHandle(NULL), "?query_cache@@3VQuery_cache@@A");
+  qc = (Query_cache_instances *)
+    GetProcAddress(GetModuleHandle(NULL),
+                   "?query_cache@@3VQuery_cache_instances@@A");
 #else
-  qc = (Accessible_Query_Cache *)&query_cache;
+  qc = &query_cache;
 #endif
 
   return qc == 0;
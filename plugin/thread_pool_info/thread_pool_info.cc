@@ -0,0 +1,119 @@
+/* Copyright (C) 2014 MariaDB Corporation Ab
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA */
+
+/*
+  INFORMATION_SCHEMA.THREAD_POOL_QUEUES: one row per thread group and
+  priority, showing the work queues of the unix thread pool.
+*/
+
+#ifndef MYSQL_SERVER
+#define MYSQL_SERVER
+#endif
+
+#include <sql_parse.h>          // check_global_access
+#include <sql_acl.h>            // PROCESS_ACL
+#include <sql_class.h>          // THD
+#include <sql_show.h>           // schema_table_store_record
+#include <table.h>              // ST_SCHEMA_TABLE
+#include <threadpool.h>
+#include <mysql/plugin.h>
+
+static const LEX_STRING priority_names[]=
+{
+  { C_STRING_WITH_LEN("HIGH") },
+  { C_STRING_WITH_LEN("LOW") }
+};
+
+static ST_FIELD_INFO thread_pool_queues_fields[]=
+{
+  {"GROUP_ID", 6, MYSQL_TYPE_LONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {"PRIORITY", 4, MYSQL_TYPE_STRING, 0, 0, 0, 0},
+  {"QUEUE_LENGTH", 6, MYSQL_TYPE_LONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {"OLDEST_WAIT_MICROSECONDS", 20, MYSQL_TYPE_LONGLONG, 0,
+   MY_I_S_UNSIGNED, 0, 0},
+  {"DEQUEUED", 20, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {"TOTAL_WAIT_MICROSECONDS", 20, MYSQL_TYPE_LONGLONG, 0,
+   MY_I_S_UNSIGNED, 0, 0},
+  {"KICKUPS", 20, MYSQL_TYPE_LONGLONG, 0, MY_I_S_UNSIGNED, 0, 0},
+  {0, 0, MYSQL_TYPE_STRING, 0, 0, 0, 0}
+};
+
+static int thread_pool_queues_fill_table(THD *thd, TABLE_LIST *tables,
+                                         COND *cond)
+{
+  TABLE *table= tables->table;
+
+  /* one must have PROCESS privilege to see thread pool internals */
+  if (check_global_access(thd, PROCESS_ACL, true))
+    return 0;
+
+  uint groups= tp_get_group_count();
+  for (uint i= 0; i < groups; i++)
+  {
+    for (int prio= TP_PRIORITY_HIGH; prio <= TP_PRIORITY_LOW; prio++)
+    {
+      TP_QUEUE_STATISTICS stats;
+      tp_get_queue_statistics(i, (TP_PRIORITY) prio, &stats);
+
+      table->field[0]->store(i, true);
+      table->field[1]->store(priority_names[prio].str,
+                             priority_names[prio].length,
+                             system_charset_info);
+      table->field[2]->store(stats.length, true);
+      table->field[3]->store(stats.oldest_wait, true);
+      table->field[4]->store(stats.dequeued, true);
+      table->field[5]->store(stats.total_wait, true);
+      table->field[6]->store(stats.kickups, true);
+      if (schema_table_store_record(thd, table))
+        return 1;
+    }
+  }
+  return 0;
+}
+
+static int thread_pool_info_plugin_init(void *p)
+{
+  ST_SCHEMA_TABLE *schema= (ST_SCHEMA_TABLE *)p;
+
+  schema->fields_info= thread_pool_queues_fields;
+  schema->fill_table= thread_pool_queues_fill_table;
+  return 0;
+}
+
+
+static struct st_mysql_information_schema thread_pool_info_plugin=
+{ MYSQL_INFORMATION_SCHEMA_INTERFACE_VERSION };
+
+/*
+  Plugin library descriptor
+*/
+
+maria_declare_plugin(thread_pool_info)
+{
+  MYSQL_INFORMATION_SCHEMA_PLUGIN,
+  &thread_pool_info_plugin,
+  "THREAD_POOL_QUEUES",
+  "MariaDB Corporation",
+  "Work queues of the thread pool.",
+  PLUGIN_LICENSE_GPL,
+  thread_pool_info_plugin_init, /* Plugin Init */
+  0,                          /* Plugin Deinit        */
+  0x0100,                     /* version, hex         */
+  NULL,                       /* status variables     */
+  NULL,                       /* system variables     */
+  "1.0",                      /* version as a string  */
+  MariaDB_PLUGIN_MATURITY_EXPERIMENTAL
+}
+maria_declare_plugin_end;
@@ -2605,7 +2605,8 @@ static int send_change_user_packet(MCPVIO_EXT *mpvio,
     4           client capabilities
     4           max packet size
     1           charset number
-    23          reserved (always 0)
+    19          reserved (always 0)
+    4           MariaDB extended capabilities (bits 32-63)
     n           user name, \0-terminated
     n           plugin auth data (e.g. scramble), length encoded
     n           database name, \0-terminated
@@ -2623,6 +2624,7 @@ static int send_client_reply_packet(MCPVIO_EXT *mpvio,
   NET *net= &mysql->net;
   char *buff, *end;
   size_t buff_size;
+  ulonglong ext_capabilities= 0;
   size_t connect_attrs_len=
     (mysql->server_capabilities & CLIENT_CONNECT_ATTRS &&
      mysql->options.extension) ?
@@ -2666,13 +2668,30 @@ static int send_client_reply_packet(MCPVIO_EXT *mpvio,
   mysql->client_flag&= ~CLIENT_COMPRESS;
 #endif
 
+  /*
+    compress_algorithm is MY_COMPRESS_LZ4 here if the server offered
+    MARIADB_CLIENT_COMPRESS_LZ4 in its handshake packet.
+  */
+#ifdef HAVE_COMPRESS
+  if ((mysql->client_flag & CLIENT_COMPRESS) &&
+      (mysql->client_flag & CLIENT_PROTOCOL_41) &&
+      net->compress_algorithm == MY_COMPRESS_LZ4 && my_have_lz4_compress &&
+      !(mysql->options.extension &&
+        mysql->options.extension->compress_zlib_only))
+    ext_capabilities|= MARIADB_CLIENT_COMPRESS_LZ4;
+  else
+#endif
+    net->compress_algorithm= MY_COMPRESS_ZLIB;
+
   if (mysql->client_flag & CLIENT_PROTOCOL_41)
   {
     /* 4.1 server and 4.1 client has a 32 byte option flag */
     int4store(buff,mysql->client_flag);
     int4store(buff+4, net->max_packet_size);
     buff[8]= (char) mysql->charset->number;
-    bzero(buff+9, 32-9);
+    bzero(buff+9, 28-9);
+    /* MariaDB extended capabilities */
+    int4store(buff+28, ext_capabilities >> 32);
     end= buff+32;
   }
   else
@@ -3612,6 +3631,9 @@ CLI_MYSQL_REAL_CONNECT(MYSQL *mysql,const char *host, const char *user,
     mysql->server_language=end[2];
     mysql->server_status=uint2korr(end+3);
     mysql->server_capabilities|= uint2korr(end+5) << 16;
+    /* MariaDB extended capabilities are in the last 4 of 10 reserved bytes */
+    if ((((ulonglong) uint4korr(end+14)) << 32) & MARIADB_CLIENT_COMPRESS_LZ4)
+      net->compress_algorithm= MY_COMPRESS_LZ4;   /* Offered by the server */
     pkt_scramble_len= end[7];
     if (pkt_scramble_len < 0)
     {
@@ -4394,6 +4416,13 @@ mysql_options(MYSQL *mysql,enum mysql_option option, const void *arg)
     mysql->options.compress= 1;			/* Remember for connect */
     mysql->options.client_flag|= CLIENT_COMPRESS;
     break;
+  case MYSQL_OPT_COMPRESSION_ALGORITHM:
+    /* Use LZ4 if possible (the default), or always zlib */
+    if (!arg || (strcmp(arg, "lz4") && strcmp(arg, "zlib")))
+      DBUG_RETURN(1);
+    ENSURE_EXTENSIONS_PRESENT(&mysql->options);
+    mysql->options.extension->compress_zlib_only= !strcmp(arg, "zlib");
+    break;
   case MYSQL_OPT_NAMED_PIPE:			/* This option is depricated */
     mysql->options.protocol=MYSQL_PROTOCOL_PIPE; /* Force named pipe */
     break;
@@ -819,6 +819,15 @@ class Field
     ptr= old_ptr;
     return return_value;
   }
+  inline double val_real(const uchar *new_ptr)
+  {
+    uchar *old_ptr= ptr;
+    double return_value;
+    ptr= (uchar*) new_ptr;
+    return_value= val_real();
+    ptr= old_ptr;
+    return return_value;
+  }
   inline String *val_str(String *str, const uchar *new_ptr)
   {
     uchar *old_ptr= ptr;
@@ -30,6 +30,7 @@
 #include <stddef.h>			/* for macro offsetof */
 #endif
 #include <m_ctype.h>
+#include <mysys_err.h>
 #include "sql_sort.h"
 #include "probes_mysql.h"
 #include "sql_base.h"                           // update_virtual_fields
@@ -195,6 +196,7 @@ ha_rows filesort(THD *thd, TABLE *table, SORT_FIELD *sortorder, uint s_length,
                           table,
                           thd->variables.max_length_for_sort_data,
                           max_rows, sort_positions);
+  param.max_threads= thd->variables.max_sort_threads;
 
   table_sort.addon_buf= 0;
   table_sort.addon_length= param.addon_length;
@@ -872,6 +874,190 @@ static ha_rows find_all_keys(Sort_param *param, SQL_SELECT *select,
 } /* find_all_keys */
 
 
+/*
+  Parallel sorting and merging.
+
+  When max_sort_threads > 1, a full sort buffer is sorted as several
+  chunks, and each pass of merge_many_buff() merges its groups of
+  BUFFPEKs in parallel.  The work is split into independent tasks that
+  are run by a few worker threads together with the thread executing
+  the query.  The tasks only write to disjoint parts of the sort buffer
+  and of the temporary files, so the files and BUFFPEKs look the same as
+  after a serial sort, and the final merge_index() is unchanged.
+*/
+
+/** Minimal number of keys sorted by one task in write_keys(). */
+#define MIN_SORT_TASK_KEYS 1024
+
+class Sort_tasks;
+
+struct Sort_worker
+{
+  Sort_tasks *tasks;
+  uint id;
+  pthread_t thread;
+};
+
+pthread_handler_t sort_worker_thread(void *arg);
+
+/**
+  A set of independent tasks, run by up to max_sort_threads threads.
+  Every thread has an id, 0 being the thread executing the query, that
+  tells which private resources it should use.
+*/
+
+class Sort_tasks
+{
+public:
+  Sort_tasks(uint tasks_arg) :
+    tasks(tasks_arg), next_task(0), failed(false), error_taken(0),
+    error_code(0)
+  {}
+  virtual ~Sort_tasks() {}
+
+  /**
+    Run all tasks.
+
+    @param threads  Number of threads to use, including the current one.
+                    If a thread cannot be created, fewer threads are used.
+
+    @retval false  OK
+    @retval true   A task failed
+  */
+  bool run(uint threads)
+  {
+    Sort_worker workers[MAX_SORT_THREADS];
+    uint started;
+    DBUG_ASSERT(threads <= MAX_SORT_THREADS);
+    set_if_smaller(threads, tasks);
+    for (started= 1; started < threads; started++)
+    {
+      workers[started].tasks= this;
+      workers[started].id= started;
+      if (mysql_thread_create(0, /* Not instrumented */
+                              &workers[started].thread, NULL,
+                              sort_worker_thread, &workers[started]))
+        break;
+    }
+    work(0);
+    for (uint i= 1; i < started; i++)
+      pthread_join(workers[i].thread, NULL);
+    /*
+      Errors of worker threads only went to the error log. Report the
+      first one for the statement, unless the statement thread has
+      reported its own error or the query was killed.
+    */
+    if (failed && error_code)
+    {
+      THD *thd= current_thd;
+      if (!thd->is_error() && !thd->killed)
+        my_error(error_code, MYF(0), error_file, error_errno);
+    }
+    return failed;
+  }
+
+  void work(uint worker)
+  {
+    int32 task;
+    while (!failed &&
+           (task= my_atomic_add32(&next_task, 1)) < (int32) tasks)
+    {
+      if (run_task((uint) task, worker))
+        failed= true;
+    }
+  }
+
+protected:
+  virtual bool run_task(uint task, uint worker)= 0;
+
+  /**
+    Save the error of a task that failed in a worker thread, to be
+    reported by run(). Only the first error is kept.
+
+    @param code      Error code for my_error()
+    @param file      File name argument of the error, if any
+    @param errno_arg errno argument of the error, if any
+  */
+  void set_worker_error(uint code, const char *file, int errno_arg)
+  {
+    int32 not_taken= 0;
+    if (!my_atomic_cas32(&error_taken, &not_taken, 1))
+      return;
+    error_code= code;
+    strmake_buf(error_file, file ? file : "");
+    error_errno= errno_arg;
+  }
+
+private:
+  uint tasks;
+  volatile int32 next_task;
+  volatile bool failed;
+  /* Error of a worker thread, read by run() after the threads are joined */
+  volatile int32 error_taken;
+  uint error_code;
+  char error_file[FN_REFLEN];
+  int error_errno;
+};
+
+
+pthread_handler_t sort_worker_thread(void *arg)
+{
+  Sort_worker *worker= (Sort_worker*) arg;
+  my_thread_init();
+  worker->tasks->work(worker->id);
+  my_thread_end();
+  return 0;
+}
+
+
+/** Sorting of the chunks of the sort buffer in write_keys(). */
+
+class Sort_chunk_tasks : public Sort_tasks
+{
+public:
+  Sort_chunk_tasks(uchar **keys_arg, uint count, uint chunks,
+                   size_t sort_length_arg, uchar **buffer_arg) :
+    Sort_tasks(chunks), keys(keys_arg), chunk_keys(count / chunks),
+    last_chunk_keys(count - chunk_keys * (chunks - 1)),
+    last_chunk(chunks - 1), sort_length(sort_length_arg), buffer(buffer_arg)
+  {}
+  uint keys_in_chunk(uint chunk) const
+  {
+    return chunk == last_chunk ? last_chunk_keys : chunk_keys;
+  }
+  uchar **chunk_start(uint chunk) const
+  {
+    return keys + (size_t) chunk * chunk_keys;
+  }
+
+protected:
+  bool run_task(uint chunk, uint worker)
+  {
+    sort_key_pointers(chunk_start(chunk), keys_in_chunk(chunk), sort_length,
+                      buffer ? buffer + (size_t) chunk * chunk_keys : NULL);
+    return false;
+  }
+
+private:
+  uchar **keys;
+  uint chunk_keys, last_chunk_keys, last_chunk;
+  size_t sort_length;
+  uchar **buffer;
+};
+
+
+/**
+  Number of chunks to sort a sort buffer of count keys in, or 1 if
+  it should be sorted by the current thread.
+*/
+
+static uint sort_chunks(Sort_param *param, uint count)
+{
+  uint chunks= MY_MIN(param->max_threads, count / MIN_SORT_TASK_KEYS);
+  return MY_MAX(chunks, 1);
+}
+
+
 /**
   @details
   Sort the buffer and write:
@@ -901,29 +1087,52 @@ write_keys(Sort_param *param,  Filesort_info *fs_info, uint count,
   size_t rec_length;
   uchar **end;
   BUFFPEK buffpek;
+  uint chunks= sort_chunks(param, count);
   DBUG_ENTER("write_keys");
 
   rec_length= param->rec_length;
   uchar **sort_keys= fs_info->get_sort_keys();
-
-  fs_info->sort_buffer(param, count);
+  uchar **radix_buffer= NULL;
+  if (chunks > 1 &&
+      sort_key_pointers_needs_buffer(count / chunks, param->sort_length))
+    radix_buffer= (uchar**) my_malloc(count * sizeof(char*),
+                                      MYF(MY_THREAD_SPECIFIC));
+  Sort_chunk_tasks chunk_tasks(sort_keys, count, chunks, param->sort_length,
+                               radix_buffer);
+
+  if (chunks == 1)
+    fs_info->sort_buffer(param, count);
+  else
+  {
+    /*
+      Sort the chunks in parallel and write each of them as a separate
+      sequence; they are combined by the merge.
+    */
+    (void) chunk_tasks.run(chunks);
+    my_free(radix_buffer);
+  }
 
   if (!my_b_inited(tempfile) &&
       open_cached_file(tempfile, mysql_tmpdir, TEMP_PREFIX, DISK_BUFFER_SIZE,
                        MYF(MY_WME)))
     goto err;                                   /* purecov: inspected */
-  /* check we won't have more buffpeks than we can possibly keep in memory */
-  if (my_b_tell(buffpek_pointers) + sizeof(BUFFPEK) > (ulonglong)UINT_MAX)
-    goto err;
-  buffpek.file_pos= my_b_tell(tempfile);
-  if ((ha_rows) count > param->max_rows)
-    count=(uint) param->max_rows;               /* purecov: inspected */
-  buffpek.count=(ha_rows) count;
-  for (end=sort_keys+count ; sort_keys != end ; sort_keys++)
-    if (my_b_write(tempfile, (uchar*) *sort_keys, (uint) rec_length))
+  for (uint chunk= 0; chunk < chunks; chunk++)
+  {
+    /* check we won't have more buffpeks than we can possibly keep in memory */
+    if (my_b_tell(buffpek_pointers) + sizeof(BUFFPEK) > (ulonglong)UINT_MAX)
       goto err;
-  if (my_b_write(buffpek_pointers, (uchar*) &buffpek, sizeof(buffpek)))
-    goto err;
+    sort_keys= chunk_tasks.chunk_start(chunk);
+    count= chunk_tasks.keys_in_chunk(chunk);
+    buffpek.file_pos= my_b_tell(tempfile);
+    if ((ha_rows) count > param->max_rows)
+      count=(uint) param->max_rows;             /* purecov: inspected */
+    buffpek.count=(ha_rows) count;
+    for (end=sort_keys+count ; sort_keys != end ; sort_keys++)
+      if (my_b_write(tempfile, (uchar*) *sort_keys, (uint) rec_length))
+        goto err;
+    if (my_b_write(buffpek_pointers, (uchar*) &buffpek, sizeof(buffpek)))
+      goto err;
+  }
   DBUG_RETURN(0);
 
 err:
@@ -1408,6 +1617,229 @@ bool check_if_pq_applicable(Sort_param *param,
 }
 
 
+/**
+  Write function of the IO_CACHEs used by parallel merge passes.
+
+  Several threads write to the same temporary file, each at its own
+  offset, so the data is written with pwrite() at pos_in_file rather
+  than at the shared file position.
+*/
+
+static int sort_flush_positional(IO_CACHE *info)
+{
+  size_t length= (size_t) (info->write_pos - info->write_buffer);
+  if (length)
+  {
+    DBUG_EXECUTE_IF("sort_flush_positional_fail",
+                    {
+                      my_errno= ENOSPC;
+                      my_error(EE_WRITE, MYF(ME_BELL+ME_WAITTANG),
+                               my_filename(info->file), my_errno);
+                      return info->error= -1;
+                    });
+    if (mysql_file_pwrite(info->file, info->write_buffer, length,
+                          info->pos_in_file, MYF(MY_WME | MY_NABP)))
+      return info->error= -1;
+    info->pos_in_file+= length;
+    info->write_pos= info->write_buffer;
+  }
+  return 0;
+}
+
+static int sort_write_positional(IO_CACHE *info, const uchar *buffer,
+                                 size_t count)
+{
+  if (sort_flush_positional(info))
+    return 1;
+  if (count >= info->buffer_length)
+  {
+    if (mysql_file_pwrite(info->file, buffer, count, info->pos_in_file,
+                          MYF(MY_WME | MY_NABP)))
+      return info->error= -1;
+    info->pos_in_file+= count;
+    return 0;
+  }
+  memcpy(info->write_pos, buffer, count);
+  info->write_pos+= count;
+  return 0;
+}
+
+
+/**
+  The merges of one pass of merge_many_buff().
+
+  Every thread has its own part of the sort buffer, a copy of the
+  Sort_param limited to that part and an IO_CACHE writing to to_file.
+  The output position of every group is known in advance, as a merge
+  writes MY_MIN(rows in the group, max_rows) records.
+*/
+
+class Sort_merge_tasks : public Sort_tasks
+{
+public:
+  Sort_merge_tasks(uint groups, Sort_param *params_arg, uchar **buffers_arg,
+                   IO_CACHE *caches_arg, IO_CACHE *from_file_arg,
+                   BUFFPEK *buffpek_arg, uint maxbuffer_arg,
+                   my_off_t *offsets_arg, BUFFPEK *result_arg) :
+    Sort_tasks(groups), params(params_arg), buffers(buffers_arg),
+    caches(caches_arg), from_file(from_file_arg), buffpek(buffpek_arg),
+    maxbuffer(maxbuffer_arg), last_group(groups - 1), offsets(offsets_arg),
+    result(result_arg)
+  {}
+
+protected:
+  bool run_task(uint group, uint worker)
+  {
+    IO_CACHE *to_file= caches + worker;
+    BUFFPEK *first= buffpek + group * MERGEBUFF;
+    BUFFPEK *last= (group == last_group ? buffpek + maxbuffer :
+                    first + MERGEBUFF - 1);
+    to_file->pos_in_file= offsets[group];
+    if (!merge_buffers(params + worker, from_file, to_file,
+                       buffers[worker], result + group, first, last, 0) &&
+        !sort_flush_positional(to_file))
+      return false;
+    /* Worker threads have no THD, the statement thread reports for them */
+    if (worker && !params[worker].merge_thd->killed)
+    {
+      if (to_file->error)
+        set_worker_error(EE_WRITE, my_filename(to_file->file), my_errno);
+      else if (my_errno == ENOMEM)
+        set_worker_error(ER_OUT_OF_RESOURCES, NULL, 0);
+      else
+        set_worker_error(EE_READ, my_filename(from_file->file), my_errno);
+    }
+    return true;
+  }
+
+private:
+  Sort_param *params;
+  uchar **buffers;
+  IO_CACHE *caches;
+  IO_CACHE *from_file;
+  BUFFPEK *buffpek;
+  uint maxbuffer, last_group;
+  my_off_t *offsets;
+  BUFFPEK *result;
+};
+
+
+/**
+  Do one pass of merge_many_buff() with several threads.
+
+  The groups merged and the BUFFPEKs and data produced are the same as
+  in the serial pass.
+
+  @retval 0      OK, *lastbuff is set past the last BUFFPEK written
+  @retval other  Error
+*/
+
+static int merge_pass_parallel(Sort_param *param, uchar *sort_buffer,
+                               BUFFPEK *buffpek, uint maxbuffer,
+                               IO_CACHE *from_file, IO_CACHE *to_file,
+                               uint threads, BUFFPEK **lastbuff)
+{
+  THD *thd= current_thd;
+  Sort_param *params;
+  uchar **buffers;
+  IO_CACHE *caches;
+  my_off_t *offsets;
+  BUFFPEK *result;
+  uint groups, group, i, started= 0;
+  my_off_t offset= 0;
+  int error= 1;
+  DBUG_ENTER("merge_pass_parallel");
+
+  /* Same grouping as in merge_many_buff() */
+  for (i= 0, groups= 1 ; i <= maxbuffer - MERGEBUFF*3/2 ; i+= MERGEBUFF)
+    groups++;
+  set_if_smaller(threads, groups);
+
+  if (!my_multi_malloc(MYF(MY_WME | MY_THREAD_SPECIFIC),
+                       &params, sizeof(Sort_param) * threads,
+                       &buffers, sizeof(uchar*) * threads,
+                       &caches, sizeof(IO_CACHE) * threads,
+                       &offsets, sizeof(my_off_t) * groups,
+                       &result, sizeof(BUFFPEK) * groups,
+                       NullS))
+    DBUG_RETURN(1);
+
+  for (group= 0; group < groups; group++)
+  {
+    BUFFPEK *first= buffpek + group * MERGEBUFF;
+    BUFFPEK *last= (group == groups - 1 ? buffpek + maxbuffer :
+                    first + MERGEBUFF - 1);
+    ha_rows rows= 0;
+    for (BUFFPEK *b= first; b <= last; b++)
+      rows+= b->count;
+    offsets[group]= offset;
+    offset+= MY_MIN(rows, param->max_rows) * param->rec_length;
+  }
+
+  /* The other threads write to the file directly, so it must exist */
+  if (to_file->file < 0 && real_open_cached_file(to_file))
+    goto err;
+
+  for (started= 0; started < threads; started++)
+  {
+    params[started]= *param;
+    params[started].max_keys_per_buffer= param->max_keys_per_buffer / threads;
+    params[started].merge_thd= thd;
+    buffers[started]= (sort_buffer + (size_t) started *
+                       params[started].max_keys_per_buffer * param->rec_length);
+    if (init_io_cache(caches + started, to_file->file, DISK_BUFFER_SIZE,
+                      WRITE_CACHE, 0L, 0, MYF(MY_WME)))
+      goto err;
+    caches[started].write_function= sort_write_positional;
+    caches[started].write_end= (caches[started].write_buffer +
+                                caches[started].buffer_length);
+  }
+
+  {
+    Sort_merge_tasks tasks(groups, params, buffers, caches, from_file,
+                           buffpek, maxbuffer, offsets, result);
+    if (tasks.run(threads))
+      goto err;
+  }
+
+  for (group= 0; group < groups; group++)
+  {
+    thd->inc_status_sort_merge_passes();
+    thd->query_plan_fsort_passes++;
+  }
+  memcpy(buffpek, result, sizeof(BUFFPEK) * groups);
+  *lastbuff= buffpek + groups;
+  /* Continue as if to_file had written everything itself */
+  error= reinit_io_cache(to_file, WRITE_CACHE, offset, 0, 0);
+
+err:
+  for (i= 0; i < started; i++)
+  {
+    caches[i].write_pos= caches[i].write_buffer;  // Nothing more to write
+    end_io_cache(caches + i);
+  }
+  my_free(params);
+  DBUG_RETURN(error);
+}
+
+
+/**
+  Number of threads to use for merge passes of merge_many_buff(), or 1
+  for the serial merge.
+*/
+
+static uint merge_threads(Sort_param *param)
+{
+  /* Every thread needs room for at least MERGEBUFF2 keys */
+  uint threads= MY_MIN(param->max_threads,
+                       param->max_keys_per_buffer / MERGEBUFF2);
+  /* Unique uses merge_buffers() to remove duplicates between groups */
+  if (param->unique_buff)
+    return 1;
+  return MY_MAX(threads, 1);
+}
+
+
 /** Merge buffers to make < MERGEBUFF2 buffers. */
 
 int merge_many_buff(Sort_param *param, uchar *sort_buffer,
@@ -1416,6 +1848,7 @@ int merge_many_buff(Sort_param *param, uchar *sort_buffer,
   register uint i;
   IO_CACHE t_file2,*from_file,*to_file,*temp;
   BUFFPEK *lastbuff;
+  uint threads= merge_threads(param);
   DBUG_ENTER("merge_many_buff");
 
   if (*maxbuffer < MERGEBUFF2)
@@ -1433,15 +1866,24 @@ int merge_many_buff(Sort_param *param, uchar *sort_buffer,
     if (reinit_io_cache(to_file,WRITE_CACHE,0L,0,0))
       goto cleanup;
     lastbuff=buffpek;
-    for (i=0 ; i <= *maxbuffer-MERGEBUFF*3/2 ; i+=MERGEBUFF)
+    if (threads > 1)
     {
+      if (merge_pass_parallel(param, sort_buffer, buffpek, *maxbuffer,
+                              from_file, to_file, threads, &lastbuff))
+        break;
+    }
+    else
+    {
+      for (i=0 ; i <= *maxbuffer-MERGEBUFF*3/2 ; i+=MERGEBUFF)
+      {
+        if (merge_buffers(param,from_file,to_file,sort_buffer,lastbuff++,
+                          buffpek+i,buffpek+i+MERGEBUFF-1,0))
+        goto cleanup;
+      }
       if (merge_buffers(param,from_file,to_file,sort_buffer,lastbuff++,
-			buffpek+i,buffpek+i+MERGEBUFF-1,0))
-      goto cleanup;
+                        buffpek+i,buffpek+ *maxbuffer,0))
+        break;					/* purecov: inspected */
     }
-    if (merge_buffers(param,from_file,to_file,sort_buffer,lastbuff++,
-		      buffpek+i,buffpek+ *maxbuffer,0))
-      break;					/* purecov: inspected */
     if (flush_io_cache(to_file))
       break;					/* purecov: inspected */
     temp=from_file; from_file=to_file; to_file=temp;
@@ -1562,11 +2004,15 @@ int merge_buffers(Sort_param *param, IO_CACHE *from_file,
   uchar *src;
   uchar *unique_buff= param->unique_buff;
   const bool killable= !param->not_killable;
-  THD* const thd=current_thd;
+  /* In a sort worker thread only the killed flag of the query is used */
+  THD* const thd= param->merge_thd ? param->merge_thd : current_thd;
   DBUG_ENTER("merge_buffers");
 
-  thd->inc_status_sort_merge_passes();
-  thd->query_plan_fsort_passes++;
+  if (!param->merge_thd)
+  {
+    thd->inc_status_sort_merge_passes();
+    thd->query_plan_fsort_passes++;
+  }
 
   error=0;
   rec_length= param->rec_length;
@@ -1643,7 +2089,8 @@ int merge_buffers(Sort_param *param, IO_CACHE *from_file,
 
   while (queue.elements > 1)
   {
-    if (killable && thd->check_killed())
+    if (killable &&
+        (param->merge_thd ? thd->killed != NOT_KILLED : thd->check_killed()))
     {
       error= 1; goto err;                        /* purecov: inspected */
     }
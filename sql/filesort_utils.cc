@@ -123,21 +123,44 @@ void Filesort_buffer::free_sort_buffer()
 }
 
 
+/*
+  The keys made by make_sortkey() are compared with memcmp(), so they
+  can be sorted by the most significant byte first radix sort, which
+  only looks at the bytes needed to tell the keys apart.  It is faster
+  than my_qsort2() and the LSD radixsort_for_str_ptr() from about 100
+  keys on, see unittest/sql/filesort_sort-t.cc, unless the keys are
+  several KB long (see msd_radixsort_is_applicable()).
+*/
+
+bool sort_key_pointers_needs_buffer(uint count, size_t sort_length)
+{
+  return msd_radixsort_is_applicable(count, sort_length);
+}
+
+
+void sort_key_pointers(uchar **keys, uint count, size_t sort_length,
+                       uchar **buffer)
+{
+  if (count <= 1 || sort_length == 0)
+    return;
+  if (buffer && msd_radixsort_is_applicable(count, sort_length))
+  {
+    msd_radixsort_for_str_ptr(keys, count, sort_length, buffer);
+    return;
+  }
+  my_qsort2(keys, count, sizeof(uchar*), get_ptr_compare(sort_length),
+            &sort_length);
+}
+
+
 void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
 {
   size_t size= param->sort_length;
   if (count <= 1 || size == 0)
     return;
-  uchar **keys= get_sort_keys();
   uchar **buffer= NULL;
-  if (radixsort_is_appliccable(count, param->sort_length) &&
-      (buffer= (uchar**) my_malloc(count*sizeof(char*),
-                                   MYF(MY_THREAD_SPECIFIC))))
-  {
-    radixsort_for_str_ptr(keys, count, param->sort_length, buffer);
-    my_free(buffer);
-    return;
-  }
-  
-  my_qsort2(keys, count, sizeof(uchar*), get_ptr_compare(size), &size);
+  if (sort_key_pointers_needs_buffer(count, size))
+    buffer= (uchar**) my_malloc(count*sizeof(char*), MYF(MY_THREAD_SPECIFIC));
+  sort_key_pointers(get_sort_keys(), count, size, buffer);
+  my_free(buffer);
 }
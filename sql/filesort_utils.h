@@ -45,6 +45,23 @@ double get_merge_many_buffs_cost_fast(ha_rows num_rows,
                                       uint    elem_size);
 
 
+/**
+  Sort an array of pointers to sort keys.
+
+    @param keys         Pointers to the keys to sort.
+    @param count        Number of pointers in keys.
+    @param sort_length  Length of the keys.
+    @param buffer       Room for count pointers for radix sort, or NULL.
+*/
+
+void sort_key_pointers(uchar **keys, uint count, size_t sort_length,
+                       uchar **buffer);
+
+/** Whether sort_key_pointers() can use a buffer for count keys. */
+
+bool sort_key_pointers_needs_buffer(uint count, size_t sort_length);
+
+
 /**
   A wrapper class around the buffer used by filesort().
   The buffer is a contiguous chunk of memory,
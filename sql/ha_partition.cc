@@ -106,10 +106,26 @@ static const char *ha_partition_ext[]=
 
 #ifdef HAVE_PSI_INTERFACE
 PSI_mutex_key key_partition_auto_inc_mutex;
+static PSI_mutex_key key_partition_LOCK_parallel_scan;
+static PSI_cond_key key_partition_COND_parallel_scan;
+static PSI_thread_key key_thread_partition_scan;
 
 static PSI_mutex_info all_partition_mutexes[]=
 {
-  { &key_partition_auto_inc_mutex, "Partition_share::auto_inc_mutex", 0}
+  { &key_partition_auto_inc_mutex, "Partition_share::auto_inc_mutex", 0},
+  { &key_partition_LOCK_parallel_scan,
+    "Partition_parallel_scan::LOCK_parallel_scan", 0}
+};
+
+static PSI_cond_info all_partition_conds[]=
+{
+  { &key_partition_COND_parallel_scan,
+    "Partition_parallel_scan::COND_parallel_scan", 0}
+};
+
+static PSI_thread_info all_partition_threads[]=
+{
+  { &key_thread_partition_scan, "partition_scan", 0}
 };
 
 static void init_partition_psi_keys(void)
@@ -119,6 +135,12 @@ static void init_partition_psi_keys(void)
 
   count= array_elements(all_partition_mutexes);
   mysql_mutex_register(category, all_partition_mutexes, count);
+
+  count= array_elements(all_partition_conds);
+  mysql_cond_register(category, all_partition_conds, count);
+
+  count= array_elements(all_partition_threads);
+  mysql_thread_register(category, all_partition_threads, count);
 }
 #endif /* HAVE_PSI_INTERFACE */
 
@@ -163,6 +185,7 @@ bool Partition_share::init(uint num_parts)
                    MY_MUTEX_INIT_FAST);
   auto_inc_initialized= false;
   partition_name_hash_initialized= false;
+  partition_file_names= NULL;
   next_auto_inc_val= 0;
   partitions_share_refs= new Parts_share_refs;
   if (!partitions_share_refs)
@@ -374,6 +397,13 @@ void ha_partition::init_handler_variables()
   part_share= NULL;
   m_new_partitions_share_refs.empty();
   m_part_ids_sorted_by_num_of_records= NULL;
+  m_lazy_open= FALSE;
+  m_table_path= NULL;
+  m_lock_on_first_use= FALSE;
+  m_parallel_scan= NULL;
+  m_part_lock_type= F_UNLCK;
+  m_part_thr_lock_type= TL_IGNORE;
+  m_extra_log_count= 0;
 
 #ifdef DONT_HAVE_TO_BE_INITALIZED
   m_start_key.flag= 0;
@@ -1332,6 +1362,9 @@ int ha_partition::handle_opt_partitions(THD *thd, HA_CHECK_OPT *check_opt,
   DBUG_ENTER("ha_partition::handle_opt_partitions");
   DBUG_PRINT("enter", ("flag= %u", flag));
 
+  if ((error= open_all_partitions()))
+    DBUG_RETURN(error);
+
   do
   {
     partition_element *part_elem= part_it++;
@@ -1424,6 +1457,8 @@ bool ha_partition::check_and_repair(THD *thd)
   handler **file= m_file;
   DBUG_ENTER("ha_partition::check_and_repair");
 
+  if (open_all_partitions())
+    DBUG_RETURN(TRUE);
   do
   {
     if ((*file)->ha_check_and_repair(thd))
@@ -1661,6 +1696,9 @@ int ha_partition::change_partitions(HA_CREATE_INFO *create_info,
   THD *thd= ha_thd();
   DBUG_ENTER("ha_partition::change_partitions");
 
+  if ((error= open_all_partitions()))
+    DBUG_RETURN(error);
+
   /*
     Assert that it works without HA_FILE_BASED and lower_case_table_name = 2.
     We use m_file[0] as long as all partitions have the same storage engine.
@@ -2063,6 +2101,10 @@ void ha_partition::update_create_info(HA_CREATE_INFO *create_info)
 {
   DBUG_ENTER("ha_partition::update_create_info");
 
+  /* The partition specific settings are read from all partitions */
+  if (open_all_partitions())
+    DBUG_VOID_RETURN;
+
   /*
     Fix for bug#38751, some engines needs info-calls in ALTER.
     Archive need this since it flushes in ::info.
@@ -3325,6 +3367,7 @@ void ha_partition::free_partition_bitmaps()
   my_bitmap_free(&m_locked_partitions);
   my_bitmap_free(&m_partitions_to_reset);
   my_bitmap_free(&m_key_not_found_partitions);
+  my_bitmap_free(&m_opened_partitions);
 }
 
 
@@ -3373,6 +3416,17 @@ bool ha_partition::init_partition_bitmaps()
   }
   bitmap_clear_all(&m_key_not_found_partitions);
   m_key_not_found= false;
+
+  /* Initialize the bitmap we use to keep track of opened partitions */
+  if (my_bitmap_init(&m_opened_partitions, NULL, m_tot_parts, FALSE))
+  {
+    my_bitmap_free(&m_bulk_insert_started);
+    my_bitmap_free(&m_locked_partitions);
+    my_bitmap_free(&m_partitions_to_reset);
+    my_bitmap_free(&m_key_not_found_partitions);
+    DBUG_RETURN(true);
+  }
+  bitmap_clear_all(&m_opened_partitions);
   /* Initialize the bitmap for read/lock_partitions */
   if (!m_is_clone_of)
   {
@@ -3387,6 +3441,296 @@ bool ha_partition::init_partition_bitmaps()
 }
 
 
+/**
+  Save the file names of the partitions in the Partition_share.
+
+  @param name_buffer_ptr  Partition names read from the .par file
+
+  @return Operation status
+    @retval true   Failure
+    @retval false  Success
+
+  @note The names are needed for opening partitions on first use, and
+  are shared by all TABLE objects of the table.
+*/
+
+bool ha_partition::populate_partition_file_names(const char *name_buffer_ptr)
+{
+  char **names, *ptr;
+  const char *name;
+  size_t length= 0;
+  uint i;
+  DBUG_ENTER("ha_partition::populate_partition_file_names");
+
+  /*
+    partition_file_names is only set once and never changed
+    -> OK to check without locking.
+  */
+  if (part_share->partition_file_names)
+    DBUG_RETURN(false);
+  lock_shared_ha_data();
+  if (part_share->partition_file_names)
+  {
+    unlock_shared_ha_data();
+    DBUG_RETURN(false);
+  }
+  for (i= 0, name= name_buffer_ptr; i < m_tot_parts; i++)
+  {
+    size_t name_length= strlen(name) + 1;
+    length+= name_length;
+    name+= name_length;
+  }
+  if (!my_multi_malloc(MY_WME,
+                       &names, m_tot_parts * sizeof(char*),
+                       &ptr, length,
+                       NULL))
+  {
+    unlock_shared_ha_data();
+    DBUG_RETURN(true);
+  }
+  memcpy(ptr, name_buffer_ptr, length);
+  for (i= 0; i < m_tot_parts; i++)
+  {
+    names[i]= ptr;
+    ptr+= strlen(ptr) + 1;
+  }
+  part_share->partition_file_names= names;
+  unlock_shared_ha_data();
+  DBUG_RETURN(false);
+}
+
+
+/**
+  Check if the statement can lock partitions on first use.
+
+  @param thd  Thread handle
+
+  @return true if partitions are to be locked when first used, false if
+  all partitions in lock_partitions are to be locked up front.
+
+  @note Used for plain DML, which prunes partitions after locking the
+  tables. LOCK TABLES and prelocking lock the tables for several
+  statements, and DDL or admin statements use all partitions anyway.
+*/
+
+bool ha_partition::can_lock_on_first_use(THD *thd) const
+{
+  if (!m_lazy_open || thd->in_lock_tables || thd->locked_tables_mode ||
+      thd->lex->requires_prelocking())
+    return false;
+  switch (thd->lex->sql_command) {
+  case SQLCOM_SELECT:
+  case SQLCOM_INSERT:
+  case SQLCOM_INSERT_SELECT:
+  case SQLCOM_REPLACE:
+  case SQLCOM_REPLACE_SELECT:
+  case SQLCOM_UPDATE:
+  case SQLCOM_UPDATE_MULTI:
+  case SQLCOM_DELETE:
+  case SQLCOM_DELETE_MULTI:
+    return true;
+  default:
+    return false;
+  }
+}
+
+
+/**
+  Open the handler of a partition not opened by open().
+
+  @param part_id  Partition to open
+
+  @return Operation status
+    @retval 0    Success
+    @retval >0   Error code
+*/
+
+int ha_partition::open_partition(uint part_id)
+{
+  handler *file= m_file[part_id];
+  char name_buff[FN_REFLEN];
+  int error;
+  uint i;
+  DBUG_ENTER("ha_partition::open_partition");
+  DBUG_PRINT("info", ("part_id: %u", part_id));
+  DBUG_ASSERT(m_lazy_open && !bitmap_is_set(&m_opened_partitions, part_id));
+
+  create_partition_name(name_buff, m_table_path,
+                        part_share->partition_file_names[part_id],
+                        NORMAL_PART_NAME, FALSE);
+  if ((error= file->ha_open(table, name_buff, m_mode,
+                            m_open_test_lock | HA_OPEN_NO_PSI_CALL)))
+    DBUG_RETURN(error);
+  /* Same checks as open() does for the partitions opened there */
+  if (file->ref_length + PARTITION_BYTES_IN_POS > m_ref_length ||
+      ((file->ha_table_flags() & ~(PARTITION_DISABLED_TABLE_FLAGS)) !=
+       (m_file[0]->table_flags() & ~(PARTITION_DISABLED_TABLE_FLAGS))))
+  {
+    file->ha_close();
+    DBUG_RETURN(HA_ERR_INITIALIZATION);
+  }
+  bitmap_set_bit(&m_opened_partitions, part_id);
+
+  /*
+    Sort the partition into m_part_ids_sorted_by_num_of_records now,
+    with the statistics it has when opened, like open() does for the
+    partitions it opens. Range estimates then start from the biggest
+    partitions, and the order does not depend on when a later statement
+    happens to refresh the statistics.
+  */
+  file->info(HA_STATUS_VARIABLE | HA_STATUS_NO_LOCK);
+  my_qsort2((void*) m_part_ids_sorted_by_num_of_records,
+            m_tot_parts,
+            sizeof(uint32),
+            (qsort2_cmp) compare_number_of_records,
+            this);
+  if (m_part_ids_sorted_by_num_of_records[0] == part_id)
+    file->info(HA_STATUS_CONST | HA_STATUS_NO_LOCK);
+
+  /* Catch up with the extra() calls done by the statement so far */
+  if (m_extra_log_count &&
+      bitmap_is_set(&m_part_info->lock_partitions, part_id))
+  {
+    for (i= 0; i < m_extra_log_count; i++)
+      (void) file->extra(m_extra_log[i]);
+    bitmap_set_bit(&m_partitions_to_reset, part_id);
+  }
+  DBUG_RETURN(0);
+}
+
+
+/**
+  Open the partitions in a set which are not opened yet.
+*/
+
+int ha_partition::open_partitions(MY_BITMAP *part_set)
+{
+  int error;
+  uint i;
+  DBUG_ENTER("ha_partition::open_partitions");
+
+  if (!m_lazy_open)
+    DBUG_RETURN(0);
+  for (i= bitmap_get_first_set(part_set);
+       i < m_tot_parts;
+       i= bitmap_get_next_set(part_set, i))
+  {
+    if (!bitmap_is_set(&m_opened_partitions, i) &&
+        (error= open_partition(i)))
+      DBUG_RETURN(error);
+  }
+  DBUG_RETURN(0);
+}
+
+
+/**
+  Open all partitions not opened yet.
+
+  Used before operations which need every partition, like ALTER TABLE
+  and the admin commands.
+*/
+
+int ha_partition::open_all_partitions()
+{
+  int error;
+  uint i;
+  DBUG_ENTER("ha_partition::open_all_partitions");
+
+  if (!m_lazy_open || bitmap_is_set_all(&m_opened_partitions))
+    DBUG_RETURN(0);
+  for (i= 0; i < m_tot_parts; i++)
+  {
+    if (!bitmap_is_set(&m_opened_partitions, i) &&
+        (error= open_partition(i)))
+      DBUG_RETURN(error);
+  }
+  DBUG_RETURN(0);
+}
+
+
+/**
+  Open a partition if needed and lock it for the current statement.
+
+  @param part_id  Partition about to be used
+
+  @return Operation status
+    @retval 0    Success
+    @retval >0   Error code
+
+  @note Called through prepare_partition(). The partition is locked only
+  if the statement locks partitions on first use and the partition is
+  in lock_partitions. The lock calls are the ones external_lock() and
+  store_lock() would have done, but the thr_lock data is not used: the
+  statement is protected by its metadata lock, and InnoDB turns table
+  level locks for DML into ones that do not conflict anyway. This only
+  holds for InnoDB outside of LOCK TABLES, see can_lock_on_first_use(),
+  and is asserted here.
+*/
+
+int ha_partition::open_and_lock_partition(uint part_id)
+{
+  handler *file= m_file[part_id];
+  THD *thd;
+  int error;
+  DBUG_ENTER("ha_partition::open_and_lock_partition");
+
+  if (!bitmap_is_set(&m_opened_partitions, part_id) &&
+      (error= open_partition(part_id)))
+    DBUG_RETURN(error);
+  if (!m_lock_on_first_use ||
+      bitmap_is_set(&m_locked_partitions, part_id) ||
+      !bitmap_is_set(&m_part_info->lock_partitions, part_id))
+    DBUG_RETURN(0);
+
+  DBUG_PRINT("info", ("lock part %u lock %d", part_id, m_part_lock_type));
+  thd= ha_thd();
+  if (m_part_thr_lock_type != TL_IGNORE)
+  {
+    THR_LOCK_DATA *lock_data[1], **end;
+    DBUG_ASSERT(m_num_locks == 1);
+    DBUG_ASSERT(ha_legacy_type(file->ht) == DB_TYPE_INNODB);
+    end= file->store_lock(thd, lock_data, m_part_thr_lock_type);
+    while (end != lock_data)
+    {
+      --end;
+      /* No other DML statement can be refused such a lock */
+      DBUG_ASSERT((*end)->type == TL_READ ||
+                  (*end)->type == TL_READ_HIGH_PRIORITY ||
+                  (*end)->type == TL_READ_WITH_SHARED_LOCKS ||
+                  (*end)->type == TL_WRITE_ALLOW_WRITE);
+      (*end)->type= TL_UNLOCK;
+    }
+  }
+  if ((error= file->ha_external_lock(thd, m_part_lock_type)))
+    DBUG_RETURN(error);
+  bitmap_set_bit(&m_locked_partitions, part_id);
+  bitmap_set_bit(&m_partitions_to_reset, part_id);
+  DBUG_RETURN(0);
+}
+
+
+/**
+  Prepare all partitions in a set for use, see prepare_partition().
+*/
+
+int ha_partition::prepare_partitions(MY_BITMAP *part_set)
+{
+  int error;
+  uint i;
+
+  if (!m_lazy_open)
+    return 0;
+  for (i= bitmap_get_first_set(part_set);
+       i < m_tot_parts;
+       i= bitmap_get_next_set(part_set, i))
+  {
+    if ((error= prepare_partition(i)))
+      return error;
+  }
+  return 0;
+}
+
+
 /*
   Open handler object
 
@@ -3483,6 +3827,19 @@ int ha_partition::open(const char *name, int mode, uint test_if_locked)
   }
   else
   {
+   /*
+     InnoDB partitions are opened on first use and locked only when the
+     statement uses them, see open_and_lock_partition(). Its ref_length
+     is the same for all partitions, and it keeps little handler state
+     between statements, so a partition opened in the middle of a
+     statement behaves as if opened with the others. Only the first
+     partition is opened here, to set up the constants of the table.
+   */
+   m_lazy_open= m_innodb;
+   if (m_lazy_open &&
+       (populate_partition_file_names(name_buffer_ptr) ||
+        !(m_table_path= strdup_root(&table->mem_root, name))))
+     goto err_alloc;
    file= m_file;
    do
    {
@@ -3497,7 +3854,7 @@ int ha_partition::open(const char *name, int mode, uint test_if_locked)
         m_num_locks= (*file)->lock_count();
       DBUG_ASSERT(m_num_locks == (*file)->lock_count());
       name_buffer_ptr+= strlen(name_buffer_ptr) + 1;
-    } while (*(++file));
+    } while (*(++file) && !m_lazy_open);
   }
   
   file= m_file;
@@ -3505,7 +3862,7 @@ int ha_partition::open(const char *name, int mode, uint test_if_locked)
   check_table_flags= (((*file)->ha_table_flags() &
                        ~(PARTITION_DISABLED_TABLE_FLAGS)) |
                       (PARTITION_ENABLED_TABLE_FLAGS));
-  while (*(++file))
+  while (!m_lazy_open && *(++file))
   {
     /* MyISAM can have smaller ref_length for partitions with MAX_ROWS set */
     set_if_bigger(ref_length, ((*file)->ref_length));
@@ -3531,6 +3888,10 @@ int ha_partition::open(const char *name, int mode, uint test_if_locked)
   */
   ref_length+= PARTITION_BYTES_IN_POS;
   m_ref_length= ref_length;
+  if (m_lazy_open)
+    bitmap_set_bit(&m_opened_partitions, 0);
+  else
+    bitmap_set_all(&m_opened_partitions);
 
   /*
     Release buffer read from .par file. It will not be reused again after
@@ -3550,7 +3911,11 @@ int ha_partition::open(const char *name, int mode, uint test_if_locked)
                             m_part_info->part_expr->get_monotonicity_info();
   else if (m_part_info->list_of_part_fields)
     m_part_func_monotonicity_info= MONOTONIC_STRICT_INCREASING;
-  info(HA_STATUS_VARIABLE | HA_STATUS_CONST);
+  /*
+    With lazy open the statistics are collected from the partitions the
+    statement uses, when the optimizer asks for them after pruning.
+  */
+  info(m_lazy_open ? HA_STATUS_CONST : HA_STATUS_VARIABLE | HA_STATUS_CONST);
   DBUG_RETURN(0);
 
 err_handler:
@@ -3622,6 +3987,13 @@ handler *ha_partition::clone(const char *name, MEM_ROOT *mem_root)
   ha_partition *new_handler;
 
   DBUG_ENTER("ha_partition::clone");
+  /*
+    The clone opens all partitions by cloning ours, and the cloned
+    handlers take over the lock state of the used partitions.
+  */
+  if (open_all_partitions() ||
+      prepare_partitions(&m_part_info->read_partitions))
+    DBUG_RETURN(NULL);
   new_handler= new (mem_root) ha_partition(ht, table_share, m_part_info,
                                            this, mem_root);
   if (!new_handler)
@@ -3682,14 +4054,14 @@ int ha_partition::close(void)
 
   DBUG_ASSERT(table->s == table_share);
   destroy_record_priority_queue();
-  free_partition_bitmaps();
   DBUG_ASSERT(m_part_info);
   file= m_file;
 
 repeat:
   do
   {
-    (*file)->ha_close();
+    if (!first || bitmap_is_set(&m_opened_partitions, (uint) (file - m_file)))
+      (*file)->ha_close();
   } while (*(++file));
 
   if (first && m_added_file && m_added_file[0])
@@ -3699,6 +4071,7 @@ int ha_partition::close(void)
     goto repeat;
   }
 
+  free_partition_bitmaps();
   m_handler_status= handler_closed;
   DBUG_RETURN(0);
 }
@@ -3755,7 +4128,37 @@ int ha_partition::external_lock(THD *thd, int lock_type)
   if (lock_type == F_UNLCK)
     used_partitions= &m_locked_partitions;
   else
+  {
     used_partitions= &(m_part_info->lock_partitions);
+    /*
+      With lazy open table_flags() uses the first partition, which may not
+      be locked. Refresh its flags as ha_external_lock() would.
+    */
+    if (m_lazy_open)
+      m_file[0]->init();
+    if (can_lock_on_first_use(thd))
+    {
+      /*
+        Partitions are pruned after the tables are locked, so only lock
+        the partitions the statement ends up using, when it first uses
+        them. The first partition is still locked here so that the engine
+        can refuse the statement (e.g. binlog format checks) up front.
+      */
+      m_lock_on_first_use= TRUE;
+      m_part_lock_type= lock_type;
+      first_used_partition= bitmap_get_first_set(used_partitions);
+      if (first_used_partition < m_tot_parts &&
+          (error= open_and_lock_partition(first_used_partition)))
+      {
+        m_lock_on_first_use= FALSE;
+        m_part_lock_type= F_UNLCK;
+        DBUG_RETURN(error);
+      }
+      DBUG_RETURN(0);
+    }
+    if ((error= open_partitions(used_partitions)))
+      DBUG_RETURN(error);
+  }
 
   first_used_partition= bitmap_get_first_set(used_partitions);
 
@@ -3776,6 +4179,9 @@ int ha_partition::external_lock(THD *thd, int lock_type)
   if (lock_type == F_UNLCK)
   {
     bitmap_clear_all(used_partitions);
+    m_lock_on_first_use= FALSE;
+    m_part_lock_type= F_UNLCK;
+    m_part_thr_lock_type= TL_IGNORE;
   }
   else
   {
@@ -3869,16 +4275,32 @@ THR_LOCK_DATA **ha_partition::store_lock(THD *thd,
   if (thd != table->in_use)
   {
     for (i= 0; i < m_tot_parts; i++)
-      to= m_file[i]->store_lock(thd, to, lock_type);
+    {
+      /* Partitions not opened have no locks */
+      if (bitmap_is_set(&m_opened_partitions, i))
+        to= m_file[i]->store_lock(thd, to, lock_type);
+    }
+  }
+  else if (can_lock_on_first_use(thd))
+  {
+    /* Done for each partition in open_and_lock_partition() */
+    if (lock_type != TL_IGNORE)
+      m_part_thr_lock_type= lock_type;
   }
   else
   {
+    /*
+      A partition that fails to open is skipped here, external_lock()
+      tries again and reports the error.
+    */
+    (void) open_partitions(&m_part_info->lock_partitions);
     for (i= bitmap_get_first_set(&(m_part_info->lock_partitions));
          i < m_tot_parts;
          i= bitmap_get_next_set(&m_part_info->lock_partitions, i))
     {
       DBUG_PRINT("info", ("store lock %d iteration", i));
-      to= m_file[i]->store_lock(thd, to, lock_type);
+      if (bitmap_is_set(&m_opened_partitions, i))
+        to= m_file[i]->store_lock(thd, to, lock_type);
     }
   }
   DBUG_RETURN(to);
@@ -4040,7 +4462,9 @@ void ha_partition::try_semi_consistent_read(bool yes)
        i < m_tot_parts;
        i= bitmap_get_next_set(&m_part_info->read_partitions, i))
   {
-    m_file[i]->try_semi_consistent_read(yes);
+    /* A partition failing to open reports the error when read */
+    if (!prepare_partition(i))
+      m_file[i]->try_semi_consistent_read(yes);
   }
   DBUG_VOID_RETURN;
 }
@@ -4159,6 +4583,8 @@ int ha_partition::write_row(uchar * buf)
   }
   m_last_part= part_id;
   DBUG_PRINT("info", ("Insert in partition %d", part_id));
+  if ((error= prepare_partition(part_id)))
+    goto exit;
   start_part_bulk_insert(thd, part_id);
 
   tmp_disable_binlog(thd); /* Do not replicate the low-level changes. */
@@ -4247,6 +4673,8 @@ int ha_partition::update_row(const uchar *old_data, uchar *new_data)
   }
 
   m_last_part= new_part_id;
+  if ((error= prepare_partition(new_part_id)))
+    goto exit;
   start_part_bulk_insert(thd, new_part_id);
   if (new_part_id == old_part_id)
   {
@@ -4430,7 +4858,8 @@ int ha_partition::delete_all_rows()
        i= bitmap_get_next_set(&m_part_info->read_partitions, i))
   {
     /* Can be pruned, like DELETE FROM t PARTITION (pX) */
-    if ((error= m_file[i]->ha_delete_all_rows()))
+    if ((error= prepare_partition(i)) ||
+        (error= m_file[i]->ha_delete_all_rows()))
       DBUG_RETURN(error);
   }
   DBUG_RETURN(0);
@@ -4459,6 +4888,8 @@ int ha_partition::truncate()
   part_share->auto_inc_initialized= false;
   unlock_auto_increment();
 
+  if ((error= open_all_partitions()))
+    DBUG_RETURN(error);
   file= m_file;
   do
   {
@@ -4489,6 +4920,9 @@ int ha_partition::truncate_partition(Alter_info *alter_info, bool *binlog_stmt)
   /* Only binlog when it starts any call to the partitions handlers */
   *binlog_stmt= false;
 
+  if ((error= open_all_partitions()))
+    DBUG_RETURN(error);
+
   if (set_part_state(alter_info, m_part_info, PART_ADMIN))
     DBUG_RETURN(HA_ERR_NO_PARTITION_FOUND);
 
@@ -4695,6 +5129,484 @@ int ha_partition::end_bulk_insert()
 }
 
 
+/****************************************************************************
+                MODULE parallel full table scan
+****************************************************************************/
+/*
+  With max_partition_scan_threads > 1, a full table scan that only reads
+  rows, of a table whose engine sets HA_CAN_PARALLEL_SCAN, is done by
+  worker threads. Each worker takes the next partition to scan and reads
+  its rows, together with their positions, into blocks of its own buffer.
+  Full blocks are handed over to the thread running the statement, which
+  returns their rows from rnd_next(). The rows are returned in no
+  particular order, as for any table scan.
+
+  While the scan is running, the handler of a partition is only used by
+  the worker scanning it. The statistics of the connection are only
+  updated by the thread running the statement.
+*/
+
+/** Size of the blocks of rows handed over by a scan worker. */
+#define PARALLEL_SCAN_BLOCK_SIZE (64*1024)
+/** Number of blocks a scan worker may fill ahead of the statement. */
+#define PARALLEL_SCAN_BLOCKS 4
+
+class Partition_parallel_scan;
+
+struct Partition_scan_worker
+{
+  Partition_parallel_scan *scan;
+  pthread_t thread;
+  uchar *memory;                        /* PARALLEL_SCAN_BLOCKS blocks */
+  uint rows[PARALLEL_SCAN_BLOCKS];      /* Rows in each filled block */
+  /* Blocks filled by the worker, handed over and released by the reader */
+  ulonglong filled, taken, released;
+};
+
+pthread_handler_t partition_scan_thread(void *arg);
+
+class Partition_parallel_scan
+{
+public:
+  Partition_parallel_scan(handler **file_arg, uint rec_length_arg,
+                          uint ref_length_arg);
+  ~Partition_parallel_scan();
+  bool init(MY_BITMAP *read_partitions, uint threads);
+  bool start(bool extra_cache, uint extra_cache_size);
+  bool is_started() { return m_num_workers != 0; }
+  void stop();
+  int next_row(uchar **row);
+  /** Position of the row last returned by next_row(). */
+  uchar *position() { return m_row - m_ref_length; }
+  void scan_partitions(Partition_scan_worker *worker);
+
+private:
+  int scan_partition(Partition_scan_worker *worker, uint part_id);
+  uchar *free_block(Partition_scan_worker *worker);
+  void fill_block(Partition_scan_worker *worker, uint rows);
+
+  handler **m_file;
+  uint m_rec_length, m_ref_length, m_row_length, m_block_rows;
+  bool m_extra_cache;
+  uint m_extra_cache_size;
+  /* Partitions to scan, and the index of the next one to take */
+  uint *m_parts;
+  uint m_num_parts;
+  volatile int32 m_next_part;
+  Partition_scan_worker *m_workers;
+  uint m_max_workers, m_num_workers;
+  uchar *m_memory;
+  /* Protected by LOCK_parallel_scan */
+  uint m_running;
+  int m_error;
+  volatile bool m_abort;
+  /* The block being returned by next_row() */
+  Partition_scan_worker *m_current;
+  uint m_next_worker;
+  uchar *m_row;
+  uint m_rows_left;
+  mysql_mutex_t LOCK_parallel_scan;
+  mysql_cond_t COND_parallel_scan;
+};
+
+
+Partition_parallel_scan::Partition_parallel_scan(handler **file_arg,
+                                                 uint rec_length_arg,
+                                                 uint ref_length_arg)
+  :m_file(file_arg), m_rec_length(rec_length_arg),
+   m_ref_length(ref_length_arg),
+   m_row_length(ALIGN_SIZE(ref_length_arg + rec_length_arg)),
+   m_extra_cache(false), m_extra_cache_size(0),
+   m_parts(NULL), m_num_parts(0), m_next_part(0), m_workers(NULL),
+   m_max_workers(0), m_num_workers(0), m_memory(NULL), m_running(0), m_error(0),
+   m_abort(false), m_current(NULL), m_next_worker(0), m_row(NULL),
+   m_rows_left(0)
+{
+  m_block_rows= MY_MAX(PARALLEL_SCAN_BLOCK_SIZE / m_row_length, 1);
+  mysql_mutex_init(key_partition_LOCK_parallel_scan, &LOCK_parallel_scan,
+                   MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_partition_COND_parallel_scan, &COND_parallel_scan,
+                  NULL);
+}
+
+
+Partition_parallel_scan::~Partition_parallel_scan()
+{
+  stop();
+  my_free(m_memory);
+  my_free(m_workers);
+  my_free(m_parts);
+  mysql_cond_destroy(&COND_parallel_scan);
+  mysql_mutex_destroy(&LOCK_parallel_scan);
+}
+
+
+/**
+  Allocate the buffers of the workers.
+
+  @param read_partitions  Partitions to scan
+  @param threads          Maximum number of workers
+
+  @return TRUE on out of memory
+*/
+
+bool Partition_parallel_scan::init(MY_BITMAP *read_partitions, uint threads)
+{
+  uint i;
+  DBUG_ENTER("Partition_parallel_scan::init");
+
+  m_num_parts= bitmap_bits_set(read_partitions);
+  m_max_workers= MY_MIN(threads, m_num_parts);
+  if (!(m_parts= (uint*) my_malloc(m_num_parts * sizeof(uint), MYF(MY_WME))) ||
+      !(m_workers= (Partition_scan_worker*)
+        my_malloc(m_max_workers * sizeof(Partition_scan_worker),
+                  MYF(MY_WME))) ||
+      !(m_memory= (uchar*) my_malloc((size_t) m_max_workers *
+                                     PARALLEL_SCAN_BLOCKS * m_block_rows *
+                                     m_row_length, MYF(MY_WME))))
+    DBUG_RETURN(TRUE);
+
+  m_num_parts= 0;
+  for (i= bitmap_get_first_set(read_partitions);
+       i < read_partitions->n_bits;
+       i= bitmap_get_next_set(read_partitions, i))
+    m_parts[m_num_parts++]= i;
+  DBUG_RETURN(FALSE);
+}
+
+
+/**
+  Start the workers.
+
+  This is done when the first row is read, as the record cache to use is
+  set up by extra() after rnd_init().
+
+  @param extra_cache       extra(HA_EXTRA_CACHE) was called
+  @param extra_cache_size  Size of the record cache, 0 for the default
+
+  @return TRUE if no worker could be started
+*/
+
+bool Partition_parallel_scan::start(bool extra_cache, uint extra_cache_size)
+{
+  size_t block_size= (size_t) m_block_rows * m_row_length;
+  uint i;
+  DBUG_ENTER("Partition_parallel_scan::start");
+  DBUG_ASSERT(!is_started());
+
+  m_extra_cache= extra_cache;
+  m_extra_cache_size= extra_cache_size;
+  mysql_mutex_lock(&LOCK_parallel_scan);
+  for (i= 0; i < m_max_workers; i++)
+  {
+    Partition_scan_worker *worker= &m_workers[i];
+    worker->scan= this;
+    worker->memory= m_memory + i * PARALLEL_SCAN_BLOCKS * block_size;
+    worker->filled= worker->taken= worker->released= 0;
+    if (mysql_thread_create(key_thread_partition_scan, &worker->thread, NULL,
+                            partition_scan_thread, (void*) worker))
+      break;
+  }
+  m_num_workers= m_running= i;
+  mysql_mutex_unlock(&LOCK_parallel_scan);
+  DBUG_PRINT("info", ("%u workers scan %u partitions",
+                      m_num_workers, m_num_parts));
+  DBUG_RETURN(m_num_workers == 0);
+}
+
+
+/** Stop the workers, whether they have scanned all partitions or not. */
+
+void Partition_parallel_scan::stop()
+{
+  mysql_mutex_lock(&LOCK_parallel_scan);
+  m_abort= true;
+  mysql_cond_broadcast(&COND_parallel_scan);
+  mysql_mutex_unlock(&LOCK_parallel_scan);
+  for (uint i= 0; i < m_num_workers; i++)
+    pthread_join(m_workers[i].thread, NULL);
+  m_num_workers= 0;
+}
+
+
+pthread_handler_t partition_scan_thread(void *arg)
+{
+  Partition_scan_worker *worker= (Partition_scan_worker*) arg;
+  my_thread_init();
+  worker->scan->scan_partitions(worker);
+  my_thread_end();
+  return 0;
+}
+
+
+void Partition_parallel_scan::scan_partitions(Partition_scan_worker *worker)
+{
+  int32 i;
+  int error= 0;
+
+  while (!m_abort &&
+         (i= my_atomic_add32(&m_next_part, 1)) < (int32) m_num_parts)
+  {
+    if ((error= scan_partition(worker, m_parts[i])))
+      break;
+  }
+
+  mysql_mutex_lock(&LOCK_parallel_scan);
+  if (error && !m_error)
+  {
+    m_error= error;
+    m_abort= true;
+  }
+  m_running--;
+  mysql_cond_broadcast(&COND_parallel_scan);
+  mysql_mutex_unlock(&LOCK_parallel_scan);
+}
+
+
+/**
+  Read all rows of a partition into the blocks of a worker.
+
+  @return 0 or error code
+*/
+
+int Partition_parallel_scan::scan_partition(Partition_scan_worker *worker,
+                                            uint part_id)
+{
+  handler *file= m_file[part_id];
+  uchar *block= NULL;
+  uint rows= 0;
+  int error, end_error;
+  DBUG_ENTER("Partition_parallel_scan::scan_partition");
+
+  if ((error= file->ha_rnd_init(1)))
+    DBUG_RETURN(error);
+  /* As late_extra_cache(), but for every partition being scanned */
+  if (m_extra_cache)
+  {
+    if (m_extra_cache_size == 0)
+      (void) file->extra(HA_EXTRA_CACHE);
+    else
+      (void) file->extra_opt(HA_EXTRA_CACHE, m_extra_cache_size);
+  }
+
+  for (;;)
+  {
+    uchar *row;
+    if (!block && !(block= free_block(worker)))
+      break;                                    // Aborted
+    row= block + rows * m_row_length;
+    if ((error= file->ha_parallel_rnd_next(row + m_ref_length)))
+    {
+      if (error == HA_ERR_RECORD_DELETED)
+        continue;
+      if (error == HA_ERR_END_OF_FILE)
+        error= 0;
+      break;
+    }
+    /* Store the position as ha_partition::position() does */
+    file->position(row + m_ref_length);
+    int2store(row, part_id);
+    memcpy(row + PARTITION_BYTES_IN_POS, file->ref, file->ref_length);
+    if (m_ref_length > PARTITION_BYTES_IN_POS + file->ref_length)
+      memset(row + PARTITION_BYTES_IN_POS + file->ref_length, 0,
+             m_ref_length - PARTITION_BYTES_IN_POS - file->ref_length);
+    if (++rows == m_block_rows)
+    {
+      fill_block(worker, rows);
+      block= NULL;
+      rows= 0;
+    }
+    if (m_abort)
+      break;
+  }
+  if (rows)
+    fill_block(worker, rows);
+
+  if (m_extra_cache)
+    (void) file->extra(HA_EXTRA_NO_CACHE);
+  end_error= file->ha_rnd_end();
+  DBUG_RETURN(error ? error : end_error);
+}
+
+
+/**
+  Wait until the worker has a free block.
+
+  @return The block, or NULL if the scan is stopped
+*/
+
+uchar *Partition_parallel_scan::free_block(Partition_scan_worker *worker)
+{
+  uchar *block= NULL;
+  mysql_mutex_lock(&LOCK_parallel_scan);
+  while (worker->filled - worker->released >= PARALLEL_SCAN_BLOCKS &&
+         !m_abort)
+    mysql_cond_wait(&COND_parallel_scan, &LOCK_parallel_scan);
+  if (!m_abort)
+    block= worker->memory + (worker->filled % PARALLEL_SCAN_BLOCKS) *
+                            m_block_rows * m_row_length;
+  mysql_mutex_unlock(&LOCK_parallel_scan);
+  return block;
+}
+
+
+/** Hand over the block returned by free_block(). */
+
+void Partition_parallel_scan::fill_block(Partition_scan_worker *worker,
+                                         uint rows)
+{
+  mysql_mutex_lock(&LOCK_parallel_scan);
+  worker->rows[worker->filled % PARALLEL_SCAN_BLOCKS]= rows;
+  worker->filled++;
+  mysql_cond_broadcast(&COND_parallel_scan);
+  mysql_mutex_unlock(&LOCK_parallel_scan);
+}
+
+
+/**
+  Get the next row read by the workers.
+
+  The row stays valid until the next call. The blocks of all workers are
+  taken in turns, so that no worker waits for its blocks to be released
+  while there are rows from the others.
+
+  @param[out] row  The row in MySQL row format
+
+  @return 0, HA_ERR_END_OF_FILE or the error of a worker
+*/
+
+int Partition_parallel_scan::next_row(uchar **row)
+{
+  if (!m_rows_left)
+  {
+    int error= HA_ERR_END_OF_FILE;
+    mysql_mutex_lock(&LOCK_parallel_scan);
+    if (m_current)
+    {
+      m_current->released= m_current->taken;
+      m_current= NULL;
+      mysql_cond_broadcast(&COND_parallel_scan);
+    }
+    while (!m_error)
+    {
+      for (uint i= 0; i < m_num_workers && !m_current; i++)
+      {
+        Partition_scan_worker *worker=
+          &m_workers[(m_next_worker + i) % m_num_workers];
+        if (worker->filled > worker->taken)
+        {
+          uint block= worker->taken % PARALLEL_SCAN_BLOCKS;
+          m_rows_left= worker->rows[block];
+          m_row= worker->memory + block * m_block_rows * m_row_length +
+                 m_ref_length;
+          worker->taken++;
+          m_current= worker;
+          m_next_worker= (m_next_worker + i + 1) % m_num_workers;
+        }
+      }
+      if (m_current || !m_running)
+        break;
+      mysql_cond_wait(&COND_parallel_scan, &LOCK_parallel_scan);
+    }
+    if (m_error)
+      error= m_error;
+    else if (m_current)
+      error= 0;
+    mysql_mutex_unlock(&LOCK_parallel_scan);
+    if (error)
+    {
+      m_rows_left= 0;
+      return error;
+    }
+  }
+  else
+    m_row+= m_row_length;
+  m_rows_left--;
+  *row= m_row;
+  return 0;
+}
+
+
+/**
+  Prepare a parallel scan of the partitions to read, if possible.
+
+  Only scans that just read rows are done by worker threads: rows are
+  neither updated nor deleted, and no handler statement keeps the scan
+  open between statements, when the table is not locked. Blobs would
+  point into the buffers of the handlers.
+
+  The workers are started by the first parallel_rnd_next(). Until the
+  scan ends, m_part_spec.start_part is NO_CURRENT_PART_ID, so that extra()
+  does not touch the handlers of the partitions.
+
+  @retval FALSE  The rows are to be read by worker threads
+  @retval TRUE   The partitions are to be scanned one after another
+*/
+
+bool ha_partition::start_parallel_scan()
+{
+  uint threads= ha_thd()->variables.max_partition_scan_threads;
+  DBUG_ENTER("ha_partition::start_parallel_scan");
+  DBUG_ASSERT(!m_parallel_scan);
+
+  if (threads <= 1 || get_lock_type() != F_RDLCK ||
+      !(ha_table_flags() & HA_CAN_PARALLEL_SCAN) ||
+      table_share->blob_fields || table->open_by_handler ||
+      bitmap_bits_set(&m_part_info->read_partitions) < 2)
+    DBUG_RETURN(TRUE);
+
+  if (!(m_parallel_scan=
+        new Partition_parallel_scan(m_file, table_share->rec_buff_length,
+                                    m_ref_length)))
+    DBUG_RETURN(TRUE);
+  if (m_parallel_scan->init(&m_part_info->read_partitions, threads))
+  {
+    end_parallel_scan();
+    DBUG_RETURN(TRUE);
+  }
+  DBUG_RETURN(FALSE);
+}
+
+
+void ha_partition::end_parallel_scan()
+{
+  DBUG_ENTER("ha_partition::end_parallel_scan");
+  delete m_parallel_scan;
+  m_parallel_scan= NULL;
+  DBUG_VOID_RETURN;
+}
+
+
+int ha_partition::parallel_rnd_next(uchar *buf)
+{
+  uchar *row;
+  int error;
+  DBUG_ENTER("ha_partition::parallel_rnd_next");
+
+  if (!m_parallel_scan->is_started() &&
+      m_parallel_scan->start(m_extra_cache, m_extra_cache_size))
+  {
+    /* No thread could be created, scan the partitions here instead */
+    uint part_id= bitmap_get_first_set(&m_part_info->read_partitions);
+    end_parallel_scan();
+    late_extra_cache(part_id);
+    if ((error= m_file[part_id]->ha_rnd_init(1)))
+    {
+      m_scan_value= 2;
+      DBUG_RETURN(error);
+    }
+    m_part_spec.start_part= part_id;
+    DBUG_RETURN(rnd_next(buf));
+  }
+  if ((error= m_parallel_scan->next_row(&row)))
+    DBUG_RETURN(error);
+  memcpy(buf, row, m_rec_length);
+  m_last_part= uint2korr(m_parallel_scan->position());
+  table->status= 0;
+  DBUG_RETURN(0);
+}
+
+
 /****************************************************************************
                 MODULE full table scan
 ****************************************************************************/
@@ -4714,7 +5626,9 @@ int ha_partition::end_bulk_insert()
     rnd_init() is called when the server wants the storage engine to do a
     table scan or when the server wants to access data through rnd_pos.
 
-    When scan is used we will scan one handler partition at a time.
+    When scan is used we will scan one handler partition at a time, or
+    let worker threads scan several partitions at the same time, see
+    start_parallel_scan().
     When preparing for rnd_pos we will init all handler partitions.
     No extra cache handling is needed when scannning is not performed.
 
@@ -4759,6 +5673,9 @@ int ha_partition::rnd_init(bool scan)
     }
   }
 
+  if ((error= prepare_partitions(&m_part_info->read_partitions)))
+    goto err1;
+
   /* Now we see what the index of our first important partition is */
   DBUG_PRINT("info", ("m_part_info->read_partitions: 0x%lx",
                       (long) m_part_info->read_partitions.bitmap));
@@ -4783,9 +5700,12 @@ int ha_partition::rnd_init(bool scan)
       is already in use
     */
     rnd_end();
-    late_extra_cache(part_id);
-    if ((error= m_file[part_id]->ha_rnd_init(scan)))
-      goto err;
+    if (start_parallel_scan())
+    {
+      late_extra_cache(part_id);
+      if ((error= m_file[part_id]->ha_rnd_init(scan)))
+        goto err;
+    }
   }
   else
   {
@@ -4798,7 +5718,7 @@ int ha_partition::rnd_init(bool scan)
     }
   }
   m_scan_value= scan;
-  m_part_spec.start_part= part_id;
+  m_part_spec.start_part= m_parallel_scan ? NO_CURRENT_PART_ID : part_id;
   m_part_spec.end_part= m_tot_parts - 1;
   DBUG_PRINT("info", ("m_scan_value=%d", m_scan_value));
   DBUG_RETURN(0);
@@ -4836,7 +5756,9 @@ int ha_partition::rnd_end()
   case 2:                                       // Error
     break;
   case 1:
-    if (NO_CURRENT_PART_ID != m_part_spec.start_part)         // Table scan
+    if (m_parallel_scan)
+      end_parallel_scan();
+    else if (NO_CURRENT_PART_ID != m_part_spec.start_part)    // Table scan
     {
       late_extra_no_cache(m_part_spec.start_part);
       m_file[m_part_spec.start_part]->ha_rnd_end();
@@ -4885,6 +5807,9 @@ int ha_partition::rnd_next(uchar *buf)
   uint part_id= m_part_spec.start_part;
   DBUG_ENTER("ha_partition::rnd_next");
 
+  if (m_parallel_scan)
+    DBUG_RETURN(parallel_rnd_next(buf));
+
   /* upper level will increment this once again at end of call */
   decrement_statistics(&SSV::ha_read_rnd_next_count);
 
@@ -4981,6 +5906,12 @@ void ha_partition::position(const uchar *record)
   DBUG_ASSERT(bitmap_is_set(&(m_part_info->read_partitions), m_last_part));
   DBUG_ENTER("ha_partition::position");
 
+  if (m_parallel_scan)
+  {
+    /* The worker stored the position along with the row */
+    memcpy(ref, m_parallel_scan->position(), m_ref_length);
+    DBUG_VOID_RETURN;
+  }
   file->position(record);
   int2store(ref, m_last_part);
   memcpy((ref + PARTITION_BYTES_IN_POS), file->ref, file->ref_length);
@@ -5017,6 +5948,7 @@ int ha_partition::rnd_pos(uchar * buf, uchar *pos)
 {
   uint part_id;
   handler *file;
+  int error;
   DBUG_ENTER("ha_partition::rnd_pos");
   decrement_statistics(&SSV::ha_read_rnd_count);
 
@@ -5025,6 +5957,8 @@ int ha_partition::rnd_pos(uchar * buf, uchar *pos)
   file= m_file[part_id];
   DBUG_ASSERT(bitmap_is_set(&(m_part_info->read_partitions), part_id));
   m_last_part= part_id;
+  if ((error= prepare_partition(part_id)))
+    DBUG_RETURN(error);
   DBUG_RETURN(file->ha_rnd_pos(buf, (pos + PARTITION_BYTES_IN_POS)));
 }
 
@@ -5246,6 +6180,8 @@ int ha_partition::index_init(uint inx, bool sorted)
                        (*key_info)->key_part[i].field->field_index);
     } while (*(++key_info));
   }
+  if ((error= prepare_partitions(&m_part_info->read_partitions)))
+    DBUG_RETURN(error);
   for (i= bitmap_get_first_set(&m_part_info->read_partitions);
        i < m_tot_parts;
        i= bitmap_get_next_set(&m_part_info->read_partitions, i))
@@ -5621,6 +6557,8 @@ int ha_partition::index_read_idx_map(uchar *buf, uint index,
          part <= m_part_spec.end_part;
          part= bitmap_get_next_set(&m_part_info->read_partitions, part))
     {
+      if ((error= prepare_partition(part)))
+        break;
       error= m_file[part]->ha_index_read_idx_map(buf, index, key,
                                                  keypart_map, find_flag);
       if (error != HA_ERR_KEY_NOT_FOUND &&
@@ -6520,6 +7458,7 @@ int ha_partition::info(uint flag)
 {
   uint no_lock_flag= flag & HA_STATUS_NO_LOCK;
   uint extra_var_flag= flag & HA_STATUS_VARIABLE_EXTRA;
+  int error;
   DBUG_ENTER("ha_partition::info");
 
 #ifndef DBUG_OFF
@@ -6554,6 +7493,11 @@ int ha_partition::info(uint flag)
         */
         handler *file, **file_array;
         ulonglong auto_increment_value= 0;
+        if ((error= open_all_partitions()))
+        {
+          unlock_auto_increment();
+          DBUG_RETURN(error);
+        }
         file_array= m_file;
         DBUG_PRINT("info",
                    ("checking all partitions for auto_increment_value"));
@@ -6609,6 +7553,8 @@ int ha_partition::info(uint flag)
     stats.index_file_length= 0;
     stats.check_time= 0;
     stats.delete_length= 0;
+    if ((error= prepare_partitions(&m_part_info->read_partitions)))
+      DBUG_RETURN(error);
     for (i= bitmap_get_first_set(&m_part_info->read_partitions);
          i < m_tot_parts;
          i= bitmap_get_next_set(&m_part_info->read_partitions, i))
@@ -6691,15 +7637,19 @@ int ha_partition::info(uint flag)
     do
     {
       file= *file_array;
-      /* Get variables if not already done */
-      if (!(flag & HA_STATUS_VARIABLE) ||
-          !bitmap_is_set(&(m_part_info->read_partitions),
-                         (file_array - m_file)))
-        file->info(HA_STATUS_VARIABLE | no_lock_flag | extra_var_flag);
-      if (file->stats.records > max_records)
+      /* Partitions not opened yet are left out, see open() */
+      if (bitmap_is_set(&m_opened_partitions, i))
       {
-        max_records= file->stats.records;
-        handler_instance= i;
+        /* Get variables if not already done */
+        if (!(flag & HA_STATUS_VARIABLE) ||
+            !bitmap_is_set(&(m_part_info->read_partitions),
+                           (file_array - m_file)))
+          file->info(HA_STATUS_VARIABLE | no_lock_flag | extra_var_flag);
+        if (file->stats.records > max_records)
+        {
+          max_records= file->stats.records;
+          handler_instance= i;
+        }
       }
       i++;
     } while (*(++file_array));
@@ -6747,6 +7697,8 @@ int ha_partition::info(uint flag)
     do
     {
       file= *file_array;
+      if (!bitmap_is_set(&m_opened_partitions, (uint) (file_array - m_file)))
+        continue;
       file->info(HA_STATUS_TIME | no_lock_flag);
       if (file->stats.update_time > stats.update_time)
 	stats.update_time= file->stats.update_time;
@@ -6761,6 +7713,11 @@ void ha_partition::get_dynamic_partition_info(PARTITION_STATS *stat_info,
 {
   handler *file= m_file[part_id];
   DBUG_ASSERT(bitmap_is_set(&(m_part_info->read_partitions), part_id));
+  if (prepare_partition(part_id))
+  {
+    bzero(stat_info, sizeof(*stat_info));
+    return;
+  }
   file->info(HA_STATUS_TIME | HA_STATUS_VARIABLE |
              HA_STATUS_VARIABLE_EXTRA | HA_STATUS_NO_LOCK);
 
@@ -7158,6 +8115,9 @@ int ha_partition::extra(enum ha_extra_function operation)
   case HA_EXTRA_NO_CACHE:
   {
     int ret= 0;
+    /* Partitions opened later must not get a logged HA_EXTRA_WRITE_CACHE */
+    if (m_lazy_open)
+      log_extra(operation);
     if (m_extra_cache_part_id != NO_CURRENT_PART_ID)
       ret= m_file[m_extra_cache_part_id]->extra(HA_EXTRA_NO_CACHE);
     m_extra_cache= FALSE;
@@ -7269,6 +8229,7 @@ int ha_partition::reset(void)
       result= tmp;
   }
   bitmap_clear_all(&m_partitions_to_reset);
+  m_extra_log_count= 0;
   DBUG_RETURN(result);
 }
 
@@ -7377,6 +8338,22 @@ int ha_partition::loop_extra(enum ha_extra_function operation)
   uint i;
   DBUG_ENTER("ha_partition::loop_extra()");
   
+  if (m_lazy_open)
+  {
+    /* Partitions opened later get the operation in open_partition() */
+    log_extra(operation);
+    for (i= bitmap_get_first_set(&m_part_info->lock_partitions);
+         i < m_tot_parts;
+         i= bitmap_get_next_set(&m_part_info->lock_partitions, i))
+    {
+      if (!bitmap_is_set(&m_opened_partitions, i))
+        continue;
+      if ((tmp= m_file[i]->extra(operation)))
+        result= tmp;
+      bitmap_set_bit(&m_partitions_to_reset, i);
+    }
+    DBUG_RETURN(result);
+  }
   for (i= bitmap_get_first_set(&m_part_info->lock_partitions);
        i < m_tot_parts;
        i= bitmap_get_next_set(&m_part_info->lock_partitions, i))
@@ -7390,6 +8367,66 @@ int ha_partition::loop_extra(enum ha_extra_function operation)
 }
 
 
+/**
+  Remember an extra() operation which lasts until reset().
+
+  @param operation  Operation passed to the opened partitions
+
+  @note Only the last of two opposite operations is kept, so that the
+  log stays short however often the statement toggles them.
+*/
+
+void ha_partition::log_extra(enum ha_extra_function operation)
+{
+  enum ha_extra_function opposite;
+  uint i, j;
+  DBUG_ENTER("ha_partition::log_extra");
+
+  switch (operation) {
+  case HA_EXTRA_KEYREAD:
+    opposite= HA_EXTRA_NO_KEYREAD;
+    break;
+  case HA_EXTRA_NO_KEYREAD:
+    opposite= HA_EXTRA_KEYREAD;
+    break;
+  case HA_EXTRA_IGNORE_DUP_KEY:
+    opposite= HA_EXTRA_NO_IGNORE_DUP_KEY;
+    break;
+  case HA_EXTRA_NO_IGNORE_DUP_KEY:
+    opposite= HA_EXTRA_IGNORE_DUP_KEY;
+    break;
+  case HA_EXTRA_NORMAL:
+    opposite= HA_EXTRA_QUICK;
+    break;
+  case HA_EXTRA_QUICK:
+    opposite= HA_EXTRA_NORMAL;
+    break;
+  case HA_EXTRA_WRITE_CACHE:
+    opposite= HA_EXTRA_NO_CACHE;
+    break;
+  case HA_EXTRA_NO_CACHE:
+    opposite= HA_EXTRA_WRITE_CACHE;
+    break;
+  case HA_EXTRA_KEYREAD_PRESERVE_FIELDS:
+  case HA_EXTRA_INSERT_WITH_UPDATE:
+    opposite= operation;
+    break;
+  default:
+    /* Operations acting on the opened handlers only, like flushing */
+    DBUG_VOID_RETURN;
+  }
+  for (i= 0, j= 0; i < m_extra_log_count; i++)
+  {
+    if (m_extra_log[i] != operation && m_extra_log[i] != opposite)
+      m_extra_log[j++]= m_extra_log[i];
+  }
+  DBUG_ASSERT(j < array_elements(m_extra_log));
+  m_extra_log[j]= operation;
+  m_extra_log_count= j + 1;
+  DBUG_VOID_RETURN;
+}
+
+
 /*
   Call extra(HA_EXTRA_CACHE) on next partition_id
 
@@ -7573,7 +8610,11 @@ double ha_partition::scan_time()
   for (i= bitmap_get_first_set(&m_part_info->read_partitions);
        i < m_tot_parts;
        i= bitmap_get_next_set(&m_part_info->read_partitions, i))
-    scan_time+= m_file[i]->scan_time();
+  {
+    /* A partition failing to open reports the error when read */
+    if (!prepare_partition(i))
+      scan_time+= m_file[i]->scan_time();
+  }
   DBUG_RETURN(scan_time);
 }
 
@@ -7603,6 +8644,8 @@ ha_rows ha_partition::records_in_range(uint inx, key_range *min_key,
   while ((part_id= get_biggest_used_partition(&partition_index))
          != NO_CURRENT_PART_ID)
   {
+    if (prepare_partition(part_id))
+      DBUG_RETURN(HA_POS_ERROR);
     rows= m_file[part_id]->records_in_range(inx, min_key, max_key);
       
     DBUG_PRINT("info", ("part %u match %lu rows of %lu", part_id, (ulong) rows,
@@ -7661,6 +8704,8 @@ ha_rows ha_partition::estimate_rows_upper_bound()
   {
     if (bitmap_is_set(&(m_part_info->read_partitions), (file - m_file)))
     {
+      if (prepare_partition((uint) (file - m_file)))
+        DBUG_RETURN(HA_POS_ERROR);
       rows= (*file)->estimate_rows_upper_bound();
       if (rows == HA_POS_ERROR)
         DBUG_RETURN(HA_POS_ERROR);
@@ -7714,6 +8759,8 @@ ha_rows ha_partition::records()
        i < m_tot_parts;
        i= bitmap_get_next_set(&m_part_info->read_partitions, i))
   {
+    if (prepare_partition(i))
+      DBUG_RETURN(HA_POS_ERROR);
     rows= m_file[i]->records();
     if (rows == HA_POS_ERROR)
       DBUG_RETURN(HA_POS_ERROR);
@@ -7743,6 +8790,8 @@ bool ha_partition::can_switch_engines()
   handler **file;
   DBUG_ENTER("ha_partition::can_switch_engines");
  
+  if (open_all_partitions())
+    DBUG_RETURN(FALSE);
   file= m_file;
   do
   {
@@ -7890,6 +8939,8 @@ const char *ha_partition::index_type(uint inx)
     DBUG_RETURN(handler::index_type(inx));
   }
 
+  if (prepare_partition(first_used_partition))
+    first_used_partition= 0;
   DBUG_RETURN(m_file[first_used_partition]->index_type(inx));
 }
 
@@ -7905,6 +8956,9 @@ enum row_type ha_partition::get_row_type() const
   if (i >= m_tot_parts)
     DBUG_RETURN(ROW_TYPE_NOT_USED);
 
+  /* Partitions not opened yet are left out, see open() */
+  if (!bitmap_is_set(&m_opened_partitions, i))
+    i= 0;
   type= m_file[i]->get_row_type();
   DBUG_PRINT("info", ("partition %u, row_type: %d", i, type));
 
@@ -7912,6 +8966,8 @@ enum row_type ha_partition::get_row_type() const
        i < m_tot_parts;
        i= bitmap_get_next_set(&m_part_info->lock_partitions, i))
   {
+    if (!bitmap_is_set(&m_opened_partitions, i))
+      continue;
     enum row_type part_type= m_file[i]->get_row_type();
     DBUG_PRINT("info", ("partition %u, row_type: %d", i, type));
     if (part_type != type)
@@ -8076,11 +9132,13 @@ handler::Table_flags ha_partition::table_flags() const
       m_handler_status >= handler_closed)
     DBUG_RETURN(PARTITION_ENABLED_TABLE_FLAGS);
 
-  if (get_lock_type() != F_UNLCK)
+  if (get_lock_type() != F_UNLCK && !m_lazy_open)
   {
     /*
       The flags are cached after external_lock, and may depend on isolation
       level. So we should use a locked partition to get the correct flags.
+      With lazy open the first partition is always opened, and its flags
+      are refreshed in external_lock().
     */
     first_used_partition= bitmap_get_first_set(&m_part_info->lock_partitions);
     if (first_used_partition == MY_BIT_NONE)
@@ -8122,6 +9180,8 @@ bool ha_partition::check_if_incompatible_data(HA_CREATE_INFO *create_info,
     in mysql_alter_table (by fix_partition_func), so it is only up to
     the underlying handlers.
   */
+  if (open_all_partitions())
+    return COMPATIBLE_DATA_NO;
   for (file= m_file; *file; file++)
     if ((ret=  (*file)->check_if_incompatible_data(create_info,
                                                    table_changes)) !=
@@ -8183,6 +9243,9 @@ ha_partition::check_if_supported_inplace_alter(TABLE *altered_table,
   if (ha_alter_info->alter_info->flags == Alter_info::ALTER_PARTITION)
     DBUG_RETURN(HA_ALTER_INPLACE_NO_LOCK);
 
+  if (open_all_partitions())
+    DBUG_RETURN(HA_ALTER_ERROR);
+
   part_inplace_ctx=
     new (thd->mem_root) ha_partition_inplace_ctx(thd, m_tot_parts);
   if (!part_inplace_ctx)
@@ -8381,8 +9444,10 @@ void ha_partition::notify_table_changed()
 
   DBUG_ENTER("ha_partition::notify_table_changed");
 
+  /* Partitions not opened yet will see the change when opened */
   for (file= m_file; *file; file++)
-    (*file)->ha_notify_table_changed();
+    if (bitmap_is_set(&m_opened_partitions, (uint) (file - m_file)))
+      (*file)->ha_notify_table_changed();
 
   DBUG_VOID_RETURN;
 }
@@ -8543,6 +9608,8 @@ int ha_partition::reset_auto_increment(ulonglong value)
   handler **file= m_file;
   int res;
   DBUG_ENTER("ha_partition::reset_auto_increment");
+  if ((res= open_all_partitions()))
+    DBUG_RETURN(res);
   lock_auto_increment();
   part_share->auto_inc_initialized= false;
   part_share->next_auto_inc_val= 0;
@@ -92,6 +92,12 @@ class Partition_share : public Handler_share
   */
   bool partition_name_hash_initialized;
   HASH partition_name_hash;
+  /**
+    File names of the partitions, as read from the .par file. Kept here
+    so that partitions can be opened on first use, without each TABLE
+    object holding its own copy. Set once, then read-only.
+  */
+  char **partition_file_names;
   /** Storage for each partitions Handler_share */
   Parts_share_refs *partitions_share_refs;
   Partition_share() {}
@@ -103,6 +109,7 @@ class Partition_share : public Handler_share
       my_hash_free(&partition_name_hash);
     if (partitions_share_refs)
       delete partitions_share_refs;
+    my_free(partition_file_names);
     DBUG_VOID_RETURN;
   }
   bool init(uint num_parts);
@@ -119,6 +126,8 @@ class Partition_share : public Handler_share
 
 extern "C" int cmp_key_rowid_part_id(void *ptr, uchar *ref1, uchar *ref2);
 
+class Partition_parallel_scan;
+
 class ha_partition :public handler
 {
 private:
@@ -281,6 +290,31 @@ class ha_partition :public handler
   /** partitions that returned HA_ERR_KEY_NOT_FOUND. */
   MY_BITMAP m_key_not_found_partitions;
   bool m_key_not_found;
+  /**
+    Open partitions on first use and lock them only when used by the
+    statement. See ha_partition::open().
+  */
+  bool m_lazy_open;
+  /** Partitions whose handlers have been opened. */
+  MY_BITMAP m_opened_partitions;
+  /** Table path given to open(), used when opening partitions later. */
+  char *m_table_path;
+  /** The current statement locks partitions on first use. */
+  bool m_lock_on_first_use;
+  /** Lock types of the statement, replayed on partitions locked later. */
+  int m_part_lock_type;
+  enum thr_lock_type m_part_thr_lock_type;
+  /**
+    Statement scoped extra() operations, replayed on partitions opened
+    after they were issued. Cleared in reset().
+  */
+  enum ha_extra_function m_extra_log[8];
+  uint m_extra_log_count;
+  /**
+    Rows of the current full table scan, read by worker threads.
+    NULL if the partitions are scanned by rnd_next(). See rnd_init().
+  */
+  Partition_parallel_scan *m_parallel_scan;
 public:
   Partition_share *get_part_share() { return part_share; }
   handler *clone(const char *name, MEM_ROOT *mem_root);
@@ -394,6 +428,26 @@ class ha_partition :public handler
   void fix_data_dir(char* path);
   bool init_partition_bitmaps();
   void free_partition_bitmaps();
+  bool populate_partition_file_names(const char *name_buffer_ptr);
+  bool can_lock_on_first_use(THD *thd) const;
+  int open_partition(uint part_id);
+  int open_partitions(MY_BITMAP *part_set);
+  int open_all_partitions();
+  int open_and_lock_partition(uint part_id);
+  /**
+    Make sure a partition is opened, and locked if the statement locks
+    partitions on first use, before it is accessed.
+  */
+  int prepare_partition(uint part_id)
+  {
+    if (!m_lazy_open ||
+        (bitmap_is_set(&m_opened_partitions, part_id) &&
+         (!m_lock_on_first_use ||
+          bitmap_is_set(&m_locked_partitions, part_id))))
+      return 0;
+    return open_and_lock_partition(part_id);
+  }
+  int prepare_partitions(MY_BITMAP *part_set);
 
 public:
 
@@ -547,6 +601,12 @@ class ha_partition :public handler
   virtual int rnd_pos_by_record(uchar *record);
   virtual void position(const uchar * record);
 
+private:
+  bool start_parallel_scan();
+  void end_parallel_scan();
+  int parallel_rnd_next(uchar *buf);
+public:
+
   /*
     -------------------------------------------------------------------------
     MODULE index scan
@@ -675,6 +735,7 @@ class ha_partition :public handler
   static const uint NO_CURRENT_PART_ID;
   int loop_extra(enum ha_extra_function operation);
   int loop_extra_alter(enum ha_extra_function operations);
+  void log_extra(enum ha_extra_function operation);
   void late_extra_cache(uint partition_id);
   void late_extra_no_cache(uint partition_id);
   void prepare_extra_cache(uint cachesize);
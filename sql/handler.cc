@@ -2591,6 +2591,42 @@ int handler::ha_rnd_next(uchar *buf)
   DBUG_RETURN(result);
 }
 
+int handler::ha_sample_next(uchar *buf, double fraction, ha_rows *skipped)
+{
+  int result;
+  DBUG_ENTER("handler::ha_sample_next");
+  DBUG_ASSERT(inited == RND);
+  DBUG_ASSERT(fraction > 0.0);
+
+  *skipped= 0;
+  result= sample_next(buf, fraction, skipped);
+  table->status=result ? STATUS_NOT_FOUND: 0;
+  DBUG_RETURN(result);
+}
+
+/**
+  Read the next row of a Bernoulli sample of the table
+
+  The rows are read one after another with ha_rnd_next(), those left out
+  of the sample are only counted.
+*/
+
+int handler::sample_next(uchar *buf, double fraction, ha_rows *skipped)
+{
+  int result;
+  THD *thd= ha_thd();
+
+  while (!(result= ha_rnd_next(buf)) || result == HA_ERR_RECORD_DELETED)
+  {
+    if (result)
+      continue;
+    if (fraction >= 1.0 || my_rnd(&thd->rand) < fraction)
+      break;
+    (*skipped)++;
+  }
+  return result;
+}
+
 int handler::ha_rnd_pos(uchar *buf, uchar *pos)
 {
   int result;
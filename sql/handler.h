@@ -250,6 +250,16 @@ enum enum_alter_inplace_result {
  */
 #define HA_CAN_EXPORT                 (1LL << 45)
 
+/*
+  A table scan (rnd_init(1), ha_parallel_rnd_next(), position(), rnd_end()
+  and extra(HA_EXTRA_CACHE)) may be done by a thread other than the one
+  running the statement, while other handlers of the same statement are
+  used. The engine must not use the THD of the handler for it, and the
+  rows read must not point into buffers of the handler, except for blobs.
+  Used by ha_partition to scan several partitions at the same time.
+*/
+#define HA_CAN_PARALLEL_SCAN          (1LL << 46)
+
 
 /*
   Set of all binlog flags. Currently only contain the capabilities
@@ -3095,11 +3105,34 @@ class handler :public Sql_alloc
     return rnd_pos(record, ref);
   }
   virtual int read_first_row(uchar *buf, uint primary_key);
+protected:
+  virtual int sample_next(uchar *buf, double fraction, ha_rows *skipped);
 public:
 
   /* Same as above, but with statistics */
   inline int ha_ft_read(uchar *buf);
   int ha_rnd_next(uchar *buf);
+  /**
+    Same as ha_rnd_next(), without updating the statistics of the
+    connection. Used from other threads, see HA_CAN_PARALLEL_SCAN.
+  */
+  int ha_parallel_rnd_next(uchar *buf)
+  {
+    int result;
+    DBUG_ASSERT(inited == RND);
+    if (!(result= rnd_next(buf)))
+      update_rows_read();
+    return result;
+  }
+  /**
+    Read the next row of a random sample of the table, for ANALYZE TABLE.
+    Used in place of ha_rnd_next() after ha_rnd_init(TRUE): every row is
+    returned with the probability 'fraction'. *skipped is set to the
+    number of rows passed over before the returned row, or before the end
+    of the table. The default implementation reads all the rows, engines
+    that can position on a row skip the others without reading them.
+  */
+  int ha_sample_next(uchar *buf, double fraction, ha_rows *skipped);
   int ha_rnd_pos(uchar *buf, uchar *pos);
   inline int ha_rnd_pos_by_record(uchar *buf);
   inline int ha_read_first_row(uchar *buf, uint primary_key);
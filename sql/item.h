@@ -59,6 +59,7 @@ struct TABLE_LIST;
 void item_init(void);			/* Init item functions */
 class Item_field;
 class user_var_entry;
+class Batch_predicate;
 
 
 static inline uint32
@@ -1640,6 +1641,13 @@ class Item {
       is_expensive_cache= walk(&Item::is_expensive_processor, 0, (uchar*)0);
     return MY_TEST(is_expensive_cache);
   }
+  /**
+    Return an object that evaluates this predicate over a batch of rows
+    of 'table' (see sql_batch.h), or NULL if the predicate can only be
+    evaluated one row at a time.
+  */
+  virtual Batch_predicate *get_batch_predicate(THD *thd, TABLE *table)
+  { return NULL; }
   virtual Field::geometry_type get_geometry_type() const
     { return Field::GEOM_GEOMETRY; };
   String *check_well_formed_result(String *str, bool send_error= 0);
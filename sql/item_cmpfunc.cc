@@ -33,6 +33,7 @@
 #include "sql_parse.h"                          // check_stack_overrun
 #include "sql_time.h"                  // make_truncated_value_warning
 #include "sql_base.h"                  // dynamic_column_error_message
+#include "sql_batch.h"                 // Batch_compare
 
 static Item_result item_store_type(Item_result a, Item *item,
                                    my_bool unsigned_flag)
@@ -2262,6 +2263,13 @@ void Item_func_between::fix_after_pullout(st_select_lex *new_parent, Item **ref)
   eval_not_null_tables(NULL);
 }
 
+
+Batch_predicate *Item_func_between::get_batch_predicate(THD *thd,
+                                                        TABLE *table)
+{
+  return Batch_between::create(thd, table, this);
+}
+
 void Item_func_between::fix_length_and_dec()
 {
   THD *thd= current_thd;
@@ -3497,8 +3505,22 @@ static int cmp_decimal(void *cmp_arg, my_decimal *a, my_decimal *b)
 int in_vector::find(Item *item)
 {
   uchar *result=get_value(item);
-  if (!result || !used_count)
+  if (!result)
     return 0;				// Null value
+  return find_value(result);
+}
+
+
+/**
+  Binary search for a value in the sorted vector.
+
+  @param result  value in the format returned by get_value()
+*/
+
+int in_vector::find_value(const uchar *result)
+{
+  if (!used_count)
+    return 0;
 
   uint start,end;
   start=0; end=used_count-1;
@@ -3979,6 +4001,12 @@ void Item_func_in::fix_after_pullout(st_select_lex *new_parent, Item **ref)
   eval_not_null_tables(NULL);
 }
 
+
+Batch_predicate *Item_func_in::get_batch_predicate(THD *thd, TABLE *table)
+{
+  return Batch_in::create(thd, table, this);
+}
+
 static int srtcmp_in(CHARSET_INFO *cs, const String *x,const String *y)
 {
   return cs->coll->strnncollsp(cs,
@@ -5702,6 +5730,18 @@ Item *Item_bool_rowready_func2::negated_item()
 }
 
 
+Batch_predicate *Item_bool_rowready_func2::get_batch_predicate(THD *thd,
+                                                               TABLE *table)
+{
+  /* NULL-safe equality has its own comparison functions */
+  if (functype() == EQUAL_FUNC)
+    return NULL;
+  return Batch_compare::create(thd, table, functype(), cmp.compare_func(),
+                               cmp.cmp_collation.collation,
+                               cmp.get_arg(0), cmp.get_arg(1));
+}
+
+
 /**
   Construct a minimal multiple equality item
 
@@ -79,6 +79,8 @@ class Arg_comparator: public Sql_alloc
                                       (*a2)->cmp_type()));
   }
   inline int compare() { return (this->*func)(); }
+  arg_cmp_func compare_func() const { return func; }
+  Item *get_arg(uint n) const { return n ? *b : *a; }
 
   int compare_string();		 // compare args[0] & args[1]
   int compare_binary_string();	 // compare args[0] & args[1]
@@ -418,6 +420,7 @@ class Item_bool_rowready_func2 :public Item_bool_func2
   {
     return (*arg != NULL);     
   }
+  Batch_predicate *get_batch_predicate(THD *thd, TABLE *table);
 };
 
 /**
@@ -692,6 +695,7 @@ class Item_func_between :public Item_func_opt_neg
   bool eval_not_null_tables(uchar *opt_arg);
   void fix_after_pullout(st_select_lex *new_parent, Item **ref);
   bool count_sargable_conds(uchar *arg);
+  Batch_predicate *get_batch_predicate(THD *thd, TABLE *table);
 };
 
 
@@ -884,6 +888,7 @@ class in_vector :public Sql_alloc
     my_qsort2(base,used_count,size,compare,(void*)collation);
   }
   int find(Item *item);
+  int find_value(const uchar *value);
   
   /* 
     Create an instance of Item_{type} (e.g. Item_decimal) constant object
@@ -964,6 +969,12 @@ class in_longlong :public in_vector
   in_longlong(uint elements);
   void set(uint pos,Item *item);
   uchar *get_value(Item *item);
+  int find_longlong(longlong val, bool unsigned_flag)
+  {
+    tmp.val= val;
+    tmp.unsigned_flag= unsigned_flag;
+    return find_value((uchar*) &tmp);
+  }
   
   Item* create_item()
   { 
@@ -1375,6 +1386,7 @@ class Item_func_in :public Item_func_opt_neg
   CHARSET_INFO *compare_collation() { return cmp_collation.collation; }
   bool eval_not_null_tables(uchar *opt_arg);
   void fix_after_pullout(st_select_lex *new_parent, Item **ref);
+  Batch_predicate *get_batch_predicate(THD *thd, TABLE *table);
 };
 
 class cmp_item_row :public cmp_item
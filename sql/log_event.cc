@@ -3615,7 +3615,7 @@ Query_log_event::Query_log_event(const char* buf, uint event_len,
   q_len= data_len - db_len -1;
   /**
     Append the db length at the end of the buffer. This will be used by
-    Query_cache::send_result_to_client() in case the query cache is On.
+    Query_cache_instances::send_result_to_client() in case the query cache is On.
    */
 #if !defined(MYSQL_CLIENT) && defined(HAVE_QUERY_CACHE)
   size_t db_length= (size_t)db_len;
@@ -9240,7 +9240,7 @@ Rows_log_event::Rows_log_event(THD *thd_arg, TABLE *tbl_arg, ulong tid,
     m_type(event_type), m_extra_row_data(0)
 #ifdef HAVE_REPLICATION
     , m_curr_row(NULL), m_curr_row_end(NULL),
-    m_key(NULL), m_key_info(NULL), m_key_nr(0),
+    m_key(NULL), m_key_info(NULL), m_key_nr(0), m_hash_rows(NULL),
     master_had_triggers(0)
 #endif
 {
@@ -9290,7 +9290,7 @@ Rows_log_event::Rows_log_event(const char *buf, uint event_len,
     m_extra_row_data(0)
 #if !defined(MYSQL_CLIENT) && defined(HAVE_REPLICATION)
     , m_curr_row(NULL), m_curr_row_end(NULL),
-    m_key(NULL), m_key_info(NULL), m_key_nr(0),
+    m_key(NULL), m_key_info(NULL), m_key_nr(0), m_hash_rows(NULL),
     master_had_triggers(0)
 #endif
 {
@@ -9888,6 +9888,9 @@ int Rows_log_event::do_apply_event(rpl_group_info *rgi)
     rgi->set_row_stmt_start_timestamp();
 
     THD_STAGE_INFO(thd, stage_executing);
+    if (error == 0 && m_hash_rows)
+      error= hash_scan_rows(rgi);
+
     while (error == 0 && m_curr_row < m_rows_end)
     {
       /* in_use can have been set to NULL in close_tables_for_reopen */
@@ -11735,8 +11738,12 @@ int Rows_log_event::find_key()
     }
     /*
       We can only use a non-unique key if it allows range scans (ie. skip
-      FULLTEXT indexes and such).
+      FULLTEXT indexes and such), and if INDEX_SCAN is enabled in
+      @@slave_rows_search_algorithms.
     */
+    if (!(slave_rows_search_algorithms_options &
+          (1ULL << SLAVE_ROWS_INDEX_SCAN)))
+      continue;
     last_part= key->user_defined_key_parts - 1;
     DBUG_PRINT("info", ("Index %s rec_per_key[%u]= %lu",
                         key->name, last_part, key->rec_per_key[last_part]));
@@ -11769,6 +11776,35 @@ int Rows_log_event::find_key()
 }
 
 
+/**
+  Set up m_hash_rows if the rows of the event are to be looked up with
+  hash_scan_rows().
+
+  This is done if HASH_SCAN is enabled in @@slave_rows_search_algorithms
+  and the rows can not be fetched by position or through a unique key
+  over NOT NULL columns.
+
+  @returns Error code on failure, 0 on success.
+*/
+int Rows_log_event::init_hash_scan()
+{
+  DBUG_ASSERT(m_table);
+  if (!(slave_rows_search_algorithms_options &
+        (1ULL << SLAVE_ROWS_HASH_SCAN)))
+    return 0;
+  if ((m_table->file->ha_table_flags() & HA_PRIMARY_KEY_REQUIRED_FOR_POSITION) &&
+      m_table->s->primary_key < MAX_KEY)
+    return 0;
+  if (m_key_info &&
+      (m_key_info->flags & (HA_NOSAME | HA_NULL_PART_KEY)) == HA_NOSAME)
+    return 0;
+
+  if (!(m_hash_rows= new Hash_slave_rows()) || m_hash_rows->init(m_table))
+    return HA_ERR_OUT_OF_MEM;
+  return 0;
+}
+
+
 /* 
   Check if we are already spending too much time on this statement.
   if we are, warn user that it might be because table does not have
@@ -11925,6 +11961,34 @@ int Rows_log_event::find_row(rpl_group_info *rgi)
    */ 
   store_record(table,record[1]);    
 
+  if (m_hash_rows)
+  {
+    uchar *ref= (uchar *) m_hash_rows->position(m_curr_row);
+    if (ref)
+    {
+      DBUG_PRINT("info",("locating record found by hash scan (rnd_pos)"));
+      if (!table->file->inited &&
+          (error= table->file->ha_rnd_init_with_error(0)))
+        goto end;
+      error= table->file->ha_rnd_pos(table->record[0], ref);
+      if (!error && !record_compare(table))
+        goto end;
+      table->file->ha_rnd_end();
+      if (error && error != HA_ERR_RECORD_DELETED &&
+          error != HA_ERR_KEY_NOT_FOUND)
+      {
+        table->file->print_error(error, MYF(0));
+        goto end;
+      }
+      restore_record(table,record[1]);
+    }
+    /*
+      The hash scan did not find the row, or it has been changed by an
+      earlier row of the event since: search for it as below.
+    */
+    error= 0;
+  }
+
   if (m_key_info)
   {
     DBUG_PRINT("info",("locating record using key #%u [%s] (index_read)",
@@ -12125,6 +12189,152 @@ int Rows_log_event::find_row(rpl_group_info *rgi)
   DBUG_RETURN(error);
 }
 
+
+/**
+  Check if the row in @c m_table->record[0] is one of the rows of the
+  event that have not been found yet, and if so remember its position.
+
+  @returns Error code on failure, 0 on success.
+*/
+
+int Rows_log_event::hash_match_row()
+{
+  TABLE *table= m_table;
+  HASH_SEARCH_STATE state;
+  ulong hash= Hash_slave_rows::hash_record(table);
+
+  for (Hash_slave_rows::Entry *entry= m_hash_rows->first_match(hash, &state);
+       entry;
+       entry= m_hash_rows->next_match(hash, &state))
+  {
+    memcpy(table->record[1], entry->record, table->s->reclength);
+    if (!record_compare(table))
+    {
+      table->file->position(table->record[0]);
+      if (m_hash_rows->set_matched(entry, table->file->ref))
+        return HA_ERR_OUT_OF_MEM;
+      break;
+    }
+  }
+  return 0;
+}
+
+
+/**
+  Locate all rows of the event with a single scan.
+
+  The before images of the rows are unpacked and hashed in @c
+  m_hash_rows. The table is then scanned once, or if @c m_key_info is
+  set, the index is read for each key value of the before images, and
+  the position of the row that matches each before image is
+  remembered. When the event is applied, find_row() fetches the rows
+  by these positions, instead of scanning the table for each of them.
+
+  Rows that are not found here are searched by find_row() as usual, so
+  errors for missing rows are reported as without the hash scan.
+
+  @returns Error code on failure, 0 on success.
+*/
+
+int Rows_log_event::hash_scan_rows(rpl_group_info *rgi)
+{
+  TABLE *table= m_table;
+  handler *file= table->file;
+  const uchar *saved_row= m_curr_row, *saved_row_end= m_curr_row_end;
+  int error= 0;
+  DBUG_ENTER("Rows_log_event::hash_scan_rows");
+
+  table->use_all_columns();
+
+  while (m_curr_row < m_rows_end)
+  {
+    prepare_record(table, m_width, FALSE);
+    if ((error= unpack_current_row(rgi)))
+      goto end;
+    if (m_hash_rows->add(m_curr_row))
+    {
+      error= HA_ERR_OUT_OF_MEM;
+      goto end;
+    }
+    m_curr_row= m_curr_row_end;
+
+    /* Skip the after image */
+    if (get_general_type_code() == UPDATE_ROWS_EVENT)
+    {
+      if ((error= unpack_current_row(rgi)))
+        goto end;
+      m_curr_row= m_curr_row_end;
+    }
+  }
+
+  if (m_key_info)
+  {
+    DBUG_PRINT("info",("hash scan using key #%u [%s]",
+                       m_key_nr, m_key_info->name));
+    if ((error= file->ha_index_init(m_key_nr, FALSE)))
+      goto end;
+
+    for (uint i= 0; i < m_hash_rows->elements() && m_hash_rows->unmatched();
+         i++)
+    {
+      Hash_slave_rows::Entry *entry= m_hash_rows->entry(i);
+      if (entry->ref)
+        continue;               /* Found by the lookup of an earlier row */
+
+      memcpy(table->record[0], entry->record, table->s->reclength);
+      key_copy(m_key, table->record[0], m_key_info, 0);
+      /* See find_row() */
+      if (table->s->null_bytes > 0)
+        table->record[0][table->s->null_bytes - 1]|=
+          256U - (1U << table->s->last_null_bit_pos);
+
+      error= file->ha_index_read_map(table->record[0], m_key, HA_WHOLE_KEY,
+                                     HA_READ_KEY_EXACT);
+      while (!error || error == HA_ERR_RECORD_DELETED)
+      {
+        if (!error && (error= hash_match_row()))
+          break;
+        error= file->ha_index_next_same(table->record[0], m_key,
+                                        m_key_info->key_length);
+      }
+      if (error != HA_ERR_KEY_NOT_FOUND && error != HA_ERR_END_OF_FILE)
+        goto end;
+      error= 0;
+    }
+  }
+  else
+  {
+    DBUG_PRINT("info",("hash scan using table scan"));
+    if ((error= file->ha_rnd_init_with_error(1)))
+      goto end;
+
+    while (m_hash_rows->unmatched())
+    {
+      if ((error= file->ha_rnd_next(table->record[0])))
+      {
+        if (error == HA_ERR_RECORD_DELETED)
+          continue;
+        break;
+      }
+      if ((error= hash_match_row()))
+        break;
+    }
+    if (error == HA_ERR_END_OF_FILE)
+      error= 0;
+  }
+
+end:
+  if (error)
+    file->print_error(error, MYF(0));
+  file->ha_index_or_rnd_end();
+  issue_long_find_row_warning(get_general_type_code(), m_table->alias.c_ptr(),
+                              m_key_info != NULL, rgi);
+  table->default_column_bitmaps();
+  m_curr_row= saved_row;
+  m_curr_row_end= saved_row_end;
+  DBUG_RETURN(error);
+}
+
 #endif
 
 /*
@@ -12174,7 +12384,10 @@ Delete_rows_log_event::do_before_row_operations(const Slave_reporting_capability
   if (slave_run_triggers_for_rbr && !master_had_triggers)
     m_table->prepare_triggers_for_delete_stmt_or_event();
 
-  return find_key();
+  int err;
+  if ((err= find_key()))
+    return err;
+  return init_hash_scan();
 }
 
 int 
@@ -12186,6 +12399,8 @@ Delete_rows_log_event::do_after_row_operations(const Slave_reporting_capability
   my_free(m_key);
   m_key= NULL;
   m_key_info= NULL;
+  delete m_hash_rows;
+  m_hash_rows= NULL;
 
   return error;
 }
@@ -12332,7 +12547,7 @@ Update_rows_log_event::do_before_row_operations(const Slave_reporting_capability
     status_var_increment(thd->status_var.com_stat[SQLCOM_UPDATE]);
 
   int err;
-  if ((err= find_key()))
+  if ((err= find_key()) || (err= init_hash_scan()))
     return err;
 
   if (slave_run_triggers_for_rbr && !master_had_triggers)
@@ -12350,6 +12565,8 @@ Update_rows_log_event::do_after_row_operations(const Slave_reporting_capability
   my_free(m_key); // Free for multi_malloc
   m_key= NULL;
   m_key_info= NULL;
+  delete m_hash_rows;
+  m_hash_rows= NULL;
 
   return error;
 }
@@ -53,6 +53,7 @@
 
 /* Forward declarations */
 class String;
+class Hash_slave_rows;
 
 #define PREFIX_SQL_LOAD "SQL_LOAD-"
 #define LONG_FIND_ROW_THRESHOLD 60 /* seconds */
@@ -4354,9 +4355,13 @@ class Rows_log_event : public Log_event
   uchar    *m_key;      /* Buffer to keep key value during searches */
   KEY      *m_key_info; /* Pointer to KEY info for m_key_nr */
   uint      m_key_nr;   /* Key number */
+  Hash_slave_rows *m_hash_rows; /* Rows found by hash_scan_rows(), or NULL */
   bool master_had_triggers;     /* set after tables opening */
 
   int find_key(); // Find a best key to use in find_row()
+  int init_hash_scan();
+  int hash_scan_rows(rpl_group_info *);
+  int hash_match_row();
   int find_row(rpl_group_info *);
   int write_row(rpl_group_info *, const bool);
 
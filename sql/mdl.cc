@@ -127,9 +127,12 @@ class MDL_map_partition
   MDL_map_partition();
   ~MDL_map_partition();
   inline MDL_lock *find_or_insert(const MDL_key *mdl_key);
+  inline MDL_lock *fast_path_acquire(const MDL_key *mdl_key,
+                                     enum_mdl_type type);
   unsigned long get_lock_owner(const MDL_key *key);
   inline void remove(MDL_lock *lock);
 private:
+  MDL_lock *find_or_create(const MDL_key *mdl_key);
   bool move_from_hash_to_lock_mutex(MDL_lock *lock);
   /** A partition of all acquired locks in the server. */
   HASH m_locks;
@@ -154,7 +157,8 @@ class MDL_map_partition
                    I_P_List_counter>
           Lock_cache;
   Lock_cache m_unused_locks_cache;
-  friend int mdl_iterate(int (*)(MDL_ticket *, void *), void *);
+  friend int mdl_iterate(int (*)(MDL_ticket *, void *), void *,
+                         mdl_iterate_fast_path_callback);
 };
 
 
@@ -175,6 +179,7 @@ class MDL_map
   void init();
   void destroy();
   MDL_lock *find_or_insert(const MDL_key *key);
+  MDL_lock *fast_path_acquire(const MDL_key *key, enum_mdl_type type);
   unsigned long get_lock_owner(const MDL_key *key);
   void remove(MDL_lock *lock);
 private:
@@ -184,7 +189,8 @@ class MDL_map
   MDL_lock *m_global_lock;
   /** Pre-allocated MDL_lock object for COMMIT namespace. */
   MDL_lock *m_commit_lock;
-  friend int mdl_iterate(int (*)(MDL_ticket *, void *), void *);
+  friend int mdl_iterate(int (*)(MDL_ticket *, void *), void *,
+                         mdl_iterate_fast_path_callback);
 };
 
 
@@ -348,6 +354,24 @@ class MDL_lock
 {
 public:
   typedef unsigned short bitmap_t;
+  typedef int64 fast_path_state_t;
+
+  /**
+    Layout of m_fast_path_state: up to three 20-bit counters of granted
+    unobtrusive locks, the increments for which are given by
+    unobtrusive_lock_increment(), and the HAS_OBTRUSIVE flag.
+  */
+  static const int FAST_PATH_COUNTER_BITS= 20;
+  static const fast_path_state_t FAST_PATH_COUNTER_MASK=
+    (1LL << FAST_PATH_COUNTER_BITS) - 1;
+  static const fast_path_state_t FAST_PATH_COUNTERS=
+    (1LL << (3 * FAST_PATH_COUNTER_BITS)) - 1;
+  /**
+    Set while there are obtrusive tickets in m_granted or m_waiting.
+    Unobtrusive locks can't be granted using the fast path then.
+  */
+  static const fast_path_state_t HAS_OBTRUSIVE=
+    1LL << (3 * FAST_PATH_COUNTER_BITS);
 
   class Ticket_list
   {
@@ -420,8 +444,37 @@ class MDL_lock
     return (m_granted.is_empty() && m_waiting.is_empty());
   }
 
+  /** No tickets, including ones granted using the fast path, use the lock. */
+  bool is_unused()
+  {
+    return is_empty() && !my_atomic_load64(&m_fast_path_state) &&
+           !my_atomic_load32(&m_cache_refs);
+  }
+
   virtual const bitmap_t *incompatible_granted_types_bitmap() const = 0;
   virtual const bitmap_t *incompatible_waiting_types_bitmap() const = 0;
+  virtual const fast_path_state_t *unobtrusive_lock_increment() const = 0;
+
+  /**
+    Obtrusive locks are the ones which conflict with some of the lock
+    types which can be granted using the fast path. They are always
+    granted using m_granted/m_waiting lists.
+  */
+  bool is_obtrusive_lock(enum_mdl_type type) const
+  {
+    return unobtrusive_lock_increment()[type] == 0;
+  }
+
+  inline static fast_path_state_t
+  get_unobtrusive_lock_increment(const MDL_request *request);
+  bool fast_path_acquire(enum_mdl_type type);
+  void fast_path_release(enum_mdl_type type, bool cached);
+  void fast_path_release_slow(enum_mdl_type type);
+  bitmap_t fast_path_granted_bitmap() const;
+  void cache_ref() { my_atomic_add32(&m_cache_refs, 1); }
+  void cache_unref();
+  void add_obtrusive_ticket(enum_mdl_type type);
+  void remove_obtrusive_ticket(enum_mdl_type type);
 
   bool has_pending_conflicting_lock(enum_mdl_type type);
 
@@ -456,11 +509,41 @@ class MDL_lock
   */
   ulong m_hog_lock_count;
 
+  /**
+    State of unobtrusive locks granted using the fast path, see
+    FAST_PATH_COUNTER_BITS. Such locks are granted and released with a
+    single atomic operation on this member without taking m_rwlock or
+    adding tickets to m_granted, as long as HAS_OBTRUSIVE is not set.
+
+    Counters are only incremented while the lock can't be removed from
+    MDL_map, i.e. under MDL_map_partition::m_mutex, while holding
+    another ticket for the lock or while m_cache_refs is non-zero.
+  */
+  volatile fast_path_state_t m_fast_path_state;
+
+  /**
+    Number of tickets of obtrusive types in m_granted and m_waiting.
+    HAS_OBTRUSIVE is set in m_fast_path_state iff it is non-zero.
+    Protected by m_rwlock.
+  */
+  uint m_obtrusive_locks_granted_waiting_count;
+
+  /**
+    Number of MDL_context::m_fast_path_cache entries referencing the
+    object. The object is not removed from MDL_map while it is non-zero.
+    Incremented only while holding a ticket for the lock, decremented
+    under m_rwlock.
+  */
+  volatile int32 m_cache_refs;
+
 public:
 
   MDL_lock(const MDL_key *key_arg, MDL_map_partition *map_part)
   : key(key_arg),
     m_hog_lock_count(0),
+    m_fast_path_state(0),
+    m_obtrusive_locks_granted_waiting_count(0),
+    m_cache_refs(0),
     m_ref_usage(0),
     m_ref_release(0),
     m_is_destroyed(FALSE),
@@ -544,6 +627,10 @@ class MDL_scoped_lock : public MDL_lock
   {
     return m_waiting_incompatible;
   }
+  virtual const fast_path_state_t *unobtrusive_lock_increment() const
+  {
+    return m_unobtrusive_lock_increment;
+  }
   virtual bool needs_notification(const MDL_ticket *ticket) const
   {
     return (ticket->get_type() == MDL_SHARED);
@@ -562,6 +649,8 @@ class MDL_scoped_lock : public MDL_lock
 private:
   static const bitmap_t m_granted_incompatible[MDL_TYPE_END];
   static const bitmap_t m_waiting_incompatible[MDL_TYPE_END];
+public:
+  static const fast_path_state_t m_unobtrusive_lock_increment[MDL_TYPE_END];
 };
 
 
@@ -587,6 +676,8 @@ class MDL_object_lock : public MDL_lock
     key.mdl_key_init(new_key);
     /* m_granted and m_waiting should be already in the empty/initial state. */
     DBUG_ASSERT(is_empty());
+    DBUG_ASSERT(!m_fast_path_state && !m_obtrusive_locks_granted_waiting_count &&
+                !m_cache_refs);
     /* Object should not be marked as destroyed. */
     DBUG_ASSERT(! m_is_destroyed);
     /*
@@ -605,6 +696,10 @@ class MDL_object_lock : public MDL_lock
   {
     return m_waiting_incompatible;
   }
+  virtual const fast_path_state_t *unobtrusive_lock_increment() const
+  {
+    return m_unobtrusive_lock_increment;
+  }
   virtual bool needs_notification(const MDL_ticket *ticket) const
   {
     return (ticket->get_type() >= MDL_SHARED_NO_WRITE);
@@ -626,6 +721,8 @@ class MDL_object_lock : public MDL_lock
 private:
   static const bitmap_t m_granted_incompatible[MDL_TYPE_END];
   static const bitmap_t m_waiting_incompatible[MDL_TYPE_END];
+public:
+  static const fast_path_state_t m_unobtrusive_lock_increment[MDL_TYPE_END];
 
 public:
   /** Members for linking the object into the list of unused objects. */
@@ -643,6 +740,28 @@ class MDL_object_lock_cache_adapter :
 };
 
 
+/**
+  Get the increment of MDL_lock::m_fast_path_state for a lock request,
+  before the MDL_lock object is looked up. Zero for obtrusive locks.
+
+  @sa MDL_lock::create()
+*/
+
+inline MDL_lock::fast_path_state_t
+MDL_lock::get_unobtrusive_lock_increment(const MDL_request *request)
+{
+  switch (request->key.mdl_namespace())
+  {
+    case MDL_key::GLOBAL:
+    case MDL_key::SCHEMA:
+    case MDL_key::COMMIT:
+      return MDL_scoped_lock::m_unobtrusive_lock_increment[request->type];
+    default:
+      return MDL_object_lock::m_unobtrusive_lock_increment[request->type];
+  }
+}
+
+
 static MDL_map mdl_locks;
 /**
   Start-up parameter for the maximum size of the unused MDL_lock objects cache.
@@ -706,6 +825,8 @@ void mdl_destroy()
 
 static inline int mdl_iterate_lock(MDL_lock *lock,
                                    int (*callback)(MDL_ticket *ticket, void *arg),
+                                   mdl_iterate_fast_path_callback
+                                   fast_path_callback,
                                    void *arg)
 {
   MDL_lock::Ticket_iterator ticket_it(lock->m_granted);
@@ -713,20 +834,57 @@ static inline int mdl_iterate_lock(MDL_lock *lock,
   int res= 0;
   mysql_prlock_rdlock(&lock->m_rwlock);
   while ((ticket= ticket_it++) && !(res= callback(ticket, arg))) /* no-op */;
+  if (!res && fast_path_callback)
+  {
+    /*
+      Holding m_rwlock ensures that no lock is moved from the counters
+      to m_granted meanwhile, i.e. reported twice.
+    */
+    MDL_lock::fast_path_state_t state=
+      my_atomic_load64(&lock->m_fast_path_state);
+    const MDL_lock::fast_path_state_t *increment=
+      lock->unobtrusive_lock_increment();
+    for (uint type= 0; type < MDL_TYPE_END && !res; type++)
+    {
+      uint count;
+      /* Types sharing a counter are reported as the first of them. */
+      if (!increment[type] || (type && increment[type - 1] == increment[type]))
+        continue;
+      if ((count= (uint) ((state / increment[type]) &
+                          MDL_lock::FAST_PATH_COUNTER_MASK)))
+        res= fast_path_callback(&lock->key, (enum_mdl_type) type, count, arg);
+    }
+  }
   mysql_prlock_unlock(&lock->m_rwlock);
   return res;
 }
 
 
-int mdl_iterate(int (*callback)(MDL_ticket *ticket, void *arg), void *arg)
+/**
+  Call a function for each granted lock.
+
+  @param callback            Called for each ticket in MDL_lock::m_granted.
+  @param arg                 Argument passed to the callbacks.
+  @param fast_path_callback  If not NULL, called for each lock type granted
+                             using the fast path, with the number of such
+                             locks. Their owners are unknown. Locks of the
+                             calling context are reported so unless
+                             MDL_context::materialize_fast_path_locks() was
+                             called before.
+*/
+
+int mdl_iterate(int (*callback)(MDL_ticket *ticket, void *arg), void *arg,
+                mdl_iterate_fast_path_callback fast_path_callback)
 {
   DYNAMIC_ARRAY locks;
   uint i, j;
   int res;
   DBUG_ENTER("mdl_iterate");
 
-  if ((res= mdl_iterate_lock(mdl_locks.m_global_lock, callback, arg)) ||
-      (res= mdl_iterate_lock(mdl_locks.m_commit_lock, callback, arg)))
+  if ((res= mdl_iterate_lock(mdl_locks.m_global_lock, callback,
+                             fast_path_callback, arg)) ||
+      (res= mdl_iterate_lock(mdl_locks.m_commit_lock, callback,
+                             fast_path_callback, arg)))
     DBUG_RETURN(res);
 
   my_init_dynamic_array(&locks, sizeof(MDL_lock*), 512, 1, MYF(0));
@@ -755,7 +913,7 @@ int mdl_iterate(int (*callback)(MDL_ticket *ticket, void *arg), void *arg)
     for (j= 0; j < locks.elements; j++)
     {
       MDL_lock *lock= (MDL_lock*) *dynamic_element(&locks, j, MDL_lock**);
-      res= mdl_iterate_lock(lock, callback, arg);
+      res= mdl_iterate_lock(lock, callback, fast_path_callback, arg);
 
       mysql_prlock_wrlock(&lock->m_rwlock);
       uint ref_usage= lock->m_ref_usage;
@@ -903,6 +1061,34 @@ MDL_lock* MDL_map_partition::find_or_insert(const MDL_key *mdl_key)
 
 retry:
   mysql_mutex_lock(&m_mutex);
+  if (!(lock= find_or_create(mdl_key)))
+  {
+    mysql_mutex_unlock(&m_mutex);
+    return NULL;
+  }
+
+  if (move_from_hash_to_lock_mutex(lock))
+    goto retry;
+
+  return lock;
+}
+
+
+/**
+  Find MDL_lock object corresponding to the key in MDL_map partition,
+  create it if it does not exist.
+
+  @pre MDL_map_partition::m_mutex is locked.
+
+  @retval non-NULL - Success.
+  @retval NULL     - Failure (OOM).
+*/
+
+MDL_lock* MDL_map_partition::find_or_create(const MDL_key *mdl_key)
+{
+  MDL_lock *lock;
+
+  mysql_mutex_assert_owner(&m_mutex);
   if (!(lock= (MDL_lock*) my_hash_search_using_hash_value(&m_locks,
                                                           mdl_key->hash_value(),
                                                           mdl_key->ptr(),
@@ -950,14 +1136,66 @@ MDL_lock* MDL_map_partition::find_or_insert(const MDL_key *mdl_key)
       {
         MDL_lock::destroy(lock);
       }
-      mysql_mutex_unlock(&m_mutex);
       return NULL;
     }
   }
+  return lock;
+}
+
+
+/**
+  Find MDL_lock object corresponding to the key, create it
+  if it does not exist, and try to grant an unobtrusive lock
+  on it using the fast path.
+
+  @retval non-NULL - Success. The lock was granted using the fast
+                     path, MDL_lock::m_rwlock is not locked.
+  @retval NULL     - The lock has to be acquired using the slow path
+                     (obtrusive locks are granted or pending, or OOM).
+*/
+
+MDL_lock* MDL_map::fast_path_acquire(const MDL_key *mdl_key,
+                                     enum_mdl_type type)
+{
+  MDL_lock *lock;
+
+  if (mdl_key->mdl_namespace() == MDL_key::GLOBAL ||
+      mdl_key->mdl_namespace() == MDL_key::COMMIT)
+  {
+    /* Pre-allocated objects are never destroyed, no need for m_mutex. */
+    lock= (mdl_key->mdl_namespace() == MDL_key::GLOBAL) ? m_global_lock :
+                                                          m_commit_lock;
+    return lock->fast_path_acquire(type) ? lock : NULL;
+  }
+
+  uint part_id= mdl_key->hash_value() % mdl_locks_hash_partitions;
+  MDL_map_partition *part= m_partitions.at(part_id);
+
+  return part->fast_path_acquire(mdl_key, type);
+}
 
-  if (move_from_hash_to_lock_mutex(lock))
-    goto retry;
 
+/**
+  Find MDL_lock object in MDL_map partition, create it if it does not
+  exist, and try to grant an unobtrusive lock on it using the fast path.
+
+  @sa MDL_map::fast_path_acquire()
+*/
+
+MDL_lock* MDL_map_partition::fast_path_acquire(const MDL_key *mdl_key,
+                                               enum_mdl_type type)
+{
+  MDL_lock *lock;
+
+  /*
+    The object can't be removed from the hash while we hold m_mutex,
+    and once its fast path counters are incremented it won't be removed
+    until the lock is released (see MDL_map_partition::remove()).
+  */
+  mysql_mutex_lock(&m_mutex);
+  if ((lock= find_or_create(mdl_key)) && !lock->fast_path_acquire(type))
+    lock= NULL;
+  mysql_mutex_unlock(&m_mutex);
   return lock;
 }
 
@@ -1116,6 +1354,19 @@ void MDL_map::remove(MDL_lock *lock)
 void MDL_map_partition::remove(MDL_lock *lock)
 {
   mysql_mutex_lock(&m_mutex);
+  if (my_atomic_load64(&lock->m_fast_path_state) ||
+      my_atomic_load32(&lock->m_cache_refs))
+  {
+    /*
+      Some lock was granted using the fast path after the caller found
+      the object unused, and possibly cached by its owner. Whoever
+      releases the last such lock or reference will try to remove the
+      object again.
+    */
+    mysql_mutex_unlock(&m_mutex);
+    mysql_prlock_unlock(&lock->m_rwlock);
+    return;
+  }
   my_hash_delete(&m_locks, (uchar*) lock);
   /*
     To let threads holding references to the MDL_lock object know that it was
@@ -1188,8 +1439,10 @@ MDL_context::MDL_context()
   :
   m_owner(NULL),
   m_needs_thr_lock_abort(FALSE),
+  m_has_fast_path_locks(FALSE),
   m_waiting_for(NULL)
 {
+  memset(m_fast_path_cache, 0, sizeof(m_fast_path_cache));
   mysql_prlock_init(key_MDL_context_LOCK_waiting_for, &m_LOCK_waiting_for);
 }
 
@@ -1212,6 +1465,7 @@ void MDL_context::destroy()
   DBUG_ASSERT(m_tickets[MDL_TRANSACTION].is_empty());
   DBUG_ASSERT(m_tickets[MDL_EXPLICIT].is_empty());
 
+  fast_path_cache_clear();
   mysql_prlock_destroy(&m_LOCK_waiting_for);
 }
 
@@ -1768,6 +2022,19 @@ const MDL_lock::bitmap_t MDL_scoped_lock::m_waiting_incompatible[MDL_TYPE_END] =
 };
 
 
+/**
+  Increments of MDL_lock::m_fast_path_state for scoped locks. Only IX
+  locks, which are taken by every statement changing data, are granted
+  using the fast path. Zero means an obtrusive lock type.
+*/
+
+const MDL_lock::fast_path_state_t
+MDL_scoped_lock::m_unobtrusive_lock_increment[MDL_TYPE_END] =
+{
+  1, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+
 /**
   Compatibility (or rather "incompatibility") matrices for per-object
   metadata lock. Arrays of bitmaps which elements specify which granted/
@@ -1862,6 +2129,25 @@ MDL_object_lock::m_waiting_incompatible[MDL_TYPE_END] =
 };
 
 
+/**
+  Increments of MDL_lock::m_fast_path_state for per-object locks.
+
+  S, SH, SR and SW locks, which are taken by DML statements, are
+  compatible with each other and are granted using the fast path.
+  S and SH locks share a counter since they conflict with the same
+  lock types. Zero means an obtrusive lock type.
+*/
+
+const MDL_lock::fast_path_state_t
+MDL_object_lock::m_unobtrusive_lock_increment[MDL_TYPE_END] =
+{
+  0, 1, 1,
+  1LL << MDL_lock::FAST_PATH_COUNTER_BITS,
+  1LL << (2 * MDL_lock::FAST_PATH_COUNTER_BITS),
+  0, 0, 0, 0
+};
+
+
 /**
   Check if request for the metadata lock can be satisfied given its
   current state.
@@ -1897,7 +2183,16 @@ MDL_lock::can_grant_lock(enum_mdl_type type_arg,
   */
   if (ignore_lock_priority || !(m_waiting.bitmap() & waiting_incompat_map))
   {
-    if (! (m_granted.bitmap() & granted_incompat_map))
+    if (fast_path_granted_bitmap() & granted_incompat_map)
+    {
+      /*
+        Locks granted using the fast path belong to other contexts since
+        a context materializes its own ones before requesting an obtrusive
+        lock (see MDL_context::try_acquire_lock_impl()).
+      */
+      DBUG_ASSERT(is_obtrusive_lock(type_arg));
+    }
+    else if (! (m_granted.bitmap() & granted_incompat_map))
       can_grant= TRUE;
     else
     {
@@ -1981,7 +2276,8 @@ void MDL_lock::remove_ticket(Ticket_list MDL_lock::*list, MDL_ticket *ticket)
 {
   mysql_prlock_wrlock(&m_rwlock);
   (this->*list).remove_ticket(ticket);
-  if (is_empty())
+  remove_obtrusive_ticket(ticket->get_type());
+  if (is_unused())
     mdl_locks.remove(this);
   else
   {
@@ -2025,6 +2321,164 @@ bool MDL_lock::has_pending_conflicting_lock(enum_mdl_type type)
 }
 
 
+/**
+  Try to grant an unobtrusive lock using the fast path.
+
+  @pre The object can't be removed from MDL_map meanwhile, see
+       m_fast_path_state.
+
+  @retval TRUE   The lock was granted.
+  @retval FALSE  Obtrusive locks are granted or pending, the lock has
+                 to be acquired using the slow path.
+*/
+
+bool MDL_lock::fast_path_acquire(enum_mdl_type type)
+{
+  fast_path_state_t increment= unobtrusive_lock_increment()[type];
+  fast_path_state_t old_state= my_atomic_load64(&m_fast_path_state);
+
+  DBUG_ASSERT(increment);
+  do
+  {
+    if (old_state & HAS_OBTRUSIVE)
+      return FALSE;
+    DBUG_ASSERT(((old_state / increment) & FAST_PATH_COUNTER_MASK) <
+                FAST_PATH_COUNTER_MASK);
+  } while (!my_atomic_cas64(&m_fast_path_state, &old_state,
+                            old_state + increment));
+  return TRUE;
+}
+
+
+/**
+  Release a lock which was granted using the fast path.
+
+  Waiters need to be rescheduled if there are obtrusive locks pending,
+  and the object should be removed from MDL_map when the last lock on
+  it is released. Both are done under m_rwlock, otherwise the release is
+  a single atomic operation.
+
+  @param type    Type of the released lock.
+  @param cached  The releasing context references the object from its
+                 MDL_context::m_fast_path_cache. Only that context can
+                 drop the reference, so the object stays used and is
+                 removed by MDL_lock::cache_unref() instead.
+*/
+
+void MDL_lock::fast_path_release(enum_mdl_type type, bool cached)
+{
+  fast_path_state_t increment= unobtrusive_lock_increment()[type];
+  fast_path_state_t old_state= my_atomic_load64(&m_fast_path_state);
+  /* Pre-allocated objects for GLOBAL and COMMIT namespaces are never removed. */
+  bool removable= (!cached &&
+                   key.mdl_namespace() != MDL_key::GLOBAL &&
+                   key.mdl_namespace() != MDL_key::COMMIT);
+
+  do
+  {
+    DBUG_ASSERT((old_state / increment) & FAST_PATH_COUNTER_MASK);
+    if ((old_state & HAS_OBTRUSIVE) || (removable && old_state == increment))
+    {
+      fast_path_release_slow(type);
+      return;
+    }
+  } while (!my_atomic_cas64(&m_fast_path_state, &old_state,
+                            old_state - increment));
+}
+
+
+/**
+  Release a lock which was granted using the fast path under m_rwlock,
+  rescheduling waiters or removing the unused object from MDL_map.
+*/
+
+void MDL_lock::fast_path_release_slow(enum_mdl_type type)
+{
+  mysql_prlock_wrlock(&m_rwlock);
+  my_atomic_add64(&m_fast_path_state, -unobtrusive_lock_increment()[type]);
+  if (is_unused())
+    mdl_locks.remove(this);
+  else
+  {
+    reschedule_waiters();
+    mysql_prlock_unlock(&m_rwlock);
+  }
+}
+
+
+/**
+  Drop a reference from MDL_context::m_fast_path_cache, removing the
+  object from MDL_map if it is no longer used.
+*/
+
+void MDL_lock::cache_unref()
+{
+  mysql_prlock_wrlock(&m_rwlock);
+  my_atomic_add32(&m_cache_refs, -1);
+  if (is_unused())
+    mdl_locks.remove(this);
+  else
+    mysql_prlock_unlock(&m_rwlock);
+}
+
+
+/**
+  Get a bitmap of lock types granted using the fast path.
+*/
+
+MDL_lock::bitmap_t MDL_lock::fast_path_granted_bitmap() const
+{
+  fast_path_state_t state=
+    my_atomic_load64(const_cast<volatile fast_path_state_t*>(&m_fast_path_state)) &
+    FAST_PATH_COUNTERS;
+  const fast_path_state_t *increment= unobtrusive_lock_increment();
+  bitmap_t result= 0;
+
+  if (state)
+  {
+    for (uint type= 0; type < MDL_TYPE_END; type++)
+    {
+      if (increment[type] && ((state / increment[type]) & FAST_PATH_COUNTER_MASK))
+        result|= MDL_BIT(type);
+    }
+  }
+  return result;
+}
+
+
+/**
+  Account a ticket added to m_granted or m_waiting. Once there is an
+  obtrusive ticket, unobtrusive locks are no longer granted using the
+  fast path.
+
+  @pre m_rwlock is write-locked.
+*/
+
+void MDL_lock::add_obtrusive_ticket(enum_mdl_type type)
+{
+  if (is_obtrusive_lock(type) &&
+      m_obtrusive_locks_granted_waiting_count++ == 0)
+    my_atomic_add64(&m_fast_path_state, HAS_OBTRUSIVE);
+}
+
+
+/**
+  Account a ticket removed from m_granted or m_waiting.
+
+  @pre m_rwlock is write-locked.
+*/
+
+void MDL_lock::remove_obtrusive_ticket(enum_mdl_type type)
+{
+  if (is_obtrusive_lock(type))
+  {
+    DBUG_ASSERT(m_obtrusive_locks_granted_waiting_count);
+    if (--m_obtrusive_locks_granted_waiting_count == 0)
+      my_atomic_add64(&m_fast_path_state, -HAS_OBTRUSIVE);
+  }
+}
+
+
 MDL_wait_for_graph_visitor::~MDL_wait_for_graph_visitor()
 {
 }
@@ -2152,7 +2606,8 @@ MDL_context::try_acquire_lock(MDL_request *mdl_request)
       We can't get here if we allocated a new lock object so there
       is no need to release it.
     */
-    DBUG_ASSERT(! ticket->m_lock->is_empty());
+    DBUG_ASSERT(! ticket->m_lock->is_unused());
+    ticket->m_lock->remove_obtrusive_ticket(ticket->get_type());
     mysql_prlock_unlock(&ticket->m_lock->m_rwlock);
     MDL_ticket::destroy(ticket);
   }
@@ -2237,6 +2692,34 @@ MDL_context::try_acquire_lock_impl(MDL_request *mdl_request,
                                    )))
     return TRUE;
 
+  if (MDL_lock::get_unobtrusive_lock_increment(mdl_request))
+  {
+    /*
+      Try to grant the unobtrusive lock using the fast path, i.e. by only
+      incrementing a counter in MDL_lock::m_fast_path_state. This fails
+      if there are obtrusive locks granted or pending.
+    */
+    if (fast_path_allowed() &&
+        (lock= fast_path_cache_acquire(key, mdl_request->type)))
+    {
+      ticket->m_lock= lock;
+      ticket->m_is_fast_path= true;
+      m_has_fast_path_locks= TRUE;
+      m_tickets[mdl_request->duration].push_front(ticket);
+      mdl_request->ticket= ticket;
+      return FALSE;
+    }
+  }
+  else
+  {
+    /*
+      Our own locks granted using the fast path must be taken into account
+      as locks of this context when checking if the obtrusive lock can be
+      granted.
+    */
+    materialize_fast_path_locks();
+  }
+
   /* The below call implicitly locks MDL_lock::m_rwlock on success. */
   if (!(lock= mdl_locks.find_or_insert(key)))
   {
@@ -2245,6 +2728,11 @@ MDL_context::try_acquire_lock_impl(MDL_request *mdl_request,
   }
 
   ticket->m_lock= lock;
+  /*
+    Stop granting unobtrusive locks using the fast path before checking
+    for conflicts with the ones which were granted so.
+  */
+  lock->add_obtrusive_ticket(mdl_request->type);
 
   if (lock->can_grant_lock(mdl_request->type, this, false))
   {
@@ -2299,9 +2787,24 @@ MDL_context::clone_ticket(MDL_request *mdl_request)
   ticket->m_lock= mdl_request->ticket->m_lock;
   mdl_request->ticket= ticket;
 
-  mysql_prlock_wrlock(&ticket->m_lock->m_rwlock);
-  ticket->m_lock->m_granted.add_ticket(ticket);
-  mysql_prlock_unlock(&ticket->m_lock->m_rwlock);
+  /*
+    The original ticket keeps the MDL_lock object in MDL_map, so the fast
+    path can be used without looking the object up.
+  */
+  if (!ticket->m_lock->is_obtrusive_lock(ticket->m_type) &&
+      fast_path_allowed() &&
+      ticket->m_lock->fast_path_acquire(ticket->m_type))
+  {
+    ticket->m_is_fast_path= true;
+    m_has_fast_path_locks= TRUE;
+  }
+  else
+  {
+    mysql_prlock_wrlock(&ticket->m_lock->m_rwlock);
+    ticket->m_lock->m_granted.add_ticket(ticket);
+    ticket->m_lock->add_obtrusive_ticket(ticket->m_type);
+    mysql_prlock_unlock(&ticket->m_lock->m_rwlock);
+  }
 
   m_tickets[mdl_request->duration].push_front(ticket);
 
@@ -2309,6 +2812,117 @@ MDL_context::clone_ticket(MDL_request *mdl_request)
 }
 
 
+/**
+  Check if locks of this context may be granted using the fast path.
+
+  Such locks are not seen by MDL_lock::notify_conflicting_locks(), so
+  contexts which have to be notified about conflicting lock requests
+  (see THD::notify_shared_lock()) must not use it. Galera conflict
+  resolution inspects the granted tickets as well.
+*/
+
+bool MDL_context::fast_path_allowed()
+{
+  return (!m_needs_thr_lock_abort && !WSREP_ON &&
+          !(get_thd()->system_thread & SYSTEM_THREAD_DELAYED_INSERT));
+}
+
+
+/**
+  Try to grant an unobtrusive lock using the fast path, looking the
+  MDL_lock object up in m_fast_path_cache first.
+
+  A cached object can't be removed from MDL_map, so the lock is granted
+  without taking MDL_map_partition::m_mutex. Otherwise the object is
+  found in MDL_map and, once the lock is granted and keeps it there,
+  replaces the cached one.
+
+  @retval non-NULL - The lock was granted using the fast path.
+  @retval NULL     - The lock has to be acquired using the slow path.
+*/
+
+MDL_lock *MDL_context::fast_path_cache_acquire(const MDL_key *key,
+                                               enum_mdl_type type)
+{
+  MDL_lock **slot;
+  MDL_lock *lock;
+
+  if (key->mdl_namespace() == MDL_key::GLOBAL ||
+      key->mdl_namespace() == MDL_key::COMMIT)
+    return mdl_locks.fast_path_acquire(key, type);
+
+  slot= &m_fast_path_cache[key->hash_value() % array_elements(m_fast_path_cache)];
+  if ((lock= *slot) && lock->key.is_equal(key))
+    return lock->fast_path_acquire(type) ? lock : NULL;
+
+  if ((lock= mdl_locks.fast_path_acquire(key, type)))
+  {
+    lock->cache_ref();
+    if (*slot)
+      (*slot)->cache_unref();
+    *slot= lock;
+  }
+  return lock;
+}
+
+
+/**
+  Drop all references from m_fast_path_cache, allowing the objects to
+  be removed from MDL_map.
+*/
+
+void MDL_context::fast_path_cache_clear()
+{
+  for (uint i= 0; i < array_elements(m_fast_path_cache); i++)
+  {
+    if (m_fast_path_cache[i])
+    {
+      m_fast_path_cache[i]->cache_unref();
+      m_fast_path_cache[i]= NULL;
+    }
+  }
+}
+
+
+/**
+  Add the locks of this context which were granted using the fast path
+  to the granted lists of their MDL_lock objects, so that other contexts
+  see them like any other granted lock.
+
+  This is done before the context starts waiting, since the deadlock
+  detector only inspects the granted lists, and before it requests an
+  obtrusive lock, which might conflict with its own locks otherwise.
+*/
+
+void MDL_context::materialize_fast_path_locks()
+{
+  if (!m_has_fast_path_locks)
+    return;
+
+  for (int i= 0; i < MDL_DURATION_END; i++)
+  {
+    Ticket_iterator it(m_tickets[i]);
+    MDL_ticket *ticket;
+
+    while ((ticket= it++))
+    {
+      if (ticket->m_is_fast_path)
+      {
+        MDL_lock *lock= ticket->m_lock;
+
+        mysql_prlock_wrlock(&lock->m_rwlock);
+        lock->m_granted.add_ticket(ticket);
+        my_atomic_add64(&lock->m_fast_path_state,
+                        -lock->unobtrusive_lock_increment()[ticket->m_type]);
+        mysql_prlock_unlock(&lock->m_rwlock);
+        ticket->m_is_fast_path= false;
+      }
+    }
+  }
+  m_has_fast_path_locks= FALSE;
+}
+
+
 /**
   Notify threads holding a shared metadata locks on object which
   conflict with a pending X, SNW or SNRW lock.
@@ -2656,14 +3270,26 @@ MDL_context::upgrade_shared_lock(MDL_ticket *mdl_ticket,
 
   /* Merge the acquired and the original lock. @todo: move to a method. */
   mysql_prlock_wrlock(&mdl_ticket->m_lock->m_rwlock);
+  /*
+    Our locks granted using the fast path were materialized when the
+    obtrusive lock was requested.
+  */
+  DBUG_ASSERT(!mdl_ticket->m_is_fast_path);
+  /* Account the new type first to not let fast path locks in meanwhile. */
+  mdl_ticket->m_lock->add_obtrusive_ticket(new_type);
   if (is_new_ticket)
+  {
     mdl_ticket->m_lock->m_granted.remove_ticket(mdl_xlock_request.ticket);
+    mdl_ticket->m_lock->remove_obtrusive_ticket(
+      mdl_xlock_request.ticket->get_type());
+  }
   /*
     Set the new type of lock in the ticket. To update state of
     MDL_lock object correctly we need to temporarily exclude
     ticket from the granted queue and then include it back.
   */
   mdl_ticket->m_lock->m_granted.remove_ticket(mdl_ticket);
+  mdl_ticket->m_lock->remove_obtrusive_ticket(mdl_ticket->m_type);
   mdl_ticket->m_type= new_type;
   mdl_ticket->m_lock->m_granted.add_ticket(mdl_ticket);
 
@@ -2943,7 +3569,13 @@ void MDL_context::release_lock(enum_mdl_duration duration, MDL_ticket *ticket)
 
   DBUG_ASSERT(this == ticket->get_ctx());
 
-  lock->remove_ticket(&MDL_lock::m_granted, ticket);
+  if (ticket->m_is_fast_path)
+    lock->fast_path_release(ticket->get_type(),
+                            m_fast_path_cache[lock->key.hash_value() %
+                                              array_elements(m_fast_path_cache)]
+                            == lock);
+  else
+    lock->remove_ticket(&MDL_lock::m_granted, ticket);
 
   m_tickets[duration].remove(ticket);
   MDL_ticket::destroy(ticket);
@@ -3047,6 +3679,7 @@ void MDL_ticket::downgrade_lock(enum_mdl_type type)
   /* Only allow downgrade from EXCLUSIVE and SHARED_NO_WRITE. */
   DBUG_ASSERT(m_type == MDL_EXCLUSIVE ||
               m_type == MDL_SHARED_NO_WRITE);
+  DBUG_ASSERT(!m_is_fast_path);
 
   mysql_prlock_wrlock(&m_lock->m_rwlock);
   /*
@@ -3054,6 +3687,9 @@ void MDL_ticket::downgrade_lock(enum_mdl_type type)
     exclude ticket from the granted queue and then include it back.
   */
   m_lock->m_granted.remove_ticket(this);
+  /* Account the new type first to not let fast path locks in meanwhile. */
+  m_lock->add_obtrusive_ticket(type);
+  m_lock->remove_obtrusive_ticket(m_type);
   m_type= type;
   m_lock->m_granted.add_ticket(this);
   m_lock->reschedule_waiters();
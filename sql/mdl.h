@@ -625,7 +625,8 @@ class MDL_ticket : public MDL_wait_for_subgraph
      m_duration(duration_arg),
 #endif
      m_ctx(ctx_arg),
-     m_lock(NULL)
+     m_lock(NULL),
+     m_is_fast_path(false)
   {}
 
   static MDL_ticket *create(MDL_context *ctx_arg, enum_mdl_type type_arg
@@ -654,6 +655,13 @@ class MDL_ticket : public MDL_wait_for_subgraph
   */
   MDL_lock *m_lock;
 
+  /**
+    Indicates that the ticket was granted using the fast path, i.e. it is
+    only accounted in MDL_lock::m_fast_path_state and is not included in
+    the MDL_lock::m_granted list. Context private.
+  */
+  bool m_is_fast_path;
+
 private:
   MDL_ticket(const MDL_ticket &);               /* not implemented */
   MDL_ticket &operator=(const MDL_ticket &);    /* not implemented */
@@ -822,6 +830,12 @@ class MDL_context
             will see the new value eventually.
     */
     m_needs_thr_lock_abort= needs_thr_lock_abort;
+    /*
+      Locks acquired using the fast path are invisible to threads which
+      try to notify their owners about conflicting lock requests.
+    */
+    if (needs_thr_lock_abort)
+      materialize_fast_path_locks();
   }
   bool get_needs_thr_lock_abort() const
   {
@@ -900,6 +914,18 @@ class MDL_context
     FALSE - Otherwise.
   */
   bool m_needs_thr_lock_abort;
+  /**
+    TRUE if some of the tickets in m_tickets may have been acquired
+    using the fast path. Context private.
+  */
+  bool m_has_fast_path_locks;
+  /**
+    MDL_lock objects of recently acquired unobtrusive locks, indexed by
+    the hash value of their keys. Each entry holds a reference that keeps
+    the object in MDL_map, so further locks on it are granted using the
+    fast path without looking it up in MDL_map. Context private.
+  */
+  MDL_lock *m_fast_path_cache[16];
 
   /**
     Read-write lock protecting m_waiting_for member.
@@ -924,10 +950,14 @@ class MDL_context
   void release_lock(enum_mdl_duration duration, MDL_ticket *ticket);
   bool try_acquire_lock_impl(MDL_request *mdl_request,
                              MDL_ticket **out_ticket);
+  bool fast_path_allowed();
+  MDL_lock *fast_path_cache_acquire(const MDL_key *key, enum_mdl_type type);
+  void fast_path_cache_clear();
 
 public:
   THD *get_thd() const { return m_owner->get_thd(); }
   void find_deadlock();
+  void materialize_fast_path_locks();
 
   ulong get_thread_id() const { return thd_get_thread_id(get_thd()); }
 
@@ -936,6 +966,12 @@ class MDL_context
   /** Inform the deadlock detector there is an edge in the wait-for graph. */
   void will_wait_for(MDL_wait_for_subgraph *waiting_for_arg)
   {
+    /*
+      Locks acquired using the fast path are not visible to the deadlock
+      detector. Since only waiting contexts can be part of a cycle in the
+      wait-for graph, it is enough to make them visible before waiting.
+    */
+    materialize_fast_path_locks();
     mysql_prlock_wrlock(&m_LOCK_waiting_for);
     m_waiting_for=  waiting_for_arg;
     mysql_prlock_unlock(&m_LOCK_waiting_for);
@@ -1003,6 +1039,11 @@ static const ulong MDL_LOCKS_HASH_PARTITIONS_DEFAULT = 8;
 */
 extern "C" ulong max_write_lock_count;
 
+typedef int (*mdl_iterate_fast_path_callback)(const MDL_key *key,
+                                              enum_mdl_type type,
+                                              uint count, void *arg);
+
 extern MYSQL_PLUGIN_IMPORT
-int mdl_iterate(int (*callback)(MDL_ticket *ticket, void *arg), void *arg);
+int mdl_iterate(int (*callback)(MDL_ticket *ticket, void *arg), void *arg,
+                mdl_iterate_fast_path_callback fast_path_callback= NULL);
 #endif
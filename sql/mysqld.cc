@@ -50,6 +50,7 @@
 #include "des_key_file.h" // load_des_key_file
 #include "sql_manager.h"  // stop_handle_manager, start_handle_manager
 #include "sql_expression_cache.h" // subquery_cache_miss, subquery_cache_hit
+#include "sql_load.h"     // init_sql_load_psi_keys
 #include "sys_vars_shared.h"
 
 #include <m_ctype.h>
@@ -497,6 +498,7 @@ ulong slave_exec_mode_options;
 ulong slave_run_triggers_for_rbr= 0;
 ulong slave_ddl_exec_mode_options= SLAVE_EXEC_MODE_IDEMPOTENT;
 ulonglong slave_type_conversions_options;
+ulonglong slave_rows_search_algorithms_options;
 ulong thread_cache_size=0;
 ulonglong binlog_cache_size=0;
 ulonglong max_binlog_cache_size=0;
@@ -1421,7 +1423,8 @@ int deny_severity = LOG_WARNING;
 #endif
 #ifdef HAVE_QUERY_CACHE
 ulong query_cache_min_res_unit= QUERY_CACHE_MIN_RESULT_DATA_SIZE;
-Query_cache query_cache;
+ulong query_cache_instances;
+Query_cache_instances query_cache;
 #endif
 #ifdef HAVE_SMEM
 char *shared_memory_base_name= default_shared_memory_base_name;
@@ -4575,6 +4578,7 @@ static int init_thread_environment()
   Events::init_mutexes();
 #endif
   init_show_explain_psi_keys();
+  init_sql_load_psi_keys();
   /* Parameter for threads created for connections */
   (void) pthread_attr_init(&connection_attrib);
   (void) pthread_attr_setdetachstate(&connection_attrib,
@@ -4785,12 +4789,11 @@ static int init_server_components()
     all things are initialized so that unireg_abort() doesn't fail
   */
   mdl_init();
-  tdc_init();
-  if (hostname_cache_init())
+  if (tdc_init() || hostname_cache_init())
     unireg_abort(1);
 
-  query_cache_set_min_res_unit(query_cache_min_res_unit);
   query_cache_init();
+  query_cache_set_min_res_unit(query_cache_min_res_unit);
   query_cache_resize(query_cache_size);
   query_cache_result_size_limit(query_cache_limit);
   my_rnd_init(&sql_rand,(ulong) server_start_time,(ulong) server_start_time/2);
@@ -7449,8 +7452,6 @@ struct my_option my_long_options[]=
   MYSQL_TO_BE_IMPLEMENTED_OPTION("optimizer-trace-max-mem-size"), // OPTIMIZER_TRACE
   MYSQL_TO_BE_IMPLEMENTED_OPTION("eq-range-index-dive-limit"),
   MYSQL_COMPATIBILITY_OPTION("server-id-bits"),
-  MYSQL_TO_BE_IMPLEMENTED_OPTION("slave-rows-search-algorithms"), // HAVE_REPLICATION
-  MYSQL_COMPATIBILITY_OPTION("table-open-cache-instances"),
   MYSQL_TO_BE_IMPLEMENTED_OPTION("slave-allow-batching"),         // HAVE_REPLICATION
   MYSQL_COMPATIBILITY_OPTION("slave-checkpoint-period"),      // HAVE_REPLICATION
   MYSQL_COMPATIBILITY_OPTION("slave-checkpoint-group"),       // HAVE_REPLICATION
@@ -7490,6 +7491,18 @@ static int show_net_compression(THD *thd, SHOW_VAR *var, char *buff,
   return 0;
 }
 
+static int show_net_compression_algorithm(THD *thd, SHOW_VAR *var, char *buff,
+                                          enum enum_var_type scope)
+{
+  var->type= SHOW_CHAR;
+  if (!thd->net.compress)
+    var->value= (char*) "";
+  else
+    var->value= (char*) (thd->net.compress_algorithm == MY_COMPRESS_LZ4 ?
+                         "lz4" : "zlib");
+  return 0;
+}
+
 static int show_starttime(THD *thd, SHOW_VAR *var, char *buff,
                           enum enum_var_type scope)
 {
@@ -7612,6 +7625,116 @@ static int show_open_tables(THD *thd, SHOW_VAR *var, char *buff,
   return 0;
 }
 
+static int show_table_open_cache(THD *thd, SHOW_VAR *var, char *buff,
+                                 enum enum_var_type scope)
+{
+  struct st_data {
+    ulonglong hits, misses, overflows;
+    SHOW_VAR var[4];
+  } *data;
+  SHOW_VAR *v;
+
+  data= (st_data *) buff;
+  v= data->var;
+
+  var->type= SHOW_ARRAY;
+  var->value= (char*) v;
+
+  tc_statistics(&data->hits, &data->misses, &data->overflows);
+
+  v[0].name= "hits";
+  v[0].type= SHOW_LONGLONG;
+  v[0].value= (char*) &data->hits;
+  v[1].name= "misses";
+  v[1].type= SHOW_LONGLONG;
+  v[1].value= (char*) &data->misses;
+  v[2].name= "overflows";
+  v[2].type= SHOW_LONGLONG;
+  v[2].value= (char*) &data->overflows;
+  v[3].name= 0;
+
+  DBUG_ASSERT((char*) (v + 4) <= buff + SHOW_VAR_FUNC_BUFF_SIZE);
+  return 0;
+}
+
+static int show_table_open_cache_instance(THD *thd, SHOW_VAR *var, char *buff,
+                                          enum enum_var_type scope)
+{
+  var->type= SHOW_ARRAY;
+  var->value= (char*) tc_instance_status_vars;
+  return 0;
+}
+
+static int show_qcache(THD *thd, SHOW_VAR *var, char *buff,
+                       enum enum_var_type scope)
+{
+  struct st_data {
+    ulong free_blocks, free_memory, hits, inserts, lowmem_prunes,
+      not_cached, queries_in_cache, total_blocks;
+    SHOW_VAR var[9];
+  } *data;
+  SHOW_VAR *v;
+
+  data= (st_data *) buff;
+  bzero(data, offsetof(st_data, var));
+  v= data->var;
+
+  var->type= SHOW_ARRAY;
+  var->value= (char*) v;
+
+  for (uint i= 0; i < query_cache.instance_count(); i++)
+  {
+    Query_cache *qc= query_cache.instance(i);
+    data->free_blocks+= qc->free_memory_blocks;
+    data->free_memory+= qc->free_memory;
+    data->hits+= qc->hits;
+    data->inserts+= qc->inserts;
+    data->lowmem_prunes+= qc->lowmem_prunes;
+    data->not_cached+= qc->refused;
+    data->queries_in_cache+= qc->queries_in_cache;
+    data->total_blocks+= qc->total_blocks;
+  }
+
+  v[0].name= "free_blocks";
+  v[0].type= SHOW_LONG;
+  v[0].value= (char*) &data->free_blocks;
+  v[1].name= "free_memory";
+  v[1].type= SHOW_LONG;
+  v[1].value= (char*) &data->free_memory;
+  v[2].name= "hits";
+  v[2].type= SHOW_LONG;
+  v[2].value= (char*) &data->hits;
+  v[3].name= "inserts";
+  v[3].type= SHOW_LONG;
+  v[3].value= (char*) &data->inserts;
+  v[4].name= "lowmem_prunes";
+  v[4].type= SHOW_LONG;
+  v[4].value= (char*) &data->lowmem_prunes;
+  v[5].name= "not_cached";
+  v[5].type= SHOW_LONG;
+  v[5].value= (char*) &data->not_cached;
+  v[6].name= "queries_in_cache";
+  v[6].type= SHOW_LONG;
+  v[6].value= (char*) &data->queries_in_cache;
+  v[7].name= "total_blocks";
+  v[7].type= SHOW_LONG;
+  v[7].value= (char*) &data->total_blocks;
+  v[8].name= 0;
+
+  DBUG_ASSERT((char*) (v + 9) <= buff + SHOW_VAR_FUNC_BUFF_SIZE);
+  return 0;
+}
+
+static int show_qcache_instance(THD *thd, SHOW_VAR *var, char *buff,
+                                enum enum_var_type scope)
+{
+  static SHOW_VAR no_instances[]= { { 0, 0, SHOW_UNDEF } };
+  var->type= SHOW_ARRAY;
+  var->value= (char*) (query_cache.instance_status_vars ?
+                       query_cache.instance_status_vars : no_instances);
+  return 0;
+}
+
 static int show_prepared_stmt_count(THD *thd, SHOW_VAR *var, char *buff,
                                     enum enum_var_type scope)
 {
@@ -8157,6 +8280,7 @@ SHOW_VAR status_vars[]= {
   {"Bytes_sent",               (char*) offsetof(STATUS_VAR, bytes_sent), SHOW_LONGLONG_STATUS},
   {"Com",                      (char*) com_status_vars, SHOW_ARRAY},
   {"Compression",              (char*) &show_net_compression, SHOW_SIMPLE_FUNC},
+  {"Compression_algorithm",    (char*) &show_net_compression_algorithm, SHOW_SIMPLE_FUNC},
   {"Connections",              (char*) &thread_id,              SHOW_LONG_NOFLUSH},
   {"Connection_errors_accept", (char*) &connection_errors_accept, SHOW_LONG},
   {"Connection_errors_internal", (char*) &connection_errors_internal, SHOW_LONG},
@@ -8232,14 +8356,8 @@ SHOW_VAR status_vars[]= {
   {"Rows_read",                (char*) offsetof(STATUS_VAR, rows_read), SHOW_LONGLONG_STATUS},
   {"Rows_tmp_read",            (char*) offsetof(STATUS_VAR, rows_tmp_read), SHOW_LONGLONG_STATUS},
 #ifdef HAVE_QUERY_CACHE
-  {"Qcache_free_blocks",       (char*) &query_cache.free_memory_blocks, SHOW_LONG_NOFLUSH},
-  {"Qcache_free_memory",       (char*) &query_cache.free_memory, SHOW_LONG_NOFLUSH},
-  {"Qcache_hits",              (char*) &query_cache.hits,       SHOW_LONG},
-  {"Qcache_inserts",           (char*) &query_cache.inserts,    SHOW_LONG},
-  {"Qcache_lowmem_prunes",     (char*) &query_cache.lowmem_prunes, SHOW_LONG},
-  {"Qcache_not_cached",        (char*) &query_cache.refused,    SHOW_LONG},
-  {"Qcache_queries_in_cache",  (char*) &query_cache.queries_in_cache, SHOW_LONG_NOFLUSH},
-  {"Qcache_total_blocks",      (char*) &query_cache.total_blocks, SHOW_LONG_NOFLUSH},
+  {"Qcache",                   (char*) &show_qcache,            SHOW_FUNC},
+  {"Qcache_instance",          (char*) &show_qcache_instance,   SHOW_FUNC},
 #endif /*HAVE_QUERY_CACHE*/
   {"Queries",                  (char*) &show_queries,            SHOW_SIMPLE_FUNC},
   {"Questions",                (char*) offsetof(STATUS_VAR, questions), SHOW_LONG_STATUS},
@@ -8303,6 +8421,8 @@ SHOW_VAR status_vars[]= {
   {"Subquery_cache_miss",      (char*) &subquery_cache_miss,    SHOW_LONG},
   {"Table_locks_immediate",    (char*) &locks_immediate,        SHOW_LONG},
   {"Table_locks_waited",       (char*) &locks_waited,           SHOW_LONG},
+  {"Table_open_cache",         (char*) &show_table_open_cache,  SHOW_FUNC},
+  {"Table_open_cache_instance", (char*) &show_table_open_cache_instance, SHOW_FUNC},
 #ifdef HAVE_MMAP
   {"Tc_log_max_pages_used",    (char*) &tc_log_max_pages_used,  SHOW_LONG},
   {"Tc_log_page_size",         (char*) &tc_log_page_size,       SHOW_LONG_NOFLUSH},
@@ -9716,6 +9836,9 @@ void refresh_status(THD *thd)
 
   /* Reset the counters of all key caches (default and named). */
   process_key_caches(reset_key_cache_counters, 0);
+#ifdef HAVE_QUERY_CACHE
+  query_cache.reset_statistics();
+#endif
   flush_status_time= time((time_t*) 0);
   mysql_mutex_unlock(&LOCK_status);
 
@@ -139,6 +139,7 @@ my_bool my_net_init(NET *net, Vio* vio, uint my_flags)
   net->write_pos=net->read_pos = net->buff;
   net->last_error[0]=0;
   net->compress=0; net->reading_or_writing=0;
+  net->compress_algorithm= MY_COMPRESS_ZLIB;
   net->where_b = net->remain_in_buf=0;
   net->net_skip_rest_factor= 0;
   net->last_errno=0;
@@ -629,7 +630,9 @@ net_real_write(NET *net,const uchar *packet, size_t len)
     }
     memcpy(b+header_length,packet,len);
 
-    if (my_compress(b+header_length, &len, &complen))
+    if (net->compress_algorithm == MY_COMPRESS_LZ4 ?
+        my_lz4_compress(b+header_length, &len, &complen) :
+        my_compress(b+header_length, &len, &complen))
       complen=0;
     int3store(&b[NET_HEADER_SIZE],complen);
     int3store(b,len);
@@ -1194,7 +1197,10 @@ my_net_read_packet(NET *net, my_bool read_from_server)
 	return packet_error;
       }
       read_from_server= 0;
-      if (my_uncompress(net->buff + net->where_b, packet_len,
+      if (net->compress_algorithm == MY_COMPRESS_LZ4 ?
+          my_lz4_uncompress(net->buff + net->where_b, packet_len,
+                            &complen) :
+          my_uncompress(net->buff + net->where_b, packet_len,
 			&complen))
       {
 	net->error= 2;			/* caller will close socket */
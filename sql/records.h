@@ -25,6 +25,7 @@ struct TABLE;
 class THD;
 class SQL_SELECT;
 class Copy_field;
+class Batch_scan;
 
 /**
   A context for reading through a single table using a chosen access method:
@@ -69,6 +70,8 @@ struct READ_RECORD
   */
   Copy_field *copy_field;
   Copy_field *copy_field_end;
+  /* Set when rows are read through a batch, see sql_batch.h */
+  Batch_scan *batch_scan;
 public:
   READ_RECORD() {}
 };
@@ -1251,5 +1251,137 @@ void Deferred_log_events::rewind()
   last_added= NULL;
 }
 
+
+Hash_slave_rows::Hash_slave_rows() : m_table(NULL), m_next(0)
+{
+  init_alloc_root(&m_mem_root, 8192, 0, MYF(MY_THREAD_SPECIFIC));
+  my_init_dynamic_array(&m_entries, sizeof(Entry *), 64, 64,
+                        MYF(MY_THREAD_SPECIFIC));
+  my_hash_clear(&m_hash);
+}
+
+
+Hash_slave_rows::~Hash_slave_rows()
+{
+  my_hash_free(&m_hash);
+  delete_dynamic(&m_entries);
+  free_root(&m_mem_root, MYF(0));
+}
+
+
+bool Hash_slave_rows::init(TABLE *table)
+{
+  m_table= table;
+  return my_hash_init(&m_hash, &my_charset_bin, 64,
+                      offsetof(Entry, hash), sizeof(ulong), NULL, NULL,
+                      HASH_THREAD_SPECIFIC);
+}
+
+
+/*
+  Hash the column values in table->record[0]. Rows that are equal as
+  compared by record_compare() in log_event.cc get the same hash.
+*/
+
+ulong Hash_slave_rows::hash_record(TABLE *table)
+{
+  ulong nr= 1, nr2= 4;
+  for (Field **ptr= table->field; *ptr; ptr++)
+  {
+    Field *field= *ptr;
+    uchar *data= field->ptr;
+    uint length= field->pack_length();
+
+    if (field->is_null())
+    {
+      nr^= (nr << 1) | 1;
+      continue;
+    }
+    if (field->flags & BLOB_FLAG)
+    {
+      Field_blob *blob= (Field_blob *) field;
+      length= blob->get_length();
+      blob->get_ptr(&data);
+    }
+    else if (field->type() == MYSQL_TYPE_VARCHAR)
+    {
+      Field_varstring *varstring= (Field_varstring *) field;
+      length= varstring->data_length();
+      data+= varstring->length_bytes;
+    }
+    my_charset_bin.coll->hash_sort(&my_charset_bin, data, length, &nr, &nr2);
+  }
+  return nr;
+}
+
+
+/*
+  Add the before image that starts at row_start in the event, and that
+  is unpacked in m_table->record[0].
+
+  Blobs in the copy of the record still point into the event, which
+  stays around until all rows have been applied.
+*/
+
+bool Hash_slave_rows::add(const uchar *row_start)
+{
+  Entry *entry;
+  if (!(entry= (Entry *) alloc_root(&m_mem_root, sizeof(Entry))) ||
+      !(entry->record= (uchar *) memdup_root(&m_mem_root, m_table->record[0],
+                                             m_table->s->reclength)))
+    return true;
+  entry->row_start= row_start;
+  entry->ref= NULL;
+  entry->hash= hash_record(m_table);
+  return insert_dynamic(&m_entries, (uchar *) &entry) ||
+         my_hash_insert(&m_hash, (uchar *) entry);
+}
+
+
+/* Unmatched entries with the given hash */
+
+Hash_slave_rows::Entry *
+Hash_slave_rows::first_match(ulong hash, HASH_SEARCH_STATE *state)
+{
+  return (Entry *) my_hash_first(&m_hash, (uchar *) &hash, sizeof(hash),
+                                 state);
+}
+
+
+Hash_slave_rows::Entry *
+Hash_slave_rows::next_match(ulong hash, HASH_SEARCH_STATE *state)
+{
+  return (Entry *) my_hash_next(&m_hash, (uchar *) &hash, sizeof(hash),
+                                state);
+}
+
+
+/*
+  Remember the position of the row that matches the entry. The entry
+  is removed from the hash, so that each row of the event is matched
+  by a different row of the table.
+*/
+
+bool Hash_slave_rows::set_matched(Entry *entry, const uchar *ref)
+{
+  if (!(entry->ref= (uchar *) memdup_root(&m_mem_root, ref,
+                                          m_table->file->ref_length)))
+    return true;
+  return my_hash_delete(&m_hash, (uchar *) entry);
+}
+
+
+/*
+  Position of the row that matched the before image at row_start, or
+  NULL if no row matched it. The rows must be asked for in event order.
+*/
+
+const uchar *Hash_slave_rows::position(const uchar *row_start)
+{
+  if (m_next < elements() && entry(m_next)->row_start == row_start)
+    return entry(m_next++)->ref;
+  return NULL;
+}
+
 #endif
 
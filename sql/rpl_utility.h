@@ -291,6 +291,50 @@ class Deferred_log_events
   bool is_last(Log_event *ev) { return ev == last_added; };
 };
 
+/**
+  The before images of the rows of an UPDATE or DELETE rows event,
+  hashed on their column values.
+
+  Used by the slave to locate all rows of the event with one scan of
+  the table (or one index lookup per distinct key value) instead of
+  one scan per row, see Rows_log_event::hash_scan_rows().
+*/
+class Hash_slave_rows
+{
+public:
+  struct Entry
+  {
+    const uchar *row_start;     /* Start of the before image in the event */
+    uchar *record;              /* The before image, unpacked */
+    uchar *ref;                 /* Position of the matching row, or NULL */
+    ulong hash;
+  };
+
+  Hash_slave_rows();
+  ~Hash_slave_rows();
+
+  bool init(TABLE *table);
+  bool add(const uchar *row_start);
+  Entry *first_match(ulong hash, HASH_SEARCH_STATE *state);
+  Entry *next_match(ulong hash, HASH_SEARCH_STATE *state);
+  bool set_matched(Entry *entry, const uchar *ref);
+  const uchar *position(const uchar *row_start);
+
+  uint elements() const { return m_entries.elements; }
+  uint unmatched() const { return m_hash.records; }
+  Entry *entry(uint i) const
+  { return *(Entry **) dynamic_array_ptr(&m_entries, i); }
+
+  static ulong hash_record(TABLE *table);
+
+private:
+  TABLE *m_table;
+  MEM_ROOT m_mem_root;
+  DYNAMIC_ARRAY m_entries;      /* All entries, in event order */
+  HASH m_hash;                  /* The entries not matched yet */
+  uint m_next;                  /* Next entry for position() */
+};
+
 #endif
 
 // NB. number of printed bit values is limited to sizeof(buf) - 1
@@ -11129,6 +11129,19 @@ static void login_failed_error(THD *thd)
   }
 }
 
+/**
+  MariaDB extended capabilities (bits 32-63) of the server
+*/
+static ulonglong server_ext_capabilities()
+{
+  ulonglong capabilities= 0;
+#ifdef HAVE_COMPRESS
+  if (my_have_lz4_compress)
+    capabilities|= MARIADB_CLIENT_COMPRESS_LZ4;
+#endif
+  return capabilities;
+}
+
 /**
   sends a server handshake initialization packet, the very first packet
   after the connection was established
@@ -11147,7 +11160,8 @@ static void login_failed_error(THD *thd)
     2           server status
     2           server capabilities (two upper bytes)
     1           length of the scramble
-    10          reserved, always 0
+    6           reserved, always 0
+    4           MariaDB extended capabilities (bits 32-63)
     n           rest of the plugin provided data (at least 12 bytes)
     1           \0 byte, terminating the second part of a scramble
 
@@ -11236,7 +11250,9 @@ static bool send_server_handshake_packet(MPVIO_EXT *mpvio,
   int2store(end+5, thd->client_capabilities >> 16);
   end[7]= data_len;
   DBUG_EXECUTE_IF("poison_srv_handshake_scramble_len", end[7]= -100;);
-  bzero(end + 8, 10);
+  bzero(end + 8, 6);
+  /* MariaDB extended capabilities */
+  int4store(end + 14, server_ext_capabilities() >> 32);
   end+= 18;
   /* write scramble tail */
   end= (char*) memcpy(end, data + SCRAMBLE_LENGTH_323,
@@ -11690,6 +11706,12 @@ static ulong parse_client_handshake_packet(MPVIO_EXT *mpvio,
     if (thd_init_client_charset(thd, (uint) net->read_pos[8]))
       return packet_error;
     thd->update_charset();
+    /* The last 4 bytes of the filler are MariaDB extended capabilities */
+    ulonglong ext_capabilities= ((ulonglong) uint4korr(net->read_pos+28)) << 32;
+    ext_capabilities&= server_ext_capabilities();
+    if ((thd->client_capabilities & CLIENT_COMPRESS) &&
+        (ext_capabilities & MARIADB_CLIENT_COMPRESS_LZ4))
+      thd->net.compress_algorithm= MY_COMPRESS_LZ4;
     end= (char*) net->read_pos+32;
   }
   else
@@ -0,0 +1,723 @@
+/* Copyright (c) 2015, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/**
+  @file
+
+  Batch evaluation of simple predicates over sequential scans, see
+  sql_batch.h.
+*/
+
+#include <my_global.h>
+#include "sql_priv.h"
+#include "sql_class.h"
+#include "sql_select.h"
+#include "sql_batch.h"
+
+
+/**
+  Set up reading of a column from batched rows.
+
+  @retval FALSE ok
+  @retval TRUE  the item is not a field of 'table' that can be read
+                from a copy of the record
+*/
+
+bool Batch_column::init(Item *item, TABLE *table)
+{
+  if (item->type() != Item::FIELD_ITEM)
+    return TRUE;
+  field= ((Item_field*) item)->field;
+  if (field->table != table ||
+      field->ptr < table->record[0] ||
+      field->ptr >= table->record[0] + table->s->reclength ||
+      (field->flags & BLOB_FLAG) ||
+      field->type() == MYSQL_TYPE_BIT)          // has bits among null bits
+    return TRUE;
+  offset= (uint) (field->ptr - table->record[0]);
+  if (field->null_ptr)
+  {
+    null_offset= (uint) (field->null_ptr - table->record[0]);
+    null_bit= field->null_bit;
+  }
+  else
+  {
+    null_offset= 0;
+    null_bit= 0;
+  }
+  type= field->type();
+  unsigned_flag= item->unsigned_flag;
+  return FALSE;
+}
+
+
+longlong Batch_column::val_int(const uchar *row) const
+{
+  const uchar *ptr= row + offset;
+  /* Decode the common integer types without a virtual call */
+  switch (type) {
+  case MYSQL_TYPE_TINY:
+    return unsigned_flag ? (longlong) ptr[0] : (longlong) (signed char) ptr[0];
+  case MYSQL_TYPE_SHORT:
+    return unsigned_flag ? (longlong) uint2korr(ptr) :
+                           (longlong) sint2korr(ptr);
+  case MYSQL_TYPE_LONG:
+    return unsigned_flag ? (longlong) uint4korr(ptr) :
+                           (longlong) sint4korr(ptr);
+  case MYSQL_TYPE_LONGLONG:
+    return sint8korr(ptr);
+  default:
+    return field->val_int(ptr);
+  }
+}
+
+
+double Batch_column::val_real(const uchar *row) const
+{
+  const uchar *ptr= row + offset;
+  switch (type) {
+  case MYSQL_TYPE_FLOAT:
+  {
+    float j;
+    float4get(j, ptr);
+    return (double) j;
+  }
+  case MYSQL_TYPE_DOUBLE:
+  {
+    double j;
+    float8get(j, ptr);
+    return j;
+  }
+  default:
+    return field->val_real(ptr);
+  }
+}
+
+
+/**
+  Compare two integers with the same rules as the
+  Arg_comparator::compare_int_*() functions.
+*/
+
+static inline int cmp_int(longlong a, bool a_unsigned,
+                          longlong b, bool b_unsigned)
+{
+  if (a_unsigned && b_unsigned)
+    return (ulonglong) a < (ulonglong) b ? -1 : a == b ? 0 : 1;
+  if (!a_unsigned && !b_unsigned)
+    return a < b ? -1 : a == b ? 0 : 1;
+  if (!a_unsigned)
+    return (a < 0 || (ulonglong) a < (ulonglong) b) ? -1 : a == b ? 0 : 1;
+  return (b < 0 || (ulonglong) a > (ulonglong) b) ? 1 : a == b ? 0 : -1;
+}
+
+
+static inline bool cmp_result(Item_func::Functype op, int cmp)
+{
+  switch (op) {
+  case Item_func::EQ_FUNC: return cmp == 0;
+  case Item_func::NE_FUNC: return cmp != 0;
+  case Item_func::LT_FUNC: return cmp < 0;
+  case Item_func::LE_FUNC: return cmp <= 0;
+  case Item_func::GT_FUNC: return cmp > 0;
+  case Item_func::GE_FUNC: return cmp >= 0;
+  default:
+    DBUG_ASSERT(0);
+    return FALSE;
+  }
+}
+
+
+/**
+  Make a copy of the value of a constant string item on the MEM_ROOT.
+
+  @retval FALSE ok, 'to' is set to the value or 'is_null' is set
+  @retval TRUE  out of memory
+*/
+
+static bool copy_const_string(THD *thd, Item *item, String *to, bool *is_null)
+{
+  char buff[STRING_BUFFER_USUAL_SIZE];
+  String tmp(buff, sizeof(buff), &my_charset_bin), *res;
+  char *ptr;
+
+  if (!(res= item->val_str(&tmp)))
+  {
+    *is_null= TRUE;
+    return FALSE;
+  }
+  *is_null= FALSE;
+  if (!(ptr= thd->strmake(res->ptr(), res->length())))
+    return TRUE;
+  to->set(ptr, res->length(), res->charset());
+  return FALSE;
+}
+
+
+/**
+  Create a batch predicate for a comparison.
+
+  @param thd   thread handle
+  @param table table being scanned
+  @param op    comparison operator, with a as the left operand
+  @param func  comparison function chosen by the Arg_comparator
+  @param cs    collation of string comparison
+  @param a, b  arguments of the comparison
+
+  @return the predicate or NULL if the comparison is not a comparison
+          of a column of 'table' with a constant that can be batched.
+*/
+
+Batch_compare *Batch_compare::create(THD *thd, TABLE *table,
+                                     Item_func::Functype op,
+                                     arg_cmp_func func, CHARSET_INFO *cs,
+                                     Item *a, Item *b)
+{
+  Batch_compare *pred;
+  Item *value;
+  Item_result cmp_type;
+  bool binary_cmp= FALSE, a_unsigned= FALSE, b_unsigned= FALSE;
+
+  switch (op) {
+  case Item_func::EQ_FUNC:
+  case Item_func::NE_FUNC:
+  case Item_func::LT_FUNC:
+  case Item_func::LE_FUNC:
+  case Item_func::GT_FUNC:
+  case Item_func::GE_FUNC:
+    break;
+  default:
+    return NULL;
+  }
+
+  if (func == &Arg_comparator::compare_int_signed)
+    cmp_type= INT_RESULT;
+  else if (func == &Arg_comparator::compare_int_unsigned)
+  {
+    cmp_type= INT_RESULT;
+    a_unsigned= b_unsigned= TRUE;
+  }
+  else if (func == &Arg_comparator::compare_int_signed_unsigned)
+  {
+    cmp_type= INT_RESULT;
+    b_unsigned= TRUE;
+  }
+  else if (func == &Arg_comparator::compare_int_unsigned_signed)
+  {
+    cmp_type= INT_RESULT;
+    a_unsigned= TRUE;
+  }
+  else if (func == &Arg_comparator::compare_real)
+    cmp_type= REAL_RESULT;
+  else if (func == &Arg_comparator::compare_string)
+    cmp_type= STRING_RESULT;
+  else if (func == &Arg_comparator::compare_binary_string)
+  {
+    cmp_type= STRING_RESULT;
+    binary_cmp= TRUE;
+  }
+  else
+    return NULL;
+
+  if (!(pred= new (thd->mem_root) Batch_compare))
+    return NULL;
+
+  /* Make the column the left operand */
+  if (!pred->column.init(a, table))
+    value= b;
+  else if (!pred->column.init(b, table))
+  {
+    value= a;
+    swap_variables(bool, a_unsigned, b_unsigned);
+    switch (op) {
+    case Item_func::LT_FUNC: op= Item_func::GT_FUNC; break;
+    case Item_func::LE_FUNC: op= Item_func::GE_FUNC; break;
+    case Item_func::GT_FUNC: op= Item_func::LT_FUNC; break;
+    case Item_func::GE_FUNC: op= Item_func::LE_FUNC; break;
+    default: break;
+    }
+  }
+  else
+    return NULL;
+
+  if (!value->const_item() || value->is_expensive())
+    return NULL;
+
+  Item *column= value == b ? a : b;
+  switch (cmp_type) {
+  case INT_RESULT:
+    pred->int_value= value->val_int();
+    pred->null_value= value->null_value;
+    break;
+  case REAL_RESULT:
+    /* Don't give a conversion warning for every row */
+    if (column->result_type() == STRING_RESULT ||
+        value->result_type() == STRING_RESULT)
+      return NULL;
+    pred->real_value= value->val_real();
+    pred->null_value= value->null_value;
+    break;
+  case STRING_RESULT:
+    if (column->cmp_type() != STRING_RESULT ||
+        copy_const_string(thd, value, &pred->str_value, &pred->null_value))
+      return NULL;
+    break;
+  default:
+    DBUG_ASSERT(0);
+    return NULL;
+  }
+  if (thd->is_error())
+    return NULL;
+
+  pred->op= op;
+  pred->cmp_type= cmp_type;
+  pred->binary_cmp= binary_cmp;
+  pred->column_unsigned= a_unsigned;
+  pred->value_unsigned= b_unsigned;
+  pred->collation= cs;
+  return pred;
+}
+
+
+inline int Batch_compare::compare(const uchar *row)
+{
+  switch (cmp_type) {
+  case INT_RESULT:
+    return cmp_int(column.val_int(row), column_unsigned,
+                   int_value, value_unsigned);
+  case REAL_RESULT:
+  {
+    double val= column.val_real(row);
+    return val < real_value ? -1 : val == real_value ? 0 : 1;
+  }
+  case STRING_RESULT:
+  {
+    String *res= column.val_str(&tmp_value, row);
+    if (binary_cmp)
+    {
+      uint res_length= res->length();
+      uint value_length= str_value.length();
+      int cmp= memcmp(res->ptr(), str_value.ptr(),
+                      MY_MIN(res_length, value_length));
+      return cmp ? cmp : (int) (res_length - value_length);
+    }
+    return sortcmp(res, &str_value, collation);
+  }
+  default:
+    DBUG_ASSERT(0);
+    return 0;
+  }
+}
+
+
+void Batch_compare::filter(const Row_batch *batch, MY_BITMAP *selected)
+{
+  if (null_value)
+  {
+    bitmap_clear_all(selected);
+    return;
+  }
+  for (uint i= 0; i < batch->count; i++)
+  {
+    const uchar *row;
+    if (!bitmap_is_set(selected, i))
+      continue;
+    row= batch->row(i);
+    if (column.is_null(row) || !cmp_result(op, compare(row)))
+      bitmap_clear_bit(selected, i);
+  }
+}
+
+
+/**
+  Create a batch predicate for BETWEEN.
+
+  @return the predicate or NULL if the BETWEEN can't be batched
+*/
+
+Batch_between *Batch_between::create(THD *thd, TABLE *table,
+                                     Item_func_between *func)
+{
+  Batch_between *pred;
+  Item **args= func->arguments();
+  bool min_is_null, max_is_null;
+
+  if (!args[1]->const_item() || args[1]->is_expensive() ||
+      !args[2]->const_item() || args[2]->is_expensive() ||
+      !(pred= new (thd->mem_root) Batch_between) ||
+      pred->column.init(args[0], table))
+    return NULL;
+
+  switch (func->cmp_type) {
+  case INT_RESULT:
+    pred->int_min= args[1]->val_int();
+    min_is_null= args[1]->null_value;
+    pred->int_max= args[2]->val_int();
+    max_is_null= args[2]->null_value;
+    break;
+  case REAL_RESULT:
+    /* Don't give a conversion warning for every row */
+    if (args[0]->result_type() == STRING_RESULT ||
+        args[1]->result_type() == STRING_RESULT ||
+        args[2]->result_type() == STRING_RESULT)
+      return NULL;
+    pred->real_min= args[1]->val_real();
+    min_is_null= args[1]->null_value;
+    pred->real_max= args[2]->val_real();
+    max_is_null= args[2]->null_value;
+    break;
+  case STRING_RESULT:
+    if (args[0]->cmp_type() != STRING_RESULT ||
+        copy_const_string(thd, args[1], &pred->str_min, &min_is_null) ||
+        copy_const_string(thd, args[2], &pred->str_max, &max_is_null))
+      return NULL;
+    break;
+  default:
+    return NULL;
+  }
+  if (thd->is_error())
+    return NULL;
+
+  /*
+    With a NULL bound BETWEEN is never TRUE, NOT BETWEEN may be TRUE
+    depending on the other bound.
+  */
+  pred->null_value= min_is_null || max_is_null;
+  if (pred->null_value && func->negated)
+    return NULL;
+
+  pred->cmp_type= func->cmp_type;
+  pred->negated= func->negated;
+  pred->collation= func->compare_collation();
+  return pred;
+}
+
+
+void Batch_between::filter(const Row_batch *batch, MY_BITMAP *selected)
+{
+  if (null_value)
+  {
+    bitmap_clear_all(selected);
+    return;
+  }
+  for (uint i= 0; i < batch->count; i++)
+  {
+    const uchar *row;
+    bool in_range;
+    if (!bitmap_is_set(selected, i))
+      continue;
+    row= batch->row(i);
+    if (column.is_null(row))
+    {
+      bitmap_clear_bit(selected, i);
+      continue;
+    }
+    switch (cmp_type) {
+    case INT_RESULT:
+    {
+      longlong val= column.val_int(row);
+      in_range= val >= int_min && val <= int_max;
+      break;
+    }
+    case REAL_RESULT:
+    {
+      double val= column.val_real(row);
+      in_range= val >= real_min && val <= real_max;
+      break;
+    }
+    case STRING_RESULT:
+    {
+      String *res= column.val_str(&tmp_value, row);
+      in_range= sortcmp(res, &str_min, collation) >= 0 &&
+                sortcmp(res, &str_max, collation) <= 0;
+      break;
+    }
+    default:
+      DBUG_ASSERT(0);
+      in_range= TRUE;
+    }
+    if (in_range == negated)
+      bitmap_clear_bit(selected, i);
+  }
+}
+
+
+/**
+  Create a batch predicate for IN with a list of constants.
+
+  @return the predicate or NULL if the IN can't be batched
+*/
+
+Batch_in *Batch_in::create(THD *thd, TABLE *table, Item_func_in *func)
+{
+  Batch_in *pred;
+  Item *column= func->arguments()[0];
+
+  if (!func->array ||
+      !(pred= new (thd->mem_root) Batch_in) ||
+      pred->column.init(column, table))
+    return NULL;
+
+  switch (func->array->result_type()) {
+  case INT_RESULT:
+    /* in_datetime is an in_longlong that compares temporal values */
+    if (func->left_result_type != INT_RESULT)
+      return NULL;
+    break;
+  case REAL_RESULT:
+    if (column->result_type() == STRING_RESULT)
+      return NULL;
+    break;
+  case STRING_RESULT:
+    if (column->cmp_type() != STRING_RESULT)
+      return NULL;
+    break;
+  default:
+    return NULL;
+  }
+
+  pred->array= func->array;
+  pred->cmp_type= func->array->result_type();
+  pred->negated= func->negated;
+  pred->have_null= func->have_null;
+  return pred;
+}
+
+
+void Batch_in::filter(const Row_batch *batch, MY_BITMAP *selected)
+{
+  /* x NOT IN (..., NULL, ...) is never TRUE */
+  if (negated && have_null)
+  {
+    bitmap_clear_all(selected);
+    return;
+  }
+  for (uint i= 0; i < batch->count; i++)
+  {
+    const uchar *row;
+    bool found;
+    if (!bitmap_is_set(selected, i))
+      continue;
+    row= batch->row(i);
+    if (column.is_null(row))
+    {
+      bitmap_clear_bit(selected, i);
+      continue;
+    }
+    switch (cmp_type) {
+    case INT_RESULT:
+      found= ((in_longlong*) array)->find_longlong(column.val_int(row),
+                                                   column.unsigned_flag);
+      break;
+    case REAL_RESULT:
+    {
+      double val= column.val_real(row);
+      found= array->find_value((uchar*) &val);
+      break;
+    }
+    case STRING_RESULT:
+      found= array->find_value((uchar*) column.val_str(&tmp_value, row));
+      break;
+    default:
+      DBUG_ASSERT(0);
+      found= !negated;
+    }
+    if (found == negated)
+      bitmap_clear_bit(selected, i);
+  }
+}
+
+
+/**
+  Set up batched reading for a join table, if possible.
+
+  Reading rows ahead must not be visible: the scan has to be a plain
+  non-locking table scan that is always read to the end, and nothing
+  may use the handler position of the current row.
+
+  @return the Batch_scan or NULL if the table is read one row at a time
+*/
+
+Batch_scan *Batch_scan::create(JOIN_TAB *tab)
+{
+  JOIN *join= tab->join;
+  THD *thd= join->thd;
+  TABLE *table= tab->table;
+  Item *cond= tab->select_cond;
+  List<Batch_predicate> predicates;
+  Batch_predicate *pred;
+  Batch_scan *scan;
+  my_bitmap_map *bitmap_buf;
+  uint capacity;
+  DBUG_ENTER("Batch_scan::create");
+
+  if (!cond || tab->cache ||
+      thd->lex->sql_command != SQLCOM_SELECT ||
+      table->reginfo.lock_type != TL_READ ||
+      table->reginfo.not_exists_optimize ||
+      table->s->blob_fields || table->vfield ||
+      tab->keep_current_rowid || tab->loosescan_match_tab ||
+      tab->do_firstmatch || tab->shortcut_for_distinct ||
+      join->unit->select_limit_cnt != HA_POS_ERROR ||
+      thd->lex->limit_rows_examined_cnt != ULONGLONG_MAX ||
+      join->join_tab_save)        // JOIN::reinit() would forget the scan
+    DBUG_RETURN(NULL);
+
+  capacity= MY_MIN(BATCH_SCAN_MAX_ROWS,
+                   BATCH_SCAN_BUFFER_SIZE / table->s->reclength);
+  if (capacity < BATCH_SCAN_MIN_ROWS)
+    DBUG_RETURN(NULL);
+
+  /*
+    Only the leading conjuncts are batched, so a row is rejected before
+    anything that could have side effects or give warnings would have
+    been evaluated for it.
+  */
+  if (cond->type() == Item::COND_ITEM &&
+      ((Item_cond*) cond)->functype() == Item_func::COND_AND_FUNC)
+  {
+    List_iterator_fast<Item> it(*((Item_cond*) cond)->argument_list());
+    Item *item;
+    while ((item= it++) && (pred= item->get_batch_predicate(thd, table)))
+      predicates.push_back(pred, thd->mem_root);
+  }
+  else if ((pred= cond->get_batch_predicate(thd, table)))
+    predicates.push_back(pred, thd->mem_root);
+  if (predicates.is_empty())
+    DBUG_RETURN(NULL);
+
+  if (!(scan= new (thd->mem_root) Batch_scan(tab)) ||
+      !(scan->batch.rows= (uchar*) thd->alloc(capacity *
+                                              table->s->reclength)) ||
+      !(bitmap_buf= (my_bitmap_map*) thd->alloc(bitmap_buffer_size(capacity))) ||
+      my_bitmap_init(&scan->selected, bitmap_buf, capacity, FALSE))
+    DBUG_RETURN(NULL);
+
+  scan->cond= cond;
+  scan->predicates= predicates;
+  scan->batch.row_length= table->s->reclength;
+  scan->batch.count= 0;
+  scan->capacity= capacity;
+  DBUG_PRINT("info", ("table: %s  rows per batch: %u  predicates: %u",
+                      table->alias.c_ptr(), capacity,
+                      predicates.elements));
+  DBUG_RETURN(scan);
+}
+
+
+/**
+  Make the READ_RECORD read through the batch, if it is a sequential
+  scan with the condition the batch was set up for. Must be called after
+  init_read_record().
+*/
+
+void Batch_scan::start(READ_RECORD *info)
+{
+  if (info->read_record != rr_sequential || tab->select_cond != cond)
+    return;
+  batch.count= 0;
+  next_row= 0;
+  end_error= 0;
+  info->batch_scan= this;
+  info->read_record= read_record;
+}
+
+
+/**
+  Read the next batch of rows and run the predicates over it.
+*/
+
+void Batch_scan::fill(READ_RECORD *info)
+{
+  int error;
+
+  batch.count= 0;
+  next_row= 0;
+  while (batch.count < capacity)
+  {
+    if ((error= rr_sequential(info)))
+    {
+      end_error= error;
+      end_status= table->status;
+      break;
+    }
+    memcpy(batch.row(batch.count++), info->record, batch.row_length);
+  }
+  bitmap_set_prefix(&selected, batch.count);
+
+  /* If killed, return all rows so that evaluate_join_record() notices */
+  if (batch.count && !tab->join->thd->killed)
+  {
+    List_iterator_fast<Batch_predicate> it(predicates);
+    Batch_predicate *pred;
+    while ((pred= it++))
+      pred->filter(&batch, &selected);
+  }
+}
+
+
+/**
+  Account for a row rejected by the predicates as evaluate_join_record()
+  would have done.
+*/
+
+inline void Batch_scan::skip_row()
+{
+  JOIN *join= tab->join;
+  tab->tracker->r_rows++;
+  join->examined_rows++;
+  join->thd->get_stmt_da()->inc_current_row_for_warning();
+}
+
+
+/**
+  READ_RECORD::read_record function of a batched scan: return the next
+  row that passed the predicates in table->record[0].
+*/
+
+int Batch_scan::read_record(READ_RECORD *info)
+{
+  Batch_scan *scan= info->batch_scan;
+
+  for (;;)
+  {
+    while (scan->next_row < scan->batch.count)
+    {
+      uint n= scan->next_row++;
+      if (bitmap_is_set(&scan->selected, n))
+      {
+        memcpy(info->record, scan->batch.row(n), scan->batch.row_length);
+        scan->table->status= 0;
+        return 0;
+      }
+      scan->skip_row();
+    }
+    if (scan->end_error)
+    {
+      scan->table->status= scan->end_status;
+      return scan->end_error;
+    }
+    scan->fill(info);
+  }
+}
+
+
+void Batch_scan::cleanup()
+{
+  List_iterator_fast<Batch_predicate> it(predicates);
+  Batch_predicate *pred;
+  while ((pred= it++))
+    pred->cleanup();
+}
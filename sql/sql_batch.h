@@ -0,0 +1,206 @@
+#ifndef SQL_BATCH_INCLUDED
+#define SQL_BATCH_INCLUDED
+/* Copyright (c) 2015, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/**
+  @file
+
+  Batch evaluation of simple predicates.
+
+  A sequential scan that has a condition attached normally reads one row
+  into table->record[0] and evaluates the whole condition tree on it
+  before the next row is read. Batch_scan instead reads up to
+  BATCH_SCAN_MAX_ROWS rows into a buffer and runs the leading conjuncts
+  of the condition that support it (see Item::get_batch_predicate())
+  over all of them at once. The predicates read the column values
+  directly from the buffered rows and only clear bits in a selection
+  bitmap, so the comparison loops do not go through the Item tree.
+
+  Rows that pass are copied back to table->record[0] one at a time and
+  go through the normal evaluate_join_record(), so the result, the
+  warnings and the row counters are the same as without batching.
+*/
+
+#include "sql_select.h"
+#include "my_bitmap.h"
+
+class Item_func_between;
+class Item_func_in;
+
+/* Maximum number of rows in a batch */
+#define BATCH_SCAN_MAX_ROWS    256
+/* Don't batch if fewer rows than this fit into the buffer */
+#define BATCH_SCAN_MIN_ROWS    16
+/* Size of the row buffer */
+#define BATCH_SCAN_BUFFER_SIZE (64*1024)
+
+
+/**
+  A number of rows in table->record[0] format, stored one after another.
+*/
+
+class Row_batch
+{
+public:
+  uchar *rows;
+  uint row_length;
+  uint count;
+  inline const uchar *row(uint n) const
+  { return rows + (size_t) n * row_length; }
+  inline uchar *row(uint n)
+  { return rows + (size_t) n * row_length; }
+};
+
+
+/**
+  Reads the value of one field of a table from rows of a Row_batch.
+*/
+
+class Batch_column
+{
+  Field *field;
+  uint offset;                                  // field->ptr - record[0]
+  uint null_offset;
+  uchar null_bit;
+  enum_field_types type;
+public:
+  bool unsigned_flag;
+
+  bool init(Item *item, TABLE *table);
+  inline bool is_null(const uchar *row) const
+  { return null_bit && (row[null_offset] & null_bit); }
+  longlong val_int(const uchar *row) const;
+  double val_real(const uchar *row) const;
+  inline String *val_str(String *buf, const uchar *row) const
+  { return field->val_str(buf, row + offset); }
+};
+
+
+class Batch_predicate :public Sql_alloc
+{
+public:
+  virtual ~Batch_predicate() {}
+  /**
+    Clear the bits in 'selected' of the rows of 'batch' for which the
+    predicate is not TRUE. Rows whose bit is already clear may be
+    skipped.
+  */
+  virtual void filter(const Row_batch *batch, MY_BITMAP *selected)= 0;
+  /* Free the memory that is not allocated on the MEM_ROOT */
+  virtual void cleanup() {}
+};
+
+
+/**
+  <column> <op> <constant>, for the =, <>, <, <=, >, >= predicates
+  comparing integers, reals or strings.
+*/
+
+class Batch_compare :public Batch_predicate
+{
+  Batch_column column;
+  Item_func::Functype op;                       // with column on the left
+  Item_result cmp_type;
+  bool binary_cmp;
+  bool column_unsigned, value_unsigned;
+  bool null_value;                              // constant is NULL
+  longlong int_value;
+  double real_value;
+  String str_value;
+  String tmp_value;
+  CHARSET_INFO *collation;
+
+  inline int compare(const uchar *row);
+public:
+  static Batch_compare *create(THD *thd, TABLE *table, Item_func::Functype op,
+                               arg_cmp_func func, CHARSET_INFO *cs,
+                               Item *a, Item *b);
+  void filter(const Row_batch *batch, MY_BITMAP *selected);
+  void cleanup() { tmp_value.free(); }
+};
+
+
+/**
+  <column> [NOT] BETWEEN <constant> AND <constant>
+*/
+
+class Batch_between :public Batch_predicate
+{
+  Batch_column column;
+  Item_result cmp_type;
+  bool negated;
+  bool null_value;                              // a bound is NULL
+  longlong int_min, int_max;
+  double real_min, real_max;
+  String str_min, str_max;
+  String tmp_value;
+  CHARSET_INFO *collation;
+public:
+  static Batch_between *create(THD *thd, TABLE *table,
+                               Item_func_between *func);
+  void filter(const Row_batch *batch, MY_BITMAP *selected);
+  void cleanup() { tmp_value.free(); }
+};
+
+
+/**
+  <column> [NOT] IN (<constant>, ...), looked up in the sorted in_vector
+  of the Item_func_in.
+*/
+
+class Batch_in :public Batch_predicate
+{
+  Batch_column column;
+  in_vector *array;
+  Item_result cmp_type;
+  bool negated;
+  bool have_null;
+  String tmp_value;
+public:
+  static Batch_in *create(THD *thd, TABLE *table, Item_func_in *func);
+  void filter(const Row_batch *batch, MY_BITMAP *selected);
+  void cleanup() { tmp_value.free(); }
+};
+
+
+/**
+  Batched sequential scan of a join table, see the file comment.
+*/
+
+class Batch_scan :public Sql_alloc
+{
+  JOIN_TAB *tab;
+  TABLE *table;
+  Item *cond;
+  List<Batch_predicate> predicates;
+  Row_batch batch;
+  MY_BITMAP selected;
+  uint capacity;
+  uint next_row;
+  int end_error;                                // error that ended the scan
+  uint end_status;                              // table->status at the end
+
+  Batch_scan(JOIN_TAB *tab_arg): tab(tab_arg), table(tab_arg->table) {}
+  void fill(READ_RECORD *info);
+  inline void skip_row();
+  static int read_record(READ_RECORD *info);
+public:
+  static Batch_scan *create(JOIN_TAB *tab);
+  void start(READ_RECORD *info);
+  void cleanup();
+};
+
+#endif /* SQL_BATCH_INCLUDED */
@@ -612,6 +612,8 @@ bool Query_cache::try_lock(THD *thd, Cache_try_lock_mode mode)
   }
   m_requests_in_progress++;
   fix_local_query_cache_mode(thd);
+  if (m_cache_lock_status == Query_cache::LOCKED)
+    lock_waits++;
 
   while (1)
   {
@@ -723,6 +725,8 @@ void Query_cache::lock(THD *thd)
   mysql_mutex_lock(&structure_guard_mutex);
   m_requests_in_progress++;
   fix_local_query_cache_mode(thd);
+  if (m_cache_lock_status != Query_cache::UNLOCKED)
+    lock_waits++;
   while (m_cache_lock_status != Query_cache::UNLOCKED)
     mysql_cond_wait(&COND_cache_status_changed, &structure_guard_mutex);
   m_cache_lock_status= Query_cache::LOCKED;
@@ -1113,8 +1117,8 @@ Query_cache::insert(Query_cache_tls *query_cache_tls,
     header->result(result);
     DBUG_PRINT("qcache", ("free query 0x%lx", (ulong) query_block));
     // The following call will remove the lock on query_block
-    query_cache.free_query(query_block);
-    query_cache.refused++;
+    free_query(query_block);
+    refused++;
     // append_result_data no success => we need unlock
     unlock();
     DBUG_VOID_RETURN;
@@ -1181,7 +1185,7 @@ void Query_cache::end_of_result(THD *thd)
 
   if (thd->killed)
   {
-    query_cache_abort(&thd->query_cache_tls);
+    abort(query_cache_tls);
     DBUG_VOID_RETURN;
   }
 
@@ -1225,9 +1229,9 @@ void Query_cache::end_of_result(THD *thd)
     }
     last_result_block= header->result()->prev;
     allign_size= ALIGN_SIZE(last_result_block->used);
-    len= MY_MAX(query_cache.min_allocation_unit, allign_size);
-    if (last_result_block->length >= query_cache.min_allocation_unit + len)
-      query_cache.split_block(last_result_block,len);
+    len= MY_MAX(min_allocation_unit, allign_size);
+    if (last_result_block->length >= min_allocation_unit + len)
+      split_block(last_result_block,len);
 
     header->found_rows(limit_found_rows);
     header->result()->type= Query_cache_block::RESULT;
@@ -1262,6 +1266,241 @@ void mysql_query_cache_invalidate4(THD *thd,
 }
 
 
+/*****************************************************************************
+   Query_cache_instances methods
+*****************************************************************************/
+
+struct Query_cache_instance_status
+{
+  char name[12];
+  SHOW_VAR vars[6];
+};
+
+
+void Query_cache_instances::init()
+{
+  Query_cache_instance_status *status;
+  DBUG_ENTER("Query_cache_instances::init");
+
+  n_instances= (uint) query_cache_instances;
+  if (!(instances= new Query_cache[n_instances]) ||
+      !my_multi_malloc(MYF(MY_WME),
+                       &instance_status_vars,
+                       sizeof(SHOW_VAR) * (n_instances + 1),
+                       &status, sizeof(*status) * n_instances,
+                       NullS))
+  {
+    delete [] instances;
+    instances= 0;
+    n_instances= 0;
+    DBUG_VOID_RETURN;
+  }
+
+  for (uint i= 0; i < n_instances; i++)
+  {
+    Query_cache *qc= instances + i;
+    SHOW_VAR *var= status[i].vars;
+
+    qc->init();
+
+    my_snprintf(status[i].name, sizeof(status[i].name), "%u", i);
+    instance_status_vars[i].name= status[i].name;
+    instance_status_vars[i].value= (char*) var;
+    instance_status_vars[i].type= SHOW_ARRAY;
+    var[0].name= "free_memory";
+    var[0].value= (char*) &qc->free_memory;
+    var[0].type= SHOW_LONG;
+    var[1].name= "hits";
+    var[1].value= (char*) &qc->hits;
+    var[1].type= SHOW_LONG;
+    var[2].name= "lock_waits";
+    var[2].value= (char*) &qc->lock_waits;
+    var[2].type= SHOW_LONG;
+    var[3].name= "misses";
+    var[3].value= (char*) &qc->misses;
+    var[3].type= SHOW_LONG;
+    var[4].name= "queries_in_cache";
+    var[4].value= (char*) &qc->queries_in_cache;
+    var[4].type= SHOW_LONG;
+    var[5].name= 0;
+  }
+  instance_status_vars[n_instances].name= 0;
+  DBUG_VOID_RETURN;
+}
+
+
+void Query_cache_instances::destroy()
+{
+  DBUG_ENTER("Query_cache_instances::destroy");
+  for (uint i= 0; i < n_instances; i++)
+    instances[i].destroy();
+  delete [] instances;
+  instances= 0;
+  n_instances= 0;
+  my_free(instance_status_vars);
+  instance_status_vars= 0;
+  DBUG_VOID_RETURN;
+}
+
+
+/**
+  Resize the query cache; every instance gets an equal share of the memory.
+
+  @return size of all instances, 0 if the cache is disabled
+*/
+
+ulong Query_cache_instances::resize(ulong query_cache_size_arg)
+{
+  ulong new_query_cache_size= 0;
+  bool disabled= false;
+  DBUG_ENTER("Query_cache_instances::resize");
+
+  if (global_system_variables.query_cache_type == 0)
+  {
+    DBUG_ASSERT(query_cache_size_arg == 0);
+    if (query_cache_size_arg != 0)
+      my_error(ER_QUERY_CACHE_IS_DISABLED, MYF(0));
+    DBUG_RETURN(0);
+  }
+  if (!n_instances)
+    DBUG_RETURN(0);
+
+  for (uint i= 0; i < n_instances; i++)
+  {
+    ulong share= query_cache_size_arg / n_instances;
+    if (i == 0)
+      share+= query_cache_size_arg % n_instances;
+    ulong size= instances[i].resize(share);
+    if (!size)
+      disabled= true;
+    new_query_cache_size+= size;
+  }
+
+  /* The share of an instance was too small: disable all of them */
+  if (disabled && new_query_cache_size)
+  {
+    for (uint i= 0; i < n_instances; i++)
+      instances[i].resize(0);
+    new_query_cache_size= 0;
+  }
+  query_cache_size= new_query_cache_size;
+  DBUG_RETURN(new_query_cache_size);
+}
+
+
+void Query_cache_instances::result_size_limit(ulong limit)
+{
+  for (uint i= 0; i < n_instances; i++)
+    instances[i].result_size_limit(limit);
+}
+
+
+ulong Query_cache_instances::set_min_res_unit(ulong size)
+{
+  for (uint i= 0; i < n_instances; i++)
+    size= instances[i].set_min_res_unit(size);
+  return size;
+}
+
+
+/**
+  Find the instance that caches the current query.
+
+  The statement text in thd->base_query is the first part of the query
+  key, so the same statement is always looked up in the instance it was
+  stored in.
+*/
+
+Query_cache *Query_cache_instances::instance_for_query(THD *thd)
+{
+  if (n_instances == 1)
+    return instances;
+  return instances + my_hash_sort(&my_charset_bin,
+                                  (const uchar*) thd->base_query.ptr(),
+                                  thd->base_query.length()) % n_instances;
+}
+
+
+void Query_cache_instances::store_query(THD *thd, TABLE_LIST *tables_used)
+{
+  /*
+    thd->base_query is only set up for statements that may be cached;
+    see also Query_cache::store_query().
+  */
+  if (!thd->query_cache_is_applicable || query_cache_size == 0 ||
+      thd->lex->sql_command != SQLCOM_SELECT)
+    return;
+  instance_for_query(thd)->store_query(thd, tables_used);
+}
+
+
+void Query_cache_instances::flush()
+{
+  for (uint i= 0; i < n_instances; i++)
+    instances[i].flush();
+}
+
+
+void Query_cache_instances::pack(THD *thd)
+{
+  for (uint i= 0; i < n_instances; i++)
+    instances[i].pack(thd);
+}
+
+
+/*
+  The result of a query is stored in the instance that registered the
+  writer in Query_cache::store_query(). See the note on double-check
+  locking above: query_cache_tls->instance is only changed by the
+  thread itself.
+*/
+
+void Query_cache_instances::insert(Query_cache_tls *query_cache_tls,
+                                   const char *packet, ulong length,
+                                   unsigned pkt_nr)
+{
+  if (query_cache_tls->first_query_block)
+    query_cache_tls->instance->insert(query_cache_tls, packet, length,
+                                      pkt_nr);
+}
+
+
+void Query_cache_instances::end_of_result(THD *thd)
+{
+  if (thd->query_cache_tls.first_query_block)
+    thd->query_cache_tls.instance->end_of_result(thd);
+}
+
+
+void Query_cache_instances::abort(Query_cache_tls *query_cache_tls)
+{
+  if (query_cache_tls->first_query_block)
+    query_cache_tls->instance->abort(query_cache_tls);
+}
+
+
+void Query_cache_instances::disable_query_cache(THD *thd)
+{
+  for (uint i= 0; i < n_instances; i++)
+    instances[i].disable_query_cache(thd);
+}
+
+
+/**
+  Reset the counters that FLUSH STATUS resets.
+*/
+
+void Query_cache_instances::reset_statistics()
+{
+  for (uint i= 0; i < n_instances; i++)
+  {
+    Query_cache *qc= instances + i;
+    qc->hits= qc->inserts= qc->refused= qc->lowmem_prunes= 0;
+    qc->misses= qc->lock_waits= 0;
+  }
+}
+
+
 /*****************************************************************************
    Query_cache methods
 *****************************************************************************/
@@ -1274,7 +1513,7 @@ Query_cache::Query_cache(ulong query_cache_limit_arg,
   :query_cache_size(0),
    query_cache_limit(query_cache_limit_arg),
    queries_in_cache(0), hits(0), inserts(0), refused(0),
-   total_blocks(0), lowmem_prunes(0),
+   total_blocks(0), lowmem_prunes(0), misses(0), lock_waits(0),
    m_cache_status(OK),
    min_allocation_unit(ALIGN_SIZE(min_allocation_unit_arg)),
    min_result_data_size(ALIGN_SIZE(min_result_data_size_arg)),
@@ -1288,6 +1527,11 @@ Query_cache::Query_cache(ulong query_cache_limit_arg,
   set_if_bigger(min_allocation_unit,min_needed);
   this->min_allocation_unit= ALIGN_SIZE(min_allocation_unit);
   set_if_bigger(this->min_result_data_size,min_allocation_unit);
+  bzero(table_filter, sizeof(table_filter));
+  /* Instances are allocated from the heap, not zero-filled like a global */
+  my_hash_clear(&queries);
+  my_hash_clear(&tables);
+  make_disabled();
 }
 
 
@@ -1336,6 +1580,7 @@ ulong Query_cache::resize(ulong query_cache_size_arg)
     queries_blocks= NULL; // avoid second destroying by free_cache
   }
   free_cache();
+  clear_table_filter();
 
   query_cache_size= query_cache_size_arg;
   new_query_cache_size= init_cache();
@@ -1558,6 +1803,7 @@ def_week_frmt: %lu, in_trans: %d, autocommit: %d",
 	inserts++;
 	queries_in_cache++;
 	thd->query_cache_tls.first_query_block= query_block;
+	thd->query_cache_tls.instance= this;
 	header->writer(&thd->query_cache_tls);
 	header->tables_type(tables_type);
 
@@ -1696,19 +1942,13 @@ size_t build_normalized_name(char *buff, size_t bufflen,
 */
 
 int
-Query_cache::send_result_to_client(THD *thd, char *org_sql, uint query_length)
+Query_cache_instances::send_result_to_client(THD *thd, char *org_sql,
+                                             uint query_length)
 {
-  ulonglong engine_data;
-  Query_cache_query *query;
-#ifndef EMBEDDED_LIBRARY
-  Query_cache_block *first_result_block;
-#endif
-  Query_cache_block *result_block;
-  Query_cache_block_table *block_table, *block_table_end;
   ulong tot_length;
   Query_cache_query_flags flags;
   const char *sql, *sql_end, *found_brace= 0;
-  DBUG_ENTER("Query_cache::send_result_to_client");
+  DBUG_ENTER("Query_cache_instances::send_result_to_client");
 
   /*
     Testing without a lock here is safe: the thing
@@ -1846,23 +2086,6 @@ Query_cache::send_result_to_client(THD *thd, char *org_sql, uint query_length)
       goto err;
     }
   }
-  /*
-    Try to obtain an exclusive lock on the query cache. If the cache is
-    disabled or if a full cache flush is in progress, the attempt to
-    get the lock is aborted.
-
-    The TIMEOUT parameter indicate that the lock is allowed to timeout.
-  */
-  if (try_lock(thd, Query_cache::TIMEOUT))
-    goto err;
-
-  if (query_cache_size == 0)
-  {
-    thd->query_cache_is_applicable= 0;            // Query can't be cached
-    goto err_unlock;
-  }
-
-  Query_cache_block *query_block;
   if (thd->variables.query_cache_strip_comments)
   {
     if (found_brace)
@@ -1945,6 +2168,55 @@ def_week_frmt: %lu, in_trans: %d, autocommit: %d",
                           (int)flags.autocommit));
   memcpy((uchar *)(sql + (tot_length - QUERY_CACHE_FLAGS_SIZE)),
 	 (uchar*) &flags, QUERY_CACHE_FLAGS_SIZE);
+
+  DBUG_RETURN(instance_for_query(thd)->send_cached_result(thd, sql,
+                                                          tot_length));
+
+err:
+  thd->query_cache_is_applicable= 0;            // Query can't be cached
+  DBUG_RETURN(0);				// Query was not cached
+}
+
+
+/**
+  Look up a query in this cache and send the cached result to the client.
+
+  @param thd Pointer to the thread handler
+  @param sql The key of the query: query text, database and flags
+  @param tot_length Length of the key
+
+  @return status code, see Query_cache_instances::send_result_to_client()
+*/
+
+int
+Query_cache::send_cached_result(THD *thd, const char *sql, ulong tot_length)
+{
+  ulonglong engine_data;
+  Query_cache_query *query;
+#ifndef EMBEDDED_LIBRARY
+  Query_cache_block *first_result_block;
+#endif
+  Query_cache_block *result_block;
+  Query_cache_block_table *block_table, *block_table_end;
+  Query_cache_block *query_block;
+  DBUG_ENTER("Query_cache::send_cached_result");
+
+  /*
+    Try to obtain an exclusive lock on the query cache. If the cache is
+    disabled or if a full cache flush is in progress, the attempt to
+    get the lock is aborted.
+
+    The TIMEOUT parameter indicate that the lock is allowed to timeout.
+  */
+  if (try_lock(thd, Query_cache::TIMEOUT))
+    goto err;
+
+  if (query_cache_size == 0)
+  {
+    thd->query_cache_is_applicable= 0;            // Query can't be cached
+    goto err_unlock;
+  }
+
   query_block = (Query_cache_block *)  my_hash_search(&queries, (uchar*) sql,
                                                       tot_length);
   /* Quick abort on unlocked data */
@@ -2159,6 +2431,7 @@ def_week_frmt: %lu, in_trans: %d, autocommit: %d",
   DBUG_RETURN(1);				// Result sent to client
 
 err_unlock:
+  misses++;
   unlock();
   MYSQL_QUERY_CACHE_MISS(thd->query());
   /*
@@ -2177,10 +2450,10 @@ def_week_frmt: %lu, in_trans: %d, autocommit: %d",
   Remove all cached queries that uses any of the tables in the list
 */
 
-void Query_cache::invalidate(THD *thd, TABLE_LIST *tables_used,
-			     my_bool using_transactions)
+void Query_cache_instances::invalidate(THD *thd, TABLE_LIST *tables_used,
+                                       my_bool using_transactions)
 {
-  DBUG_ENTER("Query_cache::invalidate (table list)");
+  DBUG_ENTER("Query_cache_instances::invalidate (table list)");
   if (is_disabled())
     DBUG_VOID_RETURN;
 
@@ -2208,9 +2481,10 @@ void Query_cache::invalidate(THD *thd, TABLE_LIST *tables_used,
   DBUG_VOID_RETURN;
 }
 
-void Query_cache::invalidate(THD *thd, CHANGED_TABLE_LIST *tables_used)
+void Query_cache_instances::invalidate(THD *thd,
+                                       CHANGED_TABLE_LIST *tables_used)
 {
-  DBUG_ENTER("Query_cache::invalidate (changed table list)");
+  DBUG_ENTER("Query_cache_instances::invalidate (changed table list)");
   if (is_disabled())
     DBUG_VOID_RETURN;
 
@@ -2230,16 +2504,16 @@ void Query_cache::invalidate(THD *thd, CHANGED_TABLE_LIST *tables_used)
   Invalidate locked for write
 
   SYNOPSIS
-    Query_cache::invalidate_locked_for_write()
+    Query_cache_instances::invalidate_locked_for_write()
     tables_used - table list
 
   NOTE
     can be used only for opened tables
 */
-void Query_cache::invalidate_locked_for_write(THD *thd,
-                                              TABLE_LIST *tables_used)
+void Query_cache_instances::invalidate_locked_for_write(THD *thd,
+                                                        TABLE_LIST *tables_used)
 {
-  DBUG_ENTER("Query_cache::invalidate_locked_for_write");
+  DBUG_ENTER("Query_cache_instances::invalidate_locked_for_write");
   if (is_disabled())
     DBUG_VOID_RETURN;
 
@@ -2259,10 +2533,10 @@ void Query_cache::invalidate_locked_for_write(THD *thd,
   Remove all cached queries that uses the given table
 */
 
-void Query_cache::invalidate(THD *thd, TABLE *table, 
-			     my_bool using_transactions)
+void Query_cache_instances::invalidate(THD *thd, TABLE *table,
+                                       my_bool using_transactions)
 {
-  DBUG_ENTER("Query_cache::invalidate (table)");
+  DBUG_ENTER("Query_cache_instances::invalidate (table)");
   if (is_disabled())
     DBUG_VOID_RETURN;
 
@@ -2277,10 +2551,11 @@ void Query_cache::invalidate(THD *thd, TABLE *table,
   DBUG_VOID_RETURN;
 }
 
-void Query_cache::invalidate(THD *thd, const char *key, uint32  key_length,
-			     my_bool using_transactions)
+void Query_cache_instances::invalidate(THD *thd, const char *key,
+                                       uint32 key_length,
+                                       my_bool using_transactions)
 {
-  DBUG_ENTER("Query_cache::invalidate (key)");
+  DBUG_ENTER("Query_cache_instances::invalidate (key)");
   if (is_disabled())
    DBUG_VOID_RETURN;
 
@@ -2298,6 +2573,15 @@ void Query_cache::invalidate(THD *thd, const char *key, uint32  key_length,
    Remove all cached queries that uses the given database.
 */
 
+void Query_cache_instances::invalidate(THD *thd, char *db)
+{
+  if (is_disabled())
+    return;
+  for (uint i= 0; i < n_instances; i++)
+    instances[i].invalidate(thd, db);
+}
+
+
 void Query_cache::invalidate(THD *thd, char *db)
 {
   DBUG_ENTER("Query_cache::invalidate (db)");
@@ -2371,9 +2655,9 @@ void Query_cache::invalidate(THD *thd, char *db)
 }
 
 
-void Query_cache::invalidate_by_MyISAM_filename(const char *filename)
+void Query_cache_instances::invalidate_by_MyISAM_filename(const char *filename)
 {
-  DBUG_ENTER("Query_cache::invalidate_by_MyISAM_filename");
+  DBUG_ENTER("Query_cache_instances::invalidate_by_MyISAM_filename");
 
   if (is_disabled())
     DBUG_VOID_RETURN;
@@ -2381,7 +2665,8 @@ void Query_cache::invalidate_by_MyISAM_filename(const char *filename)
   /* Calculate the key outside the lock to make the lock shorter */
   char key[MAX_DBKEY_LENGTH];
   uint32 db_length;
-  uint key_length= filename_2_table_key(key, filename, &db_length);
+  uint key_length= Query_cache::filename_2_table_key(key, filename,
+                                                     &db_length);
   THD *thd= current_thd;
   invalidate_table(thd,(uchar *)key, key_length);
   DBUG_VOID_RETURN;
@@ -2405,7 +2690,7 @@ void Query_cache::flush()
     DUMP(this);
   }
 
-  DBUG_EXECUTE("check_querycache",query_cache.check_integrity(1););
+  DBUG_EXECUTE("check_querycache",check_integrity(1););
   unlock();
   DBUG_VOID_RETURN;
 }
@@ -2881,6 +3166,8 @@ void Query_cache::free_query_internal(Query_cache_block *query_block)
 
   for (TABLE_COUNTER_TYPE i= 0; i < query_block->n_tables; i++)
     unlink_table(table++);
+  if (queries_in_cache == 0)
+    clear_table_filter();
   Query_cache_block *result_block= query->result();
 
   /*
@@ -3208,7 +3495,7 @@ my_bool Query_cache::allocate_data_chain(Query_cache_block **result_block,
   Invalidate the first table in the table_list
 */
 
-void Query_cache::invalidate_table(THD *thd, TABLE_LIST *table_list)
+void Query_cache_instances::invalidate_table(THD *thd, TABLE_LIST *table_list)
 {
   if (table_list->table != 0)
     invalidate_table(thd, table_list->table);	// Table is open
@@ -3223,16 +3510,27 @@ void Query_cache::invalidate_table(THD *thd, TABLE_LIST *table_list)
   }
 }
 
-void Query_cache::invalidate_table(THD *thd, TABLE *table)
+void Query_cache_instances::invalidate_table(THD *thd, TABLE *table)
 {
   invalidate_table(thd, (uchar*) table->s->table_cache_key.str,
                    table->s->table_cache_key.length);
 }
 
+void Query_cache_instances::invalidate_table(THD *thd, uchar *key,
+                                             uint32 key_length)
+{
+  for (uint i= 0; i < n_instances; i++)
+    instances[i].invalidate_table(thd, key, key_length);
+}
+
 void Query_cache::invalidate_table(THD *thd, uchar * key, uint32  key_length)
 {
   DEBUG_SYNC(thd, "wait_in_query_cache_invalidate1");
 
+  /* Don't take the lock if no query in this cache used the table */
+  if (!may_use_table(key, key_length))
+    return;
+
   /*
     Lock the query cache and queue all invalidation attempts to avoid
     the risk of a race between invalidation, cache inserts and flushes.
@@ -3248,6 +3546,67 @@ void Query_cache::invalidate_table(THD *thd, uchar * key, uint32  key_length)
 }
 
 
+/**
+  Hash a table key to a bit of the table filter.
+*/
+
+static inline uint table_filter_bit(const uchar *key, uint32 key_length)
+{
+  return my_hash_sort(&my_charset_bin, key, key_length) %
+         QUERY_CACHE_TABLE_FILTER_BITS;
+}
+
+
+/**
+  Note that the table with the given key is used by a cached query.
+
+  @pre LOCKED is set.
+*/
+
+void Query_cache::add_to_table_filter(const char *key, uint32 key_length)
+{
+  uint bit= table_filter_bit((const uchar*) key, key_length);
+  mysql_mutex_lock(&structure_guard_mutex);
+  table_filter[bit / 8]|= (uchar) (1 << (bit % 8));
+  mysql_mutex_unlock(&structure_guard_mutex);
+}
+
+
+/**
+  Check if a query using the table with the given key may be cached.
+
+  A table that is registered after the check belongs to a query that was
+  stored after the invalidation, the same as if the invalidation had got
+  the lock first.
+
+  @return FALSE if no cached query uses the table
+*/
+
+bool Query_cache::may_use_table(const uchar *key, uint32 key_length)
+{
+  uint bit= table_filter_bit(key, key_length);
+  bool res;
+  mysql_mutex_lock(&structure_guard_mutex);
+  res= MY_TEST(table_filter[bit / 8] & (1 << (bit % 8)));
+  mysql_mutex_unlock(&structure_guard_mutex);
+  return res;
+}
+
+
+/**
+  Forget the tables of the table filter when no query is cached.
+
+  @pre LOCKED or LOCKED_NO_WAIT is set.
+*/
+
+void Query_cache::clear_table_filter()
+{
+  mysql_mutex_lock(&structure_guard_mutex);
+  bzero(table_filter, sizeof(table_filter));
+  mysql_mutex_unlock(&structure_guard_mutex);
+}
+
+
 /**
   Try to locate and invalidate a table by name.
   The caller must ensure that no other thread is trying to work with
@@ -3506,6 +3865,8 @@ Query_cache::insert_table(uint key_len, const char *key,
     header->callback(callback);
     header->engine_data(engine_data);
     header->set_hashed(hash);
+    if (hash)
+      add_to_table_filter(key, key_len);
 
     /*
       We insert this table without the assumption that it isn't refrenenced by
@@ -4173,7 +4534,7 @@ void Query_cache::pack_cache()
 {
   DBUG_ENTER("Query_cache::pack_cache");
 
-  DBUG_EXECUTE("check_querycache",query_cache.check_integrity(1););
+  DBUG_EXECUTE("check_querycache",check_integrity(1););
 
   uchar *border = 0;
   Query_cache_block *before = 0;
@@ -4205,7 +4566,7 @@ void Query_cache::pack_cache()
     DUMP(this);
   }
 
-  DBUG_EXECUTE("check_querycache",query_cache.check_integrity(1););
+  DBUG_EXECUTE("check_querycache",check_integrity(1););
   DBUG_VOID_RETURN;
 }
 
@@ -4587,6 +4948,28 @@ my_bool in_blocks(Query_cache_block * point) { return 0; }
 #else
 
 
+/*
+  Switch all query cache instances off; used for errors found in a block
+  that does not know its instance.
+*/
+
+void Query_cache_instances::wreck(uint line, const char *message)
+{
+  for (uint i= 0; i < n_instances; i++)
+    instances[i].wreck(line, message);
+  query_cache_size= 0;
+}
+
+
+my_bool Query_cache_instances::check_integrity(bool locked)
+{
+  my_bool result= 0;
+  for (uint i= 0; i < n_instances; i++)
+    result|= instances[i].check_integrity(locked);
+  return result;
+}
+
+
 /*
   Debug method which switch query cache off but left content for
   investigation.
@@ -66,6 +66,12 @@ typedef struct st_changed_table_list CHANGED_TABLE_LIST;
 #define QUERY_CACHE_PACK_ITERATION		2
 #define QUERY_CACHE_PACK_LIMIT			(512*1024L)
 
+/* maximal number of query cache instances */
+#define QUERY_CACHE_MAX_INSTANCES		64
+
+/* size in bits of the filter of tables used in a query cache instance */
+#define QUERY_CACHE_TABLE_FILTER_BITS		4096
+
 #define TABLE_COUNTER_TYPE uint
 
 struct Query_cache_block;
@@ -295,6 +301,7 @@ class Query_cache
   /* statistics */
   ulong free_memory, queries_in_cache, hits, inserts, refused,
     free_memory_blocks, total_blocks, lowmem_prunes;
+  ulong misses, lock_waits;
 
 
 private:
@@ -308,8 +315,20 @@ class Query_cache
   enum Cache_staus {OK, DISABLE_REQUEST, DISABLED};
   Cache_staus m_cache_status;
 
+  /*
+    One bit per hash value of the keys of the tables used by the cached
+    queries. Bits are set when a table is registered and cleared when
+    the cache becomes empty. Protected by structure_guard_mutex, so an
+    invalidation can skip a cache that never used the table without
+    waiting for the cache lock.
+  */
+  uchar table_filter[QUERY_CACHE_TABLE_FILTER_BITS / 8];
+
   void free_query_internal(Query_cache_block *point);
   void invalidate_table_internal(THD *thd, uchar *key, uint32 key_length);
+  void add_to_table_filter(const char *key, uint32 key_length);
+  bool may_use_table(const uchar *key, uint32 key_length);
+  void clear_table_filter();
 
 protected:
   /*
@@ -360,9 +379,6 @@ class Query_cache
 			      ulong data_len,
 			      Query_cache_block *query_block,
 			      my_bool first_block);
-  void invalidate_table(THD *thd, TABLE_LIST *table);
-  void invalidate_table(THD *thd, TABLE *table);
-  void invalidate_table(THD *thd, uchar *key, uint32  key_length);
   void invalidate_table(THD *thd, Query_cache_block *table_block);
   void invalidate_query_block_list(THD *thd, 
                                    Query_cache_block_table *list_root);
@@ -460,26 +476,17 @@ class Query_cache
   void store_query(THD *thd, TABLE_LIST *used_tables);
 
   /*
-    Check if the query is in the cache and if this is true send the
-    data to client.
+    Check if the query with the given key is in the cache and if this is
+    true send the data to client.
   */
-  int send_result_to_client(THD *thd, char *query, uint query_length);
+  int send_cached_result(THD *thd, const char *key, ulong key_length);
 
-  /* Remove all queries that uses any of the listed following tables */
-  void invalidate(THD *thd, TABLE_LIST *tables_used,
-		  my_bool using_transactions);
-  void invalidate(THD *thd, CHANGED_TABLE_LIST *tables_used);
-  void invalidate_locked_for_write(THD *thd, TABLE_LIST *tables_used);
-  void invalidate(THD *thd, TABLE *table, my_bool using_transactions);
-  void invalidate(THD *thd, const char *key, uint32  key_length,
-		  my_bool using_transactions);
+  /* Remove all queries that uses the table with the given key */
+  void invalidate_table(THD *thd, uchar *key, uint32  key_length);
 
   /* Remove all queries that uses any of the tables in following database */
   void invalidate(THD *thd, char *db);
 
-  /* Remove all queries that uses any of the listed following table */
-  void invalidate_by_MyISAM_filename(const char *filename);
-
   void flush();
   void pack(THD *thd,
             ulong join_limit = QUERY_CACHE_PACK_LIMIT,
@@ -533,6 +540,92 @@ class Query_cache
   void disable_query_cache(THD *thd);
 };
 
+
+/**
+  The query cache, split into query_cache_instances instances.
+
+  A statement is stored in and looked up from the instance chosen by a
+  hash of the statement text, so that statements in different instances
+  do not wait for each other. Every instance has its own memory, hashes
+  and lock. Table invalidation goes through all instances, but does not
+  lock the ones that have never cached a query using the table.
+*/
+
+class Query_cache_instances
+{
+  Query_cache *instances;
+  uint n_instances;
+
+  Query_cache *instance_for_query(THD *thd);
+  void invalidate_table(THD *thd, TABLE_LIST *table);
+  void invalidate_table(THD *thd, TABLE *table);
+  void invalidate_table(THD *thd, uchar *key, uint32 key_length);
+
+public:
+  /* Memory of all instances; tested without a mutex */
+  ulong query_cache_size;
+
+  Query_cache_instances()
+    :instances(0), n_instances(0), query_cache_size(0),
+    instance_status_vars(0)
+  {}
+
+  inline uint instance_count() { return n_instances; }
+  inline Query_cache *instance(uint i) { return instances + i; }
+
+  /* All instances are enabled and disabled together */
+  inline bool is_disabled(void)
+  { return !instances || instances[0].is_disabled(); }
+  inline bool is_disable_in_progress(void)
+  { return instances && instances[0].is_disable_in_progress(); }
+
+  /* create query_cache_instances instances */
+  void init();
+  void destroy();
+  /* resize query cache (return real query size, 0 if disabled) */
+  ulong resize(ulong query_cache_size);
+  void result_size_limit(ulong limit);
+  ulong set_min_res_unit(ulong size);
+
+  void store_query(THD *thd, TABLE_LIST *used_tables);
+  int send_result_to_client(THD *thd, char *query, uint query_length);
+
+  /* Remove all queries that uses any of the listed following tables */
+  void invalidate(THD *thd, TABLE_LIST *tables_used,
+		  my_bool using_transactions);
+  void invalidate(THD *thd, CHANGED_TABLE_LIST *tables_used);
+  void invalidate_locked_for_write(THD *thd, TABLE_LIST *tables_used);
+  void invalidate(THD *thd, TABLE *table, my_bool using_transactions);
+  void invalidate(THD *thd, const char *key, uint32  key_length,
+		  my_bool using_transactions);
+
+  /* Remove all queries that uses any of the tables in following database */
+  void invalidate(THD *thd, char *db);
+
+  /* Remove all queries that uses any of the listed following table */
+  void invalidate_by_MyISAM_filename(const char *filename);
+
+  void flush();
+  void pack(THD *thd);
+
+  void insert(Query_cache_tls *query_cache_tls,
+              const char *packet,
+              ulong length,
+              unsigned pkt_nr);
+  void end_of_result(THD *thd);
+  void abort(Query_cache_tls *query_cache_tls);
+
+  void disable_query_cache(THD *thd);
+
+  /* Qcache_instance_<N>_* status variables */
+  struct st_mysql_show_var *instance_status_vars;
+  /* FLUSH STATUS */
+  void reset_statistics();
+
+  void wreck(uint line, const char *message);
+  my_bool check_integrity(bool not_locked);
+};
+
 #ifdef HAVE_QUERY_CACHE
 struct Query_cache_query_flags
 {
@@ -596,5 +689,5 @@ struct Query_cache_query_flags
 #define query_cache_is_cacheable_query(L) 0
 #endif /*HAVE_QUERY_CACHE*/
 
-extern Query_cache query_cache;
+extern Query_cache_instances query_cache;
 #endif
@@ -89,6 +89,9 @@ enum enum_slave_run_triggers_for_rbr { SLAVE_RUN_TRIGGERS_FOR_RBR_NO,
                                        SLAVE_RUN_TRIGGERS_FOR_RBR_LOGGING};
 enum enum_slave_type_conversions { SLAVE_TYPE_CONVERSIONS_ALL_LOSSY,
                                    SLAVE_TYPE_CONVERSIONS_ALL_NON_LOSSY};
+enum enum_slave_rows_search_algorithms { SLAVE_ROWS_TABLE_SCAN,
+                                         SLAVE_ROWS_INDEX_SCAN,
+                                         SLAVE_ROWS_HASH_SCAN };
 enum enum_mark_columns
 { MARK_COLUMNS_NONE, MARK_COLUMNS_READ, MARK_COLUMNS_WRITE};
 enum enum_filetype { FILETYPE_CSV, FILETYPE_XML };
@@ -380,6 +383,7 @@ class MY_LOCALE;
 */
 
 struct Query_cache_block;
+class Query_cache;
 
 struct Query_cache_tls
 {
@@ -388,12 +392,14 @@ struct Query_cache_tls
     functions and methods to maintain proper locking.
   */
   Query_cache_block *first_query_block;
+  /* Query cache instance of first_query_block */
+  Query_cache *instance;
   void set_first_query_block(Query_cache_block *first_query_block_arg)
   {
     first_query_block= first_query_block_arg;
   }
 
-  Query_cache_tls() :first_query_block(NULL) {}
+  Query_cache_tls() :first_query_block(NULL), instance(NULL) {}
 };
 
 /* SIGNAL / RESIGNAL / GET DIAGNOSTICS */
@@ -542,6 +548,8 @@ typedef struct system_variables
   ulong max_error_count;
   ulong max_length_for_sort_data;
   ulong max_sort_length;
+  ulong max_sort_threads;
+  ulong max_partition_scan_threads;
   ulong max_tmp_tables;
   ulong max_insert_delayed_threads;
   ulong min_examined_row_limit;
@@ -559,10 +567,12 @@ typedef struct system_variables
   ulong use_stat_tables;
   ulong histogram_size;
   ulong histogram_type;
+  ulong analyze_sample_percentage;
   ulong preload_buff_size;
   ulong profiling_history_size;
   ulong read_buff_size;
   ulong read_rnd_buff_size;
+  ulong load_data_read_ahead;
   ulong mrr_buff_size;
   ulong div_precincrement;
   /* Total size of all buffers used by the subselect_rowid_merge_engine. */
@@ -584,6 +594,7 @@ typedef struct system_variables
   ulong query_cache_type;
   ulong tx_isolation;
   ulong updatable_views_with_limit;
+  ulong threadpool_priority; ///< see enum TP_PRIORITY
   int max_user_connections;
   ulong server_id;
   /**
@@ -74,6 +74,8 @@
 
 #define MAX_SORT_MEMORY 2048*1024
 #define MIN_SORT_MEMORY 1024
+#define MAX_SORT_THREADS 64
+#define MAX_PARTITION_SCAN_THREADS 64
 
 /* Some portable defines */
 
@@ -112,6 +114,8 @@
 #define USER_VARS_HASH_SIZE     16
 #define TABLE_OPEN_CACHE_MIN    400
 #define TABLE_OPEN_CACHE_DEFAULT 400
+#define TABLE_OPEN_CACHE_INSTANCES_DEFAULT 8
+#define TABLE_OPEN_CACHE_INSTANCES_MAX 64
 #define TABLE_DEF_CACHE_DEFAULT 400
 /**
   We must have room for at least 400 table definitions in the table
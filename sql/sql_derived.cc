@@ -636,6 +636,7 @@ bool mysql_derived_prepare(THD *thd, LEX *lex, TABLE_LIST *derived)
     DBUG_RETURN(FALSE);
 
   SELECT_LEX *first_select= unit->first_select();
+  ulonglong create_options;
 
   /* prevent name resolving out of derived table */
   for (SELECT_LEX *sl= first_select; sl; sl= sl->next_select())
@@ -686,13 +687,16 @@ bool mysql_derived_prepare(THD *thd, LEX *lex, TABLE_LIST *derived)
     !unit->union_distinct->next_select() (i.e. it is union and last distinct
     SELECT is last SELECT of UNION).
   */
+  create_options= (first_select->options | thd->variables.option_bits |
+                   TMP_TABLE_ALL_COLUMNS);
+  /* MATCH() in the outer select needs a table with fulltext support */
+  if (derived->select_lex->ftfunc_list->elements)
+    create_options|= TMP_TABLE_FORCE_MYISAM;
   thd->create_tmp_table_for_derived= TRUE;
   if (derived->derived_result->create_result_table(thd, &unit->types, FALSE,
-                                                (first_select->options |
-                                                 thd->variables.option_bits |
-                                                 TMP_TABLE_ALL_COLUMNS),
-                                                derived->alias,
-                                                FALSE, FALSE))
+                                                   create_options,
+                                                   derived->alias,
+                                                   FALSE, FALSE))
   { 
     thd->create_tmp_table_for_derived= FALSE;
     goto exit;
@@ -133,6 +133,15 @@ void Expression_cache_tmptable::init()
     DBUG_PRINT("error", ("we need only heap table"));
     goto error;
   }
+  /* HEAP tables can have blobs, but not in keys */
+  for (Field **field= cache_table->field + 1; *field; field++)
+  {
+    if ((*field)->flags & BLOB_FLAG)
+    {
+      DBUG_PRINT("error", ("blob parameter"));
+      goto error;
+    }
+  }
 
   field_counter= 1;
 
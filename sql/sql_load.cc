@@ -59,9 +59,231 @@ XML_TAG::XML_TAG(int l, String f, String v)
 }
 
 
+#ifdef HAVE_PSI_INTERFACE
+static PSI_mutex_key key_LOCK_read_ahead;
+static PSI_cond_key key_COND_read_ahead;
+static PSI_thread_key key_thread_read_ahead;
+
+static PSI_mutex_info all_sql_load_mutexes[]=
+{
+  { &key_LOCK_read_ahead, "Read_ahead::LOCK_read_ahead", 0}
+};
+
+static PSI_cond_info all_sql_load_conds[]=
+{
+  { &key_COND_read_ahead, "Read_ahead::COND_read_ahead", 0}
+};
+
+static PSI_thread_info all_sql_load_threads[]=
+{
+  { &key_thread_read_ahead, "load_data_read_ahead", 0}
+};
+
+void init_sql_load_psi_keys(void)
+{
+  const char* category= "sql";
+
+  if (PSI_server == NULL)
+    return;
+
+  PSI_server->register_mutex(category, all_sql_load_mutexes,
+                             array_elements(all_sql_load_mutexes));
+  PSI_server->register_cond(category, all_sql_load_conds,
+                            array_elements(all_sql_load_conds));
+  PSI_server->register_thread(category, all_sql_load_threads,
+                              array_elements(all_sql_load_threads));
+}
+#endif
+
+
+/**
+  Reads the file of LOAD DATA INFILE in a separate thread.
+
+  The file is read into a ring of blocks.  The statement thread parses
+  the rows of one block and inserts them, while the reader thread fills
+  the other blocks with the next parts of the file.
+
+  Only the reading is overlapped: tokenizing, Field::store() and
+  ha_write_row() are still done by the statement thread, one row after
+  the other.  Row boundaries are only known after scanning the file
+  from the start (ENCLOSED BY and ESCAPED BY can hide line terminators),
+  and the Append_block events of the binlog are written from the
+  IO_CACHE hooks of the statement thread, so a LOAD DATA remains bound
+  by one core when parsing, not reading, is the bottleneck.
+*/
+
+pthread_handler_t read_ahead_thread(void *arg);
+
+class Read_ahead
+{
+public:
+  Read_ahead(File file_arg);
+  ~Read_ahead();
+  bool start(uint blocks_arg, size_t block_size_arg);
+  void stop();
+  size_t next_block(uchar **block);
+  void read_blocks();
+
+  int error;                            /* errno of a failed read */
+
+private:
+
+  File file;
+  uchar *memory;
+  size_t *lengths;
+  size_t block_size;
+  uint blocks;
+  /* Blocks filled by the reader, handed out and released by the parser */
+  ulonglong filled, taken, released;
+  bool running, eof, abort;
+  pthread_t thread;
+  mysql_mutex_t LOCK_read_ahead;
+  mysql_cond_t COND_read_ahead;
+};
+
+
+Read_ahead::Read_ahead(File file_arg)
+  :error(0), file(file_arg), memory(NULL), lengths(NULL), block_size(0),
+   blocks(0), filled(0), taken(0), released(0), running(false), eof(false),
+   abort(false)
+{
+  mysql_mutex_init(key_LOCK_read_ahead, &LOCK_read_ahead, MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_COND_read_ahead, &COND_read_ahead, NULL);
+}
+
+
+Read_ahead::~Read_ahead()
+{
+  stop();
+  my_free(lengths);
+  my_free(memory);
+  mysql_cond_destroy(&COND_read_ahead);
+  mysql_mutex_destroy(&LOCK_read_ahead);
+}
+
+
+/**
+  Start the reader thread.
+
+  @param blocks_arg      Number of blocks to read ahead of the parser
+  @param block_size_arg  Size of one read
+
+  @return TRUE if the thread could not be started
+*/
+
+bool Read_ahead::start(uint blocks_arg, size_t block_size_arg)
+{
+  DBUG_ENTER("Read_ahead::start");
+  /* One more block for the one that is being parsed */
+  blocks= blocks_arg + 1;
+  block_size= block_size_arg;
+  if (!(memory= (uchar*) my_malloc(blocks * block_size, MYF(MY_WME))) ||
+      !(lengths= (size_t*) my_malloc(blocks * sizeof(size_t), MYF(MY_WME))))
+    DBUG_RETURN(TRUE);
+  if (mysql_thread_create(key_thread_read_ahead, &thread, NULL,
+                          read_ahead_thread, (void*) this))
+    DBUG_RETURN(TRUE);
+  running= true;
+  DBUG_RETURN(FALSE);
+}
+
+
+void Read_ahead::stop()
+{
+  if (!running)
+    return;
+  mysql_mutex_lock(&LOCK_read_ahead);
+  abort= true;
+  mysql_cond_broadcast(&COND_read_ahead);
+  mysql_mutex_unlock(&LOCK_read_ahead);
+  pthread_join(thread, NULL);
+  running= false;
+}
+
+
+pthread_handler_t read_ahead_thread(void *arg)
+{
+  my_thread_init();
+  ((Read_ahead*) arg)->read_blocks();
+  my_thread_end();
+  return 0;
+}
+
+
+void Read_ahead::read_blocks()
+{
+  mysql_mutex_lock(&LOCK_read_ahead);
+  for (;;)
+  {
+    uchar *block= memory + (filled % blocks) * block_size;
+    size_t length;
+
+    while (filled - released >= blocks && !abort)
+      mysql_cond_wait(&COND_read_ahead, &LOCK_read_ahead);
+    if (abort)
+      break;
+    mysql_mutex_unlock(&LOCK_read_ahead);
+
+    length= mysql_file_read(file, block, block_size, MYF(0));
+
+    mysql_mutex_lock(&LOCK_read_ahead);
+    if (length == (size_t) -1)
+    {
+      error= my_errno ? my_errno : -1;
+      break;
+    }
+    if (length == 0)
+    {
+      eof= true;
+      break;
+    }
+    lengths[filled % blocks]= length;
+    filled++;
+    mysql_cond_broadcast(&COND_read_ahead);
+  }
+  mysql_cond_broadcast(&COND_read_ahead);
+  mysql_mutex_unlock(&LOCK_read_ahead);
+}
+
+
+/**
+  Release the block returned by the previous call and wait for the next one.
+
+  @return Length of the block, 0 at end of file or (size_t) -1 on error
+*/
+
+size_t Read_ahead::next_block(uchar **block)
+{
+  size_t length;
+  mysql_mutex_lock(&LOCK_read_ahead);
+  released= taken;
+  mysql_cond_broadcast(&COND_read_ahead);
+  while (filled == taken && !eof && !error)
+    mysql_cond_wait(&COND_read_ahead, &LOCK_read_ahead);
+  if (filled == taken)
+    length= error ? (size_t) -1 : 0;
+  else
+  {
+    *block= memory + (taken % blocks) * block_size;
+    length= lengths[taken % blocks];
+    taken++;
+  }
+  mysql_mutex_unlock(&LOCK_read_ahead);
+  return length;
+}
+
+
 #define GET (stack_pos != stack ? *--stack_pos : my_b_get(&cache))
 #define PUSH(A) *(stack_pos++)=(A)
 
+class READ_INFO;
+
+/* The IO_CACHE of READ_INFO, see READ_INFO::read_ahead_block() */
+struct Load_io_cache: public IO_CACHE
+{
+  READ_INFO *read_info;
+};
+
 class READ_INFO {
   File	file;
   uchar	*buffer,			/* Buffer for read text */
@@ -75,7 +297,8 @@ class READ_INFO {
   int	*stack,*stack_pos;
   bool	found_end_of_line,start_of_line,eof;
   bool  need_end_io_cache;
-  IO_CACHE cache;
+  Load_io_cache cache;
+  Read_ahead *read_ahead;
   NET *io_net;
   int level; /* for load xml */
 
@@ -95,6 +318,13 @@ class READ_INFO {
   char unescape(char chr);
   int terminator(const uchar *ptr, uint length);
   bool find_start_of_fields();
+  bool start_read_ahead(uint blocks);
+  void end_read_ahead()
+  {
+    if (read_ahead)
+      read_ahead->stop();
+  }
+  static int read_ahead_block(IO_CACHE *info, uchar *Buffer, size_t Count);
   /* load xml */
   List<XML_TAG> taglist;
   int read_value(int delim, String *val);
@@ -450,6 +680,15 @@ int mysql_load(THD *thd,sql_exchange *ex,TABLE_LIST *table_list,
     DBUG_RETURN(TRUE);				// Can't allocate buffers
   }
 
+  /*
+    Read a file of the server in a separate thread, ahead of the parsing.
+    A named pipe is still read by this thread, since a reader blocked on
+    it could not be stopped.
+  */
+  if (!read_file_from_client && !is_fifo &&
+      thd->variables.load_data_read_ahead)
+    (void) read_info.start_read_ahead(thd->variables.load_data_read_ahead);
+
 #ifndef EMBEDDED_LIBRARY
   if (mysql_bin_log.is_open())
   {
@@ -519,6 +758,7 @@ int mysql_load(THD *thd,sql_exchange *ex,TABLE_LIST *table_list,
     table->file->extra(HA_EXTRA_WRITE_CANNOT_REPLACE);
     table->next_number_field=0;
   }
+  read_info.end_read_ahead();
   if (file >= 0)
     mysql_file_close(file, MYF(0));
   free_blobs(table);				/* if pack_blob was used */
@@ -1351,7 +1591,8 @@ READ_INFO::READ_INFO(File file_par, uint tot_length, CHARSET_INFO *cs,
 		     bool is_fifo)
   :file(file_par), buffer(NULL), buff_length(tot_length), escape_char(escape),
    found_end_of_line(false), eof(false), need_end_io_cache(false),
-   error(false), line_cuted(false), found_null(false), read_charset(cs)
+   read_ahead(NULL), error(false), line_cuted(false), found_null(false),
+   read_charset(cs)
 {
   /*
     Field and line terminators must be interpreted as sequence of unsigned char.
@@ -1434,6 +1675,7 @@ READ_INFO::~READ_INFO()
 {
   if (need_end_io_cache)
     ::end_io_cache(&cache);
+  delete read_ahead;
   my_free(buffer);
   List_iterator<XML_TAG> xmlit(taglist);
   XML_TAG *t;
@@ -1442,6 +1684,70 @@ READ_INFO::~READ_INFO()
 }
 
 
+/**
+  Read the file in a separate thread, see Read_ahead.
+
+  @return TRUE if the reader thread could not be started, in which case
+          the file is read by the cache as usual
+*/
+
+bool READ_INFO::start_read_ahead(uint blocks)
+{
+  /* init_io_cache() left the file at its end */
+  if (mysql_file_seek(file, cache.pos_in_file, MY_SEEK_SET, MYF(0)) ==
+      MY_FILEPOS_ERROR)
+    return TRUE;
+  if (!(read_ahead= new Read_ahead(file)))
+    return TRUE;
+  /* Same blocks as _my_b_read(), for the Append_block events */
+  if (read_ahead->start(blocks, cache.read_length))
+  {
+    delete read_ahead;
+    read_ahead= NULL;
+    return TRUE;
+  }
+  cache.read_info= this;
+  cache.read_function= read_ahead_block;
+  return FALSE;
+}
+
+
+/**
+  The read_function of the cache when the file is read ahead.
+
+  Like _my_b_net_read(), it points the cache to the next block instead
+  of copying it.  As in _my_b_read(), pos_in_file is the position of the
+  block in the file, for log_loaded_block() and my_b_tell().
+*/
+
+int READ_INFO::read_ahead_block(IO_CACHE *info, uchar *Buffer,
+                                size_t Count __attribute__((unused)))
+{
+  READ_INFO *read_info= static_cast<Load_io_cache*>(info)->read_info;
+  uchar *block;
+  size_t length;
+
+  info->pos_in_file+= (size_t) (info->read_end - info->request_pos);
+  info->request_pos= info->read_pos= info->read_end;
+  length= read_info->read_ahead->next_block(&block);
+  if (length == (size_t) -1)
+  {
+    my_error(ER_ERROR_ON_READ, MYF(0), my_filename(read_info->file),
+             read_info->read_ahead->error);
+    read_info->error= 1;
+    info->error= -1;
+    return 1;
+  }
+  if (length == 0)
+    return 1;                                   /* End of file */
+  info->request_pos= info->read_pos= block;
+  info->read_end= block + length;
+  /* my_b_get() reads one byte at a time */
+  Buffer[0]= *info->read_pos++;
+  return 0;
+}
+
+
 inline int READ_INFO::terminator(const uchar *ptr,uint length)
 {
   int chr=0;					// Keep gcc happy
@@ -30,5 +30,11 @@ int mysql_load(THD *thd, sql_exchange *ex, TABLE_LIST *table_list,
                 enum enum_duplicates handle_duplicates, bool ignore,
                 bool local_file);
 
+#ifdef HAVE_PSI_INTERFACE
+void init_sql_load_psi_keys(void);
+#else
+#define init_sql_load_psi_keys() /* no-op */
+#endif
+
 
 #endif /* SQL_LOAD_INCLUDED */
@@ -53,6 +53,7 @@
 #include "log_slow.h"
 #include "sql_derived.h"
 #include "sql_statistics.h"
+#include "sql_batch.h"         // Batch_scan
 
 #include "debug_sync.h"          // DEBUG_SYNC
 #include <m_ctype.h>
@@ -11374,6 +11375,12 @@ void JOIN_TAB::cleanup()
     cache->free();
     cache= 0;
   }
+  if (batch_scan)
+  {
+    batch_scan->cleanup();
+    batch_scan= 0;
+  }
+  batch_scan_checked= FALSE;
   limit= 0;
   if (table)
   {
@@ -16226,9 +16233,14 @@ create_tmp_table(THD *thd, TMP_TABLE_PARAM *param, List<Item> &fields,
   share->fields= field_count;
   share->column_bitmap_size= bitmap_buffer_size(share->fields);
 
-  /* If result table is small; use a heap */
+  /*
+    If result table is small; use a heap.
+    HEAP stores blobs, but cannot have them in the distinct key.
+    INFORMATION_SCHEMA tables with blobs keep the engine they are shown with.
+  */
   /* future: storage engine selection can be made dynamic? */
-  if (blob_count || using_unique_constraint
+  if ((blob_count && (distinct || param->schema_table))
+      || using_unique_constraint
       || (thd->variables.big_tables && !(select_options & SELECT_SMALL_RESULT))
       || (select_options & TMP_TABLE_FORCE_MYISAM)
       || thd->variables.tmp_table_size == 0)
@@ -16398,13 +16410,15 @@ create_tmp_table(THD *thd, TMP_TABLE_PARAM *param, List<Item> &fields,
   param->recinfo= recinfo;              	// Pointer to after last field
   store_record(table,s->default_values);        // Make empty default record
 
-  if (thd->variables.tmp_table_size == ~ (ulonglong) 0)		// No limit
+  /*
+    HEAP limits the memory of the table to tmp_table_size itself, as its
+    rows can be shorter than reclength.
+  */
+  if (thd->variables.tmp_table_size == ~ (ulonglong) 0 ||	// No limit
+      share->db_type() == heap_hton)
     share->max_rows= ~(ha_rows) 0;
   else
-    share->max_rows= (ha_rows) (((share->db_type() == heap_hton) ?
-                                 MY_MIN(thd->variables.tmp_table_size,
-                                     thd->variables.max_heap_table_size) :
-                                 thd->variables.tmp_table_size) /
+    share->max_rows= (ha_rows) (thd->variables.tmp_table_size /
 			         share->reclength);
   set_if_bigger(share->max_rows,1);		// For dummy start options
   /*
@@ -18761,6 +18775,13 @@ int join_init_read_record(JOIN_TAB *tab)
   if (init_read_record(&tab->read_record, tab->join->thd, tab->table,
                        tab->select,1,1, FALSE))
     return 1;
+  if (!tab->batch_scan_checked)
+  {
+    tab->batch_scan= Batch_scan::create(tab);
+    tab->batch_scan_checked= TRUE;
+  }
+  if (tab->batch_scan)
+    tab->batch_scan->start(&tab->read_record);
   return (*tab->read_record.read_record)(&tab->read_record);
 }
 
@@ -21029,8 +21050,8 @@ remove_duplicates(JOIN *join, TABLE *table, List<Item> &fields, Item *having)
 
   free_io_cache(table);				// Safety
   table->file->info(HA_STATUS_VARIABLE);
-  if (table->s->db_type() == heap_hton ||
-      (!table->s->blob_fields &&
+  if (!table->s->blob_fields &&
+      (table->s->db_type() == heap_hton ||
        ((ALIGN_SIZE(keylength) + HASH_OVERHEAD) * table->file->stats.records <
 	thd->variables.sortbuff_size)))
     error=remove_dup_with_hash_index(join->thd, table, field_count, first_field,
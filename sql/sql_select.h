@@ -197,6 +197,7 @@ int rr_sequential_and_unpack(READ_RECORD *info);
 
 class JOIN_CACHE;
 class SJ_TMP_TABLE;
+class Batch_scan;
 class JOIN_TAB_RANGE;
 
 typedef struct st_join_table {
@@ -417,6 +418,13 @@ typedef struct st_join_table {
 
   bool preread_init_done;
 
+  /*
+    Batched evaluation of the condition for sequential scans (see
+    sql_batch.h), set up by the first join_init_read_record() call.
+  */
+  Batch_scan *batch_scan;
+  bool batch_scan_checked;
+
   void cleanup();
   inline bool is_using_loose_index_scan()
   {
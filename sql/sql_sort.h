@@ -26,6 +26,7 @@ typedef struct st_buffpek BUFFPEK;
 typedef struct st_sort_field SORT_FIELD;
 
 class Field;
+class THD;
 struct TABLE;
 
 /* Defines used by filesort and uniques */
@@ -84,6 +85,8 @@ class Sort_param {
   uchar *unique_buff;
   bool not_killable;
   char* tmp_buffer;
+  uint max_threads;           // Threads allowed for sorting and merging.
+  THD *merge_thd;             // Set when merging in a sort worker thread.
   // The fields below are used only by Unique class.
   qsort2_cmp compare;
   BUFFPEK_COMPARE_CONTEXT cmp_context;
@@ -30,6 +30,13 @@
 #include "opt_range.h"
 #include "my_atomic.h"
 
+/*
+  With analyze_sample_percentage=0 tables with up to this number of rows
+  are analyzed in full, bigger tables on a sample of about this number of
+  rows growing with the logarithm of the table size
+*/
+#define ANALYZE_SAMPLE_MIN_ROWS 50000
+
 /*
   The system variable 'use_stat_tables' can take one of the
   following values:
@@ -186,7 +193,7 @@ class Column_statistics_collected :public Column_statistics
 
   inline void init(THD *thd, Field * table_field);
   inline bool add(ha_rows rowno);
-  inline void finish(ha_rows rows); 
+  inline void finish(ha_rows rows, ha_rows table_rows); 
   inline void cleanup();
 };
 
@@ -1282,6 +1289,7 @@ class Histogram_builder
   uint curr_bucket;        /* number of the current bucket to be built     */
   ulonglong count;         /* number of values retrieved                   */
   ulonglong count_distinct;    /* number of distinct values retrieved      */
+  ulonglong count_singletons;  /* number of values retrieved only once     */
 
 public: 
   Histogram_builder(Field *col, uint col_len, ha_rows rows)
@@ -1296,13 +1304,18 @@ class Histogram_builder
     curr_bucket= 0;
     count= 0;
     count_distinct= 0;    
+    count_singletons= 0;
   }
 
   ulonglong get_count_distinct() { return count_distinct; }
 
+  ulonglong get_count_singletons() { return count_singletons; }
+
   int next(void *elem, element_count elem_cnt)
   {
     count_distinct++;
+    if (elem_cnt == 1)
+      count_singletons++;
     count+= elem_cnt;
     if (curr_bucket == hist_width)
       return 0;
@@ -1332,6 +1345,20 @@ int histogram_build_walk(void *elem, element_count elem_cnt, void *arg)
   return hist_builder->next(elem, elem_cnt);
 }
 
+/*
+  Count the distinct values and, in arg[1], the values that occur only once
+*/
+
+int count_distinct_singletons_walk(void *elem, element_count elem_cnt,
+                                   void *arg)
+{
+  ulonglong *count= (ulonglong *) arg;
+  count[0]++;
+  if (elem_cnt == 1)
+    count[1]++;
+  return 0;
+}
+
 C_MODE_END
 
 
@@ -1419,14 +1446,29 @@ class Count_distinct_field: public Sql_alloc
     return count;
   }
 
+  /*
+    @brief
+    Calculate the number of elements accumulated in the container of 'tree'
+    and the number of them that were added only once
+  */
+  ulonglong get_value_and_singletons(ulonglong *singletons)
+  {
+    ulonglong count[2]= { 0, 0 };
+    tree->walk(table_field->table, count_distinct_singletons_walk,
+               (void*) count);
+    *singletons= count[1];
+    return count[0];
+  }
+
   /*
     @brief
     Build the histogram for the elements accumulated in the container of 'tree'
   */
-  ulonglong get_value_with_histogram(ha_rows rows)
+  ulonglong get_value_with_histogram(ha_rows rows, ulonglong *singletons)
   {
     Histogram_builder hist_builder(table_field, tree_key_length, rows);
     tree->walk(table_field->table,  histogram_build_walk, (void *) &hist_builder);
+    *singletons= hist_builder.get_count_singletons();
     return hist_builder.get_count_distinct();
   }
 
@@ -2240,16 +2282,57 @@ bool Column_statistics_collected::add(ha_rows rowno)
 }
 
 
+/**
+  @brief
+  Estimate the number of distinct values of a column from a sample
+
+  @param
+  distincts     The number of distinct values in the sample
+  @param
+  singletons    The number of values that occur only once in the sample
+  @param
+  sampled       The number of not null values in the sample
+  @param
+  total         The estimated number of not null values in the column
+
+  @details
+  The function uses the Duj1 estimator of Haas and Stokes: the values that
+  occur only once in the sample indicate how many values were not sampled
+  at all. If every sampled value is unique the column is assumed to be
+  unique, if every value was seen at least twice the sample is assumed to
+  contain all the values.
+*/
+
+static
+double estimate_distinct_values(double distincts, double singletons,
+                                double sampled, double total)
+{
+  double estimate;
+  if (sampled >= total)
+    return distincts;
+  estimate= sampled * distincts /
+            (sampled - singletons + singletons * sampled / total);
+  return MY_MIN(MY_MAX(estimate, distincts), total);
+}
+
+
 /**
   @brief
   Get the results of aggregation when collecting the statistics on a column
   
   @param
-  rows          The total number of rows in the table 
+  rows          The number of rows aggregated for the column
+  @param
+  table_rows    The total number of rows in the table 
+
+  @details
+  When ANALYZE samples the table, 'rows' is smaller than 'table_rows'. The
+  ratios and the histogram are then taken from the sample as they are, while
+  the number of distinct values is extrapolated to the whole table.
 */
 
 inline
-void Column_statistics_collected::finish(ha_rows rows)
+void Column_statistics_collected::finish(ha_rows rows, ha_rows table_rows)
 {
   double val;
 
@@ -2267,15 +2350,26 @@ void Column_statistics_collected::finish(ha_rows rows)
   }
   if (count_distinct)
   {
-    ulonglong distincts;
+    ulonglong distincts, singletons;
     uint hist_size= count_distinct->get_hist_size();
-    if (hist_size == 0)
-      distincts= count_distinct->get_value();
+    if (hist_size)
+      distincts= count_distinct->get_value_with_histogram(rows - nulls,
+                                                          &singletons);
+    else if (rows < table_rows)
+      distincts= count_distinct->get_value_and_singletons(&singletons);
     else
-      distincts= count_distinct->get_value_with_histogram(rows - nulls);
+      distincts= count_distinct->get_value();
     if (distincts)
     {
-      val= (double) (rows - nulls) / distincts;
+      if (rows < table_rows)
+      {
+        double total= (double) (rows - nulls) * table_rows / rows;
+        val= total / estimate_distinct_values((double) distincts,
+                                              (double) singletons,
+                                              (double) (rows - nulls), total);
+      }
+      else
+        val= (double) (rows - nulls) / distincts;
       set_avg_frequency(val); 
       set_not_null(COLUMN_STAT_AVG_FREQUENCY);
     }
@@ -2439,6 +2533,15 @@ int collect_statistics_for_index(THD *thd, TABLE *table, uint index)
   After the full table scan the function calls collect_statistics_for_index
   for each table index. The latter performs full index scan for each index.
 
+  @note
+  If analyze_sample_percentage is less than 100 only a random sample of the
+  rows is aggregated for the columns, see handler::ha_sample_next(). The
+  rows outside of the sample are counted for the cardinality of the table
+  but not added to the containers of distinct values. Engines that cannot
+  position on a row read them all the same. The value 0 chooses the size
+  of the sample by the number of rows in the table. Index statistics are
+  always collected on all index entries.
+
   @note
   Currently the statistical data is collected indiscriminately for all
   columns/indexes of 'table', for all statistical characteristics.
@@ -2459,10 +2562,25 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
   Field **field_ptr;
   Field *table_field;
   ha_rows rows= 0;
+  ha_rows sampled_rows= 0;
+  ha_rows skipped;
+  double sample_fraction= 1.0;
   handler *file=table->file;
 
   DBUG_ENTER("collect_statistics_for_table");
 
+  if (thd->variables.analyze_sample_percentage == 0)
+  {
+    ha_rows records;
+    file->info(HA_STATUS_VARIABLE | HA_STATUS_NO_LOCK);
+    records= file->stats.records;
+    if (records > ANALYZE_SAMPLE_MIN_ROWS)
+      sample_fraction= MY_MIN(1.0, (ANALYZE_SAMPLE_MIN_ROWS +
+                                    4096 * log2((double) records)) / records);
+  }
+  else
+    sample_fraction= thd->variables.analyze_sample_percentage / 100.0;
+
   table->collected_stats->cardinality_is_null= TRUE;
   table->collected_stats->cardinality= 0;
 
@@ -2476,35 +2594,36 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
 
   restore_record(table, s->default_values);
 
-  /* Perform a full table scan to collect statistics on 'table's columns */
+  /* Scan the table, or a sample of it, to collect statistics on columns */
   if (!(rc= file->ha_rnd_init(TRUE)))
   {  
     DEBUG_SYNC(table->in_use, "statistics_collection_start");
 
-    while ((rc= file->ha_rnd_next(table->record[0])) != HA_ERR_END_OF_FILE)
+    while ((rc= file->ha_sample_next(table->record[0], sample_fraction,
+                                     &skipped)) != HA_ERR_END_OF_FILE)
     {
       if (thd->killed)
         break;
 
       if (rc)
-      {
-        if (rc == HA_ERR_RECORD_DELETED)
-          continue;
         break;
-      }
 
+      rows+= skipped;
       for (field_ptr= table->field; *field_ptr; field_ptr++)
       {
         table_field= *field_ptr;
         if (!bitmap_is_set(table->read_set, table_field->field_index))
           continue;  
-        if ((rc= table_field->collected_stats->add(rows)))
+        if ((rc= table_field->collected_stats->add(sampled_rows)))
           break;
       }
       if (rc)
         break;
       rows++;
+      sampled_rows++;
     }
+    if (rc == HA_ERR_END_OF_FILE)
+      rows+= skipped;
     file->ha_rnd_end();
   }
   rc= (rc == HA_ERR_END_OF_FILE && !thd->killed) ? 0 : 1;
@@ -2528,7 +2647,7 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
       continue;
     bitmap_set_bit(table->write_set, table_field->field_index); 
     if (!rc)
-      table_field->collected_stats->finish(rows);
+      table_field->collected_stats->finish(sampled_rows, rows);
     else
       table_field->collected_stats->cleanup();
   }
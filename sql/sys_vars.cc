@@ -1111,6 +1111,15 @@ static Sys_var_mybool Sys_local_infile(
        "local_infile", "Enable LOAD DATA LOCAL INFILE",
        GLOBAL_VAR(opt_local_infile), CMD_LINE(OPT_ARG), DEFAULT(TRUE));
 
+static Sys_var_ulong Sys_load_data_read_ahead(
+       "load_data_read_ahead",
+       "Number of blocks of read_buffer_size bytes that LOAD DATA INFILE "
+       "reads from a server file in a separate thread. Only the reading is "
+       "done ahead, the rows are still parsed and inserted by the thread of "
+       "the statement. 0 reads the file in the thread of the statement",
+       SESSION_VAR(load_data_read_ahead), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 1024), DEFAULT(4), BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_lock_wait_timeout(
        "lock_wait_timeout",
        "Timeout in seconds to wait for a lock before returning an error.",
@@ -2084,6 +2093,23 @@ static Sys_var_ulong Sys_max_length_for_sort_data(
        SESSION_VAR(max_length_for_sort_data), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(4, 8192*1024L), DEFAULT(1024), BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_max_sort_threads(
+       "max_sort_threads",
+       "The maximum number of threads a sort that does not fit in "
+       "sort_buffer_size may use to sort chunks and merge them. "
+       "1 means that all sorting is done by the thread running the query",
+       SESSION_VAR(max_sort_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, MAX_SORT_THREADS), DEFAULT(1), BLOCK_SIZE(1));
+
+static Sys_var_ulong Sys_max_partition_scan_threads(
+       "max_partition_scan_threads",
+       "The maximum number of threads a full scan of a partitioned table "
+       "may use to read rows of several partitions at the same time, if "
+       "the storage engine supports it. 1 means that the partitions are "
+       "scanned one after another by the thread running the query",
+       SESSION_VAR(max_partition_scan_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, MAX_PARTITION_SCAN_THREADS), DEFAULT(1), BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_max_long_data_size(
        "max_long_data_size",
        "The maximum BLOB length to send to server from "
@@ -2749,6 +2775,14 @@ static Sys_var_ulong Sys_query_cache_min_res_unit(
        BLOCK_SIZE(8), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
        ON_UPDATE(fix_qcache_min_res_unit));
 
+static Sys_var_ulong Sys_query_cache_instances(
+       "query_cache_instances",
+       "Number of query cache instances. A query is cached in the instance "
+       "chosen by a hash of its text; every instance has its own lock and "
+       "an equal share of query_cache_size",
+       READ_ONLY GLOBAL_VAR(query_cache_instances), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, QUERY_CACHE_MAX_INSTANCES), DEFAULT(1), BLOCK_SIZE(1));
+
 static const char *query_cache_type_names[]= { "OFF", "ON", "DEMAND", 0 };
 static bool check_query_cache_type(sys_var *self, THD *thd, set_var *var)
 {
@@ -2894,6 +2928,22 @@ static Sys_var_set Slave_type_conversions(
        slave_type_conversions_name,
        DEFAULT(0));
 
+static const char *slave_rows_search_algorithms_names[]=
+  {"TABLE_SCAN", "INDEX_SCAN", "HASH_SCAN", 0};
+static Sys_var_set Slave_rows_search_algorithms(
+       "slave_rows_search_algorithms",
+       "Set of methods the slave uses to find the rows of row-based UPDATE "
+       "and DELETE events in tables without a primary key or a unique key "
+       "over NOT NULL columns. INDEX_SCAN looks up each row through the "
+       "most selective other index, TABLE_SCAN scans the table for each "
+       "row. HASH_SCAN hashes all rows of an event and finds them with a "
+       "single scan, of the index if INDEX_SCAN is also set, otherwise "
+       "of the table",
+       GLOBAL_VAR(slave_rows_search_algorithms_options), CMD_LINE(REQUIRED_ARG),
+       slave_rows_search_algorithms_names,
+       DEFAULT((1ULL << SLAVE_ROWS_TABLE_SCAN) |
+               (1ULL << SLAVE_ROWS_INDEX_SCAN)));
+
 static Sys_var_mybool Sys_slave_sql_verify_checksum(
        "slave_sql_verify_checksum",
        "Force checksum verification of replication events after reading them "
@@ -3174,6 +3224,12 @@ static Sys_var_ulong Sys_table_cache_size(
        BLOCK_SIZE(1), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
        ON_UPDATE(fix_table_open_cache));
 
+static Sys_var_ulong Sys_table_cache_instances(
+       "table_open_cache_instances", "Number of table cache instances",
+       READ_ONLY GLOBAL_VAR(tc_instances), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, TABLE_OPEN_CACHE_INSTANCES_MAX),
+       DEFAULT(TABLE_OPEN_CACHE_INSTANCES_DEFAULT), BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_thread_cache_size(
        "thread_cache_size",
        "How many threads we should keep in a cache for reuse",
@@ -3249,6 +3305,23 @@ static Sys_var_uint Sys_threadpool_oversubscribe(
   GLOBAL_VAR(threadpool_oversubscribe), CMD_LINE(REQUIRED_ARG),
   VALID_RANGE(1, 1000), DEFAULT(3), BLOCK_SIZE(1)
 );
+static const char *threadpool_priority_names[]= { "high", "low", "auto", 0 };
+static Sys_var_enum Sys_threadpool_priority(
+  "thread_pool_priority",
+  "Threadpool priority. High priority connections usually start executing "
+  "earlier than low priority. If priority set to 'auto', the actual "
+  "priority (low or high) is determined based on whether or not connection "
+  "is inside transaction or holds table locks.",
+  SESSION_VAR(threadpool_priority), CMD_LINE(REQUIRED_ARG),
+  threadpool_priority_names, DEFAULT(TP_PRIORITY_AUTO)
+);
+static Sys_var_uint Sys_threadpool_prio_kickup_timer(
+ "thread_pool_prio_kickup_timer",
+ "The number of milliseconds a low priority connection can wait in the "
+ "queue before it is served ahead of high priority connections",
+  GLOBAL_VAR(threadpool_prio_kickup_timer), CMD_LINE(REQUIRED_ARG),
+  VALID_RANGE(0, UINT_MAX), DEFAULT(1000), BLOCK_SIZE(1)
+);
 static Sys_var_uint Sys_threadpool_size(
  "thread_pool_size",
  "Number of thread groups in the pool. "
@@ -5087,6 +5160,17 @@ static Sys_var_enum Sys_histogram_type(
        SESSION_VAR(histogram_type), CMD_LINE(REQUIRED_ARG),
        histogram_types, DEFAULT(0));
 
+static Sys_var_ulong Sys_analyze_sample_percentage(
+       "analyze_sample_percentage",
+       "Percentage of the rows of a table that ANALYZE TABLE ... PERSISTENT "
+       "aggregates to collect the statistics on its columns. The column "
+       "statistics of the other rows are extrapolated from this sample. "
+       "The other rows are skipped without reading them only for MyISAM "
+       "tables with fixed length rows, other tables are still read in full. "
+       "If set to 0, the size of the sample is chosen by the size of the table.",
+       SESSION_VAR(analyze_sample_percentage), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 100), DEFAULT(100), BLOCK_SIZE(1));
+
 static Sys_var_mybool Sys_no_thread_alarm(
        "debug_no_thread_alarm",
        "Disable system thread alarm calls. Disabling it may be useful "
@@ -491,6 +491,7 @@ TABLE_CATEGORY get_table_category(const LEX_STRING *db,
 
 struct TABLE_share;
 struct All_share_tables;
+struct Table_cache_free_tables;
 
 typedef struct st_table_field_type
 {
@@ -1001,12 +1002,18 @@ struct TABLE
   */
   TABLE *share_all_next, **share_all_prev;
   friend struct All_share_tables;
+  /**
+     Links for the LRU list of unused TABLE objects of table cache instance.
+     Protected by Table_cache_instance::LOCK_table_cache.
+  */
+  TABLE *tc_free_next, **tc_free_prev;
+  friend struct Table_cache_free_tables;
 
 public:
 
   THD	*in_use;                        /* Which thread uses this */
-  /* Time when table was released to table cache. Valid for unused tables. */
-  ulonglong tc_time;
+  /* Table cache instance this object belongs to. */
+  uint tc_instance;
   Field **field;			/* Pointer to fields */
 
   uchar *record[2];			/* Pointer to records */
@@ -1400,6 +1407,25 @@ struct All_share_tables
 };
 
 
+/**
+   Helper class which specifies which members of TABLE are used for
+   participation in the LRU list of unused TABLE objects of table cache
+   instance.
+*/
+
+struct Table_cache_free_tables
+{
+  static inline TABLE **next_ptr(TABLE *l)
+  {
+    return &l->tc_free_next;
+  }
+  static inline TABLE ***prev_ptr(TABLE *l)
+  {
+    return &l->tc_free_prev;
+  }
+};
+
+
 enum enum_schema_table_state
 { 
   NOT_PROCESSED= 0,
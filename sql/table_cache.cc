@@ -35,6 +35,10 @@
   - purge unused TABLE objects of a table from cache (tdc_remove_table())
   - get number of TABLE objects in cache (tc_records())
 
+  Table cache is split into tc_instances instances, each protected by its
+  own mutex. Every thread works with one instance, TABLE objects are added
+  to and released to the instance of the thread that created them.
+
   Dependencies:
   - intern_close_table(): frees TABLE object
   - kill_delayed_threads_for_table()
@@ -43,9 +47,12 @@
   - free_table_share()
 
   Table cache invariants:
-  - TABLE_SHARE::free_tables shall not contain objects with TABLE::in_use != 0
-  - TABLE_SHARE::free_tables shall not receive new objects if
+  - TABLE_SHARE::tdc.free_tables shall not contain objects with
+    TABLE::in_use != 0
+  - TABLE_SHARE::tdc.free_tables shall not receive new objects if
     TABLE_SHARE::tdc.flushed is true
+  - TABLE_SHARE::tdc.free_tables[i] and Table_cache_instance::free_tables
+    of instance i shall contain the same objects
 */
 
 #include "my_global.h"
@@ -57,6 +64,7 @@
 /** Configuration. */
 ulong tdc_size; /**< Table definition cache threshold for LRU eviction. */
 ulong tc_size; /**< Table cache threshold for LRU eviction. */
+ulong tc_instances; /**< Number of table cache instances. */
 
 /** Data collections. */
 static LF_HASH tdc_hash; /**< Collection of TABLE_SHARE objects. */
@@ -70,7 +78,56 @@ static int64 tdc_version;  /* Increments on each reload */
 static int64 last_table_id;
 static bool tdc_inited;
 
-static int32 tc_count; /**< Number of TABLE objects in table cache. */
+
+/**
+  Table cache instance.
+
+  Every THD is mapped to one instance (see tc_thd_instance()). TABLE object
+  is added to the instance of the thread that created it and is always
+  released back to the same instance (TABLE::tc_instance). This way threads
+  opening and closing the same tables concurrently don't serialize on a
+  single mutex.
+*/
+
+struct Table_cache_instance
+{
+  /**
+    Protects free_tables, records, statistics and
+    TDC_element::free_tables[instance] of all table shares.
+  */
+  mysql_mutex_t LOCK_table_cache;
+  /** LRU list of unused TABLE objects of all shares, oldest first. */
+  I_P_List <TABLE, Table_cache_free_tables, I_P_List_null_counter,
+            I_P_List_fast_push_back<TABLE> > free_tables;
+  /** Number of TABLE objects (used and unused) in this instance. */
+  ulong records;
+  /** Number of TABLE objects acquired from this instance. */
+  ulonglong hits;
+  /** Number of TABLE objects created because no unused object was found. */
+  ulonglong misses;
+  /** Number of times this instance exceeded its share of tc_size. */
+  ulonglong overflows;
+  /** Avoid false sharing between instances. */
+  char pad[TC_CACHE_LINE_SIZE];
+};
+
+static Table_cache_instance *tc;
+
+
+/**
+  Status variables of table cache instances.
+
+  Table_open_cache_instance_<N>_{hits,misses,open_tables,overflows}.
+*/
+
+struct Table_cache_instance_status
+{
+  char name[12];
+  SHOW_VAR vars[5];
+};
+
+static Table_cache_instance_status *tc_status;
+SHOW_VAR *tc_instance_status_vars;
 
 
 /**
@@ -84,11 +141,13 @@ static int32 tc_count; /**< Number of TABLE objects in table cache. */
 static mysql_mutex_t LOCK_unused_shares;
 
 #ifdef HAVE_PSI_INTERFACE
-PSI_mutex_key key_LOCK_unused_shares, key_TABLE_SHARE_LOCK_table_share;
+PSI_mutex_key key_LOCK_unused_shares, key_TABLE_SHARE_LOCK_table_share,
+              key_LOCK_table_cache;
 static PSI_mutex_info all_tc_mutexes[]=
 {
   { &key_LOCK_unused_shares, "LOCK_unused_shares", PSI_FLAG_GLOBAL },
-  { &key_TABLE_SHARE_LOCK_table_share, "TABLE_SHARE::tdc.LOCK_table_share", 0 }
+  { &key_TABLE_SHARE_LOCK_table_share, "TABLE_SHARE::tdc.LOCK_table_share", 0 },
+  { &key_LOCK_table_cache, "LOCK_table_cache", 0 }
 };
 
 PSI_cond_key key_TABLE_SHARE_COND_release;
@@ -121,35 +180,135 @@ static int fix_thd_pins(THD *thd)
 
 /*
   Auxiliary routines for manipulating with per-share all/unused lists
-  and tc_count counter.
-  Responsible for preserving invariants between those lists, counter
-  and TABLE::in_use member.
+  and table cache instances.
+  Responsible for preserving invariants between those lists, instance
+  counters and TABLE::in_use member.
   In fact those routines implement sort of implicit table cache as
   part of table definition cache.
 */
 
 
+/**
+  Get table cache instance that thread works with.
+*/
+
+static inline ulong tc_thd_instance(THD *thd)
+{
+  return (ulong) (thd->thread_id % tc_instances);
+}
+
+
+/**
+  Get table cache threshold of one instance.
+
+  tc_size is split evenly between instances. Rounded up, so that every
+  instance may keep at least one object unless tc_size is 0.
+*/
+
+static inline ulong tc_instance_size(void)
+{
+  return (tc_size + tc_instances - 1) / tc_instances;
+}
+
+
 /**
   Get number of TABLE objects (used and unused) in table cache.
+
+  Instance counters are read without instance mutexes, the result is
+  approximate if tables are opened or closed concurrently.
 */
 
 uint tc_records(void)
 {
-  return my_atomic_load32_explicit(&tc_count, MY_MEMORY_ORDER_RELAXED);
+  ulong total= 0;
+  for (ulong i= 0; i < tc_instances; i++)
+    total+= tc[i].records;
+  return (uint) total;
+}
+
+
+/**
+  Get table cache statistics summed over all instances.
+*/
+
+void tc_statistics(ulonglong *hits, ulonglong *misses, ulonglong *overflows)
+{
+  *hits= *misses= *overflows= 0;
+  for (ulong i= 0; i < tc_instances; i++)
+  {
+    mysql_mutex_lock(&tc[i].LOCK_table_cache);
+    *hits+= tc[i].hits;
+    *misses+= tc[i].misses;
+    *overflows+= tc[i].overflows;
+    mysql_mutex_unlock(&tc[i].LOCK_table_cache);
+  }
 }
 
 
 /**
-  Remove TABLE object from table cache.
+  Remove TABLE object from table cache and free it.
+
+  @pre object is not on any unused list and is not accounted in
+       Table_cache_instance::records anymore.
 
-  - decrement tc_count
+  While locked:
   - remove object from TABLE_SHARE::tdc.all_tables
+
+  While unlocked:
+  - free object
 */
 
 static void tc_remove_table(TABLE *table)
 {
-  my_atomic_add32_explicit(&tc_count, -1, MY_MEMORY_ORDER_RELAXED);
-  table->s->tdc->all_tables.remove(table);
+  TDC_element *element= table->s->tdc;
+
+  mysql_mutex_lock(&element->LOCK_table_share);
+  element->wait_for_mdl_deadlock_detector();
+  element->all_tables.remove(table);
+  mysql_mutex_unlock(&element->LOCK_table_share);
+  table->in_use= 0;
+  intern_close_table(table);
+}
+
+
+/**
+  Move all unused TABLE objects of a share to purge list.
+
+  @pre TABLE_SHARE::tdc.LOCK_table_share is locked and MDL deadlock
+       detector doesn't traverse TABLE_SHARE::tdc.all_tables.
+
+  - optionally mark share flushed
+  - remove unused objects from TABLE_SHARE::tdc.free_tables of every
+    instance and from TABLE_SHARE::tdc.all_tables
+  - decrement Table_cache_instance::records
+
+  @note Share must be marked flushed before instance mutexes are taken:
+  tc_release_table() checks TABLE_SHARE::tdc.flushed under instance mutex
+  only.
+*/
+
+static void tc_remove_all_unused_tables(TDC_element *element,
+                                        Share_free_tables::List *purge_tables,
+                                        bool mark_flushed)
+{
+  TABLE *table;
+
+  mysql_mutex_assert_owner(&element->LOCK_table_share);
+  DBUG_ASSERT(element->all_tables_refs == 0);
+  if (mark_flushed)
+    element->flushed= true;
+  for (ulong i= 0; i < tc_instances; i++)
+  {
+    mysql_mutex_lock(&tc[i].LOCK_table_cache);
+    while ((table= element->free_tables[i].list.pop_front()))
+    {
+      tc[i].records--;
+      tc[i].free_tables.remove(table);
+      element->all_tables.remove(table);
+      purge_tables->push_front(table);
+    }
+    mysql_mutex_unlock(&tc[i].LOCK_table_cache);
+  }
 }
 
 
@@ -159,7 +318,7 @@ static void tc_remove_table(TABLE *table)
   While locked:
   - remove unused objects from TABLE_SHARE::tdc.free_tables and
     TABLE_SHARE::tdc.all_tables
-  - decrement tc_count
+  - decrement Table_cache_instance::records
 
   While unlocked:
   - free resources related to unused objects
@@ -170,24 +329,16 @@ static void tc_remove_table(TABLE *table)
 
 struct tc_purge_arg
 {
-  TDC_element::TABLE_list purge_tables;
+  Share_free_tables::List purge_tables;
   bool mark_flushed;
 };
 
 
 static my_bool tc_purge_callback(TDC_element *element, tc_purge_arg *arg)
 {
-  TABLE *table;
-
   mysql_mutex_lock(&element->LOCK_table_share);
   element->wait_for_mdl_deadlock_detector();
-  if (arg->mark_flushed)
-    element->flushed= true;
-  while ((table= element->free_tables.pop_front()))
-  {
-    tc_remove_table(table);
-    arg->purge_tables.push_front(table);
-  }
+  tc_remove_all_unused_tables(element, &arg->purge_tables, arg->mark_flushed);
   mysql_mutex_unlock(&element->LOCK_table_share);
   return FALSE;
 }
@@ -205,6 +356,47 @@ void tc_purge(bool mark_flushed)
 }
 
 
+/**
+  Evict LRU object from table cache instance.
+
+  @pre Table_cache_instance::LOCK_table_cache of the instance is locked.
+
+  TABLE_SHARE::tdc.LOCK_table_share is locked before instance mutex
+  elsewhere, so it is only tried here. The object is removed from
+  TABLE_SHARE::tdc.all_tables together with instance lists: an evicted
+  object is never seen in all_tables by tdc_remove_table() or MDL deadlock
+  detector. If share mutex is busy or MDL deadlock detector traverses
+  all_tables, nothing is evicted and the instance shrinks back when objects
+  are released (see tc_release_table()).
+
+  @return evicted object, to be freed by caller without locks, or NULL
+*/
+
+static TABLE *tc_evict_table(ulong i)
+{
+  TABLE *table;
+  TDC_element *element;
+
+  mysql_mutex_assert_owner(&tc[i].LOCK_table_cache);
+  if (!(table= tc[i].free_tables.front()))
+    return 0;
+  element= table->s->tdc;
+  if (mysql_mutex_trylock(&element->LOCK_table_share))
+    return 0;
+  if (element->all_tables_refs)
+    table= 0;
+  else
+  {
+    tc[i].free_tables.remove(table);
+    element->free_tables[i].list.remove(table);
+    element->all_tables.remove(table);
+    tc[i].records--;
+  }
+  mysql_mutex_unlock(&element->LOCK_table_share);
+  return table;
+}
+
+
 /**
   Add new TABLE object to table cache.
 
@@ -214,87 +406,72 @@ void tc_purge(bool mark_flushed)
 
   While locked:
   - add object to TABLE_SHARE::tdc.all_tables
-  - increment tc_count
-  - evict LRU object from table cache if we reached threshold
+  - increment Table_cache_instance::records
+  - evict LRU object from table cache instance if we reached threshold
 
   While unlocked:
   - free evicted object
 */
 
-struct tc_add_table_arg
-{
-  char key[MAX_DBKEY_LENGTH];
-  uint key_length;
-  ulonglong purge_time;
-};
-
-
-my_bool tc_add_table_callback(TDC_element *element, tc_add_table_arg *arg)
+void tc_add_table(THD *thd, TABLE *table)
 {
-  TABLE *table;
+  ulong i= tc_thd_instance(thd);
+  TABLE *LRU_table= 0;
+  TDC_element *element= table->s->tdc;
 
+  DBUG_ASSERT(table->in_use == thd);
+  table->tc_instance= i;
   mysql_mutex_lock(&element->LOCK_table_share);
-  if ((table= element->free_tables_back()) && table->tc_time < arg->purge_time)
+  element->wait_for_mdl_deadlock_detector();
+  element->all_tables.push_front(table);
+  mysql_mutex_unlock(&element->LOCK_table_share);
+
+  mysql_mutex_lock(&tc[i].LOCK_table_cache);
+  tc[i].misses++;
+  /* If we have too many TABLE instances around, try to get rid of them */
+  if (++tc[i].records > tc_instance_size())
   {
-    memcpy(arg->key, element->m_key, element->m_key_length);
-    arg->key_length= element->m_key_length;
-    arg->purge_time= table->tc_time;
+    tc[i].overflows++;
+    LRU_table= tc_evict_table(i);
   }
-  mysql_mutex_unlock(&element->LOCK_table_share);
-  return FALSE;
+  mysql_mutex_unlock(&tc[i].LOCK_table_cache);
+
+  if (LRU_table)
+    intern_close_table(LRU_table);
 }
 
 
-void tc_add_table(THD *thd, TABLE *table)
-{
-  bool need_purge;
-  DBUG_ASSERT(table->in_use == thd);
-  mysql_mutex_lock(&table->s->tdc->LOCK_table_share);
-  table->s->tdc->wait_for_mdl_deadlock_detector();
-  table->s->tdc->all_tables.push_front(table);
-  mysql_mutex_unlock(&table->s->tdc->LOCK_table_share);
+/**
+  Acquire TABLE object from table cache.
 
-  /* If we have too many TABLE instances around, try to get rid of them */
-  need_purge= my_atomic_add32_explicit(&tc_count, 1, MY_MEMORY_ORDER_RELAXED) >=
-              (int32) tc_size;
+  @pre share must be protected against removal.
 
-  if (need_purge)
-  {
-    tc_add_table_arg argument;
-    argument.purge_time= ULONGLONG_MAX;
-    tdc_iterate(thd, (my_hash_walk_action) tc_add_table_callback, &argument);
+  Acquired object cannot be evicted or acquired again.
 
-    if (argument.purge_time != ULONGLONG_MAX)
-    {
-      TDC_element *element= (TDC_element*) lf_hash_search(&tdc_hash,
-                                                          thd->tdc_hash_pins,
-                                                          argument.key,
-                                                          argument.key_length);
-      if (element)
-      {
-        TABLE *entry;
-        mysql_mutex_lock(&element->LOCK_table_share);
-        lf_hash_search_unpin(thd->tdc_hash_pins);
-        element->wait_for_mdl_deadlock_detector();
-
-        /*
-          It may happen that oldest table was acquired meanwhile. In this case
-          just go ahead, number of objects in table cache will normalize
-          eventually.
-        */
-        if ((entry= element->free_tables_back()) &&
-            entry->tc_time == argument.purge_time)
-        {
-          element->free_tables.remove(entry);
-          tc_remove_table(entry);
-          mysql_mutex_unlock(&element->LOCK_table_share);
-          intern_close_table(entry);
-        }
-        else
-          mysql_mutex_unlock(&element->LOCK_table_share);
-      }
-    }
+  Only objects of the instance that thread is mapped to are considered.
+
+  @return TABLE object, or NULL if no unused objects.
+*/
+
+static TABLE *tc_acquire_table(THD *thd, TDC_element *element)
+{
+  ulong i= tc_thd_instance(thd);
+  TABLE *table;
+
+  mysql_mutex_lock(&tc[i].LOCK_table_cache);
+  if ((table= element->free_tables[i].list.pop_front()))
+  {
+    tc[i].free_tables.remove(table);
+    tc[i].hits++;
+    DBUG_ASSERT(!table->in_use);
+    table->in_use= thd;
+    /* The ex-unused table must be fully functional. */
+    DBUG_ASSERT(table->db_stat && table->file);
+    /* The children must be detached from the table. */
+    DBUG_ASSERT(!table->file->extra(HA_EXTRA_IS_ATTACHED_CHILDREN));
   }
+  mysql_mutex_unlock(&tc[i].LOCK_table_cache);
+  return table;
 }
 
 
@@ -306,18 +483,17 @@ void tc_add_table(THD *thd, TABLE *table)
   Released object may be evicted or acquired again.
 
   While locked:
-  - if object is marked for purge, decrement tc_count
-  - add object to TABLE_SHARE::tdc.free_tables
-  - evict LRU object from table cache if we reached threshold
+  - if object is marked for purge, decrement Table_cache_instance::records
+  - add object to TABLE_SHARE::tdc.free_tables of its instance and to
+    the instance LRU list
 
   While unlocked:
-  - mark object not in use by any thread
-  - free evicted/purged object
+  - free purged object
 
   @note Another thread may mark share for purge any moment (even
   after version check). It means to-be-purged object may go to
   unused lists. This other thread is expected to call tc_purge(),
-  which is synchronized with us on TABLE_SHARE::tdc.LOCK_table_share.
+  which is synchronized with us on Table_cache_instance::LOCK_table_cache.
 
   @return
     @retval true  object purged
@@ -326,20 +502,19 @@ void tc_add_table(THD *thd, TABLE *table)
 
 bool tc_release_table(TABLE *table)
 {
+  ulong i= table->tc_instance;
   DBUG_ASSERT(table->in_use);
   DBUG_ASSERT(table->file);
 
-  if (table->needs_reopen() || tc_records() > tc_size)
+  mysql_mutex_lock(&tc[i].LOCK_table_cache);
+  if (table->needs_reopen() || table->s->tdc->flushed ||
+      tc[i].records > tc_instance_size())
   {
-    mysql_mutex_lock(&table->s->tdc->LOCK_table_share);
-    goto purge;
+    tc[i].records--;
+    mysql_mutex_unlock(&tc[i].LOCK_table_cache);
+    tc_remove_table(table);
+    return true;
   }
-
-  table->tc_time= my_interval_timer();
-
-  mysql_mutex_lock(&table->s->tdc->LOCK_table_share);
-  if (table->s->tdc->flushed)
-    goto purge;
   /*
     in_use doesn't really need mutex protection, but must be reset after
     checking tdc.flushed and before this table appears in free_tables.
@@ -348,17 +523,10 @@ bool tc_release_table(TABLE *table)
   */
   table->in_use= 0;
   /* Add table to the list of unused TABLE objects for this share. */
-  table->s->tdc->free_tables.push_front(table);
-  mysql_mutex_unlock(&table->s->tdc->LOCK_table_share);
+  table->s->tdc->free_tables[i].list.push_front(table);
+  tc[i].free_tables.push_back(table);
+  mysql_mutex_unlock(&tc[i].LOCK_table_cache);
   return false;
-
-purge:
-  table->s->tdc->wait_for_mdl_deadlock_detector();
-  tc_remove_table(table);
-  mysql_mutex_unlock(&table->s->tdc->LOCK_table_share);
-  table->in_use= 0;
-  intern_close_table(table);
-  return true;
 }
 
 
@@ -417,23 +585,69 @@ static void tdc_delete_share_from_hash(TDC_element *element)
   Initialize table definition cache.
 */
 
-void tdc_init(void)
+bool tdc_init(void)
 {
   DBUG_ENTER("tdc_init");
 #ifdef HAVE_PSI_INTERFACE
   init_tc_psi_keys();
 #endif
+  if (!(tc= (Table_cache_instance*) my_malloc(sizeof(*tc) * tc_instances,
+                                               MYF(MY_WME))))
+    DBUG_RETURN(true);
+  if (!(tc_status= (Table_cache_instance_status*)
+        my_malloc(sizeof(*tc_status) * tc_instances, MYF(MY_WME))) ||
+      !(tc_instance_status_vars= (SHOW_VAR*)
+        my_malloc(sizeof(SHOW_VAR) * (tc_instances + 1), MYF(MY_WME))))
+  {
+    my_free(tc_status);
+    my_free(tc);
+    DBUG_RETURN(true);
+  }
+  for (ulong i= 0; i < tc_instances; i++)
+  {
+    SHOW_VAR *var= tc_status[i].vars;
+
+    mysql_mutex_init(key_LOCK_table_cache, &tc[i].LOCK_table_cache,
+                     MY_MUTEX_INIT_FAST);
+    tc[i].free_tables.empty();
+    tc[i].records= 0;
+    tc[i].hits= 0;
+    tc[i].misses= 0;
+    tc[i].overflows= 0;
+
+    my_snprintf(tc_status[i].name, sizeof(tc_status[i].name), "%lu", i);
+    tc_instance_status_vars[i].name= tc_status[i].name;
+    tc_instance_status_vars[i].value= (char*) var;
+    tc_instance_status_vars[i].type= SHOW_ARRAY;
+    var[0].name= "hits";
+    var[0].value= (char*) &tc[i].hits;
+    var[0].type= SHOW_LONGLONG;
+    var[1].name= "misses";
+    var[1].value= (char*) &tc[i].misses;
+    var[1].type= SHOW_LONGLONG;
+    var[2].name= "open_tables";
+    var[2].value= (char*) &tc[i].records;
+    var[2].type= SHOW_LONG;
+    var[3].name= "overflows";
+    var[3].value= (char*) &tc[i].overflows;
+    var[3].type= SHOW_LONGLONG;
+    var[4].name= 0;
+  }
+  tc_instance_status_vars[tc_instances].name= 0;
   tdc_inited= true;
   mysql_mutex_init(key_LOCK_unused_shares, &LOCK_unused_shares,
                    MY_MUTEX_INIT_FAST);
   tdc_version= 1L;  /* Increments on each reload */
-  lf_hash_init(&tdc_hash, sizeof(TDC_element), LF_HASH_UNIQUE, 0, 0,
+  /* TDC_element::free_tables is allocated for every instance. */
+  lf_hash_init(&tdc_hash, sizeof(TDC_element) +
+               sizeof(Share_free_tables) * (tc_instances - 1),
+               LF_HASH_UNIQUE, 0, 0,
                (my_hash_get_key) TDC_element::key,
                &my_charset_bin);
   tdc_hash.alloc.constructor= TDC_element::lf_alloc_constructor;
   tdc_hash.alloc.destructor= TDC_element::lf_alloc_destructor;
   tdc_hash.element_size= offsetof(TDC_element, version);
-  DBUG_VOID_RETURN;
+  DBUG_RETURN(false);
 }
 
 
@@ -475,6 +689,12 @@ void tdc_deinit(void)
     tdc_inited= false;
     lf_hash_destroy(&tdc_hash);
     mysql_mutex_destroy(&LOCK_unused_shares);
+    for (ulong i= 0; i < tc_instances; i++)
+      mysql_mutex_destroy(&tc[i].LOCK_table_cache);
+    my_free(tc_instance_status_vars);
+    my_free(tc_status);
+    my_free(tc);
+    tc_instance_status_vars= 0;
   }
   DBUG_VOID_RETURN;
 }
@@ -666,7 +886,7 @@ TABLE_SHARE *tdc_acquire_share(THD *thd, const char *db, const char *table_name,
 
   if (out_table && (flags & GTS_TABLE))
   {
-    if ((*out_table= element->acquire_table(thd)))
+    if ((*out_table= tc_acquire_table(thd, element)))
     {
       lf_hash_search_unpin(thd->tdc_hash_pins);
       DBUG_ASSERT(!(flags & GTS_NOLOCK));
@@ -842,7 +1062,7 @@ bool tdc_remove_table(THD *thd, enum_tdc_remove_table_type remove_type,
                       const char *db, const char *table_name,
                       bool kill_delayed_threads)
 {
-  I_P_List <TABLE, TABLE_share> purge_tables;
+  Share_free_tables::List purge_tables;
   TABLE *table;
   TDC_element *element;
   uint my_refs= 1;
@@ -890,14 +1110,8 @@ bool tdc_remove_table(THD *thd, enum_tdc_remove_table_type remove_type,
     marking share flushed is followed by purge of unused table
     shares.
   */
-  if (remove_type != TDC_RT_REMOVE_NOT_OWN_KEEP_SHARE)
-    element->flushed= true;
-
-  while ((table= element->free_tables.pop_front()))
-  {
-    tc_remove_table(table);
-    purge_tables.push_front(table);
-  }
+  tc_remove_all_unused_tables(element, &purge_tables,
+                              remove_type != TDC_RT_REMOVE_NOT_OWN_KEEP_SHARE);
   if (kill_delayed_threads)
     kill_delayed_threads_for_table(element);
 
@@ -19,6 +19,26 @@
 extern PSI_mutex_key key_TABLE_SHARE_LOCK_table_share;
 extern PSI_cond_key key_TABLE_SHARE_COND_release;
 
+extern ulong tc_instances;
+
+/** Assumed CPU cache line size, used to avoid false sharing. */
+#define TC_CACHE_LINE_SIZE 64
+
+/**
+  Unused TABLE objects of a share that belong to one table cache instance.
+
+  Protected by Table_cache_instance::LOCK_table_cache of that instance.
+  Padded so that instances don't share CPU cache lines.
+*/
+
+struct Share_free_tables
+{
+  typedef I_P_List <TABLE, TABLE_share> List;
+  List list;
+  char pad[TC_CACHE_LINE_SIZE - sizeof(List)];
+};
+
+
 class TDC_element
 {
 public:
@@ -28,11 +48,9 @@ class TDC_element
   bool flushed;
   TABLE_SHARE *share;
 
-  typedef I_P_List <TABLE, TABLE_share> TABLE_list;
   typedef I_P_List <TABLE, All_share_tables> All_share_tables_list;
   /**
-    Protects ref_count, m_flush_tickets, all_tables, free_tables, flushed,
-    all_tables_refs.
+    Protects ref_count, m_flush_tickets, all_tables, flushed, all_tables_refs.
   */
   mysql_mutex_t LOCK_table_share;
   mysql_cond_t COND_release;
@@ -44,11 +62,16 @@ class TDC_element
   */
   Wait_for_flush_list m_flush_tickets;
   /*
-    Doubly-linked (back-linked) lists of used and unused TABLE objects
+    Doubly-linked (back-linked) list of used and unused TABLE objects
     for this share.
   */
   All_share_tables_list all_tables;
-  TABLE_list free_tables;
+  /**
+    Lists of unused TABLE objects for this share, one per table cache
+    instance. Must be the last member: the real size of the array is
+    tc_instances, see tdc_init().
+  */
+  Share_free_tables free_tables[1];
 
   TDC_element() {}
 
@@ -64,57 +87,16 @@ class TDC_element
     DBUG_ASSERT(ref_count == 0);
     DBUG_ASSERT(m_flush_tickets.is_empty());
     DBUG_ASSERT(all_tables.is_empty());
-    DBUG_ASSERT(free_tables.is_empty());
+#ifndef DBUG_OFF
+    for (ulong i= 0; i < tc_instances; i++)
+      DBUG_ASSERT(free_tables[i].list.is_empty());
+#endif
     DBUG_ASSERT(all_tables_refs == 0);
     DBUG_ASSERT(next == 0);
     DBUG_ASSERT(prev == 0);
   }
 
 
-  /**
-    Acquire TABLE object from table cache.
-
-    @pre share must be protected against removal.
-
-    Acquired object cannot be evicted or acquired again.
-
-    @return TABLE object, or NULL if no unused objects.
-  */
-
-  TABLE *acquire_table(THD *thd)
-  {
-    TABLE *table;
-
-    mysql_mutex_lock(&LOCK_table_share);
-    table= free_tables.pop_front();
-    if (table)
-    {
-      DBUG_ASSERT(!table->in_use);
-      table->in_use= thd;
-      /* The ex-unused table must be fully functional. */
-      DBUG_ASSERT(table->db_stat && table->file);
-      /* The children must be detached from the table. */
-      DBUG_ASSERT(!table->file->extra(HA_EXTRA_IS_ATTACHED_CHILDREN));
-    }
-    mysql_mutex_unlock(&LOCK_table_share);
-    return table;
-  }
-
-
-  /**
-    Get last element of free_tables.
-  */
-
-  TABLE *free_tables_back()
-  {
-    TABLE_list::Iterator it(share->tdc->free_tables);
-    TABLE *entry, *last= 0;
-     while ((entry= it++))
-       last= entry;
-    return last;
-  }
-
-
   /**
     Wait for MDL deadlock detector to complete traversing tdc.all_tables.
 
@@ -141,7 +123,8 @@ class TDC_element
     mysql_cond_init(key_TABLE_SHARE_COND_release, &element->COND_release, 0);
     element->m_flush_tickets.empty();
     element->all_tables.empty();
-    element->free_tables.empty();
+    for (ulong i= 0; i < tc_instances; i++)
+      element->free_tables[i].list.empty();
     element->all_tables_refs= 0;
     element->share= 0;
     element->ref_count= 0;
@@ -186,7 +169,7 @@ enum enum_tdc_remove_table_type
 extern ulong tdc_size;
 extern ulong tc_size;
 
-extern void tdc_init(void);
+extern bool tdc_init(void);
 extern void tdc_start_shutdown(void);
 extern void tdc_deinit(void);
 extern ulong tdc_records(void);
@@ -214,6 +197,9 @@ extern int tdc_iterate(THD *thd, my_hash_walk_action action, void *argument,
                        bool no_dups= false);
 
 extern uint tc_records(void);
+extern void tc_statistics(ulonglong *hits, ulonglong *misses,
+                          ulonglong *overflows);
+extern struct st_mysql_show_var *tc_instance_status_vars;
 extern void tc_purge(bool mark_flushed= false);
 extern void tc_add_table(THD *thd, TABLE *table);
 extern bool tc_release_table(TABLE *table);
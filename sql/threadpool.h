@@ -23,6 +23,15 @@ extern uint threadpool_max_size;
 extern uint threadpool_stall_limit;  /* time interval in 10 ms units for stall checks*/
 extern uint threadpool_max_threads;  /* Maximum threads in pool */
 extern uint threadpool_oversubscribe;  /* Maximum active threads in group */
+extern uint threadpool_prio_kickup_timer;  /* Time before low prio item gets prio boost */
+
+/* Possible values for the thread_pool_priority session variable */
+enum TP_PRIORITY
+{
+  TP_PRIORITY_HIGH,
+  TP_PRIORITY_LOW,
+  TP_PRIORITY_AUTO
+};
 
 
 
@@ -57,6 +66,24 @@ struct TP_STATISTICS
 
 extern TP_STATISTICS tp_stats;
 
+/*
+  Work queue statistics of a thread group,
+  used by INFORMATION_SCHEMA.THREAD_POOL_QUEUES
+*/
+struct TP_QUEUE_STATISTICS
+{
+  uint length;               /* Connections currently in the queue */
+  ulonglong oldest_wait;     /* Microseconds the first connection has waited */
+  ulonglong dequeued;        /* Connections taken from the queue so far */
+  ulonglong total_wait;      /* Microseconds dequeued connections have waited */
+  ulonglong kickups;         /* Low priority connections preferred after
+                                waiting thread_pool_prio_kickup_timer */
+};
+
+extern uint tp_get_group_count();
+extern void tp_get_queue_statistics(uint group_id, TP_PRIORITY priority,
+                                    TP_QUEUE_STATISTICS *stats);
+
 
 /* Functions to set threadpool parameters */
 extern void tp_set_min_threads(uint val);
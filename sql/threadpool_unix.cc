@@ -116,6 +116,8 @@ struct connection_t
   connection_t *next_in_queue;
   connection_t **prev_in_queue;
   ulonglong abs_wait_timeout;
+  ulonglong enqueue_time;
+  TP_PRIORITY priority;
   bool logged_in;
   bool bound_to_poll_descriptor;
   bool waiting;
@@ -125,14 +127,17 @@ typedef I_P_List<connection_t,
                      I_P_List_adapter<connection_t,
                                       &connection_t::next_in_queue,
                                       &connection_t::prev_in_queue>,
-                     I_P_List_null_counter,
+                     I_P_List_counter,
                      I_P_List_fast_push_back<connection_t> >
 connection_queue_t;
 
+/* One work queue per priority, TP_PRIORITY_HIGH is served first */
+#define NQUEUES 2
+
 struct thread_group_t 
 {
   mysql_mutex_t mutex;
-  connection_queue_t queue;
+  connection_queue_t queues[NQUEUES];
   worker_list_t waiting_threads; 
   worker_thread_t *listener;
   pthread_attr_t *pthread_attr;
@@ -143,6 +148,10 @@ struct thread_group_t
   /* Stats for the deadlock detection timer routine.*/
   int io_event_count;
   int queue_event_count;
+  /* Stats for INFORMATION_SCHEMA.THREAD_POOL_QUEUES */
+  ulonglong dequeue_count[NQUEUES];
+  ulonglong queue_wait_time[NQUEUES];
+  ulonglong kickup_count;
   ulonglong last_thread_creation_time;
   int  shutdown_pipe[2];
   bool shutdown;
@@ -411,18 +420,58 @@ static void* native_event_get_userdata(native_event *event)
 #endif
 
 
-/* Dequeue element from a workqueue */
+static bool queue_is_empty(thread_group_t *thread_group)
+{
+  for (int i= 0; i < NQUEUES; i++)
+  {
+    if (!thread_group->queues[i].is_empty())
+      return false;
+  }
+  return true;
+}
+
+
+/* Enqueue element into the workqueue matching its priority */
+
+static void queue_push(thread_group_t *thread_group, connection_t *connection)
+{
+  connection->enqueue_time= microsecond_interval_timer();
+  thread_group->queues[connection->priority].push_back(connection);
+}
+
+
+/* 
+  Dequeue element from a workqueue.
+
+  High priority connections are dequeued first. To prevent starvation,
+  a low priority connection that has waited for longer than
+  thread_pool_prio_kickup_timer milliseconds is dequeued ahead of them.
+*/
 
 static connection_t *queue_get(thread_group_t *thread_group)
 {
   DBUG_ENTER("queue_get");
   thread_group->queue_event_count++;
-  connection_t *c= thread_group->queue.front();
-  if (c)
+
+  if (queue_is_empty(thread_group))
+    DBUG_RETURN(NULL);
+
+  ulonglong now= microsecond_interval_timer();
+  connection_t *low= thread_group->queues[TP_PRIORITY_LOW].front();
+  int prio= TP_PRIORITY_HIGH;
+  if (thread_group->queues[TP_PRIORITY_HIGH].is_empty())
+    prio= TP_PRIORITY_LOW;
+  else if (low && now - low->enqueue_time >= threadpool_prio_kickup_timer * 1000ULL)
   {
-    thread_group->queue.remove(c);
+    prio= TP_PRIORITY_LOW;
+    thread_group->kickup_count++;
   }
-  DBUG_RETURN(c);  
+
+  connection_t *c= thread_group->queues[prio].front();
+  thread_group->queues[prio].remove(c);
+  thread_group->dequeue_count[prio]++;
+  thread_group->queue_wait_time[prio]+= now - c->enqueue_time;
+  DBUG_RETURN(c);
 }
 
 
@@ -591,7 +640,7 @@ void check_stall(thread_group_t *thread_group)
     do wait and indicate that via thd_wait_begin/end callbacks, thread creation
     will be faster.
   */
-  if (!thread_group->queue.is_empty() && !thread_group->queue_event_count)
+  if (!queue_is_empty(thread_group) && !thread_group->queue_event_count)
   {
     thread_group->stalled= true;
     wake_or_create_thread(thread_group);
@@ -709,23 +758,24 @@ static connection_t * listener(worker_thread_t *current_thread,
      more workers.
     */
     
-    bool listener_picks_event= thread_group->queue.is_empty();
+    bool listener_picks_event= queue_is_empty(thread_group);
     
     /* 
-      If listener_picks_event is set, listener thread will handle first event, 
-      and put the rest into the queue. If listener_pick_event is not set, all 
-      events go to the queue.
+      All events go to the queue. If listener_picks_event is set, listener
+      thread takes back the event that queue_get() prefers, so a high
+      priority request is not left behind a low priority one that happened
+      to be reported first.
     */
-    for(int i=(listener_picks_event)?1:0; i < cnt ; i++)
+    for(int i=0; i < cnt ; i++)
     {
       connection_t *c= (connection_t *)native_event_get_userdata(&ev[i]);
-      thread_group->queue.push_back(c);
+      queue_push(thread_group, c);
     }
     
     if (listener_picks_event)
     {
-      /* Handle the first event. */
-      retval= (connection_t *)native_event_get_userdata(&ev[0]);
+      /* Handle the event of highest priority. */
+      retval= queue_get(thread_group);
       mysql_mutex_unlock(&thread_group->mutex);
       break;
     }
@@ -911,7 +961,8 @@ int thread_group_init(thread_group_t *thread_group, pthread_attr_t* thread_attr)
   thread_group->pollfd= -1;
   thread_group->shutdown_pipe[0]= -1;
   thread_group->shutdown_pipe[1]= -1;
-  thread_group->queue.empty();
+  for (int i= 0; i < NQUEUES; i++)
+    thread_group->queues[i].empty();
   DBUG_RETURN(0);
 }
 
@@ -1017,7 +1068,7 @@ static void queue_put(thread_group_t *thread_group, connection_t *connection)
   DBUG_ENTER("queue_put");
 
   mysql_mutex_lock(&thread_group->mutex);
-  thread_group->queue.push_back(connection);
+  queue_push(thread_group, connection);
 
   if (thread_group->active_thread_count == 0)
     wake_or_create_thread(thread_group);
@@ -1172,7 +1223,7 @@ void wait_begin(thread_group_t *thread_group)
   DBUG_ASSERT(thread_group->connection_count > 0);
  
   if ((thread_group->active_thread_count == 0) && 
-     (thread_group->queue.is_empty() || !thread_group->listener))
+     (queue_is_empty(thread_group) || !thread_group->listener))
   {
     /* 
       Group might stall while this thread waits, thus wake 
@@ -1215,6 +1266,8 @@ connection_t *alloc_connection(THD *thd)
     connection->logged_in= false;
     connection->bound_to_poll_descriptor= false;
     connection->abs_wait_timeout= ULONGLONG_MAX;
+    /* Logins are queued behind requests of established connections */
+    connection->priority= TP_PRIORITY_LOW;
   }
   DBUG_RETURN(connection);
 }
@@ -1432,6 +1485,26 @@ static int start_io(connection_t *connection)
 
 
 
+/**
+  Priority of the next request of a connection.
+
+  With thread_pool_priority=auto, connections inside a transaction or
+  holding table locks are preferred, so they release their locks sooner.
+*/
+
+static TP_PRIORITY get_priority(connection_t *c)
+{
+  THD *thd= c->thd;
+  TP_PRIORITY prio= (TP_PRIORITY) thd->variables.threadpool_priority;
+  if (prio == TP_PRIORITY_AUTO)
+  {
+    prio= (thd->in_active_multi_stmt_transaction() || thd->locked_tables_mode) ?
+      TP_PRIORITY_HIGH : TP_PRIORITY_LOW;
+  }
+  return prio;
+}
+
+
 static void handle_event(connection_t *connection)
 {
 
@@ -1452,6 +1525,7 @@ static void handle_event(connection_t *connection)
     goto end;
 
   set_wait_timeout(connection);
+  connection->priority= get_priority(connection);
   err= start_io(connection);
 
 end:
@@ -1628,6 +1702,31 @@ int tp_get_idle_thread_count()
 }
 
 
+uint tp_get_group_count()
+{
+  return threadpool_started ? group_count : 0;
+}
+
+
+void tp_get_queue_statistics(uint group_id, TP_PRIORITY priority,
+                             TP_QUEUE_STATISTICS *stats)
+{
+  DBUG_ASSERT(group_id < threadpool_max_size);
+  DBUG_ASSERT(priority < NQUEUES);
+  thread_group_t *group= &all_groups[group_id];
+  ulonglong now= microsecond_interval_timer();
+
+  mysql_mutex_lock(&group->mutex);
+  connection_t *c= group->queues[priority].front();
+  stats->length= group->queues[priority].elements();
+  stats->oldest_wait= c ? now - c->enqueue_time : 0;
+  stats->dequeued= group->dequeue_count[priority];
+  stats->total_wait= group->queue_wait_time[priority];
+  stats->kickups= priority == TP_PRIORITY_LOW ? group->kickup_count : 0;
+  mysql_mutex_unlock(&group->mutex);
+}
+
+
 /* Report threadpool problems */
 
 /** 
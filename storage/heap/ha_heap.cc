@@ -104,6 +104,7 @@ int ha_heap::open(const char *name, int mode, uint test_if_locked)
 
     rc= heap_create(name, &create_info, &internal_share, &created_new_share);
     my_free(create_info.keydef);
+    my_free(create_info.columndef);
     if (rc)
       goto end;
 
@@ -359,6 +360,17 @@ int ha_heap::rnd_pos(uchar * buf, uchar *pos)
   return error;
 }
 
+int ha_heap::remember_rnd_pos()
+{
+  remembered_record= file->current_record;
+  return 0;
+}
+
+int ha_heap::restart_rnd_next(uchar *buf)
+{
+  return heap_scan_restart(file, buf, remembered_record);
+}
+
 void ha_heap::position(const uchar *record)
 {
   *(HEAP_PTR*) ref= heap_position(file);	// Ref is aligned
@@ -606,21 +618,76 @@ heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
 {
   uint key, parts, mem_per_row= 0, keys= table_arg->s->keys;
   uint auto_key= 0, auto_key_type= 0;
+  uint columns= 0, reclength= table_arg->s->reclength;
   ha_rows max_rows;
   HP_KEYDEF *keydef;
+  HP_COLUMNDEF *columndef;
   HA_KEYSEG *seg;
   TABLE_SHARE *share= table_arg->s;
+  THD *thd= current_thd;
   bool found_real_auto_increment= 0;
 
   bzero(hp_create_info, sizeof(*hp_create_info));
 
+  /*
+    Store the data of blobs, and of VARCHAR columns longer than 255
+    bytes that are not in a key, in chunks instead of the row.
+  */
+  if (!(columndef= (HP_COLUMNDEF*) my_malloc(share->fields *
+                                             sizeof(HP_COLUMNDEF),
+                                             MYF(MY_WME |
+                                                 MY_THREAD_SPECIFIC))))
+    return my_errno;
+  for (Field **field_ptr= table_arg->field; *field_ptr; field_ptr++)
+  {
+    Field *field= *field_ptr;
+    HP_COLUMNDEF *column= columndef + columns;
+
+    if (field->flags & BLOB_FLAG)
+    {
+      column->type= FIELD_BLOB;
+      column->length_bytes= ((Field_blob*) field)->pack_length_no_ptr();
+    }
+    else if (field->real_type() == MYSQL_TYPE_VARCHAR &&
+             ((Field_varstring*) field)->length_bytes == 2)
+    {
+      bool in_key= 0;
+      for (key= 0; key < keys && !in_key; key++)
+      {
+        KEY *pos= table_arg->key_info + key;
+        for (uint part= 0; part < pos->user_defined_key_parts; part++)
+          in_key|= pos->key_part[part].fieldnr == field->field_index + 1;
+      }
+      if (in_key)
+        continue;
+      column->type= FIELD_VARCHAR;
+      column->length_bytes= 2;
+    }
+    else
+      continue;
+    column->offset= (uint) (field->ptr - table_arg->record[0]);
+    column->length= field->pack_length();
+    reclength-= column->length - column->length_bytes;
+    columns++;
+  }
+  if (columns)
+    reclength+= sizeof(char*);
+  else
+  {
+    my_free(columndef);
+    columndef= 0;
+  }
+
   for (key= parts= 0; key < keys; key++)
     parts+= table_arg->key_info[key].user_defined_key_parts;
 
   if (!(keydef= (HP_KEYDEF*) my_malloc(keys * sizeof(HP_KEYDEF) +
 				       parts * sizeof(HA_KEYSEG),
 				       MYF(MY_WME | MY_THREAD_SPECIFIC))))
+  {
+    my_free(columndef);
     return my_errno;
+  }
   seg= reinterpret_cast<HA_KEYSEG*>(keydef + keys);
   for (key= 0; key < keys; key++)
   {
@@ -705,7 +772,7 @@ heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
       }
     }
   }
-  mem_per_row+= MY_ALIGN(share->reclength + 1, sizeof(char*));
+  mem_per_row+= MY_ALIGN(reclength + 1, sizeof(char*));
   if (table_arg->found_next_number_field)
   {
     keydef[share->next_number_index].flag|= HA_AUTO_KEY;
@@ -713,7 +780,11 @@ heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
   }
   hp_create_info->auto_key= auto_key;
   hp_create_info->auto_key_type= auto_key_type;
-  hp_create_info->max_table_size=current_thd->variables.max_heap_table_size;
+  hp_create_info->max_table_size= thd->variables.max_heap_table_size;
+  /* create_tmp_table() leaves the memory limit of its tables to us */
+  if (internal_table)
+    set_if_smaller(hp_create_info->max_table_size,
+                   thd->variables.tmp_table_size);
   hp_create_info->with_auto_increment= found_real_auto_increment;
   hp_create_info->internal_table= internal_table;
 
@@ -726,6 +797,8 @@ heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
   hp_create_info->keys= share->keys;
   hp_create_info->reclength= share->reclength;
   hp_create_info->keydef= keydef;
+  hp_create_info->columndef= columndef;
+  hp_create_info->columns= columns;
   return 0;
 }
 
@@ -745,6 +818,7 @@ int ha_heap::create(const char *name, TABLE *table_arg,
 				  create_info->auto_increment_value - 1 : 0);
   error= heap_create(name, &hp_create_info, &internal_share, &created);
   my_free(hp_create_info.keydef);
+  my_free(hp_create_info.columndef);
   DBUG_ASSERT(file == 0);
   return (error);
 }
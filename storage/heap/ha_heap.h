@@ -33,6 +33,8 @@ class ha_heap: public handler
   /* number of records changed since last statistics update */
   ulong   records_changed;
   uint    key_stat_version;
+  /* row of the scan to continue from, for restart_rnd_next() */
+  ulong   remembered_record;
   my_bool internal_table;
 public:
   ha_heap(handlerton *hton, TABLE_SHARE *table);
@@ -43,11 +45,12 @@ class ha_heap: public handler
     return ((table_share->key_info[inx].algorithm == HA_KEY_ALG_BTREE) ?
             "BTREE" : "HASH");
   }
-  /* Rows also use a fixed-size format */
-  enum row_type get_row_type() const { return ROW_TYPE_FIXED; }
+  /* Rows use a fixed-size format, unless some columns are in chunks */
+  enum row_type get_row_type() const
+  { return file && file->s->columns ? ROW_TYPE_DYNAMIC : ROW_TYPE_FIXED; }
   ulonglong table_flags() const
   {
-    return (HA_FAST_KEY_READ | HA_NO_BLOBS | HA_NULL_IN_KEY |
+    return (HA_FAST_KEY_READ | HA_NULL_IN_KEY |
             HA_BINLOG_ROW_CAPABLE | HA_BINLOG_STMT_CAPABLE |
             HA_CAN_SQL_HANDLER |
             HA_REC_NOT_IN_SEQ | HA_CAN_INSERT_DELAYED | HA_NO_TRANSACTIONS |
@@ -90,6 +93,8 @@ class ha_heap: public handler
   int rnd_init(bool scan);
   int rnd_next(uchar *buf);
   int rnd_pos(uchar * buf, uchar *pos);
+  int remember_rnd_pos();
+  int restart_rnd_next(uchar *buf);
   void position(const uchar *record);
   int can_continue_handler_scan();
   int info(uint);
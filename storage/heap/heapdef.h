@@ -32,6 +32,13 @@ C_MODE_START
 #define HP_MIN_RECORDS_IN_BLOCK 16
 #define HP_MAX_RECORDS_IN_BLOCK 8192
 
+/*
+  Length of a chunk of column data, including the pointer to the next
+  chunk.  See hp_record.c
+*/
+
+#define HP_CHUNK_LENGTH 256
+
 	/* Some extern variables */
 
 extern LIST *heap_open_list,*heap_share_list;
@@ -102,6 +109,9 @@ extern void hp_clear(HP_SHARE *info);
 extern void hp_clear_keys(HP_SHARE *info);
 extern uint hp_rb_pack_key(HP_KEYDEF *keydef, uchar *key, const uchar *old,
                            key_part_map keypart_map);
+extern int hp_pack_record(HP_INFO *info, const uchar *record);
+extern int hp_extract_record(HP_INFO *info, uchar *record, const uchar *pos);
+extern void hp_free_chunks(HP_SHARE *share, uchar *pos);
 
 extern mysql_mutex_t THR_LOCK_heap;
 
@@ -19,6 +19,9 @@
 static int keys_compare(heap_rb_param *param, uchar *key1, uchar *key2);
 static void init_block(HP_BLOCK *block,uint reclength,ulong min_records,
 		       ulong max_records);
+static int columndef_cmp(const void *a, const void *b);
+static uint hp_pack_offset(HP_COLUMNDEF *columndef, uint columns,
+                           uint offset);
 
 /* Create a heap table */
 
@@ -29,8 +32,10 @@ int heap_create(const char *name, HP_CREATE_INFO *create_info,
   HP_SHARE *share= 0;
   HA_KEYSEG *keyseg;
   HP_KEYDEF *keydef= create_info->keydef;
+  HP_COLUMNDEF *columndef= create_info->columndef;
   uint reclength= create_info->reclength;
   uint keys= create_info->keys;
+  uint columns= create_info->columns;
   ulong min_records= create_info->min_records;
   ulong max_records= create_info->max_records;
   DBUG_ENTER("heap_create");
@@ -55,6 +60,22 @@ int heap_create(const char *name, HP_CREATE_INFO *create_info,
   {
     HP_KEYDEF *keyinfo;
     DBUG_PRINT("info",("Initializing new table"));
+
+    if (columns)
+    {
+      /*
+        The row stores only the length of the data of these columns,
+        and the pointer to the chunks with their data at the end.
+        See hp_record.c
+      */
+      qsort(columndef, columns, sizeof(*columndef), columndef_cmp);
+      for (i= length= 0; i < columns; i++)
+      {
+        columndef[i].pack_offset= columndef[i].offset - length;
+        length+= columndef[i].length - columndef[i].length_bytes;
+      }
+      reclength+= sizeof(uchar*) - length;
+    }
     
     /*
       We have to store sometimes uchar* del_link in records,
@@ -68,6 +89,14 @@ int heap_create(const char *name, HP_CREATE_INFO *create_info,
       bzero((char*) &keyinfo->rb_tree ,sizeof(keyinfo->rb_tree));
       for (j= length= 0; j < keyinfo->keysegs; j++)
       {
+        if (columns)
+        {
+          /* Keys are made from the row, where the columns are moved */
+          HA_KEYSEG *seg= keyinfo->seg + j;
+          seg->start= hp_pack_offset(columndef, columns, seg->start);
+          seg->null_pos= hp_pack_offset(columndef, columns, seg->null_pos);
+          seg->bit_pos= hp_pack_offset(columndef, columns, seg->bit_pos);
+        }
 	length+= keyinfo->seg[j].length;
 	if (keyinfo->seg[j].null_bit)
 	{
@@ -146,7 +175,8 @@ int heap_create(const char *name, HP_CREATE_INFO *create_info,
     }
     if (!(share= (HP_SHARE*) my_malloc((uint) sizeof(HP_SHARE)+
 				       keys*sizeof(HP_KEYDEF)+
-				       key_segs*sizeof(HA_KEYSEG),
+				       key_segs*sizeof(HA_KEYSEG)+
+				       columns*sizeof(HP_COLUMNDEF),
 				       MYF(MY_ZEROFILL |
                                            (create_info->internal_table ?
                                             MY_THREAD_SPECIFIC : 0)))))
@@ -155,6 +185,14 @@ int heap_create(const char *name, HP_CREATE_INFO *create_info,
     share->key_stat_version= 1;
     keyseg= (HA_KEYSEG*) (share->keydef + keys);
     init_block(&share->block, reclength + 1, min_records, max_records);
+    if (columns)
+    {
+      share->columndef= (HP_COLUMNDEF*) (keyseg + key_segs);
+      memcpy(share->columndef, columndef,
+             (size_t) (sizeof(columndef[0]) * columns));
+      init_block(&share->chunk_block, HP_CHUNK_LENGTH, min_records,
+                 max_records);
+    }
 	/* Fix keys */
     memcpy(share->keydef, keydef, (size_t) (sizeof(keydef[0]) * keys));
     for (i= 0, keyinfo= share->keydef; i < keys; i++, keyinfo++)
@@ -196,6 +234,8 @@ int heap_create(const char *name, HP_CREATE_INFO *create_info,
     share->max_table_size= create_info->max_table_size;
     share->data_length= share->index_length= 0;
     share->reclength= reclength;
+    share->org_reclength= create_info->reclength;
+    share->columns= columns;
     share->blength= 1;
     share->keys= keys;
     share->max_key_length= max_length;
@@ -247,6 +287,25 @@ static int keys_compare(heap_rb_param *param, uchar *key1, uchar *key2)
 		    param->search_flag, not_used);
 }
 
+static int columndef_cmp(const void *a, const void *b)
+{
+  uint offset_a= ((const HP_COLUMNDEF*) a)->offset;
+  uint offset_b= ((const HP_COLUMNDEF*) b)->offset;
+  return offset_a < offset_b ? -1 : offset_a > offset_b;
+}
+
+/* Offset in the row of a byte of the record that is not in columndef */
+
+static uint hp_pack_offset(HP_COLUMNDEF *columndef, uint columns,
+                           uint offset)
+{
+  HP_COLUMNDEF *end= columndef + columns;
+  uint pack_offset= offset;
+  for (; columndef < end && columndef->offset < offset; columndef++)
+    pack_offset-= columndef->length - columndef->length_bytes;
+  return pack_offset;
+}
+
 static void init_block(HP_BLOCK *block, uint reclength, ulong min_records,
 		       ulong max_records)
 {
@@ -33,6 +33,8 @@ int heap_delete(HP_INFO *info, const uchar *record)
 
   if ( --(share->records) < share->blength >> 1) share->blength>>=1;
   pos=info->current_ptr;
+  if (share->columns)
+    record= pos;                                /* Keys are made from rows */
 
   p_lastinx = share->keydef + info->lastinx;
   for (keydef = share->keydef, end = keydef + share->keys; keydef < end; 
@@ -43,6 +45,8 @@ int heap_delete(HP_INFO *info, const uchar *record)
   }
 
   info->update=HA_STATE_DELETED;
+  if (share->columns)
+    hp_free_chunks(share, pos);
   *((uchar**) pos)=share->del_link;
   share->del_link=pos;
   pos[share->reclength]=0;		/* Record deleted */
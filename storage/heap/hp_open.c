@@ -31,7 +31,8 @@ HP_INFO *heap_open_from_share(HP_SHARE *share, int mode)
   DBUG_ENTER("heap_open_from_share");
 
   if (!(info= (HP_INFO*) my_malloc(sizeof(HP_INFO) +
-				  2 * share->max_key_length,
+				  2 * share->max_key_length +
+                                   (share->columns ? share->reclength : 0),
                                    MYF(MY_ZEROFILL +
                                        (share->internal ?
                                         MY_THREAD_SPECIFIC : 0)))))
@@ -43,6 +44,7 @@ HP_INFO *heap_open_from_share(HP_SHARE *share, int mode)
   info->s= share;
   info->lastkey= (uchar*) (info + 1);
   info->recbuf= (uchar*) (info->lastkey + share->max_key_length);
+  info->rec_buff= (uchar*) (info->recbuf + share->max_key_length);
   info->mode= mode;
   info->current_record= (ulong) ~0L;		/* No current record */
   info->lastinx= info->errkey= -1;
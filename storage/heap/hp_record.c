@@ -0,0 +1,276 @@
+/* Copyright (c) 2015, MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/*
+  Rows with columns stored in chunks
+
+  The columns in HP_SHARE::columndef (BLOB/TEXT and long VARCHAR columns
+  that are not part of a key) are not stored in the row at the full
+  width they have in the record.  For each of them the row keeps only
+  the bytes of the length of the data, the other columns are stored as
+  they are in the record.  The data of these columns follows, one column
+  after the other, in one chain of chunks of HP_CHUNK_LENGTH bytes,
+  allocated from HP_SHARE::chunk_block.  A chunk starts with the pointer
+  to the next one, the pointer to the first chunk is at the end of the
+  row.
+
+  As the columns of the keys are stored as in the record, keys are made
+  from the row, with the key segments moved to the offsets in the row
+  by heap_create().
+*/
+
+#include "heapdef.h"
+
+#define CHUNK_DATA_LENGTH (HP_CHUNK_LENGTH - sizeof(uchar*))
+
+
+static uint column_data_length(HP_COLUMNDEF *column, const uchar *pos)
+{
+  switch (column->length_bytes) {
+  case 1:
+    return (uint) *pos;
+  case 2:
+    return uint2korr(pos);
+  case 3:
+    return uint3korr(pos);
+  default:
+    return uint4korr(pos);
+  }
+}
+
+
+static uchar *next_free_chunk(HP_SHARE *share)
+{
+  ulong block_pos;
+  uchar *pos;
+  size_t length;
+
+  if ((pos= share->chunk_del_link))
+  {
+    share->chunk_del_link= *((uchar**) pos);
+    return pos;
+  }
+  if (!(block_pos= (share->chunks % share->chunk_block.records_in_block)))
+  {
+    if (share->data_length + share->index_length >= share->max_table_size)
+    {
+      my_errno= HA_ERR_RECORD_FILE_FULL;
+      return NULL;
+    }
+    if (hp_get_new_block(share, &share->chunk_block, &length))
+      return NULL;
+    share->data_length+= length;
+  }
+  share->chunks++;
+  return ((uchar*) share->chunk_block.level_info[0].last_blocks +
+          block_pos * share->chunk_block.recbuffer);
+}
+
+
+static void free_chain(HP_SHARE *share, uchar *chunk)
+{
+  uchar *next;
+  for (; chunk; chunk= next)
+  {
+    next= *((uchar**) chunk);
+    *((uchar**) chunk)= share->chunk_del_link;
+    share->chunk_del_link= chunk;
+  }
+}
+
+
+/*
+  Free the chunks of a row
+
+  SYNOPSIS
+    hp_free_chunks()
+    share		Heap table
+    pos			Row with columns stored in chunks
+*/
+
+void hp_free_chunks(HP_SHARE *share, uchar *pos)
+{
+  uchar *chunk;
+  memcpy(&chunk, pos + share->reclength - sizeof(chunk), sizeof(chunk));
+  free_chain(share, chunk);
+}
+
+
+/*
+  Make the row to store for a record in info->rec_buff
+
+  SYNOPSIS
+    hp_pack_record()
+    info		Heap table handler
+    record		Record given to heap_write() or heap_update()
+
+  NOTES
+    The data of the columns in chunks is copied to new chunks.  The row
+    owns them until it is deleted, or hp_free_chunks() is called on
+    info->rec_buff if the row is not stored.
+
+  RETURN
+    0      ok
+    other  error code; HA_ERR_RECORD_FILE_FULL if the table is full
+*/
+
+int hp_pack_record(HP_INFO *info, const uchar *record)
+{
+  HP_SHARE *share= info->s;
+  HP_COLUMNDEF *column, *end= share->columndef + share->columns;
+  uchar *to= info->rec_buff, *first= 0, **link= &first, *chunk= 0;
+  uint from= 0;
+  size_t left= 0;
+  DBUG_ENTER("hp_pack_record");
+
+  for (column= share->columndef; column < end; column++)
+  {
+    const uchar *data;
+    size_t length;
+
+    /* The columns before this one, and the length of the data */
+    memcpy(to, record + from, column->offset + column->length_bytes - from);
+    to+= column->offset + column->length_bytes - from;
+    from= column->offset + column->length;
+
+    length= column_data_length(column, record + column->offset);
+    if (column->type == FIELD_BLOB)
+      memcpy(&data, record + column->offset + column->length_bytes,
+             sizeof(data));
+    else
+      data= record + column->offset + column->length_bytes;
+
+    while (length)
+    {
+      size_t part;
+      if (!left)
+      {
+        if (!(chunk= next_free_chunk(share)))
+          goto err;
+        *link= chunk;
+        link= (uchar**) chunk;
+        *link= 0;
+        left= CHUNK_DATA_LENGTH;
+      }
+      part= MY_MIN(length, left);
+      memcpy(chunk + HP_CHUNK_LENGTH - left, data, part);
+      data+= part;
+      length-= part;
+      left-= part;
+    }
+  }
+  memcpy(to, record + from, share->org_reclength - from);
+  to+= share->org_reclength - from;
+  memcpy(to, &first, sizeof(first));
+  DBUG_RETURN(0);
+
+err:
+  free_chain(share, first);
+  DBUG_RETURN(my_errno);
+}
+
+
+/*
+  Copy a row to a record
+
+  SYNOPSIS
+    hp_extract_record()
+    info		Heap table handler
+    record		Store the record here
+    pos			Row in the table
+
+  NOTES
+    The blobs of the record point to info->blob_buff, which is valid
+    until the next row is read with this handler.
+
+  RETURN
+    0      ok
+    other  error code
+*/
+
+int hp_extract_record(HP_INFO *info, uchar *record, const uchar *pos)
+{
+  HP_SHARE *share= info->s;
+  HP_COLUMNDEF *column, *end;
+  const uchar *chunk= 0, *next;
+  uchar *blob;
+  size_t blob_length= 0, left= 0;
+  uint from= 0, pack_from= 0;
+
+  if (!share->columns)
+  {
+    memcpy(record, pos, (size_t) share->reclength);
+    return 0;
+  }
+
+  end= share->columndef + share->columns;
+  for (column= share->columndef; column < end; column++)
+  {
+    if (column->type == FIELD_BLOB)
+      blob_length+= column_data_length(column, pos + column->pack_offset);
+  }
+  if (blob_length > info->blob_buff_length)
+  {
+    if (!(blob= (uchar*) my_realloc(info->blob_buff, blob_length,
+                                    MYF(MY_ALLOW_ZERO_PTR |
+                                        (share->internal ?
+                                         MY_THREAD_SPECIFIC : 0)))))
+      return my_errno= HA_ERR_OUT_OF_MEM;
+    info->blob_buff= blob;
+    info->blob_buff_length= blob_length;
+  }
+  blob= info->blob_buff;
+
+  memcpy(&next, pos + share->reclength - sizeof(next), sizeof(next));
+  for (column= share->columndef; column < end; column++)
+  {
+    uchar *data;
+    size_t length;
+
+    memcpy(record + from, pos + pack_from,
+           column->offset + column->length_bytes - from);
+    from= column->offset + column->length;
+    pack_from= column->pack_offset + column->length_bytes;
+
+    length= column_data_length(column, pos + column->pack_offset);
+    if (column->type == FIELD_BLOB)
+    {
+      data= blob;
+      blob+= length;
+      memcpy(record + column->offset + column->length_bytes, &data,
+             sizeof(data));
+    }
+    else
+      data= record + column->offset + column->length_bytes;
+
+    while (length)
+    {
+      size_t part;
+      if (!left)
+      {
+        chunk= next;
+        next= *((uchar**) chunk);
+        left= CHUNK_DATA_LENGTH;
+      }
+      part= MY_MIN(length, left);
+      memcpy(data, chunk + HP_CHUNK_LENGTH - left, part);
+      data+= part;
+      length-= part;
+      left-= part;
+    }
+  }
+  memcpy(record + from, pos + pack_from, share->org_reclength - from);
+  return 0;
+}
@@ -41,14 +41,15 @@ int heap_rsame(register HP_INFO *info, uchar *record, int inx)
     else if (inx != -1)
     {
       info->lastinx=inx;
-      hp_make_key(share->keydef + inx, info->lastkey, record);
+      hp_make_key(share->keydef + inx, info->lastkey, info->current_ptr);
       if (!hp_search(info, share->keydef + inx, info->lastkey, 3))
       {
 	info->update= 0;
 	DBUG_RETURN(my_errno);
       }
     }
-    memcpy(record,info->current_ptr,(size_t) share->reclength);
+    if (hp_extract_record(info, record, info->current_ptr))
+      DBUG_RETURN(my_errno);
     DBUG_RETURN(0);
   }
   info->update=0;
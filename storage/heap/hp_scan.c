@@ -69,7 +69,46 @@ int heap_scan(register HP_INFO *info, uchar *record)
     DBUG_RETURN(my_errno=HA_ERR_RECORD_DELETED);
   }
   info->update= HA_STATE_PREV_FOUND | HA_STATE_NEXT_FOUND | HA_STATE_AKTIV;
-  memcpy(record,info->current_ptr,(size_t) share->reclength);
+  if (hp_extract_record(info, record, info->current_ptr))
+    DBUG_RETURN(my_errno);
   info->current_hash_ptr=0;			/* Can't use read_next */
   DBUG_RETURN(0);
 } /* heap_scan */
+
+
+/*
+  Read a row found by heap_scan() again, and continue the scan after it
+
+  SYNOPSIS
+    heap_scan_restart()
+    info		Heap table handler
+    record		Store the row here
+    pos			info->current_record after heap_scan() read the row
+*/
+
+int heap_scan_restart(HP_INFO *info, uchar *record, ulong pos)
+{
+  HP_SHARE *share=info->s;
+  ulong records_in_block= share->block.records_in_block;
+  DBUG_ENTER("heap_scan_restart");
+
+  info->current_record= pos;
+  info->next_block= MY_MIN((pos / records_in_block + 1) * records_in_block,
+                           share->records + share->deleted);
+  if (pos >= info->next_block)
+  {
+    info->update= 0;
+    DBUG_RETURN(my_errno= HA_ERR_END_OF_FILE);
+  }
+  hp_find_record(info, pos);
+  if (!info->current_ptr[share->reclength])
+  {
+    info->update= HA_STATE_PREV_FOUND | HA_STATE_NEXT_FOUND;
+    DBUG_RETURN(my_errno=HA_ERR_RECORD_DELETED);
+  }
+  info->update= HA_STATE_PREV_FOUND | HA_STATE_NEXT_FOUND | HA_STATE_AKTIV;
+  if (hp_extract_record(info, record, info->current_ptr))
+    DBUG_RETURN(my_errno);
+  info->current_hash_ptr=0;
+  DBUG_RETURN(0);
+}
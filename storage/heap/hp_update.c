@@ -31,6 +31,14 @@ int heap_update(HP_INFO *info, const uchar *old, const uchar *heap_new)
 
   if (info->opt_flag & READ_CHECK_USED && hp_rectest(info,old))
     DBUG_RETURN(my_errno);				/* Record changed */
+  if (share->columns)
+  {
+    /* Keys are made from the rows */
+    if (hp_pack_record(info, heap_new))
+      DBUG_RETURN(my_errno);
+    heap_new= info->rec_buff;
+    old= pos;
+  }
   if (--(share->records) < share->blength >> 1) share->blength>>= 1;
   share->changed=1;
 
@@ -47,6 +55,8 @@ int heap_update(HP_INFO *info, const uchar *old, const uchar *heap_new)
     }
   }
 
+  if (share->columns)
+    hp_free_chunks(share, pos);
   memcpy(pos,heap_new,(size_t) share->reclength);
   if (++(share->records) == share->blength) share->blength+= share->blength;
 
@@ -85,6 +95,8 @@ int heap_update(HP_INFO *info, const uchar *old, const uchar *heap_new)
       keydef--;
     }
   }
+  if (share->columns)
+    hp_free_chunks(share, info->rec_buff);
   if (++(share->records) == share->blength)
     share->blength+= share->blength;
   DBUG_RETURN(my_errno);
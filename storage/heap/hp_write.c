@@ -42,8 +42,19 @@ int heap_write(HP_INFO *info, const uchar *record)
     DBUG_RETURN(my_errno=EACCES);
   }
 #endif
+  if (share->columns)
+  {
+    /* Keys are made from the row */
+    if (hp_pack_record(info, record))
+      DBUG_RETURN(my_errno);
+    record= info->rec_buff;
+  }
   if (!(pos=next_free_record_pos(share)))
+  {
+    if (share->columns)
+      hp_free_chunks(share, info->rec_buff);
     DBUG_RETURN(my_errno);
+  }
   share->changed=1;
 
   for (keydef = share->keydef, end = keydef + share->keys; keydef < end;
@@ -89,6 +100,8 @@ int heap_write(HP_INFO *info, const uchar *record)
     keydef--;
   } 
 
+  if (share->columns)
+    hp_free_chunks(share, info->rec_buff);
   share->deleted++;
   *((uchar**) pos)=share->del_link;
   share->del_link=pos;
@@ -30,8 +30,10 @@ Created April 08, 2011 Vasil Dimov
 
 #include "buf0buf.h" /* buf_pool_mutex_enter(), srv_buf_pool_instances */
 #include "buf0dump.h"
+#include "buf0rea.h" /* buf_read_pages_async() */
 #include "db0err.h"
 #include "dict0dict.h" /* dict_operation_lock */
+#include "mach0data.h" /* mach_write_compressed() */
 #include "os0file.h" /* OS_FILE_MAX_PATH */
 #include "os0sync.h" /* os_event* */
 #include "os0thread.h" /* os_thread_* */
@@ -68,6 +70,24 @@ typedef ib_uint64_t	buf_dump_t;
 #define BUF_DUMP_SPACE(a)		((ulint) ((a) >> 32))
 #define BUF_DUMP_PAGE(a)		((ulint) ((a) & 0xFFFFFFFFUL))
 
+/* The dump file starts with BUF_DUMP_MAGIC, followed by one byte of
+BUF_DUMP_VERSION and one byte of BUF_DUMP_N_TIERS. The pages of the LRU
+list of each buffer pool instance are split by their position in the list
+into BUF_DUMP_N_TIERS tiers of equal size, the hottest one first, and each
+tier is written as the compressed number of its pages followed by the
+pages sorted on space_no,page_no. A page is written as a compressed delta
+from the previous page of the same tier in the same tablespace, or as
+a compressed 0 followed by the compressed space_no and page_no. Files
+in the older text format of "space_no,page_no" lines are still loaded. */
+#define BUF_DUMP_MAGIC			"IBPD"
+#define BUF_DUMP_MAGIC_LEN		4
+#define BUF_DUMP_HEADER_LEN		(BUF_DUMP_MAGIC_LEN + 2)
+#define BUF_DUMP_VERSION		1
+#define BUF_DUMP_N_TIERS		8
+
+/* Maximum number of consecutive pages that buf_load() requests at once */
+#define BUF_LOAD_MAX_RUN		64
+
 /*****************************************************************//**
 Wakes up the buffer pool dump/load thread and instructs it to start
 a dump. This function is called by MySQL code via buffer_pool_dump_now()
@@ -167,6 +187,79 @@ buf_load_status(
 	va_end(ap);
 }
 
+/*****************************************************************//**
+Compare two buffer pool dump entries, used to sort the dump on
+space_no,page_no before loading in order to increase the chance for
+sequential IO.
+@return -1/0/1 if entry 1 is smaller/equal/bigger than entry 2 */
+static
+lint
+buf_dump_cmp(
+/*=========*/
+	const buf_dump_t	d1,	/*!< in: buffer pool dump entry 1 */
+	const buf_dump_t	d2)	/*!< in: buffer pool dump entry 2 */
+{
+	if (d1 < d2) {
+		return(-1);
+	} else if (d1 == d2) {
+		return(0);
+	} else {
+		return(1);
+	}
+}
+
+/*****************************************************************//**
+Sort a buffer pool dump on space_no, page_no. */
+static
+void
+buf_dump_sort(
+/*==========*/
+	buf_dump_t*	dump,	/*!< in/out: buffer pool dump to sort */
+	buf_dump_t*	tmp,	/*!< in/out: temp storage */
+	ulint		low,	/*!< in: lowest index (inclusive) */
+	ulint		high)	/*!< in: highest index (non-inclusive) */
+{
+	UT_SORT_FUNCTION_BODY(buf_dump_sort, dump, tmp, low, high,
+			      buf_dump_cmp);
+}
+
+/*****************************************************************//**
+Write the pages of one tier of a buffer pool dump in the binary format.
+@return pointer to the end of the written data */
+static
+byte*
+buf_dump_write_tier(
+/*================*/
+	byte*			ptr,	/*!< out: buffer to write to, at least
+					1 + 11 * n bytes */
+	const buf_dump_t*	dump,	/*!< in: pages of the tier, sorted */
+	ulint			n)	/*!< in: number of pages */
+{
+	ulint	space_id = ULINT_UNDEFINED;
+	ulint	page_no = 0;
+	ulint	j;
+
+	ptr += mach_write_compressed(ptr, n);
+
+	for (j = 0; j < n; j++) {
+		if (BUF_DUMP_SPACE(dump[j]) == space_id) {
+			ut_ad(BUF_DUMP_PAGE(dump[j]) > page_no);
+			ptr += mach_write_compressed(
+				ptr, BUF_DUMP_PAGE(dump[j]) - page_no);
+		} else {
+			space_id = BUF_DUMP_SPACE(dump[j]);
+			ptr += mach_write_compressed(ptr, 0);
+			ptr += mach_write_compressed(ptr, space_id);
+			ptr += mach_write_compressed(
+				ptr, BUF_DUMP_PAGE(dump[j]));
+		}
+
+		page_no = BUF_DUMP_PAGE(dump[j]);
+	}
+
+	return(ptr);
+}
+
 /*****************************************************************//**
 Perform a buffer pool dump into the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
@@ -185,6 +278,7 @@ buf_dump(
 	char	full_filename[OS_FILE_MAX_PATH];
 	char	tmp_filename[OS_FILE_MAX_PATH];
 	char	now[32];
+	byte	header[BUF_DUMP_HEADER_LEN];
 	FILE*	f;
 	ulint	i;
 	int	ret;
@@ -199,7 +293,7 @@ buf_dump(
 	buf_dump_status(STATUS_NOTICE, "Dumping buffer pool(s) to %s",
 			full_filename);
 
-	f = fopen(tmp_filename, "w");
+	f = fopen(tmp_filename, "wb");
 	if (f == NULL) {
 		buf_dump_status(STATUS_ERR,
 				"Cannot open '%s' for writing: %s",
@@ -208,13 +302,30 @@ buf_dump(
 	}
 	/* else */
 
+	memcpy(header, BUF_DUMP_MAGIC, BUF_DUMP_MAGIC_LEN);
+	header[BUF_DUMP_MAGIC_LEN] = BUF_DUMP_VERSION;
+	header[BUF_DUMP_MAGIC_LEN + 1] = BUF_DUMP_N_TIERS;
+
+	if (fwrite(header, 1, sizeof(header), f) != sizeof(header)) {
+		fclose(f);
+		buf_dump_status(STATUS_ERR,
+				"Cannot write to '%s': %s",
+				tmp_filename, strerror(errno));
+		/* leave tmp_filename to exist */
+		return;
+	}
+
 	/* walk through each buffer pool */
 	for (i = 0; i < srv_buf_pool_instances && !SHOULD_QUIT(); i++) {
 		buf_pool_t*		buf_pool;
 		const buf_page_t*	bpage;
 		buf_dump_t*		dump;
+		buf_dump_t*		dump_tmp;
+		byte*			buf;
+		ulint			buf_size;
 		ulint			n_pages;
 		ulint			j;
+		ulint			t;
 
 		buf_pool = buf_pool_from_array(i);
 
@@ -244,9 +355,10 @@ buf_dump(
 			return;
 		}
 
-		for (bpage = UT_LIST_GET_LAST(buf_pool->LRU), j = 0;
+		/* the hottest pages first */
+		for (bpage = UT_LIST_GET_FIRST(buf_pool->LRU), j = 0;
 		     bpage != NULL;
-		     bpage = UT_LIST_GET_PREV(LRU, bpage), j++) {
+		     bpage = UT_LIST_GET_NEXT(LRU, bpage), j++) {
 
 			ut_a(buf_page_in_file(bpage));
 
@@ -258,11 +370,43 @@ buf_dump(
 
 		buf_pool_mutex_exit(buf_pool);
 
-		for (j = 0; j < n_pages && !SHOULD_QUIT(); j++) {
-			ret = fprintf(f, ULINTPF "," ULINTPF "\n",
-				      BUF_DUMP_SPACE(dump[j]),
-				      BUF_DUMP_PAGE(dump[j]));
-			if (ret < 0) {
+		/* at most 5 bytes for the number of pages of a tier, and
+		1 + 5 + 5 bytes for a page */
+		buf_size = BUF_DUMP_N_TIERS * 5 + n_pages * 11;
+
+		dump_tmp = static_cast<buf_dump_t*>(
+			ut_malloc(n_pages * sizeof(*dump_tmp)));
+		buf = static_cast<byte*>(ut_malloc(buf_size));
+
+		if (dump_tmp == NULL || buf == NULL) {
+			ut_free(buf);
+			ut_free(dump_tmp);
+			ut_free(dump);
+			fclose(f);
+			buf_dump_status(STATUS_ERR,
+					"Cannot allocate " ULINTPF " bytes: %s",
+					(ulint) (n_pages * sizeof(*dump_tmp)
+						 + buf_size),
+					strerror(errno));
+			/* leave tmp_filename to exist */
+			return;
+		}
+
+		for (t = 0; t < BUF_DUMP_N_TIERS && !SHOULD_QUIT(); t++) {
+			ulint	low = n_pages * t / BUF_DUMP_N_TIERS;
+			ulint	high = n_pages * (t + 1) / BUF_DUMP_N_TIERS;
+			ulint	len;
+
+			if (low < high) {
+				buf_dump_sort(dump, dump_tmp, low, high);
+			}
+
+			len = buf_dump_write_tier(buf, dump + low, high - low)
+				- buf;
+
+			if (fwrite(buf, 1, len, f) != len) {
+				ut_free(buf);
+				ut_free(dump_tmp);
 				ut_free(dump);
 				fclose(f);
 				buf_dump_status(STATUS_ERR,
@@ -272,17 +416,17 @@ buf_dump(
 				return;
 			}
 
-			if (j % 128 == 0) {
-				buf_dump_status(
-					STATUS_INFO,
-					"Dumping buffer pool "
-					ULINTPF "/" ULINTPF ", "
-					"page " ULINTPF "/" ULINTPF,
-					i + 1, srv_buf_pool_instances,
-					j + 1, n_pages);
-			}
+			buf_dump_status(
+				STATUS_INFO,
+				"Dumping buffer pool "
+				ULINTPF "/" ULINTPF ", "
+				"page " ULINTPF "/" ULINTPF,
+				i + 1, srv_buf_pool_instances,
+				high, n_pages);
 		}
 
+		ut_free(buf);
+		ut_free(dump_tmp);
 		ut_free(dump);
 	}
 
@@ -325,90 +469,211 @@ buf_dump(
 }
 
 /*****************************************************************//**
-Compare two buffer pool dump entries, used to sort the dump on
-space_no,page_no before loading in order to increase the chance for
-sequential IO.
-@return -1/0/1 if entry 1 is smaller/equal/bigger than entry 2 */
+Parse the pages of one tier of a buffer pool dump in the binary format.
+The pages are stored in dump[*pos] onwards, up to dump[limit - 1]; the
+remaining pages of the tier are parsed but not stored.
+@return pointer to the end of the tier, or NULL if the data is corrupted */
 static
-lint
-buf_dump_cmp(
-/*=========*/
-	const buf_dump_t	d1,	/*!< in: buffer pool dump entry 1 */
-	const buf_dump_t	d2)	/*!< in: buffer pool dump entry 2 */
+byte*
+buf_load_parse_tier(
+/*================*/
+	byte*		ptr,	/*!< in: pointer to the pages of the tier */
+	byte*		end_ptr,/*!< in: end of the buffer */
+	ulint		n,	/*!< in: number of pages in the tier */
+	buf_dump_t*	dump,	/*!< out: parsed pages, or NULL */
+	ulint*		pos,	/*!< in/out: position to store the next
+				page in dump */
+	ulint		limit)	/*!< in: end of the space in dump */
 {
-	if (d1 < d2) {
-		return(-1);
-	} else if (d1 == d2) {
-		return(0);
-	} else {
-		return(1);
+	ulint	space_id = ULINT_UNDEFINED;
+	ulint	page_no = 0;
+	ulint	delta;
+
+	for (; n > 0; n--) {
+		ptr = mach_parse_compressed(ptr, end_ptr, &delta);
+
+		if (ptr == NULL) {
+			return(NULL);
+		} else if (delta != 0) {
+			if (space_id == ULINT_UNDEFINED
+			    || page_no + delta > ULINT32_MASK) {
+				return(NULL);
+			}
+			page_no += delta;
+		} else {
+			ptr = mach_parse_compressed(ptr, end_ptr, &space_id);
+			if (ptr == NULL) {
+				return(NULL);
+			}
+			ptr = mach_parse_compressed(ptr, end_ptr, &page_no);
+			if (ptr == NULL) {
+				return(NULL);
+			}
+		}
+
+		if (dump != NULL && *pos < limit) {
+			dump[(*pos)++] = BUF_DUMP_CREATE(space_id, page_no);
+		}
 	}
+
+	return(ptr);
 }
 
 /*****************************************************************//**
-Sort a buffer pool dump on space_no, page_no. */
+Read a buffer pool dump in the binary format. The hottest tier comes
+first in the returned array, the pages within each tier are not sorted.
+If the dump is larger than max_n pages, then the coldest pages are
+ignored.
+@return true on success, false if an error was reported in
+innodb_buffer_pool_load_status */
 static
-void
-buf_dump_sort(
-/*==========*/
-	buf_dump_t*	dump,	/*!< in/out: buffer pool dump to sort */
-	buf_dump_t*	tmp,	/*!< in/out: temp storage */
-	ulint		low,	/*!< in: lowest index (inclusive) */
-	ulint		high)	/*!< in: highest index (non-inclusive) */
+bool
+buf_load_read_binary(
+/*=================*/
+	FILE*		f,		/*!< in: file positioned after the
+					magic number */
+	const char*	full_filename,	/*!< in: name of the file */
+	ulint		max_n,		/*!< in: maximum number of pages */
+	buf_dump_t**	dump,		/*!< out: pages, to be freed with
+					ut_free() */
+	ulint*		dump_n,		/*!< out: number of pages */
+	ulint*		tier_end)	/*!< out: BUF_DUMP_N_TIERS positions
+					in dump after the end of each tier */
 {
-	UT_SORT_FUNCTION_BODY(buf_dump_sort, dump, tmp, low, high,
-			      buf_dump_cmp);
+	byte*	buf;
+	byte*	ptr;
+	byte*	end_ptr;
+	long	size;
+	ulint	tier_n[BUF_DUMP_N_TIERS];
+	ulint	pos[BUF_DUMP_N_TIERS];
+	ulint	n;
+	ulint	t;
+
+	if (fseek(f, 0, SEEK_END) != 0 || (size = ftell(f)) < 0
+	    || fseek(f, 0, SEEK_SET) != 0) {
+		buf_load_status(STATUS_ERR, "Error reading '%s': %s",
+				full_filename, strerror(errno));
+		return(false);
+	}
+
+	buf = static_cast<byte*>(ut_malloc(size));
+
+	if (buf == NULL) {
+		buf_load_status(STATUS_ERR,
+				"Cannot allocate " ULINTPF " bytes: %s",
+				(ulint) size, strerror(errno));
+		return(false);
+	}
+
+	if (fread(buf, 1, size, f) != (size_t) size) {
+		ut_free(buf);
+		buf_load_status(STATUS_ERR, "Error reading '%s', "
+				"unable to load buffer pool", full_filename);
+		return(false);
+	}
+
+	end_ptr = buf + size;
+
+	if (size < BUF_DUMP_HEADER_LEN
+	    || buf[BUF_DUMP_MAGIC_LEN] != BUF_DUMP_VERSION
+	    || buf[BUF_DUMP_MAGIC_LEN + 1] != BUF_DUMP_N_TIERS) {
+		ut_free(buf);
+		buf_load_status(STATUS_ERR, "Unsupported format of '%s', "
+				"unable to load buffer pool", full_filename);
+		return(false);
+	}
+
+	/* First count the pages of each tier */
+	memset(tier_n, 0, sizeof(tier_n));
+
+	for (ptr = buf + BUF_DUMP_HEADER_LEN, t = 0; ptr < end_ptr;
+	     t = (t + 1) % BUF_DUMP_N_TIERS) {
+
+		ptr = mach_parse_compressed(ptr, end_ptr, &n);
+
+		if (ptr != NULL) {
+			tier_n[t] += n;
+			ptr = buf_load_parse_tier(ptr, end_ptr, n, NULL,
+						  NULL, 0);
+		}
+
+		if (ptr == NULL) {
+			ut_free(buf);
+			buf_load_status(STATUS_ERR, "Error parsing '%s', "
+					"unable to load buffer pool",
+					full_filename);
+			return(false);
+		}
+	}
+
+	/* Give the space to the hottest tiers first */
+	*dump_n = 0;
+
+	for (t = 0; t < BUF_DUMP_N_TIERS; t++) {
+		pos[t] = *dump_n;
+		*dump_n += ut_min(tier_n[t], max_n - *dump_n);
+		tier_end[t] = *dump_n;
+	}
+
+	if (*dump_n == 0) {
+		ut_free(buf);
+		*dump = NULL;
+		return(true);
+	}
+
+	*dump = static_cast<buf_dump_t*>(ut_malloc(*dump_n * sizeof(**dump)));
+
+	if (*dump == NULL) {
+		ut_free(buf);
+		buf_load_status(STATUS_ERR,
+				"Cannot allocate " ULINTPF " bytes: %s",
+				(ulint) (*dump_n * sizeof(**dump)),
+				strerror(errno));
+		return(false);
+	}
+
+	for (ptr = buf + BUF_DUMP_HEADER_LEN, t = 0; ptr < end_ptr;
+	     t = (t + 1) % BUF_DUMP_N_TIERS) {
+
+		ptr = mach_parse_compressed(ptr, end_ptr, &n);
+		ptr = buf_load_parse_tier(ptr, end_ptr, n, *dump,
+					  &pos[t], tier_end[t]);
+	}
+
+	ut_free(buf);
+
+	return(true);
 }
 
 /*****************************************************************//**
-Perform a buffer pool load from the file specified by
-innodb_buffer_pool_filename. If any errors occur then the value of
-innodb_buffer_pool_load_status will be set accordingly, see buf_load_status().
-The dump filename can be specified by (relative to srv_data_home):
-SET GLOBAL innodb_buffer_pool_filename='filename'; */
+Read a buffer pool dump in the text format of "space_no,page_no" lines.
+If the dump is larger than max_n pages, then the extra trailing is
+ignored.
+@return true on success, false if an error was reported in
+innodb_buffer_pool_load_status */
 static
-void
-buf_load()
-/*======*/
+bool
+buf_load_read_text(
+/*===============*/
+	FILE*		f,		/*!< in: file */
+	const char*	full_filename,	/*!< in: name of the file */
+	ulint		max_n,		/*!< in: maximum number of pages */
+	buf_dump_t**	dump,		/*!< out: pages, to be freed with
+					ut_free() */
+	ulint*		dump_n)		/*!< out: number of pages */
 {
-	char		full_filename[OS_FILE_MAX_PATH];
-	char		now[32];
-	FILE*		f;
-	buf_dump_t*	dump;
-	buf_dump_t*	dump_tmp;
-	ulint		dump_n;
-	ulint		total_buffer_pools_pages;
 	ulint		i;
 	ulint		space_id;
 	ulint		page_no;
 	int		fscanf_ret;
 
-	/* Ignore any leftovers from before */
-	buf_load_abort_flag = FALSE;
-
-	ut_snprintf(full_filename, sizeof(full_filename),
-		    "%s%c%s", srv_data_home, SRV_PATH_SEPARATOR,
-		    srv_buf_dump_filename);
-
-	buf_load_status(STATUS_NOTICE,
-			"Loading buffer pool(s) from %s", full_filename);
-
-	f = fopen(full_filename, "r");
-	if (f == NULL) {
-		buf_load_status(STATUS_ERR,
-				"Cannot open '%s' for reading: %s",
-				full_filename, strerror(errno));
-		return;
-	}
-	/* else */
-
 	/* First scan the file to estimate how many entries are in it.
 	This file is tiny (approx 500KB per 1GB buffer pool), reading it
 	two times is fine. */
-	dump_n = 0;
+	*dump_n = 0;
 	while (fscanf(f, ULINTPF "," ULINTPF, &space_id, &page_no) == 2
 	       && !SHUTTING_DOWN()) {
-		dump_n++;
+		(*dump_n)++;
 	}
 
 	if (!SHUTTING_DOWN() && !feof(f)) {
@@ -419,49 +684,32 @@ buf_load()
 		} else {
 			what = "parsing";
 		}
-		fclose(f);
 		buf_load_status(STATUS_ERR, "Error %s '%s', "
 				"unable to load buffer pool (stage 1)",
 				what, full_filename);
-		return;
+		return(false);
 	}
 
 	/* If dump is larger than the buffer pool(s), then we ignore the
 	extra trailing. This could happen if a dump is made, then buffer
 	pool is shrunk and then load it attempted. */
-	total_buffer_pools_pages = buf_pool_get_n_pages()
-		* srv_buf_pool_instances;
-	if (dump_n > total_buffer_pools_pages) {
-		dump_n = total_buffer_pools_pages;
+	if (*dump_n > max_n) {
+		*dump_n = max_n;
 	}
 
-	dump = static_cast<buf_dump_t*>(ut_malloc(dump_n * sizeof(*dump)));
+	*dump = static_cast<buf_dump_t*>(ut_malloc(*dump_n * sizeof(**dump)));
 
-	if (dump == NULL) {
-		fclose(f);
+	if (*dump == NULL) {
 		buf_load_status(STATUS_ERR,
 				"Cannot allocate " ULINTPF " bytes: %s",
-				(ulint) (dump_n * sizeof(*dump)),
+				(ulint) (*dump_n * sizeof(**dump)),
 				strerror(errno));
-		return;
-	}
-
-	dump_tmp = static_cast<buf_dump_t*>(
-		ut_malloc(dump_n * sizeof(*dump_tmp)));
-
-	if (dump_tmp == NULL) {
-		ut_free(dump);
-		fclose(f);
-		buf_load_status(STATUS_ERR,
-				"Cannot allocate " ULINTPF " bytes: %s",
-				(ulint) (dump_n * sizeof(*dump_tmp)),
-				strerror(errno));
-		return;
+		return(false);
 	}
 
 	rewind(f);
 
-	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
+	for (i = 0; i < *dump_n && !SHUTTING_DOWN(); i++) {
 		fscanf_ret = fscanf(f, ULINTPF "," ULINTPF,
 				    &space_id, &page_no);
 
@@ -471,20 +719,16 @@ buf_load()
 			}
 			/* else */
 
-			ut_free(dump);
-			ut_free(dump_tmp);
-			fclose(f);
+			ut_free(*dump);
 			buf_load_status(STATUS_ERR,
 					"Error parsing '%s', unable "
 					"to load buffer pool (stage 2)",
 					full_filename);
-			return;
+			return(false);
 		}
 
 		if (space_id > ULINT32_MASK || page_no > ULINT32_MASK) {
-			ut_free(dump);
-			ut_free(dump_tmp);
-			fclose(f);
+			ut_free(*dump);
 			buf_load_status(STATUS_ERR,
 					"Error parsing '%s': bogus "
 					"space,page " ULINTPF "," ULINTPF
@@ -493,19 +737,92 @@ buf_load()
 					full_filename,
 					space_id, page_no,
 					i);
-			return;
+			return(false);
 		}
 
-		dump[i] = BUF_DUMP_CREATE(space_id, page_no);
+		(*dump)[i] = BUF_DUMP_CREATE(space_id, page_no);
 	}
 
 	/* Set dump_n to the actual number of initialized elements,
 	i could be smaller than dump_n here if the file got truncated after
 	we read it the first time. */
-	dump_n = i;
+	*dump_n = i;
+
+	return(true);
+}
+
+/*****************************************************************//**
+Perform a buffer pool load from the file specified by
+innodb_buffer_pool_filename. If any errors occur then the value of
+innodb_buffer_pool_load_status will be set accordingly, see buf_load_status().
+The dump filename can be specified by (relative to srv_data_home):
+SET GLOBAL innodb_buffer_pool_filename='filename'.
+The pages are loaded one tier after the other, the hottest first, and
+within a tier in the order of space_no,page_no, with runs of consecutive
+pages requested at once. */
+static
+void
+buf_load()
+/*======*/
+{
+	char		full_filename[OS_FILE_MAX_PATH];
+	char		magic[BUF_DUMP_MAGIC_LEN];
+	char		now[32];
+	FILE*		f;
+	buf_dump_t*	dump;
+	buf_dump_t*	dump_tmp;
+	ulint		dump_n;
+	ulint		tier_end[BUF_DUMP_N_TIERS];
+	ulint		total_buffer_pools_pages;
+	ulint		i;
+	ulint		n;
+	ulint		t;
+	bool		success;
+
+	/* Ignore any leftovers from before */
+	buf_load_abort_flag = FALSE;
+
+	ut_snprintf(full_filename, sizeof(full_filename),
+		    "%s%c%s", srv_data_home, SRV_PATH_SEPARATOR,
+		    srv_buf_dump_filename);
+
+	buf_load_status(STATUS_NOTICE,
+			"Loading buffer pool(s) from %s", full_filename);
+
+	f = fopen(full_filename, "rb");
+	if (f == NULL) {
+		buf_load_status(STATUS_ERR,
+				"Cannot open '%s' for reading: %s",
+				full_filename, strerror(errno));
+		return;
+	}
+	/* else */
+
+	total_buffer_pools_pages = buf_pool_get_n_pages()
+		* srv_buf_pool_instances;
+
+	if (fread(magic, 1, sizeof(magic), f) == sizeof(magic)
+	    && !memcmp(magic, BUF_DUMP_MAGIC, sizeof(magic))) {
+		success = buf_load_read_binary(f, full_filename,
+					       total_buffer_pools_pages,
+					       &dump, &dump_n, tier_end);
+	} else {
+		rewind(f);
+		success = buf_load_read_text(f, full_filename,
+					     total_buffer_pools_pages,
+					     &dump, &dump_n);
+		/* the text format has no tiers */
+		for (t = 0; success && t < BUF_DUMP_N_TIERS; t++) {
+			tier_end[t] = dump_n;
+		}
+	}
 
 	fclose(f);
 
+	if (!success) {
+		return;
+	}
+
 	if (dump_n == 0) {
 		ut_free(dump);
 		ut_sprintf_timestamp(now);
@@ -515,25 +832,43 @@ buf_load()
 		return;
 	}
 
-	if (!SHUTTING_DOWN()) {
-		buf_dump_sort(dump, dump_tmp, 0, dump_n);
+	dump_tmp = static_cast<buf_dump_t*>(
+		ut_malloc(dump_n * sizeof(*dump_tmp)));
+
+	if (dump_tmp == NULL) {
+		ut_free(dump);
+		buf_load_status(STATUS_ERR,
+				"Cannot allocate " ULINTPF " bytes: %s",
+				(ulint) (dump_n * sizeof(*dump_tmp)),
+				strerror(errno));
+		return;
+	}
+
+	for (t = 0, i = 0; t < BUF_DUMP_N_TIERS && !SHUTTING_DOWN(); t++) {
+		if (i < tier_end[t]) {
+			buf_dump_sort(dump, dump_tmp, i, tier_end[t]);
+		}
+		i = tier_end[t];
 	}
 
 	ut_free(dump_tmp);
 
-	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
+	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i += n) {
 
-		buf_read_page_async(BUF_DUMP_SPACE(dump[i]),
-				    BUF_DUMP_PAGE(dump[i]));
-
-		if (i % 64 == 63) {
-			os_aio_simulated_wake_handler_threads();
+		/* Request the run of consecutive pages starting at i */
+		for (n = 1;
+		     n < BUF_LOAD_MAX_RUN && i + n < dump_n
+		     && dump[i + n] == dump[i] + n;
+		     n++) {
 		}
 
-		if (i % 128 == 0) {
+		buf_read_pages_async(BUF_DUMP_SPACE(dump[i]),
+				     BUF_DUMP_PAGE(dump[i]), n);
+
+		if (i % 128 + n >= 128 || i == 0) {
 			buf_load_status(STATUS_INFO,
 					"Loaded " ULINTPF "/" ULINTPF " pages",
-					i + 1, dump_n);
+					i + n, dump_n);
 		}
 
 		if (buf_load_abort_flag) {
@@ -428,36 +428,50 @@ buf_read_page(
 }
 
 /********************************************************************//**
-High-level function which reads a page asynchronously from a file to the
-buffer buf_pool if it is not already there. Sets the io_fix flag and sets
-an exclusive lock on the buffer frame. The flag is cleared and the x-lock
-released by the i/o-handler thread.
-@return TRUE if page has been read in, FALSE in case of failure */
+High-level function which reads a run of consecutive pages asynchronously
+from a file to the buffer buf_pool, skipping the pages that are already
+there. The requests are posted back to back, so that the i/o-handler
+threads can merge them into one read, and the handler threads are woken
+up once at the end. Sets the io_fix flag and sets an exclusive lock on
+the buffer frames. The flag is cleared and the x-lock released by the
+i/o-handler thread.
+@return number of page read requests issued */
 UNIV_INTERN
-ibool
-buf_read_page_async(
-/*================*/
+ulint
+buf_read_pages_async(
+/*=================*/
 	ulint	space,	/*!< in: space id */
-	ulint	offset)	/*!< in: page number */
+	ulint	offset,	/*!< in: page number of the first page */
+	ulint	n_pages)/*!< in: number of pages to read */
 {
 	ulint		zip_size;
 	ib_int64_t	tablespace_version;
-	ulint		count;
+	ulint		count = 0;
+	ulint		i;
 	dberr_t		err;
 
 	zip_size = fil_space_get_zip_size(space);
 
 	if (zip_size == ULINT_UNDEFINED) {
-		return(FALSE);
+		return(0);
 	}
 
 	tablespace_version = fil_space_get_version(space);
 
-	count = buf_read_page_low(&err, true, BUF_READ_ANY_PAGE
-				  | OS_AIO_SIMULATED_WAKE_LATER
-				  | BUF_READ_IGNORE_NONEXISTENT_PAGES,
-				  space, zip_size, FALSE,
-				  tablespace_version, offset);
+	for (i = 0; i < n_pages; i++) {
+		count += buf_read_page_low(&err, false, BUF_READ_ANY_PAGE
+					   | OS_AIO_SIMULATED_WAKE_LATER
+					   | BUF_READ_IGNORE_NONEXISTENT_PAGES,
+					   space, zip_size, FALSE,
+					   tablespace_version, offset + i);
+
+		if (err == DB_TABLESPACE_DELETED) {
+			break;
+		}
+	}
+
+	os_aio_simulated_wake_handler_threads();
+
 	srv_stats.buf_pool_reads.add(count);
 
 	/* We do not increment number of I/O operations used for LRU policy
@@ -467,7 +481,7 @@ buf_read_page_async(
 	these IOs are deliberate and are not part of normal workload we can
 	ignore these in our heuristics. */
 
-	return(count > 0);
+	return(count);
 }
 
 /********************************************************************//**
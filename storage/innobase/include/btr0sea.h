@@ -33,6 +33,7 @@ Created 2/17/1996 Heikki Tuuri
 #include "btr0types.h"
 #include "mtr0mtr.h"
 #include "ha0ha.h"
+#include "ut0counter.h"
 
 /*****************************************************************//**
 Creates and initializes the adaptive search system at a database start. */
@@ -80,13 +81,14 @@ btr_search_info_create(
 	mem_heap_t*	heap);	/*!< in: heap where created */
 /*****************************************************************//**
 Returns the value of ref_count. The value is protected by
-btr_search_latch.
+the latch of the AHI partition corresponding to this index.
 @return	ref_count value. */
 UNIV_INTERN
 ulint
 btr_search_info_get_ref_count(
 /*==========================*/
-	btr_search_t*   info);	/*!< in: search info. */
+	btr_search_t*   info,	/*!< in: search info. */
+	dict_index_t*	index); /*!< in: index */
 /*********************************************************************//**
 Updates the search info. */
 UNIV_INLINE
@@ -191,6 +193,125 @@ btr_search_validate(void);
 /*======================*/
 #endif /* defined UNIV_AHI_DEBUG || defined UNIV_DEBUG */
 
+/********************************************************************//**
+Returns the adaptive hash index table for a given index key.
+@return the adaptive hash index table for a given index key */
+UNIV_INLINE
+hash_table_t*
+btr_search_get_hash_table(
+/*======================*/
+	const dict_index_t*	index)	/*!< in: index */
+	__attribute__((pure,warn_unused_result));
+
+/********************************************************************//**
+Returns the adaptive hash index latch for a given index key.
+@return the adaptive hash index latch for a given index key */
+UNIV_INLINE
+rw_lock_t*
+btr_search_get_latch(
+/*=================*/
+	const dict_index_t*	index)	/*!< in: index */
+	__attribute__((pure,warn_unused_result));
+
+/*********************************************************************//**
+Returns the AHI partition number corresponding to a given index ID. */
+UNIV_INLINE
+ulint
+btr_search_get_key(
+/*===============*/
+	index_id_t	index_id)	/*!< in: index ID */
+	__attribute__((pure,warn_unused_result));
+
+/*********************************************************************//**
+Initializes AHI-related fields in a newly created index. */
+UNIV_INLINE
+void
+btr_search_index_init(
+/*===============*/
+	dict_index_t*	index)	/*!< in: index */
+	__attribute__((nonnull));
+
+/********************************************************************//**
+Latches all adaptive hash index latches in exclusive mode.  */
+UNIV_INLINE
+void
+btr_search_x_lock_all(void);
+/*========================*/
+
+/********************************************************************//**
+Unlatches all adaptive hash index latches in exclusive mode.  */
+UNIV_INLINE
+void
+btr_search_x_unlock_all(void);
+/*==========================*/
+
+/********************************************************************//**
+Latches the adaptive hash index partition of an index in shared mode.
+If the latch is not immediately available, a latch wait is counted in
+the partition statistics before blocking on it. */
+UNIV_INLINE
+void
+btr_search_s_lock_func(
+/*===================*/
+	const dict_index_t*	index,	/*!< in: index */
+	const char*		file,	/*!< in: file name where lock
+					requested */
+	ulint			line);	/*!< in: line where requested */
+
+/********************************************************************//**
+Latches the adaptive hash index partition of an index in exclusive mode.
+If the latch is not immediately available, a latch wait is counted in
+the partition statistics before blocking on it. */
+UNIV_INLINE
+void
+btr_search_x_lock_func(
+/*===================*/
+	const dict_index_t*	index,	/*!< in: index */
+	const char*		file,	/*!< in: file name where lock
+					requested */
+	ulint			line);	/*!< in: line where requested */
+
+#define btr_search_s_lock(index)				\
+	btr_search_s_lock_func((index), __FILE__, __LINE__)
+#define btr_search_x_lock(index)				\
+	btr_search_x_lock_func((index), __FILE__, __LINE__)
+
+/********************************************************************//**
+Computes the adaptive hash index partition statistics that are exported
+through INNODB_METRICS. The counters are read without latching, so the
+values are approximate. */
+UNIV_INTERN
+void
+btr_search_get_partition_stats(
+/*===========================*/
+	ulint*	latch_waits,	/*!< out: latch waits in all partitions */
+	ulint*	max_hits,	/*!< out: hits in the busiest partition */
+	ulint*	max_latch_waits);/*!< out: latch waits in the most
+				contended partition */
+
+#ifdef UNIV_SYNC_DEBUG
+/******************************************************************//**
+Checks if the thread has locked all the adaptive hash index latches in the
+specified mode.
+
+@return true if all latches are locked by the current thread, false
+otherwise.  */
+UNIV_INLINE
+bool
+btr_search_own_all(
+/*===============*/
+	ulint lock_type)
+	__attribute__((warn_unused_result));
+/********************************************************************//**
+Checks if the thread owns any adaptive hash latches in either S or X mode.
+@return	true if the thread owns at least one latch in any mode. */
+UNIV_INLINE
+bool
+btr_search_own_any(void)
+/*=====================*/
+	 __attribute__((warn_unused_result));
+#endif
+
 /** The search info struct in an index */
 struct btr_search_t{
 	ulint	ref_count;	/*!< Number of blocks in this index tree
@@ -246,11 +367,26 @@ struct btr_search_t{
 #endif /* UNIV_DEBUG */
 };
 
+/** Usage statistics of one adaptive hash index partition. The counters
+are updated without latching; they are padded to a cache line so that
+threads working on different partitions do not share a line. */
+struct btr_search_part_stats_t{
+	ulint		n_hits;		/*!< number of successful hash
+					lookups in the partition */
+	ulint		n_latch_waits;	/*!< number of times the partition
+					latch was not immediately
+					available */
+	byte		pad[CACHE_LINE_SIZE - 2 * sizeof(ulint)];
+};
+
 /** The hash index system */
 struct btr_search_sys_t{
-	hash_table_t*	hash_index;	/*!< the adaptive hash index,
-					mapping dtuple_fold values
-					to rec_t pointers on index pages */
+	hash_table_t**	hash_tables;	/*!< the array of adaptive hash index
+					tables, mapping dtuple_fold values to
+					rec_t pointers on index pages */
+	btr_search_part_stats_t* part_stats;
+					/*!< the array of per-partition
+					statistics */
 };
 
 /** The adaptive hash index */
@@ -43,17 +43,20 @@ buf_read_page(
 	ulint	zip_size,/*!< in: compressed page size in bytes, or 0 */
 	ulint	offset);/*!< in: page number */
 /********************************************************************//**
-High-level function which reads a page asynchronously from a file to the
-buffer buf_pool if it is not already there. Sets the io_fix flag and sets
-an exclusive lock on the buffer frame. The flag is cleared and the x-lock
+High-level function which reads a run of consecutive pages asynchronously
+from a file to the buffer buf_pool, skipping the pages that are already
+there. The requests are posted back to back, so that the i/o-handler
+threads can merge them into one read. Sets the io_fix flag and sets an
+exclusive lock on the buffer frames. The flag is cleared and the x-lock
 released by the i/o-handler thread.
-@return TRUE if page has been read in, FALSE in case of failure */
+@return number of page read requests issued */
 UNIV_INTERN
-ibool
-buf_read_page_async(
-/*================*/
+ulint
+buf_read_pages_async(
+/*=================*/
 	ulint	space,	/*!< in: space id */
-	ulint	offset);/*!< in: page number */
+	ulint	offset,	/*!< in: page number of the first page */
+	ulint	n_pages);/*!< in: number of pages to read */
 /********************************************************************//**
 Applies a random read-ahead in buf_pool if there are at least a threshold
 value of accessed pages from the random read-ahead area. Does not read any
@@ -868,13 +868,32 @@ struct log_t{
 					/*!< how far we have written the log
 					AND flushed to disk */
 	ulint		n_pending_writes;/*!< number of currently
-					pending flushes or writes */
+					pending writes, 0 or 1; the log
+					mutex is not held during the
+					write i/o, writers of the log
+					buffer append after
+					write_end_offset meanwhile */
+#ifdef UNIV_DEBUG
+	os_thread_id_t	write_thread;	/*!< the thread doing the pending
+					write, if n_pending_writes == 1 */
+#endif /* UNIV_DEBUG */
+	ulint		n_pending_flushes;/*!< number of currently pending
+					flushes, 0 or 1; counted from the
+					start of the write preceding the
+					flush, but a new write can start
+					while the flush is running */
+	os_event_t	flush_event;	/*!< this event is in the reset state
+					when a flush is running; a thread
+					should wait for this without owning
+					the log mutex, but NOTE that to set
+					or reset this event, the thread MUST
+					own the log mutex! */
 	/* NOTE on the 'flush' in names of the fields below: starting from
 	4.0.14, we separate the write of the log file and the actual fsync()
 	or other method to flush it to disk. The names below shhould really
 	be 'flush_or_write'! */
 	os_event_t	no_flush_event;	/*!< this event is in the reset state
-					when a flush or a write is running;
+					when a write is running;
 					a thread should wait for this without
 					owning the log mutex, but NOTE that
 					to set or reset this event, the
@@ -893,7 +912,15 @@ struct log_t{
 					event, the thread MUST own the log
 					mutex! */
 	ulint		n_log_ios;	/*!< number of log i/os initiated thus
-					far */
+					far, except for those counted in
+					n_log_write_ios; protected by the
+					log mutex */
+	ulint		n_log_write_ios;/*!< number of writes of the log
+					buffer to the log files initiated thus
+					far; only changed by the thread that
+					may write the log buffer, see
+					log_group_write_buf(), which does not
+					always own the log mutex */
 	ulint		n_log_ios_old;	/*!< number of log i/o's at the
 					previous printout */
 	time_t		last_printout_time;/*!< when log_print was last time
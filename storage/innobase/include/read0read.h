@@ -47,6 +47,16 @@ read_view_open_now(
 	mem_heap_t*	heap);		/*!< in: memory heap from which
 					allocated */
 /*********************************************************************//**
+Opens a read view for a transaction and sets it as trx->global_read_view.
+For a transaction created for MySQL, the view is made from
+trx_sys->rw_slots without acquiring trx_sys->mutex when possible.
+@return	own: read view struct */
+UNIV_INTERN
+read_view_t*
+read_view_open_for_trx(
+/*===================*/
+	trx_t*		trx);		/*!< in/out: active transaction */
+/*********************************************************************//**
 Makes a copy of the oldest existing read view, or opens a new. The view
 must be closed with ..._close.
 @return	own: read view struct */
@@ -158,6 +168,13 @@ struct read_view_t{
 				0 used in purge */
 	UT_LIST_NODE_T(read_view_t) view_list;
 				/*!< List of read views in trx_sys */
+	ulint		version;/*!< trx_sys_rw_slots_version() when the
+				view was made, or 0; a view with a smaller
+				version does not see more transactions */
+	trx_t*		owner;	/*!< the transaction whose
+				trx_t::read_view_state tracks this view,
+				or NULL if the view is in
+				trx_sys->view_list */
 };
 
 /** Read view types @{ */
@@ -29,4 +29,12 @@ Created 2/16/1997 Heikki Tuuri
 struct read_view_t;
 struct cursor_view_t;
 
+/** Values of trx_t::read_view_state */
+enum read_view_state_t {
+	READ_VIEW_CLOSED = 0,	/*!< no view, or a view in
+				trx_sys->view_list */
+	READ_VIEW_SNAPSHOT,	/*!< the view is being created */
+	READ_VIEW_OPEN		/*!< the view is open */
+};
+
 #endif
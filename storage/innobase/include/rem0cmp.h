@@ -215,10 +215,9 @@ cmp_rec_rec_simple(
 	const ulint*		offsets1,/*!< in: rec_get_offsets(rec1, ...) */
 	const ulint*		offsets2,/*!< in: rec_get_offsets(rec2, ...) */
 	const dict_index_t*	index,	/*!< in: data dictionary index */
-	struct TABLE*		table)	/*!< in: MySQL table, for reporting
-					duplicate key value if applicable,
-					or NULL */
-	__attribute__((nonnull(1,2,3,4), warn_unused_result));
+	bool			check_dup)/*!< in: whether to return 0
+					for duplicates in a unique index */
+	__attribute__((nonnull, warn_unused_result));
 /*************************************************************//**
 This function is used to compare two physical records. Only the common
 first fields are compared, and if an externally stored field is
@@ -120,6 +120,15 @@ struct index_def_t {
 	index_field_t*	fields;		/*!< field definitions */
 };
 
+/** Duplicate key reporting shared by the threads that build indexes
+in parallel. Only the first duplicate is copied to the MySQL table. */
+struct row_merge_dup_sync_t {
+	ib_mutex_t		mutex;	/*!< protects index and the
+					record of the MySQL table */
+	const dict_index_t*	index;	/*!< index whose duplicate was
+					reported, or NULL */
+};
+
 /** Structure for reporting duplicate records. */
 struct row_merge_dup_t {
 	dict_index_t*		index;	/*!< index being sorted */
@@ -129,6 +138,8 @@ struct row_merge_dup_t {
 					(index->table), or NULL if not
 					rebuilding table */
 	ulint			n_dup;	/*!< number of duplicates */
+	row_merge_dup_sync_t*	sync;	/*!< shared with other threads
+					building indexes, or NULL */
 };
 
 /*************************************************************//**
@@ -118,7 +118,10 @@ struct purge_node_t{
 	btr_pcur_t	pcur;	/*!< persistent cursor used in searching the
 				clustered index record */
 	ibool		done;	/* Debug flag */
-
+	ulint		n_batch_recs;/*!< number of undo log records given
+				to this node in the current purge batch */
+	ulint		n_undo_recs;/*!< total number of undo log records
+				given to this node */
 };
 
 #ifndef UNIV_NONINL
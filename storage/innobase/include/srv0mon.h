@@ -285,6 +285,8 @@ enum monitor_id_t {
 	MONITOR_N_UPD_EXIST_EXTERN,
 	MONITOR_PURGE_INVOKED,
 	MONITOR_PURGE_N_PAGE_HANDLED,
+	MONITOR_PURGE_N_UNDO_RECS,
+	MONITOR_PURGE_WORKER_RECS_MAX,
 	MONITOR_DML_PURGE_DELAY,
 	MONITOR_PURGE_STOP_COUNT,
 	MONITOR_PURGE_RESUME_COUNT,
@@ -346,6 +348,9 @@ enum monitor_id_t {
 	MONITOR_ADAPTIVE_HASH_ROW_REMOVED,
 	MONITOR_ADAPTIVE_HASH_ROW_REMOVE_NOT_FOUND,
 	MONITOR_ADAPTIVE_HASH_ROW_UPDATED,
+	MONITOR_OVLD_ADAPTIVE_HASH_LATCH_WAITS,
+	MONITOR_OVLD_ADAPTIVE_HASH_PART_HITS_MAX,
+	MONITOR_OVLD_ADAPTIVE_HASH_PART_WAITS_MAX,
 
 	/* Tablespace related counters */
 	MONITOR_MODULE_FIL_SYSTEM,
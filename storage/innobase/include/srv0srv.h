@@ -259,6 +259,8 @@ extern ibool	srv_locks_unsafe_for_binlog;
 
 /** Sort buffer size in index creation */
 extern ulong	srv_sort_buf_size;
+/** Number of threads that scan, sort and insert in index creation */
+extern ulong	srv_index_build_threads;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
 
@@ -523,6 +525,9 @@ extern const char* srv_io_thread_function[];
 /* the number of purge threads to use from the worker pool (currently 0 or 1) */
 extern ulong srv_n_purge_threads;
 
+/* Maximum value of innodb_purge_threads */
+#define SRV_MAX_N_PURGE_THREADS	32
+
 /* the number of pages to purge in one batch */
 extern ulong srv_purge_batch_size;
 
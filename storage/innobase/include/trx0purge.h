@@ -119,6 +119,13 @@ UNIV_INTERN
 purge_state_t
 trx_purge_state(void);
 /*=================*/
+/*******************************************************************//**
+Prints the number of undo log records given to each purge thread. */
+UNIV_INTERN
+void
+trx_purge_print_threads(
+/*====================*/
+	FILE*	file);	/*!< in: output stream */
 
 /** This is the purge pointer/iterator. We need both the undo no and the
 transaction no up to which purge has parsed and applied the records. */
@@ -151,6 +151,18 @@ trx_undo_update_rec_get_sys_cols(
 	trx_id_t*	trx_id,		/*!< out: trx id */
 	roll_ptr_t*	roll_ptr,	/*!< out: roll ptr */
 	ulint*		info_bits);	/*!< out: info bits state */
+/**********************************************************************//**
+Computes a fold value of the table id and the first field of the row
+reference of an undo log record. The table definition is not needed:
+all the undo log records of a row have the same fold value, so that they
+can be given to the same purge thread to be purged in order.
+@return	fold value */
+UNIV_INTERN
+ulint
+trx_undo_rec_get_row_fold(
+/*======================*/
+	trx_undo_rec_t*	undo_rec)	/*!< in: undo log record */
+	__attribute__((nonnull, warn_unused_result));
 /*******************************************************************//**
 Builds an update vector based on a remaining part of an undo log record.
 @return remaining part of the record, NULL if an error detected, which
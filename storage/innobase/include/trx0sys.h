@@ -46,6 +46,13 @@ Created 3/26/1996 Heikki Tuuri
 #include "trx0xa.h"
 #endif /* WITH_WSREP */
 
+#if defined HAVE_ATOMIC_BUILTINS_64 && UNIV_WORD_SIZE >= 8
+/** The ids of the active read-write transactions are registered in
+trx_sys->rw_slots, and read views of transactions created for MySQL are
+opened without trx_sys->mutex */
+# define TRX_SYS_RW_SLOTS
+#endif
+
 typedef UT_LIST_BASE_NODE_T(trx_t) trx_list_t;
 
 /** In a MySQL replication slave, in crash recovery we store the master log
@@ -186,6 +193,60 @@ UNIV_INLINE
 trx_id_t
 trx_sys_get_max_trx_id(void);
 /*========================*/
+#ifdef TRX_SYS_RW_SLOTS
+/*****************************************************************//**
+Registers a read-write transaction in trx_sys->rw_slots. This must be
+called before trx_sys->max_trx_id is incremented past the id. */
+UNIV_INTERN
+void
+trx_sys_rw_slot_register(
+/*=====================*/
+	trx_t*		trx,	/*!< in/out: transaction */
+	trx_id_t	id);	/*!< in: the id that trx is getting */
+/*****************************************************************//**
+Publishes the serialisation number of a registered transaction. This must
+be called before trx_sys->max_trx_id is incremented past the number. */
+UNIV_INTERN
+void
+trx_sys_rw_slot_set_no(
+/*===================*/
+	const trx_t*	trx,	/*!< in: transaction */
+	trx_id_t	no);	/*!< in: the number that trx is getting */
+/*****************************************************************//**
+Starts the commit in memory of a transaction. The change of trx->state
+to TRX_STATE_COMMITTED_IN_MEMORY must be between this and
+trx_sys_rw_slot_clear(). */
+UNIV_INTERN
+void
+trx_sys_rw_slot_clear_start(
+/*========================*/
+	const trx_t*	trx);	/*!< in: transaction */
+/*****************************************************************//**
+Removes the id of a transaction from trx_sys->rw_slots when it is
+committed in memory. The slot stays reserved until
+trx_sys_rw_slot_free(). */
+UNIV_INTERN
+void
+trx_sys_rw_slot_clear(
+/*==================*/
+	const trx_t*	trx);	/*!< in: transaction */
+/*****************************************************************//**
+Waits until no slot of trx_sys->rw_slots is being cleared.
+@return number of clears so far; a read view that is made before this
+changes sees the same transactions as other views made in between */
+UNIV_INTERN
+ulint
+trx_sys_rw_slots_version(void);
+/*===========================*/
+/*****************************************************************//**
+Releases the slot of a transaction that is removed from
+trx_sys->rw_trx_list. */
+UNIV_INTERN
+void
+trx_sys_rw_slot_free(
+/*=================*/
+	trx_t*		trx);	/*!< in/out: transaction */
+#endif /* TRX_SYS_RW_SLOTS */
 
 #ifdef UNIV_DEBUG
 /* Flag to control TRX_RSEG_N_SLOTS behavior debugging. */
@@ -632,6 +693,21 @@ identifier is added to this 64-bit constant. */
 /* @} */
 
 #ifndef UNIV_HOTBACKUP
+#ifdef TRX_SYS_RW_SLOTS
+/** Slot of a read-write transaction in trx_sys->rw_slots */
+struct trx_rw_slot_t{
+	volatile trx_id_t	id;	/*!< trx_t::id, or 0 if the slot is
+					free or the transaction is committed
+					in memory */
+	volatile trx_id_t	no;	/*!< trx_t::no */
+	ulint			next_free;
+					/*!< next slot in
+					trx_sys->rw_slots_free, or
+					ULINT_UNDEFINED; protected by
+					trx_sys->mutex */
+};
+#endif /* TRX_SYS_RW_SLOTS */
+
 /** The transaction system central memory data structure. */
 struct trx_sys_t{
 
@@ -692,6 +768,32 @@ struct trx_sys_t{
 	UT_LIST_BASE_NODE_T(read_view_t) view_list;
 					/*!< List of read views sorted
 					on trx no, biggest first */
+#ifdef TRX_SYS_RW_SLOTS
+	/** Registry of the active read-write transactions, which
+	read_view_open_for_trx() reads without trx_sys->mutex. Slots are
+	reserved and released under trx_sys->mutex, and a slot is filled
+	before trx_sys->max_trx_id moves past the id in it. */
+	/* @{ */
+	trx_rw_slot_t*	rw_slots;	/*!< array of rw_slots_max slots */
+	ulint		rw_slots_max;	/*!< size of rw_slots */
+	volatile ulint	rw_slots_hwm;	/*!< slots at and above this have
+					never been used */
+	ulint		rw_slots_free;	/*!< first free slot below
+					rw_slots_hwm, or ULINT_UNDEFINED */
+	volatile ulint	rw_slots_overflow;
+					/*!< number of transactions in
+					rw_trx_list that did not get a slot;
+					while nonzero, read views are opened
+					under trx_sys->mutex */
+	volatile ulint	rw_slots_clearing;
+					/*!< number of commits in memory of
+					read-write transactions started, see
+					trx_sys_rw_slot_clear_start() */
+	volatile ulint	rw_slots_cleared;
+					/*!< number of commits in memory of
+					read-write transactions completed */
+	/* @} */
+#endif /* TRX_SYS_RW_SLOTS */
 };
 
 /** When a trx id which is zero modulo this number (which must be a power of
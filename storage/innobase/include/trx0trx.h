@@ -44,7 +44,8 @@ Created 3/26/1996 Heikki Tuuri
 extern sess_t*	trx_dummy_sess;
 
 /********************************************************************//**
-Releases the search latch if trx has reserved it. */
+A transaction can only hold an adaptive hash index latch inside
+row_search_for_mysql(), so there is nothing to release on demand. */
 UNIV_INLINE
 void
 trx_search_latch_release_if_reserved(
@@ -797,18 +798,15 @@ struct trx_t{
 					trx_commit_complete_for_mysql() */
 	ulint		duplicates;	/*!< TRX_DUP_IGNORE | TRX_DUP_REPLACE */
 	ulint		has_search_latch;
-					/*!< TRUE if this trx has latched the
-					search system latch in S-mode */
+					/*!< TRUE if this trx has latched an
+					adaptive hash index partition latch
+					in S-mode; only inside
+					row_search_for_mysql() */
 	ulint		search_latch_timeout;
-					/*!< If we notice that someone is
-					waiting for our S-lock on the search
-					latch to be released, we wait in
-					row0sel.cc for BTR_SEA_TIMEOUT new
-					searches until we try to keep
-					the search latch again over
-					calls from MySQL; this is intended
-					to reduce contention on the search
-					latch */
+					/*!< Only reported in
+					INNODB_TRX.TRX_ADAPTIVE_HASH_TIMEOUT;
+					the search latch is not kept over
+					calls from MySQL any more */
 	trx_dict_op_t	dict_operation;	/**< @see enum trx_dict_op */
 
 	/* Fields protected by the srv_conc_mutex. */
@@ -883,11 +881,12 @@ struct trx_t{
 	UT_LIST_NODE_T(trx_t)
 			mysql_trx_list;	/*!< list of transactions created for
 					MySQL; protected by trx_sys->mutex */
-#ifdef UNIV_DEBUG
 	ibool		in_mysql_trx_list;
 					/*!< TRUE if in
 					trx_sys->mysql_trx_list */
-#endif /* UNIV_DEBUG */
+	ulint		rw_slot;	/*!< slot of the transaction in
+					trx_sys->rw_slots, or ULINT_UNDEFINED;
+					protected by trx_sys->mutex */
 	/*------------------------------*/
 	dberr_t		error_state;	/*!< 0 if no error, otherwise error
 					number; NOTE That ONLY the thread
@@ -913,6 +912,16 @@ struct trx_t{
 	read_view_t*	global_read_view;
 					/*!< consistent read view associated
 					to a transaction or NULL */
+	volatile ulint	read_view_state;
+					/*!< READ_VIEW_SNAPSHOT while
+					read_view_open_for_trx() reads the
+					active transactions, READ_VIEW_OPEN
+					while global_read_view is a view that
+					purge finds through
+					trx_sys->mysql_trx_list instead of
+					trx_sys->view_list, else
+					READ_VIEW_CLOSED; changed to
+					READ_VIEW_CLOSED under trx->mutex */
 	read_view_t*	read_view;	/*!< consistent read view used in the
 					transaction or NULL, this read view
 					if defined can be normal read view
@@ -1098,23 +1107,9 @@ struct commit_node_t{
 	mutex_exit(&t->mutex);			\
 } while (0)
 
-/** @brief The latch protecting the adaptive search system
-
-This latch protects the
-(1) hash index;
-(2) columns of a record to which we have a pointer in the hash index;
-
-but does NOT protect:
-
-(3) next record offset field in a record;
-(4) next or previous records on the same page.
-
-Bear in mind (3) and (4) when using the hash index.
-*/
-extern rw_lock_t*	btr_search_latch_temp;
-
-/** The latch protecting the adaptive search system */
-#define btr_search_latch	(*btr_search_latch_temp)
+/** @brief The latches protecting the adaptive search partitions,
+see btr0types.h */
+extern rw_lock_t*	btr_search_latch_arr;
 
 #ifndef UNIV_NONINL
 #include "trx0trx.ic"
@@ -5811,6 +5811,8 @@ lock_print_info_summary(
 		"History list length %lu\n",
 		(ulong) trx_sys->rseg_history_len);
 
+	trx_purge_print_threads(file);
+
 #ifdef PRINT_NUM_OF_LOCK_STRUCTS
 	fprintf(file,
 		"Total number of lock structs in row lock hash table %lu\n",
@@ -7461,10 +7463,19 @@ lock_trx_release_locks(
 	flush fails, and T never gets committed, also T2 will never get
 	committed. */
 
+#ifdef TRX_SYS_RW_SLOTS
+	trx_sys_rw_slot_clear_start(trx);
+#endif /* TRX_SYS_RW_SLOTS */
+
 	/*--------------------------------------*/
 	trx->state = TRX_STATE_COMMITTED_IN_MEMORY;
 	/*--------------------------------------*/
 
+#ifdef TRX_SYS_RW_SLOTS
+	/* Read views opened from now on see the changes of trx. */
+	trx_sys_rw_slot_clear(trx);
+#endif /* TRX_SYS_RW_SLOTS */
+
 	/* If the background thread trx_rollback_or_clean_recovered()
 	is still active then there is a chance that the rollback
 	thread may see this trx as COMMITTED_IN_MEMORY and goes ahead
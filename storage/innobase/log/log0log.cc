@@ -873,6 +873,7 @@ log_init(void)
 	UT_LIST_INIT(log_sys->log_groups);
 
 	log_sys->n_log_ios = 0;
+	log_sys->n_log_write_ios = 0;
 
 	log_sys->n_log_ios_old = log_sys->n_log_ios;
 	log_sys->last_printout_time = time(NULL);
@@ -888,6 +889,11 @@ log_init(void)
 	log_sys->written_to_all_lsn = log_sys->lsn;
 
 	log_sys->n_pending_writes = 0;
+	log_sys->n_pending_flushes = 0;
+
+	log_sys->flush_event = os_event_create();
+
+	os_event_set(log_sys->flush_event);
 
 	log_sys->no_flush_event = os_event_create();
 
@@ -1226,6 +1232,39 @@ log_io_complete(
 	mutex_exit(&(log_sys->mutex));
 }
 
+#ifdef UNIV_DEBUG
+/******************************************************//**
+Checks if the current thread may write the log buffer to the log files:
+log_write_up_to() does the write without the log mutex, other callers of
+log_group_write_buf() own the log mutex and no write is pending then.
+@return true if the thread may write */
+static
+bool
+log_write_own(void)
+/*===============*/
+{
+	if (log_sys->n_pending_writes == 0) {
+		return(mutex_own(&log_sys->mutex));
+	}
+
+	return(log_sys->n_pending_writes == 1
+	       && os_thread_eq(log_sys->write_thread,
+			       os_thread_get_curr_id())
+	       && !mutex_own(&log_sys->mutex));
+}
+#endif /* UNIV_DEBUG */
+
+/******************************************************//**
+Gets the number of log i/os initiated thus far.
+@return number of log i/os */
+static
+ulint
+log_n_ios(void)
+/*===========*/
+{
+	return(log_sys->n_log_ios + log_sys->n_log_write_ios);
+}
+
 /******************************************************//**
 Writes a log file header to a log file space. */
 static
@@ -1241,7 +1280,7 @@ log_group_file_header_flush(
 	byte*	buf;
 	lsn_t	dest_offset;
 
-	ut_ad(mutex_own(&(log_sys->mutex)));
+	ut_ad(log_write_own());
 	ut_ad(!recv_no_log_write);
 	ut_a(nth_file < group->n_files);
 
@@ -1263,7 +1302,7 @@ log_group_file_header_flush(
 	}
 #endif /* UNIV_DEBUG */
 	if (log_do_write) {
-		log_sys->n_log_ios++;
+		log_sys->n_log_write_ios++;
 
 		MONITOR_INC(MONITOR_LOG_IO);
 
@@ -1315,7 +1354,7 @@ log_group_write_buf(
 	lsn_t		next_offset;
 	ulint		i;
 
-	ut_ad(mutex_own(&(log_sys->mutex)));
+	ut_ad(log_write_own());
 	ut_ad(!recv_no_log_write);
 	ut_a(len % OS_FILE_LOG_BLOCK_SIZE == 0);
 	ut_a(start_lsn % OS_FILE_LOG_BLOCK_SIZE == 0);
@@ -1390,7 +1429,7 @@ log_group_write_buf(
 	}
 
 	if (log_do_write) {
-		log_sys->n_log_ios++;
+		log_sys->n_log_write_ios++;
 
 		MONITOR_INC(MONITOR_LOG_IO);
 
@@ -1424,7 +1463,11 @@ log_group_write_buf(
 This function is called, e.g., when a transaction wants to commit. It checks
 that the log has been written to the log file up to the last log entry written
 by the transaction. If there is a flush running, it waits and checks if the
-flush flushed enough. If not, starts a new flush. */
+flush flushed enough. If not, starts a new flush.
+
+The log mutex is not held during the write i/o and the flush: other threads
+keep on catenating log records to the log buffer meanwhile. A write can start
+while the previous flush is running, the next flush waits for it. */
 UNIV_INTERN
 void
 log_write_up_to(
@@ -1447,6 +1490,9 @@ log_write_up_to(
 	ulint		loop_count	= 0;
 #endif /* UNIV_DEBUG */
 	ulint		unlock;
+	ibool		do_flush;
+	byte*		write_buf;
+	lsn_t		start_lsn;
 	ib_uint64_t	write_lsn;
 	ib_uint64_t	flush_lsn;
 
@@ -1463,7 +1509,7 @@ log_write_up_to(
 #ifdef UNIV_DEBUG
 	loop_count++;
 
-	ut_ad(loop_count < 5);
+	ut_ad(loop_count < 10);
 
 # if 0
 	if (loop_count > 2) {
@@ -1493,17 +1539,46 @@ log_write_up_to(
 		return;
 	}
 
-	if (log_sys->n_pending_writes > 0) {
-		/* A write (+ possibly flush to disk) is running */
+	do_flush = flush_to_disk;
+
+	if (flush_to_disk && log_sys->n_pending_flushes > 0) {
+		/* A flush is running */
 
-		if (flush_to_disk
-		    && log_sys->current_flush_lsn >= lsn) {
-			/* The write + flush will write enough: wait for it to
+		if (log_sys->current_flush_lsn >= lsn) {
+			/* The flush will flush enough: wait for it to
 			complete */
 
-			goto do_waits;
+			mutex_exit(&(log_sys->mutex));
+
+			if (wait != LOG_NO_WAIT) {
+				os_event_wait(log_sys->flush_event);
+			}
+
+			return;
 		}
 
+		if (log_sys->n_pending_writes > 0
+		    || log_sys->written_to_all_lsn >= lsn) {
+
+			mutex_exit(&(log_sys->mutex));
+
+			/* Wait for the flush to complete and try to start
+			a new flush */
+
+			os_event_wait(log_sys->flush_event);
+
+			goto loop;
+		}
+
+		/* Write the log while the running flush completes, and
+		flush it after that */
+
+		do_flush = FALSE;
+	}
+
+	if (log_sys->n_pending_writes > 0) {
+		/* A write is running */
+
 		if (!flush_to_disk
 		    && log_sys->write_lsn >= lsn) {
 			/* The write will write enough: wait for it to
@@ -1522,7 +1597,7 @@ log_write_up_to(
 		goto loop;
 	}
 
-	if (!flush_to_disk
+	if (!do_flush
 	    && log_sys->buf_free == log_sys->buf_next_to_write) {
 		/* Nothing to write and no flush to disk requested */
 
@@ -1540,6 +1615,7 @@ log_write_up_to(
 	}
 #endif /* UNIV_DEBUG */
 	log_sys->n_pending_writes++;
+	ut_d(log_sys->write_thread = os_thread_get_curr_id());
 	MONITOR_INC(MONITOR_PENDING_LOG_WRITE);
 
 	group = UT_LIST_GET_FIRST(log_sys->log_groups);
@@ -1559,8 +1635,11 @@ log_write_up_to(
 
 	log_sys->write_lsn = log_sys->lsn;
 
-	if (flush_to_disk) {
+	if (do_flush) {
+		ut_ad(log_sys->n_pending_flushes == 0);
+		log_sys->n_pending_flushes++;
 		log_sys->current_flush_lsn = log_sys->lsn;
+		os_event_reset(log_sys->flush_event);
 	}
 
 	log_sys->one_flushed = FALSE;
@@ -1581,46 +1660,51 @@ log_write_up_to(
 	log_sys->buf_free += OS_FILE_LOG_BLOCK_SIZE;
 	log_sys->write_end_offset = log_sys->buf_free;
 
+	write_buf = log_sys->buf + area_start;
+	write_lsn = log_sys->write_lsn;
+	start_lsn = ut_uint64_align_down(log_sys->written_to_all_lsn,
+					 OS_FILE_LOG_BLOCK_SIZE);
+
+	/* Nobody else touches the segment to write, nor moves the log
+	buffer before n_pending_writes drops to zero: do the write without
+	the log mutex, so that mini-transactions can commit meanwhile */
+
+	mutex_exit(&(log_sys->mutex));
+
 	group = UT_LIST_GET_FIRST(log_sys->log_groups);
 
 	/* Do the write to the log files */
 
 	while (group) {
 		log_group_write_buf(
-			group, log_sys->buf + area_start,
-			area_end - area_start,
-			ut_uint64_align_down(log_sys->written_to_all_lsn,
-					     OS_FILE_LOG_BLOCK_SIZE),
+			group, write_buf, area_end - area_start, start_lsn,
 			start_offset - area_start);
 
-		log_group_set_fields(group, log_sys->write_lsn);
-
 		group = UT_LIST_GET_NEXT(log_groups, group);
 	}
 
-	mutex_exit(&(log_sys->mutex));
-
-	if (srv_unix_file_flush_method == SRV_UNIX_O_DSYNC) {
-		/* O_DSYNC means the OS did not buffer the log file at all:
-		so we have also flushed to disk what we have written */
-
-		log_sys->flushed_to_disk_lsn = log_sys->write_lsn;
+	mutex_enter(&(log_sys->mutex));
 
-	} else if (flush_to_disk) {
+	group = UT_LIST_GET_FIRST(log_sys->log_groups);
 
-		group = UT_LIST_GET_FIRST(log_sys->log_groups);
+	while (group) {
+		log_group_set_fields(group, write_lsn);
 
-		fil_flush(group->space_id);
-		log_sys->flushed_to_disk_lsn = log_sys->write_lsn;
+		group = UT_LIST_GET_NEXT(log_groups, group);
 	}
 
-	mutex_enter(&(log_sys->mutex));
-
 	group = UT_LIST_GET_FIRST(log_sys->log_groups);
 
 	ut_a(group->n_pending_writes == 1);
 	ut_a(log_sys->n_pending_writes == 1);
 
+	if (srv_unix_file_flush_method == SRV_UNIX_O_DSYNC) {
+		/* O_DSYNC means the OS did not buffer the log file at all:
+		so we have also flushed to disk what we have written */
+
+		log_sys->flushed_to_disk_lsn = write_lsn;
+	}
+
 	group->n_pending_writes--;
 	log_sys->n_pending_writes--;
 	MONITOR_DEC(MONITOR_PENDING_LOG_WRITE);
@@ -1630,6 +1714,24 @@ log_write_up_to(
 
 	log_flush_do_unlocks(unlock);
 
+	if (do_flush) {
+		if (srv_unix_file_flush_method != SRV_UNIX_O_DSYNC) {
+			/* Let the next write start during the flush */
+
+			mutex_exit(&(log_sys->mutex));
+
+			fil_flush(group->space_id);
+
+			mutex_enter(&(log_sys->mutex));
+
+			log_sys->flushed_to_disk_lsn = write_lsn;
+		}
+
+		ut_a(log_sys->n_pending_flushes == 1);
+		log_sys->n_pending_flushes--;
+		os_event_set(log_sys->flush_event);
+	}
+
 	write_lsn = log_sys->write_lsn;
 	flush_lsn = log_sys->flushed_to_disk_lsn;
 
@@ -1637,6 +1739,12 @@ log_write_up_to(
 
 	innobase_mysql_log_notify(write_lsn, flush_lsn);
 
+	if (do_flush != flush_to_disk) {
+		/* Written only, wait for the running flush and flush */
+
+		goto loop;
+	}
+
 	return;
 
 do_waits:
@@ -3327,7 +3435,8 @@ logs_empty_and_mark_files_at_shutdown(void)
 #ifdef UNIV_LOG_ARCHIVE
 		|| log_sys->n_pending_archive_ios
 #endif /* UNIV_LOG_ARCHIVE */
-		|| log_sys->n_pending_writes;
+		|| log_sys->n_pending_writes
+		|| log_sys->n_pending_flushes;
 	mutex_exit(&log_sys->mutex);
 
 	if (server_busy) {
@@ -3617,11 +3726,11 @@ log_print(
 		"%lu log i/o's done, %.2f log i/o's/second\n",
 		(ulong) log_sys->n_pending_writes,
 		(ulong) log_sys->n_pending_checkpoint_writes,
-		(ulong) log_sys->n_log_ios,
-		((double)(log_sys->n_log_ios - log_sys->n_log_ios_old)
+		(ulong) log_n_ios(),
+		((double)(log_n_ios() - log_sys->n_log_ios_old)
 		 / time_elapsed));
 
-	log_sys->n_log_ios_old = log_sys->n_log_ios;
+	log_sys->n_log_ios_old = log_n_ios();
 	log_sys->last_printout_time = current_time;
 
 	mutex_exit(&(log_sys->mutex));
@@ -3634,7 +3743,7 @@ void
 log_refresh_stats(void)
 /*===================*/
 {
-	log_sys->n_log_ios_old = log_sys->n_log_ios;
+	log_sys->n_log_ios_old = log_n_ios();
 	log_sys->last_printout_time = time(NULL);
 }
 
@@ -3705,6 +3814,7 @@ log_shutdown(void)
 	log_sys->checkpoint_buf_ptr = NULL;
 	log_sys->checkpoint_buf = NULL;
 
+	os_event_free(log_sys->flush_event);
 	os_event_free(log_sys->no_flush_event);
 	os_event_free(log_sys->one_flushed_event);
 
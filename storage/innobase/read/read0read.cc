@@ -32,6 +32,10 @@ Created 2/16/1997 Heikki Tuuri
 #include "srv0srv.h"
 #include "trx0sys.h"
 
+#ifdef TRX_SYS_RW_SLOTS
+#include <algorithm>
+#endif /* TRX_SYS_RW_SLOTS */
+
 /*
 -------------------------------------------------------------------------------
 FACT A: Cursor read view on a secondary index sees only committed versions
@@ -192,6 +196,8 @@ read_view_create_low(
 
 	view->n_trx_ids = n;
 	view->trx_ids = (trx_id_t*) &view[1];
+	view->version = 0;
+	view->owner = NULL;
 
 	return(view);
 }
@@ -293,7 +299,7 @@ struct	CreateView {
 		from ACTIVE to PREPARED or COMMITTED. */
 
 		if (trx->id != m_view->creator_trx_id
-		    && !trx_state_eq(trx, TRX_STATE_COMMITTED_IN_MEMORY)) {
+		    && !is_committed(trx)) {
 
 			ut_ad(m_n_trx > m_view->n_trx_ids);
 
@@ -316,10 +322,70 @@ struct	CreateView {
 		}
 	}
 
+	/** @return whether the changes of trx are visible in new views */
+	static bool is_committed(const trx_t* trx)
+	{
+#ifdef TRX_SYS_RW_SLOTS
+		/* The views made by read_view_open_lock_free() see the
+		changes of trx from the time its slot is cleared, after
+		trx->state has been changed. */
+		if (trx->rw_slot != ULINT_UNDEFINED) {
+			return(trx_sys->rw_slots[trx->rw_slot].id == 0);
+		}
+#endif /* TRX_SYS_RW_SLOTS */
+
+		return(trx_state_eq(trx, TRX_STATE_COMMITTED_IN_MEMORY));
+	}
+
 	read_view_t*	m_view;
 	ulint		m_n_trx;
 };
 
+/*********************************************************************//**
+Sets the limits of a view and fills its trx_ids array with the ids of the
+active read-write transactions other than the creator of the view. */
+static
+void
+read_view_set_active(
+/*=================*/
+	read_view_t*	view)	/*!< in/out: view with a trx_ids array
+				for all of trx_sys->rw_trx_list */
+{
+	ulint	n_trx = view->n_trx_ids;
+
+	ut_ad(mutex_own(&trx_sys->mutex));
+
+#ifdef TRX_SYS_RW_SLOTS
+	/* Of the transactions in trx_sys->rw_trx_list, only commits in
+	memory can change while trx_sys->mutex is held. If one happened,
+	make the view again, so that it sees the same transactions as the
+	other views with the same version. */
+	do {
+		view->version = trx_sys_rw_slots_version();
+		view->n_trx_ids = n_trx;
+#endif /* TRX_SYS_RW_SLOTS */
+
+		/* No future transactions should be visible in the view */
+
+		view->low_limit_no = trx_sys->max_trx_id;
+		view->low_limit_id = view->low_limit_no;
+
+		ut_list_map(trx_sys->rw_trx_list, &trx_t::trx_list,
+			    CreateView(view));
+
+#ifdef TRX_SYS_RW_SLOTS
+		os_rmb;
+	} while (view->version != trx_sys->rw_slots_clearing);
+#endif /* TRX_SYS_RW_SLOTS */
+
+	if (view->n_trx_ids > 0) {
+		/* The last active transaction has the smallest id: */
+		view->up_limit_id = view->trx_ids[view->n_trx_ids - 1];
+	} else {
+		view->up_limit_id = view->low_limit_id;
+	}
+}
+
 /*********************************************************************//**
 Opens a read view where exactly the transactions serialized before this
 point in time are seen in the view.
@@ -344,21 +410,9 @@ read_view_open_now_low(
 	view->type = VIEW_NORMAL;
 	view->creator_trx_id = cr_trx_id;
 
-	/* No future transactions should be visible in the view */
-
-	view->low_limit_no = trx_sys->max_trx_id;
-	view->low_limit_id = view->low_limit_no;
-
 	/* No active transaction should be visible, except cr_trx */
 
-	ut_list_map(trx_sys->rw_trx_list, &trx_t::trx_list, CreateView(view));
-
-	if (view->n_trx_ids > 0) {
-		/* The last active transaction has the smallest id: */
-		view->up_limit_id = view->trx_ids[view->n_trx_ids - 1];
-	} else {
-		view->up_limit_id = view->low_limit_id;
-	}
+	read_view_set_active(view);
 
 	/* Purge views are not added to the view list. */
 	if (cr_trx_id > 0) {
@@ -392,6 +446,265 @@ read_view_open_now(
 	return(view);
 }
 
+#ifdef TRX_SYS_RW_SLOTS
+/** Functor to sort the view trx_ids array in descending order. */
+struct	TrxIdGreater {
+
+	bool	operator()(trx_id_t a, trx_id_t b) const
+	{
+		return(a > b);
+	}
+};
+
+/*********************************************************************//**
+Opens a read view from trx_sys->rw_slots without acquiring trx_sys->mutex.
+
+The slots are read while no transaction is committed in memory, that is,
+trx_sys_rw_slots_version() does not change. Then the ids that were found
+are those of the read-write transactions that were active when
+trx_sys->max_trx_id was read: a transaction fills its slot before
+trx_sys->max_trx_id is incremented past its id or number.
+
+While the slots are read, trx->read_view_state is READ_VIEW_SNAPSHOT, and
+read_view_purge_open() waits for the view to be opened. The view is not
+added to trx_sys->view_list; it is closed by read_view_remove(), which
+sets trx->read_view_state to READ_VIEW_CLOSED.
+@return	own: read view struct, or NULL if the view must be made under
+trx_sys->mutex */
+static
+read_view_t*
+read_view_open_lock_free(
+/*=====================*/
+	trx_t*		trx)		/*!< in/out: active transaction */
+{
+	read_view_t*	view = NULL;
+	ulint		n_slots = 0;
+	ulint		version;
+	trx_id_t	low_limit_id;
+	trx_id_t	low_limit_no;
+	ulint		n_trx_ids;
+	ulint		n_tries = 0;
+
+	ut_ad(trx->global_read_view == NULL);
+
+	/* This is a full memory barrier: if read_view_purge_open() found
+	the state READ_VIEW_CLOSED, trx_sys->max_trx_id is read after the
+	purge view was made. */
+	ut_a(os_compare_and_swap_ulint(
+		     &trx->read_view_state,
+		     READ_VIEW_CLOSED, READ_VIEW_SNAPSHOT));
+
+	for (;;) {
+		ulint	hwm;
+
+		version = trx_sys_rw_slots_version();
+
+		os_rmb;
+
+		low_limit_id = *(volatile trx_id_t*) &trx_sys->max_trx_id;
+
+		os_rmb;
+
+		/* While some transactions have no slot, or if the
+		transactions keep committing, make the view under
+		trx_sys->mutex. */
+		if (trx_sys->rw_slots_overflow > 0 || ++n_tries > 3) {
+
+			ut_a(os_compare_and_swap_ulint(
+				     &trx->read_view_state,
+				     READ_VIEW_SNAPSHOT, READ_VIEW_CLOSED));
+
+			return(NULL);
+		}
+
+		hwm = trx_sys->rw_slots_hwm;
+
+		os_rmb;
+
+		if (view == NULL || hwm > n_slots) {
+			n_slots = hwm;
+			view = read_view_create_low(
+				n_slots, trx->global_read_view_heap);
+		}
+
+		low_limit_no = low_limit_id;
+		n_trx_ids = 0;
+
+		for (ulint i = 0; i < hwm; i++) {
+			const trx_rw_slot_t*	slot = &trx_sys->rw_slots[i];
+			trx_id_t		id;
+			trx_id_t		no;
+
+			do {
+				id = slot->id;
+				os_rmb;
+				no = slot->no;
+				os_rmb;
+			} while (id != slot->id);
+
+			if (id == 0 || id >= low_limit_id || id == trx->id) {
+				continue;
+			}
+
+			view->trx_ids[n_trx_ids++] = id;
+
+			if (no < low_limit_no) {
+				low_limit_no = no;
+			}
+		}
+
+		os_rmb;
+
+		if (version == trx_sys->rw_slots_clearing) {
+			break;
+		}
+	}
+
+	std::sort(view->trx_ids, view->trx_ids + n_trx_ids,
+		  TrxIdGreater());
+
+	view->n_trx_ids = n_trx_ids;
+	view->undo_no = 0;
+	view->type = VIEW_NORMAL;
+	view->creator_trx_id = trx->id;
+	view->low_limit_no = low_limit_no;
+	view->low_limit_id = low_limit_id;
+	view->version = version;
+
+	if (n_trx_ids > 0) {
+		/* The last active transaction has the smallest id: */
+		view->up_limit_id = view->trx_ids[n_trx_ids - 1];
+	} else {
+		view->up_limit_id = low_limit_id;
+	}
+
+	view->owner = trx;
+	trx->global_read_view = view;
+
+	ut_a(os_compare_and_swap_ulint(
+		     &trx->read_view_state, READ_VIEW_SNAPSHOT, READ_VIEW_OPEN));
+
+	return(view);
+}
+#endif /* TRX_SYS_RW_SLOTS */
+
+/*********************************************************************//**
+Opens a read view for a transaction and sets it as trx->global_read_view.
+For a transaction created for MySQL, the view is made from
+trx_sys->rw_slots without acquiring trx_sys->mutex when possible.
+@return	own: read view struct */
+UNIV_INTERN
+read_view_t*
+read_view_open_for_trx(
+/*===================*/
+	trx_t*		trx)		/*!< in/out: active transaction */
+{
+	read_view_t*	view;
+
+#ifdef TRX_SYS_RW_SLOTS
+	/* read_view_purge_open() looks for the views that are not in
+	trx_sys->view_list in trx_sys->mysql_trx_list. */
+	if (trx->in_mysql_trx_list) {
+
+		view = read_view_open_lock_free(trx);
+
+		if (view != NULL) {
+			return(view);
+		}
+	}
+#endif /* TRX_SYS_RW_SLOTS */
+
+	view = read_view_open_now(trx->id, trx->global_read_view_heap);
+
+	trx->global_read_view = view;
+
+	return(view);
+}
+
+#ifdef TRX_SYS_RW_SLOTS
+/*********************************************************************//**
+Checks if a read view does not see more transactions than another one.
+Of two views with the same version, the one with the smaller
+low_limit_no was made first.
+@return	true if view is older than version and low_limit_no */
+static
+bool
+read_view_is_older(
+/*===============*/
+	const read_view_t*	view,		/*!< in: read view */
+	ulint			version,	/*!< in: version of other view */
+	trx_id_t		low_limit_no)	/*!< in: low_limit_no of
+						other view */
+{
+	return(view->version < version
+	       || (view->version == version
+		   && view->low_limit_no < low_limit_no));
+}
+
+/*********************************************************************//**
+Finds the oldest of the read views that read_view_open_lock_free() opened.
+The caller must hold trx_sys->mutex and make the purge view before, so
+that views opened after this is called are not older than it.
+@return	transaction owning the oldest view that is older than
+oldest_view, or NULL */
+static
+trx_t*
+read_view_find_oldest_lock_free(
+/*============================*/
+	const read_view_t*	oldest_view)	/*!< in: oldest view found
+						so far, or NULL */
+{
+	trx_t*		oldest_trx = NULL;
+	ulint		version = ULINT_MAX;
+	trx_id_t	low_limit_no = TRX_ID_MAX;
+
+	ut_ad(mutex_own(&trx_sys->mutex));
+
+	if (oldest_view != NULL) {
+		version = oldest_view->version;
+		low_limit_no = oldest_view->low_limit_no;
+	}
+
+	for (trx_t* trx = UT_LIST_GET_FIRST(trx_sys->mysql_trx_list);
+	     trx != NULL;
+	     trx = UT_LIST_GET_NEXT(mysql_trx_list, trx)) {
+
+		/* The compare and swap is a full memory barrier, see
+		read_view_open_lock_free(). */
+		while (!os_compare_and_swap_ulint(
+			       &trx->read_view_state,
+			       READ_VIEW_CLOSED, READ_VIEW_CLOSED)) {
+
+			if (trx->read_view_state == READ_VIEW_OPEN) {
+				const read_view_t*	view;
+
+				trx_mutex_enter(trx);
+
+				view = trx->global_read_view;
+
+				if (trx->read_view_state == READ_VIEW_OPEN
+				    && read_view_is_older(
+					    view, version, low_limit_no)) {
+
+					version = view->version;
+					low_limit_no = view->low_limit_no;
+					oldest_trx = trx;
+				}
+
+				trx_mutex_exit(trx);
+
+				break;
+			}
+
+			/* The view is being made; it cannot take long. */
+			os_thread_yield();
+		}
+	}
+
+	return(oldest_trx);
+}
+#endif /* TRX_SYS_RW_SLOTS */
+
 /*********************************************************************//**
 Makes a copy of the oldest existing read view, with the exception that also
 the creating trx of the oldest view is set as not visible in the 'copied'
@@ -413,11 +726,45 @@ read_view_purge_open(
 
 	mutex_enter(&trx_sys->mutex);
 
+#ifdef TRX_SYS_RW_SLOTS
+	/* Views that are opened without trx_sys->mutex while the oldest
+	view is searched for see at least what this view sees. */
+	view = read_view_open_now_low(0, heap);
+
+	for (;;) {
+		trx_t*	oldest_trx;
+
+		oldest_view = UT_LIST_GET_LAST(trx_sys->view_list);
+		oldest_trx = read_view_find_oldest_lock_free(oldest_view);
+
+		if (oldest_trx == NULL) {
+			break;
+		}
+
+		trx_mutex_enter(oldest_trx);
+
+		if (oldest_trx->read_view_state == READ_VIEW_OPEN) {
+
+			oldest_view = read_view_clone(
+				oldest_trx->global_read_view, heap);
+
+			trx_mutex_exit(oldest_trx);
+
+			goto add_creator;
+		}
+
+		/* The view was closed; look again. */
+		trx_mutex_exit(oldest_trx);
+	}
+#else
 	oldest_view = UT_LIST_GET_LAST(trx_sys->view_list);
+#endif /* TRX_SYS_RW_SLOTS */
 
 	if (oldest_view == NULL) {
 
+#ifndef TRX_SYS_RW_SLOTS
 		view = read_view_open_now_low(0, heap);
+#endif /* !TRX_SYS_RW_SLOTS */
 
 		mutex_exit(&trx_sys->mutex);
 
@@ -428,6 +775,10 @@ read_view_purge_open(
 
 	oldest_view = read_view_clone(oldest_view, heap);
 
+#ifdef TRX_SYS_RW_SLOTS
+add_creator:
+#endif /* TRX_SYS_RW_SLOTS */
+
 	ut_ad(read_view_validate(oldest_view));
 
 	mutex_exit(&trx_sys->mutex);
@@ -576,25 +927,12 @@ read_cursor_view_create_for_mysql(
 	view->type = VIEW_HIGH_GRANULARITY;
 	view->creator_trx_id = UINT64_UNDEFINED;
 
-	/* No future transactions should be visible in the view */
-
-	view->low_limit_no = trx_sys->max_trx_id;
-	view->low_limit_id = view->low_limit_no;
-
 	/* No active transaction should be visible */
 
-	ut_list_map(trx_sys->rw_trx_list, &trx_t::trx_list, CreateView(view));
+	read_view_set_active(view);
 
 	view->creator_trx_id = cr_trx->id;
 
-	if (view->n_trx_ids > 0) {
-		/* The last active transaction has the smallest id: */
-
-		view->up_limit_id = view->trx_ids[view->n_trx_ids - 1];
-	} else {
-		view->up_limit_id = view->low_limit_id;
-	}
-
 	read_view_add(view);
 
 	mutex_exit(&trx_sys->mutex);
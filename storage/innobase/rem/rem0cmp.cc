@@ -30,7 +30,6 @@ Created 7/1/1994 Heikki Tuuri
 #endif
 
 #include "ha_prototypes.h"
-#include "handler0alter.h"
 #include "srv0srv.h"
 
 /*		ALPHABETICAL ORDER
@@ -1030,9 +1029,8 @@ cmp_rec_rec_simple(
 	const ulint*		offsets1,/*!< in: rec_get_offsets(rec1, ...) */
 	const ulint*		offsets2,/*!< in: rec_get_offsets(rec2, ...) */
 	const dict_index_t*	index,	/*!< in: data dictionary index */
-	struct TABLE*		table)	/*!< in: MySQL table, for reporting
-					duplicate key value if applicable,
-					or NULL */
+	bool			check_dup)/*!< in: whether to return 0
+					for duplicates in a unique index */
 {
 	ulint		n;
 	ulint		n_uniq	= dict_index_get_n_unique(index);
@@ -1066,9 +1064,7 @@ cmp_rec_rec_simple(
 	/* If we ran out of fields, the ordering columns of rec1 were
 	equal to rec2. Issue a duplicate key error if needed. */
 
-	if (!null_eq && table && dict_index_is_unique(index)) {
-		/* Report erroneous row using new version of table. */
-		innobase_rec_to_mysql(table, rec1, index, offsets1);
+	if (!null_eq && check_dup && dict_index_is_unique(index)) {
 		return(0);
 	}
 
@@ -30,6 +30,7 @@ Created 10/13/2010 Jimmy Yang
 #include "row0merge.h"
 #include "row0row.h"
 #include "btr0cur.h"
+#include "btr0sea.h"
 
 /** Read the next record to buffer N.
 @param N	index into array of merge info structure */
@@ -87,6 +88,8 @@ row_merge_create_fts_sort_index(
 	new_index->n_def = FTS_NUM_FIELDS_SORT;
 	new_index->cached = TRUE;
 
+	btr_search_index_init(new_index);
+
 	idx_field = dict_index_get_nth_field(index, 0);
 	charset = fts_index_get_charset(index);
 
@@ -1186,7 +1189,7 @@ row_fts_sel_tree_propagate(
 	} else if (cmp_rec_rec_simple(mrec[child_left], mrec[child_right],
 				      offsets[child_left],
 				      offsets[child_right],
-				      index, NULL) < 0) {
+				      index, false) < 0) {
 		selected = child_left;
 	} else {
 		selected = child_right;
@@ -1275,7 +1278,7 @@ row_fts_build_sel_tree_level(
 		int cmp = cmp_rec_rec_simple(
 			mrec[child_left], mrec[child_right],
 			offsets[child_left], offsets[child_right],
-			index, NULL);
+			index, false);
 
 		sel_tree[start + i] = cmp < 0 ? child_left : child_right;
 	}
@@ -1502,7 +1505,7 @@ row_fts_merge_insert(
 				if (cmp_rec_rec_simple(
 					    mrec[i], mrec[min_rec],
 					    offsets[i], offsets[min_rec],
-					    index, NULL) < 0) {
+					    index, false) < 0) {
 					min_rec = static_cast<int>(i);
 				}
 			}
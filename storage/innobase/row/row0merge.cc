@@ -48,6 +48,12 @@ float my_log2f(float n)
 	return (float)(log((double)n) / log((double)2));
 }
 
+#ifdef UNIV_PFS_MUTEX
+/** Key to register the mutexes of parallel index builds
+with performance schema */
+UNIV_INTERN mysql_pfs_key_t	row_merge_mutex_key;
+#endif /* UNIV_PFS_MUTEX */
+
 /* Ignore posix_fadvise() on those platforms where it does not exist */
 #if defined __WIN__
 # define posix_fadvise(fd, offset, len, advice) /* nothing */
@@ -548,13 +554,50 @@ row_merge_dup_report(
 	row_merge_dup_t*	dup,	/*!< in/out: for reporting duplicates */
 	const dfield_t*		entry)	/*!< in: duplicate index entry */
 {
-	if (!dup->n_dup++) {
+	if (dup->n_dup++) {
 		/* Only report the first duplicate record,
 		but count all duplicate records. */
+	} else if (!dup->sync) {
 		innobase_fields_to_mysql(dup->table, dup->index, entry);
+	} else {
+		mutex_enter(&dup->sync->mutex);
+
+		if (!dup->sync->index) {
+			dup->sync->index = dup->index;
+			innobase_fields_to_mysql(
+				dup->table, dup->index, entry);
+		}
+
+		mutex_exit(&dup->sync->mutex);
 	}
 }
 
+/*************************************************************//**
+Report a duplicate key found when merging sorted records. */
+static __attribute__((nonnull))
+void
+row_merge_dup_report_rec(
+/*=====================*/
+	const row_merge_dup_t*	dup,	/*!< in: for reporting duplicates */
+	const mrec_t*		mrec,	/*!< in: duplicate merge record */
+	const ulint*		offsets)/*!< in: offsets of mrec */
+{
+	if (!dup->sync) {
+		/* Report erroneous row using new version of table. */
+		innobase_rec_to_mysql(dup->table, mrec, dup->index, offsets);
+		return;
+	}
+
+	mutex_enter(&dup->sync->mutex);
+
+	if (!dup->sync->index) {
+		dup->sync->index = dup->index;
+		innobase_rec_to_mysql(dup->table, mrec, dup->index, offsets);
+	}
+
+	mutex_exit(&dup->sync->mutex);
+}
+
 /*************************************************************//**
 Compare two tuples.
 @return	1, 0, -1 if a is greater, equal, less, respectively, than b */
@@ -1158,6 +1201,616 @@ row_merge_write_eof(
 	return(&block[0]);
 }
 
+/** State shared by the threads that read key ranges of the clustered
+index when secondary indexes are created */
+struct row_merge_scan_t {
+	ib_mutex_t		mutex;	/*!< protects err, err_index and
+					the offset and n_rec of files[] */
+	trx_t*			trx;	/*!< transaction */
+	struct TABLE*		table;	/*!< MySQL table object,
+					for reporting duplicate keys */
+	const dict_table_t*	old_table;/*!< table whose clustered
+					index is read */
+	bool			online;	/*!< true if creating indexes
+					online */
+	dict_index_t**		index;	/*!< indexes to be created */
+	merge_file_t*		files;	/*!< temporary files */
+	ulint			n_index;/*!< number of indexes to create */
+	const dtuple_t**	bounds;	/*!< range i is from bounds[i]
+					to bounds[i + 1]; bounds[0] and
+					bounds[n_ranges] are NULL */
+	ulint			n_ranges;/*!< number of key ranges */
+	ulint			next_range;/*!< number of ranges taken
+					by the threads */
+	ulint			n_threads;/*!< number of threads that
+					have not finished yet */
+	dberr_t			err;	/*!< first error */
+	ulint			err_index;/*!< index of the first
+					error in index[], or
+					ULINT_UNDEFINED */
+	row_merge_dup_sync_t	dup_sync;/*!< reporting of duplicates */
+	ulint			n_rows;	/*!< number of rows read,
+					updated every 1000 rows */
+	ib_int64_t		total_rows;/*!< estimated number of
+					rows in old_table */
+	float			pct_cost;/*!< percent of task weight
+					out of total alter job */
+};
+
+/*********************************************************************//**
+Split the clustered index in key ranges at the node pointers of its
+root page.
+@return	number of ranges, 1 if the index consists of a single page */
+static __attribute__((nonnull, warn_unused_result))
+ulint
+row_merge_scan_ranges(
+/*==================*/
+	dict_index_t*		index,	/*!< in: clustered index */
+	ulint			max_ranges,/*!< in: maximum number
+					of ranges */
+	const dtuple_t***	bounds,	/*!< out: first keys of the
+					ranges, see row_merge_scan_t */
+	mem_heap_t*		heap)	/*!< in/out: memory heap
+					for bounds */
+{
+	mtr_t		mtr;
+	const page_t*	page;
+	ulint		n_recs;
+	ulint		n_ranges	= 1;
+
+	mtr_start(&mtr);
+	mtr_s_lock(dict_index_get_lock(index), &mtr);
+
+	page = buf_block_get_frame(btr_block_get(
+		dict_index_get_space(index),
+		dict_table_zip_size(index->table),
+		dict_index_get_page(index), RW_S_LATCH, index, &mtr));
+
+	n_recs = page_get_n_recs(page);
+
+	if (btr_page_get_level(page, &mtr) > 0 && n_recs > 1) {
+		const ulint	n_uniq = dict_index_get_n_unique_in_tree(index);
+		const rec_t*	rec = page_rec_get_next_const(
+			page_get_infimum_rec(page));
+
+		n_ranges = ut_min(n_recs, max_ranges);
+
+		*bounds = static_cast<const dtuple_t**>(
+			mem_heap_zalloc(heap, (n_ranges + 1) * sizeof **bounds));
+
+		/* The first node pointer is the minimum record.
+		The first range starts from the beginning of the index. */
+		for (ulint i = 1, r = 1; r < n_ranges; i++) {
+			rec = page_rec_get_next_const(rec);
+
+			if (i == r * n_recs / n_ranges) {
+				(*bounds)[r++] = dict_index_build_data_tuple(
+					index, const_cast<rec_t*>(rec),
+					n_uniq, heap);
+			}
+		}
+	}
+
+	mtr_commit(&mtr);
+
+	return(n_ranges);
+}
+
+/*********************************************************************//**
+Note an error of a thread reading the clustered index. Only the first
+error is kept. */
+static __attribute__((nonnull))
+void
+row_merge_scan_set_error(
+/*=====================*/
+	row_merge_scan_t*	scan,	/*!< in/out: parallel scan */
+	dberr_t			err,	/*!< in: error code */
+	ulint			i)	/*!< in: index of the error in
+					scan->index[], or ULINT_UNDEFINED */
+{
+	mutex_enter(&scan->mutex);
+
+	if (scan->err == DB_SUCCESS) {
+		scan->err = err;
+		scan->err_index = i;
+	}
+
+	mutex_exit(&scan->mutex);
+}
+
+/*********************************************************************//**
+Sort a full buffer of a thread reading the clustered index and write
+it to the temporary file of the index, as one run.
+@return	DB_SUCCESS or error code */
+static __attribute__((nonnull, warn_unused_result))
+dberr_t
+row_merge_scan_write(
+/*=================*/
+	row_merge_scan_t*	scan,	/*!< in/out: parallel scan */
+	ulint			i,	/*!< in: index in scan->index[] */
+	row_merge_buf_t*	buf,	/*!< in/out: sort buffer */
+	row_merge_block_t*	block)	/*!< in/out: file buffer */
+{
+	merge_file_t*	file	= &scan->files[i];
+	ulint		offset;
+
+	ut_ad(buf->n_tuples);
+
+	if (dict_index_is_unique(buf->index)) {
+		row_merge_dup_t	dup = {
+			buf->index, scan->table, NULL, 0, &scan->dup_sync};
+
+		row_merge_buf_sort(buf, &dup);
+
+		if (dup.n_dup) {
+			return(DB_DUPLICATE_KEY);
+		}
+	} else {
+		row_merge_buf_sort(buf, NULL);
+	}
+
+	row_merge_buf_write(buf, file, block);
+
+	/* The runs of all threads go to the same file, in the order
+	they are written.  Each one takes one block. */
+	mutex_enter(&scan->mutex);
+	offset = file->offset++;
+	file->n_rec += buf->n_tuples;
+	mutex_exit(&scan->mutex);
+
+	if (!row_merge_write(file->fd, offset, block)) {
+		return(DB_TEMP_FILE_WRITE_FAILURE);
+	}
+
+	UNIV_MEM_INVALID(&block[0], srv_sort_buf_size);
+
+	return(DB_SUCCESS);
+}
+
+/*********************************************************************//**
+Read a key range of the clustered index and add the index entries
+of the rows to the sort buffers of the thread.
+@return	DB_SUCCESS or error code */
+static __attribute__((nonnull(1,4,5,6,7), warn_unused_result))
+dberr_t
+row_merge_scan_range(
+/*=================*/
+	row_merge_scan_t*	scan,	/*!< in/out: parallel scan */
+	const dtuple_t*		start,	/*!< in: first key of the range,
+					or NULL */
+	const dtuple_t*		end,	/*!< in: first key after the
+					range, or NULL */
+	row_merge_buf_t**	merge_buf,/*!< in/out: sort buffers */
+	row_merge_block_t*	block,	/*!< in/out: file buffer */
+	mem_heap_t*		row_heap,/*!< in/out: heap for the rows */
+	ulint*			err_index)/*!< out: index of the error
+					in scan->index[], or
+					ULINT_UNDEFINED */
+{
+	trx_t*		trx		= scan->trx;
+	dict_index_t*	clust_index	= dict_table_get_first_index(
+		scan->old_table);
+	btr_pcur_t	pcur;
+	mtr_t		mtr;
+	ulint		n_rows		= 0;
+	doc_id_t	doc_id		= 0;
+	dberr_t		err		= DB_SUCCESS;
+
+	*err_index = ULINT_UNDEFINED;
+
+	mtr_start(&mtr);
+
+	if (start) {
+		/* Position on the last record before the range. */
+		btr_pcur_open(clust_index, start, PAGE_CUR_L,
+			      BTR_SEARCH_LEAF, &pcur, &mtr);
+	} else {
+		btr_pcur_open_at_index_side(
+			true, clust_index, BTR_SEARCH_LEAF,
+			&pcur, true, 0, &mtr);
+	}
+
+	for (;;) {
+		const rec_t*	rec;
+		ulint*		offsets;
+		const dtuple_t*	row;
+		row_ext_t*	ext;
+		page_cur_t*	cur	= btr_pcur_get_page_cur(&pcur);
+
+		page_cur_move_to_next(cur);
+
+		if (page_cur_is_after_last(cur)) {
+			if (UNIV_UNLIKELY(trx_is_interrupted(trx))) {
+				err = DB_INTERRUPTED;
+				break;
+			}
+
+			if (scan->err != DB_SUCCESS) {
+				/* Another thread failed. */
+				break;
+			}
+
+			if (rw_lock_get_waiters(
+				    dict_index_get_lock(clust_index))) {
+				/* Yield to the waiters on the clustered
+				index tree lock, as in
+				row_merge_read_clustered_index(). */
+				btr_pcur_move_to_prev_on_page(&pcur);
+				btr_pcur_store_position(&pcur, &mtr);
+				mtr_commit(&mtr);
+
+				os_thread_yield();
+
+				mtr_start(&mtr);
+				btr_pcur_restore_position(
+					BTR_SEARCH_LEAF, &pcur, &mtr);
+
+				if (!btr_pcur_move_to_next_user_rec(
+					    &pcur, &mtr)) {
+					break;
+				}
+			} else {
+				ulint		next_page_no;
+				buf_block_t*	next_block;
+
+				next_page_no = btr_page_get_next(
+					page_cur_get_page(cur), &mtr);
+
+				if (next_page_no == FIL_NULL) {
+					break;
+				}
+
+				next_block = page_cur_get_block(cur);
+				next_block = btr_block_get(
+					buf_block_get_space(next_block),
+					buf_block_get_zip_size(next_block),
+					next_page_no, BTR_SEARCH_LEAF,
+					clust_index, &mtr);
+
+				btr_leaf_page_release(page_cur_get_block(cur),
+						      BTR_SEARCH_LEAF, &mtr);
+				page_cur_set_before_first(next_block, cur);
+				page_cur_move_to_next(cur);
+
+				ut_ad(!page_cur_is_after_last(cur));
+			}
+		}
+
+		rec = page_cur_get_rec(cur);
+
+		offsets = rec_get_offsets(rec, clust_index, NULL,
+					  ULINT_UNDEFINED, &row_heap);
+
+		if (end && cmp_dtuple_rec(end, rec, offsets) <= 0) {
+			/* This record is in the next range. */
+			break;
+		}
+
+		if (scan->online) {
+			/* Perform a REPEATABLE READ, see
+			row_merge_read_clustered_index(). */
+			ut_ad(trx->read_view);
+
+			if (!read_view_sees_trx_id(
+				    trx->read_view,
+				    row_get_rec_trx_id(
+					    rec, clust_index, offsets))) {
+				rec_t*	old_vers;
+
+				row_vers_build_for_consistent_read(
+					rec, &mtr, clust_index, &offsets,
+					trx->read_view, &row_heap,
+					row_heap, &old_vers);
+
+				rec = old_vers;
+
+				if (!rec) {
+					continue;
+				}
+			}
+		}
+
+		if (rec_get_deleted_flag(
+			    rec, dict_table_is_comp(scan->old_table))) {
+			continue;
+		}
+
+		ut_ad(!rec_offs_any_null_extern(rec, offsets));
+
+		row = row_build(ROW_COPY_POINTERS, clust_index,
+				rec, offsets, scan->old_table,
+				NULL, NULL, &ext, row_heap);
+
+		for (ulint i = 0; i < scan->n_index; i++) {
+			row_merge_buf_t*	buf	= merge_buf[i];
+
+			if (row_merge_buf_add(buf, NULL, scan->old_table,
+					      NULL, row, ext, &doc_id)) {
+				continue;
+			}
+
+			/* An empty buffer has room for a record. */
+			ut_ad(buf->n_tuples);
+
+			err = row_merge_scan_write(scan, i, buf, block);
+
+			if (err != DB_SUCCESS) {
+				*err_index = i;
+				goto func_exit;
+			}
+
+			merge_buf[i] = buf = row_merge_buf_empty(buf);
+
+			if (!row_merge_buf_add(buf, NULL, scan->old_table,
+					       NULL, row, ext, &doc_id)) {
+				ut_error;
+			}
+		}
+
+		mem_heap_empty(row_heap);
+
+		if (++n_rows == 1000) {
+			/* Increment innodb_onlineddl_pct_progress
+			status variable */
+			ulint	read_rows = os_atomic_increment_ulint(
+				&scan->n_rows, n_rows);
+
+			n_rows = 0;
+			/* presenting 10.12% as 1012 integer */
+			onlineddl_pct_progress = 100 * (
+				ib_int64_t(read_rows) >= scan->total_rows
+				? scan->pct_cost
+				: scan->pct_cost * read_rows
+				/ scan->total_rows);
+		}
+	}
+
+func_exit:
+	mtr_commit(&mtr);
+	btr_pcur_close(&pcur);
+	mem_heap_empty(row_heap);
+
+	return(err);
+}
+
+/*********************************************************************//**
+Read key ranges of the clustered index, until all ranges have been
+taken, and write the sorted index entries to the temporary files. */
+static __attribute__((nonnull))
+void
+row_merge_scan_worker(
+/*==================*/
+	row_merge_scan_t*	scan,	/*!< in/out: parallel scan */
+	row_merge_block_t*	block)	/*!< in/out: file buffer of
+					srv_sort_buf_size bytes */
+{
+	row_merge_buf_t**	merge_buf;
+	mem_heap_t*		row_heap;
+	ulint			err_index = ULINT_UNDEFINED;
+	dberr_t			err = DB_SUCCESS;
+
+	merge_buf = static_cast<row_merge_buf_t**>(
+		mem_alloc(scan->n_index * sizeof *merge_buf));
+
+	for (ulint i = 0; i < scan->n_index; i++) {
+		merge_buf[i] = row_merge_buf_create(scan->index[i]);
+	}
+
+	row_heap = mem_heap_create(sizeof(mrec_buf_t));
+
+	while (err == DB_SUCCESS && scan->err == DB_SUCCESS) {
+		ulint	r = os_atomic_increment_ulint(&scan->next_range, 1);
+
+		if (r > scan->n_ranges) {
+			break;
+		}
+
+		err = row_merge_scan_range(
+			scan, scan->bounds[r - 1], scan->bounds[r],
+			merge_buf, block, row_heap, &err_index);
+	}
+
+	/* Write out the rest of the buffers. */
+	for (ulint i = 0; err == DB_SUCCESS && i < scan->n_index; i++) {
+		if (merge_buf[i]->n_tuples) {
+			err = row_merge_scan_write(
+				scan, i, merge_buf[i], block);
+			err_index = i;
+		}
+	}
+
+	if (err != DB_SUCCESS) {
+		row_merge_scan_set_error(scan, err, err_index);
+	}
+
+	for (ulint i = 0; i < scan->n_index; i++) {
+		row_merge_buf_free(merge_buf[i]);
+	}
+
+	mem_heap_free(row_heap);
+	mem_free(merge_buf);
+}
+
+/*********************************************************************//**
+Thread for reading key ranges of the clustered index.
+@return	OS_THREAD_DUMMY_RETURN */
+static
+os_thread_ret_t
+DECLARE_THREAD(row_merge_scan_thread)(
+/*==================================*/
+	void*	arg)	/*!< in: row_merge_scan_t */
+{
+	row_merge_scan_t*	scan = static_cast<row_merge_scan_t*>(arg);
+	ulint			block_size = srv_sort_buf_size;
+	row_merge_block_t*	block = static_cast<row_merge_block_t*>(
+		os_mem_alloc_large(&block_size));
+
+	/* Without memory, leave the ranges to the other threads. */
+	if (block) {
+		row_merge_scan_worker(scan, block);
+		os_mem_free_large(block, block_size);
+	}
+
+	/* This must be the last access to scan. */
+	os_atomic_decrement_ulint(&scan->n_threads, 1);
+
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/*********************************************************************//**
+Read the clustered index with several threads, each one reading a key
+range at a time, and create the temporary files containing the entries
+of the secondary indexes to be built.  The runs that the threads write
+to a file are not in key order, which does not matter to
+row_merge_sort().
+@return	DB_SUCCESS or error code, or DB_END_OF_INDEX if the clustered
+index is too small to be read in parallel */
+static __attribute__((nonnull, warn_unused_result))
+dberr_t
+row_merge_read_clustered_index_pll(
+/*===============================*/
+	trx_t*			trx,	/*!< in: transaction */
+	struct TABLE*		table,	/*!< in/out: MySQL table object,
+					for reporting erroneous records */
+	const dict_table_t*	old_table,/*!< in: table where rows are
+					read from */
+	bool			online,	/*!< in: true if creating indexes
+					online */
+	dict_index_t**		index,	/*!< in: indexes to be created */
+	merge_file_t*		files,	/*!< in: temporary files */
+	const ulint*		key_numbers,
+					/*!< in: MySQL key numbers to create */
+	ulint			n_index,/*!< in: number of indexes to create */
+	row_merge_block_t*	block,	/*!< in/out: file buffer */
+	ib_int64_t		table_total_rows,
+					/*!< in: estimated number of rows */
+	float			pct_cost)/*!< in: percent of task weight
+					out of total alter job */
+{
+	row_merge_scan_t	scan;
+	mem_heap_t*		heap;
+	ulint			n_threads = srv_index_build_threads;
+	dberr_t			err = DB_SUCCESS;
+
+	heap = mem_heap_create(1024);
+
+	/* Use a few ranges per thread, so that the threads will
+	finish at about the same time. */
+	scan.n_ranges = row_merge_scan_ranges(
+		dict_table_get_first_index(old_table), 4 * n_threads,
+		&scan.bounds, heap);
+
+	if (scan.n_ranges < 2) {
+		mem_heap_free(heap);
+		return(DB_END_OF_INDEX);
+	}
+
+	n_threads = ut_min(n_threads, scan.n_ranges);
+
+	mutex_create(row_merge_mutex_key, &scan.mutex, SYNC_INDEX_BUILD);
+	mutex_create(row_merge_mutex_key, &scan.dup_sync.mutex,
+		     SYNC_INDEX_BUILD);
+	scan.dup_sync.index = NULL;
+	scan.trx = trx;
+	scan.table = table;
+	scan.old_table = old_table;
+	scan.online = online;
+	scan.index = index;
+	scan.files = files;
+	scan.n_index = n_index;
+	scan.next_range = 0;
+	scan.n_threads = n_threads - 1;
+	scan.err = DB_SUCCESS;
+	scan.err_index = ULINT_UNDEFINED;
+	scan.n_rows = 0;
+	scan.total_rows = table_total_rows;
+	scan.pct_cost = pct_cost;
+
+	for (ulint i = 1; i < n_threads; i++) {
+		os_thread_create(row_merge_scan_thread, &scan, NULL);
+	}
+
+	/* This thread reads ranges as well. */
+	row_merge_scan_worker(&scan, block);
+
+	while (scan.n_threads) {
+		os_thread_sleep(1000);
+	}
+
+	os_rmb;
+
+	if (scan.err == DB_SUCCESS) {
+		for (ulint i = 0; i < n_index; i++) {
+			merge_file_t*	file = &files[i];
+
+			if (!file->offset) {
+				/* The file must contain at least one
+				block, with the end of list marker. */
+				row_merge_buf_t*	buf
+					= row_merge_buf_create(index[i]);
+
+				row_merge_buf_write(buf, file, block);
+				row_merge_buf_free(buf);
+
+				if (!row_merge_write(file->fd, file->offset++,
+						     block)) {
+					scan.err = DB_TEMP_FILE_WRITE_FAILURE;
+					scan.err_index = i;
+					break;
+				}
+
+				UNIV_MEM_INVALID(&block[0], srv_sort_buf_size);
+			}
+
+			if (!online) {
+				continue;
+			}
+
+			/* Note the newest transaction that modified
+			this index when the scan was completed. We
+			prevent older readers from accessing this
+			index, to ensure read consistency. */
+			trx_id_t	max_trx_id;
+
+			rw_lock_x_lock(dict_index_get_lock(index[i]));
+			ut_a(dict_index_get_online_status(index[i])
+			     == ONLINE_INDEX_CREATION);
+
+			max_trx_id = row_log_get_max_trx(index[i]);
+
+			if (max_trx_id > index[i]->trx_id) {
+				index[i]->trx_id = max_trx_id;
+			}
+
+			rw_lock_x_unlock(dict_index_get_lock(index[i]));
+		}
+	}
+
+	err = scan.err;
+
+	if (err == DB_DUPLICATE_KEY && scan.dup_sync.index) {
+		/* Report the key number of the duplicate that was
+		copied to the MySQL record, which may be of another
+		index than the first error. */
+		for (ulint i = 0; i < n_index; i++) {
+			if (index[i] == scan.dup_sync.index) {
+				trx->error_key_num = key_numbers[i];
+			}
+		}
+	} else if (err != DB_SUCCESS) {
+		trx->error_key_num = scan.err_index == ULINT_UNDEFINED
+			? 0 : key_numbers[scan.err_index];
+	}
+
+	mutex_free(&scan.dup_sync.mutex);
+	mutex_free(&scan.mutex);
+	mem_heap_free(heap);
+
+	return(err);
+}
+
 /********************************************************************//**
 Reads clustered index of the table and create temporary files
 containing the index entries for the indexes to be built.
@@ -1236,6 +1889,25 @@ row_merge_read_clustered_index(
 
 	trx->op_info = "reading clustered index";
 
+	if (old_table == new_table && !fts_sort_idx
+	    && srv_index_build_threads > 1) {
+		/* Secondary indexes can be built from several key
+		ranges of the clustered index at a time. */
+		ut_ad(add_autoinc == ULINT_UNDEFINED);
+
+		err = row_merge_read_clustered_index_pll(
+			trx, table, old_table, online, index, files,
+			key_numbers, n_index, block, table_total_rows,
+			pct_cost);
+
+		if (err != DB_END_OF_INDEX) {
+			trx->op_info = "";
+			DBUG_RETURN(err);
+		}
+
+		err = DB_SUCCESS;
+	}
+
 #ifdef FTS_INTERNAL_DIAG_PRINT
 	DEBUG_FTS_SORT_PRINT("FTS_SORT: Start Create Index\n");
 #endif
@@ -1949,8 +2621,9 @@ row_merge_blocks(
 	while (mrec0 && mrec1) {
 		switch (cmp_rec_rec_simple(
 				mrec0, mrec1, offsets0, offsets1,
-				dup->index, dup->table)) {
+				dup->index, dup->table != NULL)) {
 		case 0:
+			row_merge_dup_report_rec(dup, mrec0, offsets0);
 			mem_heap_free(heap);
 			return(DB_DUPLICATE_KEY);
 		case -1:
@@ -2251,7 +2924,9 @@ row_merge_sort(
 	of file marker).  Thus, it must be at least one block. */
 	ut_ad(file->offset > 0);
 
-	thd_progress_init(trx->mysql_thd, num_runs);
+	if (update_progress) {
+		thd_progress_init(trx->mysql_thd, num_runs);
+	}
 	sql_print_information("InnoDB: Online DDL : merge-sorting has estimated %lu runs", num_runs);
 
 	/* Merge the runs until we have one big run */
@@ -2260,7 +2935,9 @@ row_merge_sort(
 
 		/* Report progress of merge sort to MySQL for
 		show processlist progress field */
-		thd_progress_report(trx->mysql_thd, cur_run, num_runs);
+		if (update_progress) {
+			thd_progress_report(trx->mysql_thd, cur_run, num_runs);
+		}
 		sql_print_information("InnoDB: Online DDL : merge-sorting current run %lu estimated %lu runs", cur_run, num_runs);
 
 		error = row_merge(trx, dup, file, block, tmpfd,
@@ -2284,7 +2961,9 @@ row_merge_sort(
 
 	mem_free(run_offset);
 
-	thd_progress_end(trx->mysql_thd);
+	if (update_progress) {
+		thd_progress_end(trx->mysql_thd);
+	}
 
 	DBUG_RETURN(error);
 }
@@ -2357,6 +3036,9 @@ row_merge_insert_index_tuples(
 	ulint			foffs = 0;
 	ulint*			offsets;
 	mrec_buf_t*		buf;
+	btr_cur_t		cursor;
+	mtr_t			mtr;
+	bool			mtr_started = false;
 	ib_int64_t		inserted_rows = 0;
 	float			curr_progress;
 	DBUG_ENTER("row_merge_insert_index_tuples");
@@ -2392,8 +3074,18 @@ row_merge_insert_index_tuples(
 			ulint		n_ext;
 			big_rec_t*	big_rec;
 			rec_t*		rec;
-			btr_cur_t	cursor;
-			mtr_t		mtr;
+
+			if (mtr_started
+			    && (ulint) (&block[srv_sort_buf_size] - b)
+			    <= 2 + sizeof *buf) {
+				/* The next record may continue in the
+				next block of the file. Do not keep the
+				leaf page latched during the file read.
+				A record is shorter than *buf, plus at
+				most 2 bytes of extra_size. */
+				mtr_commit(&mtr);
+				mtr_started = false;
+			}
 
 			b = row_merge_read_rec(block, buf, b, index,
 					       fd, &foffs, &mrec, offsets);
@@ -2423,6 +3115,15 @@ row_merge_insert_index_tuples(
 				/* There are no externally stored columns. */
 			} else {
 				ut_ad(dict_index_is_clust(index));
+
+				if (mtr_started) {
+					/* Do not keep the leaf page
+					latched while reading the BLOB
+					pages of old_table. */
+					mtr_commit(&mtr);
+					mtr_started = false;
+				}
+
 				/* Off-page columns can be fetched safely
 				when concurrent modifications to the table
 				are disabled. (Purge can process delete-marked
@@ -2449,18 +3150,23 @@ row_merge_insert_index_tuples(
 			}
 
 			ut_ad(dtuple_validate(dtuple));
-			log_free_check();
-
-			mtr_start(&mtr);
-			/* Insert after the last user record. */
-			btr_cur_open_at_index_side(
-				false, index, BTR_MODIFY_LEAF,
-				&cursor, 0, &mtr);
-			page_cur_position(
-				page_rec_get_prev(btr_cur_get_rec(&cursor)),
-				btr_cur_get_block(&cursor),
-				btr_cur_get_page_cur(&cursor));
-			cursor.flag = BTR_CUR_BINARY;
+
+			if (!mtr_started) {
+				log_free_check();
+
+				mtr_start(&mtr);
+				mtr_started = true;
+				/* Insert after the last user record. */
+				btr_cur_open_at_index_side(
+					false, index, BTR_MODIFY_LEAF,
+					&cursor, 0, &mtr);
+				page_cur_position(
+					page_rec_get_prev(
+						btr_cur_get_rec(&cursor)),
+					btr_cur_get_block(&cursor),
+					btr_cur_get_page_cur(&cursor));
+				cursor.flag = BTR_CUR_BINARY;
+			}
 #ifdef UNIV_DEBUG
 			/* Check that the records are inserted in order. */
 			rec = btr_cur_get_rec(&cursor);
@@ -2474,6 +3180,7 @@ row_merge_insert_index_tuples(
 			}
 #endif /* UNIV_DEBUG */
 			ulint*	ins_offsets = NULL;
+			bool	pessimistic = false;
 
 			error = btr_cur_optimistic_insert(
 				BTR_NO_UNDO_LOG_FLAG | BTR_NO_LOCKING_FLAG
@@ -2483,6 +3190,7 @@ row_merge_insert_index_tuples(
 
 			if (error == DB_FAIL) {
 				ut_ad(!big_rec);
+				pessimistic = true;
 				mtr_commit(&mtr);
 				mtr_start(&mtr);
 				btr_cur_open_at_index_side(
@@ -2509,7 +3217,22 @@ row_merge_insert_index_tuples(
 					trx_id, &mtr);
 			}
 
-			mtr_commit(&mtr);
+			if (error == DB_SUCCESS && !big_rec && !pessimistic) {
+				/* The tuples arrive in ascending order
+				and go to the last leaf page.  Keep the
+				page latched and insert the following
+				tuples after this one in the same
+				mini-transaction, until the page is
+				full.  The redo log written by the
+				mini-transaction is bounded by the
+				size of the page. */
+				page_cur_position(
+					rec, btr_cur_get_block(&cursor),
+					btr_cur_get_page_cur(&cursor));
+			} else {
+				mtr_commit(&mtr);
+				mtr_started = false;
+			}
 
 			if (UNIV_LIKELY_NULL(big_rec)) {
 				/* If the system crashes at this
@@ -2552,6 +3275,10 @@ row_merge_insert_index_tuples(
 	}
 
 err_exit:
+	if (mtr_started) {
+		mtr_commit(&mtr);
+	}
+
 	mem_heap_free(tuple_heap);
 	mem_heap_free(ins_heap);
 	mem_heap_free(heap);
@@ -3497,6 +4224,193 @@ row_merge_drop_table(
 	return(row_drop_table_for_mysql(table->name, trx, false, false));
 }
 
+/** State shared by the threads that sort and insert the entries of
+the indexes being created, one index at a time each */
+struct row_merge_build_t {
+	trx_t*			trx;	/*!< transaction */
+	struct TABLE*		table;	/*!< MySQL table object,
+					for reporting duplicate keys */
+	const dict_table_t*	old_table;/*!< table where rows are
+					read from */
+	dict_index_t**		indexes;/*!< indexes to be created */
+	merge_file_t*		files;	/*!< temporary files */
+	dberr_t*		errors;	/*!< errors of indexes[] */
+	ulint			n_indexes;/*!< size of indexes[] */
+	ulint			next_index;/*!< number of indexes taken
+					by the threads */
+	ulint			n_threads;/*!< number of threads that
+					have not finished yet */
+	bool			failed;	/*!< whether an error occurred */
+	row_merge_dup_sync_t	dup_sync;/*!< reporting of duplicates */
+	float			pct_progress;/*!< total progress percent
+					until the sorting started */
+};
+
+/*********************************************************************//**
+Sort and insert the entries of indexes, until all indexes have been
+taken. */
+static __attribute__((nonnull))
+void
+row_merge_build_worker(
+/*===================*/
+	row_merge_build_t*	build,	/*!< in/out: parallel build */
+	row_merge_block_t*	block,	/*!< in/out: 3 file buffers */
+	int*			tmpfd)	/*!< in/out: temporary file handle */
+{
+	while (!build->failed) {
+		ulint	i = os_atomic_increment_ulint(&build->next_index, 1);
+
+		if (i > build->n_indexes) {
+			break;
+		}
+
+		i--;
+
+		merge_file_t*	file	= &build->files[i];
+		row_merge_dup_t	dup	= {
+			build->indexes[i], build->table, NULL, 0,
+			&build->dup_sync};
+		dberr_t		error;
+
+		error = row_merge_sort(build->trx, &dup, file, block, tmpfd,
+				       false, 0, 0);
+
+		if (error == DB_SUCCESS) {
+			error = row_merge_insert_index_tuples(
+				build->trx->id, build->indexes[i],
+				build->old_table, file->fd, block,
+				file->n_rec, build->pct_progress, 0);
+		}
+
+		/* Close the temporary file to free up space. */
+		row_merge_file_destroy(file);
+
+		if (error != DB_SUCCESS) {
+			build->errors[i] = error;
+			build->failed = true;
+		}
+	}
+}
+
+/*********************************************************************//**
+Thread for sorting and inserting the entries of indexes.
+@return	OS_THREAD_DUMMY_RETURN */
+static
+os_thread_ret_t
+DECLARE_THREAD(row_merge_build_thread)(
+/*===================================*/
+	void*	arg)	/*!< in: row_merge_build_t */
+{
+	row_merge_build_t*	build = static_cast<row_merge_build_t*>(arg);
+	ulint			block_size = 3 * srv_sort_buf_size;
+	row_merge_block_t*	block = static_cast<row_merge_block_t*>(
+		os_mem_alloc_large(&block_size));
+	int			tmpfd = row_merge_file_create_low();
+
+	/* Without resources, leave the indexes to the other threads. */
+	if (block && tmpfd >= 0) {
+		row_merge_build_worker(build, block, &tmpfd);
+	}
+
+	row_merge_file_destroy_low(tmpfd);
+
+	if (block) {
+		os_mem_free_large(block, block_size);
+	}
+
+	/* This must be the last access to build. */
+	os_atomic_decrement_ulint(&build->n_threads, 1);
+
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/*********************************************************************//**
+Sort the temporary files of several secondary indexes and insert the
+entries into the indexes, with the indexes divided among threads.
+The online logs of the indexes are not applied.
+@return	DB_SUCCESS or error code */
+static __attribute__((nonnull, warn_unused_result))
+dberr_t
+row_merge_build_indexes_pll(
+/*========================*/
+	trx_t*			trx,	/*!< in: transaction */
+	const dict_table_t*	old_table,/*!< in: table where rows are
+					read from */
+	dict_index_t**		indexes,/*!< in: indexes to be created */
+	const ulint*		key_numbers,/*!< in: MySQL key numbers */
+	ulint			n_indexes,/*!< in: size of indexes[] */
+	merge_file_t*		files,	/*!< in/out: temporary files,
+					closed on return */
+	struct TABLE*		table,	/*!< in/out: MySQL table, for
+					reporting erroneous key value
+					if applicable */
+	row_merge_block_t*	block,	/*!< in/out: 3 file buffers */
+	int*			tmpfd,	/*!< in/out: temporary file handle */
+	float			pct_progress)/*!< in: total progress
+					percent until now */
+{
+	row_merge_build_t	build;
+	ulint			n_threads;
+	dberr_t			error = DB_SUCCESS;
+
+	n_threads = ut_min(srv_index_build_threads, n_indexes);
+
+	mutex_create(row_merge_mutex_key, &build.dup_sync.mutex,
+		     SYNC_INDEX_BUILD);
+	build.dup_sync.index = NULL;
+	build.trx = trx;
+	build.table = table;
+	build.old_table = old_table;
+	build.indexes = indexes;
+	build.files = files;
+	build.errors = static_cast<dberr_t*>(
+		mem_alloc(n_indexes * sizeof *build.errors));
+	build.n_indexes = n_indexes;
+	build.next_index = 0;
+	build.n_threads = n_threads - 1;
+	build.failed = false;
+	build.pct_progress = pct_progress;
+
+	for (ulint i = 0; i < n_indexes; i++) {
+		build.errors[i] = DB_SUCCESS;
+	}
+
+	for (ulint i = 1; i < n_threads; i++) {
+		os_thread_create(row_merge_build_thread, &build, NULL);
+	}
+
+	/* This thread builds indexes as well. */
+	row_merge_build_worker(&build, block, tmpfd);
+
+	while (build.n_threads) {
+		os_thread_sleep(1000);
+	}
+
+	os_rmb;
+
+	for (ulint i = 0; i < n_indexes; i++) {
+		if (build.errors[i] == DB_SUCCESS) {
+			continue;
+		}
+
+		/* Report the index of the duplicate that was copied
+		to the MySQL record, if any, or else the first one. */
+		if (error == DB_SUCCESS
+		    || (build.errors[i] == DB_DUPLICATE_KEY
+			&& indexes[i] == build.dup_sync.index)) {
+			error = build.errors[i];
+			trx->error_key_num = key_numbers[i];
+		}
+	}
+
+	mem_free(build.errors);
+	mutex_free(&build.dup_sync.mutex);
+
+	return(error);
+}
+
 /*********************************************************************//**
 Build indexes on a table by reading a clustered index,
 creating a temporary file containing index entries, merge sorting
@@ -3543,6 +4457,7 @@ row_merge_build_indexes(
 	fts_psort_t*		merge_info = NULL;
 	ib_int64_t		sig_count = 0;
 	bool			fts_psort_initiated = false;
+	bool			built = false;
 
 	float total_static_cost = 0;
 	float total_dynamic_cost = 0;
@@ -3605,6 +4520,7 @@ row_merge_build_indexes(
 			dup->table = table;
 			dup->col_map = col_map;
 			dup->n_dup = 0;
+			dup->sync = NULL;
 
 			row_fts_psort_info_init(
 				trx, dup, new_table, opt_doc_id_size,
@@ -3660,10 +4576,48 @@ row_merge_build_indexes(
 	/* Now we have files containing index entries ready for
 	sorting and inserting. */
 
+	if (old_table == new_table && !fts_sort_idx && n_indexes > 1
+	    && srv_index_build_threads > 1) {
+		/* Sort and insert several indexes at a time. This is
+		only done when adding indexes, as is the parallel scan:
+		a table rebuild builds its indexes one at a time. */
+		pct_cost = 0;
+
+		for (i = 0; i < n_indexes; i++) {
+			pct_cost += (COST_BUILD_INDEX_STATIC +
+				(total_dynamic_cost * merge_files[i].offset /
+					total_index_blocks)) /
+				(total_static_cost + total_dynamic_cost) * 100;
+		}
+
+		sql_print_information("InnoDB: Online DDL : Start merge-sorting"
+			" and building %lu indexes, estimated cost : %2.4f",
+			n_indexes, pct_cost);
+
+		error = row_merge_build_indexes_pll(
+			trx, old_table, indexes, key_numbers, n_indexes,
+			merge_files, table, block, &tmpfd, pct_progress);
+
+		sql_print_information("InnoDB: Online DDL : End of merge-sorting"
+			" and building %lu indexes", n_indexes);
+
+		if (error != DB_SUCCESS) {
+			goto func_exit;
+		}
+
+		pct_progress += pct_cost;
+		/* presenting 10.12% as 1012 integer */
+		onlineddl_pct_progress = pct_progress * 100;
+		built = true;
+	}
+
 	for (i = 0; i < n_indexes; i++) {
 		dict_index_t*	sort_idx = indexes[i];
 
-		if (indexes[i]->type & DICT_FTS) {
+		if (built) {
+			/* The index was built by
+			row_merge_build_indexes_pll(). */
+		} else if (indexes[i]->type & DICT_FTS) {
 			os_event_t	fts_parallel_merge_event;
 
 			sort_idx = fts_sort_idx;
@@ -35,6 +35,7 @@ Created 12/9/2009 Jimmy Yang
 #include "trx0rseg.h"
 #include "lock0lock.h"
 #include "ibuf0ibuf.h"
+#include "btr0sea.h"
 #ifdef UNIV_NONINL
 #include "srv0mon.ic"
 #endif
@@ -804,6 +805,17 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_PURGE_N_PAGE_HANDLED},
 
+	{"purge_undo_records", "purge",
+	 "Number of undo log records handed to the purge threads",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_N_UNDO_RECS},
+
+	{"purge_worker_records_max", "purge",
+	 "Number of undo log records handed to the busiest purge thread"
+	 " in the last non-empty purge batch",
+	 MONITOR_DISPLAY_CURRENT,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_WORKER_RECS_MAX},
+
 	{"purge_dml_delay_usec", "purge",
 	 "Microseconds DML to be delayed due to purge lagging",
 	 MONITOR_DISPLAY_CURRENT,
@@ -1066,6 +1078,26 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_ADAPTIVE_HASH_ROW_UPDATED},
 
+	{"adaptive_hash_latch_waits", "adaptive_hash_index",
+	 "Number of times an Adaptive Hash Index partition latch was not"
+	 " immediately available",
+	 MONITOR_EXISTING,
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_LATCH_WAITS},
+
+	{"adaptive_hash_partition_hits_max", "adaptive_hash_index",
+	 "Number of successful searches in the busiest Adaptive Hash Index"
+	 " partition (innodb_adaptive_hash_index_partitions)",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DISPLAY_CURRENT),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_PART_HITS_MAX},
+
+	{"adaptive_hash_partition_latch_waits_max", "adaptive_hash_index",
+	 "Number of latch waits in the most contended Adaptive Hash Index"
+	 " partition (innodb_adaptive_hash_index_partitions)",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DISPLAY_CURRENT),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_ADAPTIVE_HASH_PART_WAITS_MAX},
+
 	/* ========== Counters for tablespace ========== */
 	{"module_file", "file_system", "Tablespace and File System Manager",
 	 MONITOR_MODULE,
@@ -1959,6 +1991,27 @@ srv_mon_process_existing_counter(
 		value = btr_cur_n_non_sea;
 		break;
 
+	case MONITOR_OVLD_ADAPTIVE_HASH_LATCH_WAITS:
+	case MONITOR_OVLD_ADAPTIVE_HASH_PART_HITS_MAX:
+	case MONITOR_OVLD_ADAPTIVE_HASH_PART_WAITS_MAX: {
+		ulint	latch_waits;
+		ulint	max_hits;
+		ulint	max_latch_waits;
+
+		btr_search_get_partition_stats(
+			&latch_waits, &max_hits, &max_latch_waits);
+
+		if (monitor_id == MONITOR_OVLD_ADAPTIVE_HASH_LATCH_WAITS) {
+			value = latch_waits;
+		} else if (monitor_id
+			   == MONITOR_OVLD_ADAPTIVE_HASH_PART_HITS_MAX) {
+			value = max_hits;
+		} else {
+			value = max_latch_waits;
+		}
+		break;
+	}
+
         case MONITOR_OVLD_PAGE_COMPRESS_SAVED:
 		value = srv_stats.page_compression_saved;
 		break;
@@ -144,6 +144,8 @@ on duplicate key checking and foreign key checking */
 UNIV_INTERN ibool	srv_locks_unsafe_for_binlog = FALSE;
 /** Sort buffer size in index creation */
 UNIV_INTERN ulong	srv_sort_buf_size = 1048576;
+/** Number of threads that scan, sort and insert in index creation */
+UNIV_INTERN ulong	srv_index_build_threads = 1;
 /** Maximum modification log file size for online index creation */
 UNIV_INTERN unsigned long long	srv_online_max_size;
 
@@ -1300,7 +1302,17 @@ srv_printf_innodb_monitor(
 	      "-------------------------------------\n", file);
 	ibuf_print(file);
 
-	ha_print_info(file, btr_search_sys->hash_index);
+	for (ulint i = 0; i < btr_search_index_num; i++) {
+		const btr_search_part_stats_t*	stats
+			= &btr_search_sys->part_stats[i];
+
+		ha_print_info(file, btr_search_sys->hash_tables[i]);
+
+		fprintf(file,
+			"Partition %lu: %lu hash hits, %lu latch waits\n",
+			(ulong) i, (ulong) stats->n_hits,
+			(ulong) stats->n_latch_waits);
+	}
 
 	fprintf(file,
 		"%.2f hash searches/s, %.2f non-hash searches/s\n",
@@ -956,7 +956,10 @@ trx_purge_fetch_next_rec(
 }
 
 /*******************************************************************//**
-This function runs a purge batch.
+This function runs a purge batch. The undo log records are partitioned
+among the purge threads by the row that they modify, so that the records
+of a row are purged in order by one thread while the rows of a single
+table can be purged by all the threads.
 @return	number of undo log pages handled in the batch */
 static
 ulint
@@ -968,11 +971,15 @@ trx_purge_attach_undo_recs(
 	ulint		batch_size)	/*!< in: no. of pages to purge */
 {
 	que_thr_t*	thr;
+	purge_node_t*	nodes[SRV_MAX_N_PURGE_THREADS];
 	ulint		i = 0;
 	ulint		n_pages_handled = 0;
+	ulint		n_recs = 0;
+	ulint		max_recs = 0;
 	ulint		n_thrs = UT_LIST_GET_LEN(purge_sys->query->thrs);
 
 	ut_a(n_purge_threads > 0);
+	ut_a(n_purge_threads <= SRV_MAX_N_PURGE_THREADS);
 
 	*limit = purge_sys->iter;
 
@@ -983,6 +990,8 @@ trx_purge_attach_undo_recs(
 
 		purge_node_t*		node;
 
+		ut_a(!thr->is_active);
+
 		/* Get the purge node. */
 		node = (purge_node_t*) thr->child;
 
@@ -991,33 +1000,27 @@ trx_purge_attach_undo_recs(
 		ut_a(node->done);
 
 		node->done = FALSE;
+		node->n_batch_recs = 0;
+
+		nodes[i] = node;
 	}
 
 	/* There should never be fewer nodes than threads, the inverse
 	however is allowed because we only use purge threads as needed. */
 	ut_a(i == n_purge_threads);
-
-	/* Fetch and parse the UNDO records. The UNDO records are added
-	to a per purge node vector. */
-	thr = UT_LIST_GET_FIRST(purge_sys->query->thrs);
-	ut_a(n_thrs > 0 && thr != NULL);
+	ut_a(n_thrs > 0);
 
 	ut_ad(trx_purge_check_limit());
 
-	i = 0;
-
-	for (;;) {
+	/* Fetch and parse the UNDO records. The UNDO records are added
+	to a per purge node vector. They are allocated from purge_sys->heap,
+	which is emptied only after all the nodes have completed. */
+	for (i = 0;; i++) {
 		purge_node_t*		node;
 		trx_purge_rec_t*	purge_rec;
 
-		ut_a(!thr->is_active);
-
-		/* Get the purge node. */
-		node = (purge_node_t*) thr->child;
-		ut_a(que_node_get_type(node) == QUE_NODE_PURGE);
-
 		purge_rec = static_cast<trx_purge_rec_t*>(
-			mem_heap_zalloc(node->heap, sizeof(*purge_rec)));
+			mem_heap_zalloc(purge_sys->heap, sizeof(*purge_rec)));
 
 		/* Track the max {trx_id, undo_no} for truncating the
 		UNDO logs once we have purged the records. */
@@ -1031,36 +1034,47 @@ trx_purge_attach_undo_recs(
 
 		/* Fetch the next record, and advance the purge_sys->iter. */
 		purge_rec->undo_rec = trx_purge_fetch_next_rec(
-			&purge_rec->roll_ptr, &n_pages_handled, node->heap);
+			&purge_rec->roll_ptr, &n_pages_handled,
+			purge_sys->heap);
+
+		if (purge_rec->undo_rec == NULL) {
+			break;
+		} else if (purge_rec->undo_rec == &trx_purge_dummy_rec) {
+			/* Nothing to purge, any node will do */
+			node = nodes[i % n_purge_threads];
+		} else {
+			node = nodes[trx_undo_rec_get_row_fold(
+				purge_rec->undo_rec) % n_purge_threads];
+		}
 
-		if (purge_rec->undo_rec != NULL) {
+		if (node->undo_recs == NULL) {
+			node->undo_recs = ib_vector_create(
+				ib_heap_allocator_create(node->heap),
+				sizeof(trx_purge_rec_t),
+				batch_size);
+		} else {
+			ut_a(!ib_vector_is_empty(node->undo_recs));
+		}
 
-			if (node->undo_recs == NULL) {
-				node->undo_recs = ib_vector_create(
-					ib_heap_allocator_create(node->heap),
-					sizeof(trx_purge_rec_t),
-					batch_size);
-			} else {
-				ut_a(!ib_vector_is_empty(node->undo_recs));
-			}
+		ib_vector_push(node->undo_recs, purge_rec);
 
-			ib_vector_push(node->undo_recs, purge_rec);
+		++node->n_batch_recs;
+		++node->n_undo_recs;
 
-			if (n_pages_handled >= batch_size) {
+		if (n_pages_handled >= batch_size) {
 
-				break;
-			}
-		} else {
 			break;
 		}
+	}
 
-		thr = UT_LIST_GET_NEXT(thrs, thr);
-
-		if (!(++i % n_purge_threads)) {
-			thr = UT_LIST_GET_FIRST(purge_sys->query->thrs);
-		}
+	for (i = 0; i < n_purge_threads; ++i) {
+		n_recs += nodes[i]->n_batch_recs;
+		max_recs = ut_max(max_recs, nodes[i]->n_batch_recs);
+	}
 
-		ut_a(thr != NULL);
+	if (n_recs > 0) {
+		MONITOR_INC_VALUE(MONITOR_PURGE_N_UNDO_RECS, n_recs);
+		MONITOR_SET(MONITOR_PURGE_WORKER_RECS_MAX, max_recs);
 	}
 
 	ut_ad(trx_purge_check_limit());
@@ -1403,3 +1417,37 @@ trx_purge_run(void)
 
 	srv_purge_wakeup();
 }
+
+/*******************************************************************//**
+Prints the number of undo log records given to each purge thread. */
+UNIV_INTERN
+void
+trx_purge_print_threads(
+/*====================*/
+	FILE*	file)	/*!< in: output stream */
+{
+	const que_thr_t*	thr;
+	const char*		sep = "";
+
+	if (purge_sys->query == NULL
+	    || UT_LIST_GET_LEN(purge_sys->query->thrs) < 2) {
+		return;
+	}
+
+	/* The counters are read without the latch, merely for display */
+	fputs("Purge undo records per thread:", file);
+
+	for (thr = UT_LIST_GET_FIRST(purge_sys->query->thrs);
+	     thr != NULL;
+	     thr = UT_LIST_GET_NEXT(thrs, thr)) {
+
+		const purge_node_t*	node;
+
+		node = static_cast<const purge_node_t*>(thr->child);
+
+		fprintf(file, "%s " ULINTPF, sep, node->n_undo_recs);
+		sep = ",";
+	}
+
+	putc('\n', file);
+}
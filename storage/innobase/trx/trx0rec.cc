@@ -878,6 +878,54 @@ trx_undo_update_rec_get_sys_cols(
 	return(ptr);
 }
 
+/**********************************************************************//**
+Computes a fold value of the table id and the first field of the row
+reference of an undo log record. The table definition is not needed:
+all the undo log records of a row have the same fold value, so that they
+can be given to the same purge thread to be purged in order.
+@return	fold value */
+UNIV_INTERN
+ulint
+trx_undo_rec_get_row_fold(
+/*======================*/
+	trx_undo_rec_t*	undo_rec)	/*!< in: undo log record */
+{
+	byte*		ptr;
+	byte*		field;
+	ulint		type;
+	ulint		cmpl_info;
+	bool		updated_extern;
+	undo_no_t	undo_no;
+	table_id_t	table_id;
+	ulint		len;
+	ulint		orig_len;
+	ulint		fold;
+
+	ptr = trx_undo_rec_get_pars(undo_rec, &type, &cmpl_info,
+				    &updated_extern, &undo_no, &table_id);
+
+	fold = ut_fold_ull(table_id);
+
+	if (type != TRX_UNDO_INSERT_REC) {
+		trx_id_t	trx_id;
+		roll_ptr_t	roll_ptr;
+		ulint		info_bits;
+
+		ptr = trx_undo_update_rec_get_sys_cols(
+			ptr, &trx_id, &roll_ptr, &info_bits);
+	}
+
+	trx_undo_rec_get_col_val(ptr, &field, &len, &orig_len);
+
+	/* The fields of the row reference are never NULL or stored
+	externally */
+	if (len < UNIV_EXTERN_STORAGE_FIELD) {
+		fold = ut_fold_ulint_pair(fold, ut_fold_binary(field, len));
+	}
+
+	return(fold);
+}
+
 /**********************************************************************//**
 Reads from an update undo log record the number of updated fields.
 @return	remaining part of undo log record after reading this value */
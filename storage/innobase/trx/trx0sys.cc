@@ -724,8 +724,170 @@ trx_sys_create(void)
 	trx_sys = static_cast<trx_sys_t*>(mem_zalloc(sizeof(*trx_sys)));
 
 	mutex_create(trx_sys_mutex_key, &trx_sys->mutex, SYNC_TRX_SYS);
+
+#ifdef TRX_SYS_RW_SLOTS
+	/* Every connection can have one active read-write transaction.
+	Any transactions beyond this are handled by rw_slots_overflow. */
+	trx_sys->rw_slots_max = ut_max(srv_max_n_threads, 1000);
+	trx_sys->rw_slots = static_cast<trx_rw_slot_t*>(
+		ut_malloc(trx_sys->rw_slots_max * sizeof *trx_sys->rw_slots));
+	trx_sys->rw_slots_free = ULINT_UNDEFINED;
+#endif /* TRX_SYS_RW_SLOTS */
+}
+
+#ifdef TRX_SYS_RW_SLOTS
+/*****************************************************************//**
+Registers a read-write transaction in trx_sys->rw_slots. This must be
+called before trx_sys->max_trx_id is incremented past the id. */
+UNIV_INTERN
+void
+trx_sys_rw_slot_register(
+/*=====================*/
+	trx_t*		trx,	/*!< in/out: transaction */
+	trx_id_t	id)	/*!< in: the id that trx is getting */
+{
+	trx_rw_slot_t*	slot;
+
+	ut_ad(mutex_own(&trx_sys->mutex) || srv_is_being_started);
+	ut_ad(trx->rw_slot == ULINT_UNDEFINED);
+
+	if (trx_sys->rw_slots_free != ULINT_UNDEFINED) {
+		trx->rw_slot = trx_sys->rw_slots_free;
+		slot = &trx_sys->rw_slots[trx->rw_slot];
+		trx_sys->rw_slots_free = slot->next_free;
+	} else if (trx_sys->rw_slots_hwm < trx_sys->rw_slots_max) {
+		trx->rw_slot = trx_sys->rw_slots_hwm;
+		slot = &trx_sys->rw_slots[trx->rw_slot];
+		slot->id = 0;
+		/* The slot must be below rw_slots_hwm before the id
+		is filled in. */
+		os_atomic_increment_ulint(&trx_sys->rw_slots_hwm, 1);
+	} else {
+		os_atomic_increment_ulint(&trx_sys->rw_slots_overflow, 1);
+		return;
+	}
+
+	slot->no = TRX_ID_MAX;
+	slot->next_free = ULINT_UNDEFINED;
+
+	/* This is a full memory barrier: the id is visible before
+	trx_sys->max_trx_id moves past it. */
+	ut_a(os_compare_and_swap(&slot->id, 0, id));
 }
 
+/*****************************************************************//**
+Publishes the serialisation number of a registered transaction. This must
+be called before trx_sys->max_trx_id is incremented past the number. */
+UNIV_INTERN
+void
+trx_sys_rw_slot_set_no(
+/*===================*/
+	const trx_t*	trx,	/*!< in: transaction */
+	trx_id_t	no)	/*!< in: the number that trx is getting */
+{
+	ut_ad(mutex_own(&trx_sys->mutex) || srv_is_being_started);
+
+	if (trx->rw_slot != ULINT_UNDEFINED) {
+		trx_rw_slot_t*	slot = &trx_sys->rw_slots[trx->rw_slot];
+
+		ut_ad(slot->id == trx->id);
+
+		os_compare_and_swap(&slot->no, slot->no, no);
+	}
+}
+
+/*****************************************************************//**
+Starts the commit in memory of a transaction. The change of trx->state
+to TRX_STATE_COMMITTED_IN_MEMORY must be between this and
+trx_sys_rw_slot_clear(). */
+UNIV_INTERN
+void
+trx_sys_rw_slot_clear_start(
+/*========================*/
+	const trx_t*	trx)	/*!< in: transaction */
+{
+	if (!trx->read_only) {
+		os_atomic_increment_ulint(&trx_sys->rw_slots_clearing, 1);
+	}
+}
+
+/*****************************************************************//**
+Removes the id of a transaction from trx_sys->rw_slots when it is
+committed in memory. The slot stays reserved until
+trx_sys_rw_slot_free(). */
+UNIV_INTERN
+void
+trx_sys_rw_slot_clear(
+/*==================*/
+	const trx_t*	trx)	/*!< in: transaction */
+{
+	if (trx->read_only) {
+		return;
+	}
+
+	if (trx->rw_slot != ULINT_UNDEFINED) {
+		trx_rw_slot_t*	slot = &trx_sys->rw_slots[trx->rw_slot];
+
+		ut_ad(slot->id == trx->id);
+
+		slot->id = 0;
+	}
+
+	/* A read view that was made while the slot was cleared sees a
+	new version and is made again. */
+	os_atomic_increment_ulint(&trx_sys->rw_slots_cleared, 1);
+}
+
+/*****************************************************************//**
+Waits until no slot of trx_sys->rw_slots is being cleared.
+@return number of clears so far; a read view that is made before this
+changes sees the same transactions as other views made in between */
+UNIV_INTERN
+ulint
+trx_sys_rw_slots_version(void)
+/*==========================*/
+{
+	for (;;) {
+		ulint	cleared = trx_sys->rw_slots_cleared;
+
+		os_rmb;
+
+		if (trx_sys->rw_slots_clearing == cleared) {
+			return(cleared);
+		}
+
+		UT_RELAX_CPU();
+	}
+}
+
+/*****************************************************************//**
+Releases the slot of a transaction that is removed from
+trx_sys->rw_trx_list. */
+UNIV_INTERN
+void
+trx_sys_rw_slot_free(
+/*=================*/
+	trx_t*		trx)	/*!< in/out: transaction */
+{
+	ut_ad(mutex_own(&trx_sys->mutex) || srv_is_being_started);
+
+	if (trx->rw_slot == ULINT_UNDEFINED) {
+		ut_a(trx_sys->rw_slots_overflow > 0);
+		os_atomic_decrement_ulint(&trx_sys->rw_slots_overflow, 1);
+		return;
+	}
+
+	if (trx_sys->rw_slots[trx->rw_slot].id != 0) {
+		trx_sys_rw_slot_clear_start(trx);
+		trx_sys_rw_slot_clear(trx);
+	}
+
+	trx_sys->rw_slots[trx->rw_slot].next_free = trx_sys->rw_slots_free;
+	trx_sys->rw_slots_free = trx->rw_slot;
+	trx->rw_slot = ULINT_UNDEFINED;
+}
+#endif /* TRX_SYS_RW_SLOTS */
+
 /*****************************************************************//**
 Creates and initializes the transaction system at the database creation. */
 UNIV_INTERN
@@ -1364,6 +1526,10 @@ trx_sys_close(void)
 
 	mutex_free(&trx_sys->mutex);
 
+#ifdef TRX_SYS_RW_SLOTS
+	ut_free(trx_sys->rw_slots);
+#endif /* TRX_SYS_RW_SLOTS */
+
 	mem_free(trx_sys);
 
 	trx_sys = NULL;
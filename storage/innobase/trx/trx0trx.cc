@@ -121,6 +121,8 @@ trx_create(void)
 
 	trx->no = TRX_ID_MAX;
 
+	trx->rw_slot = ULINT_UNDEFINED;
+
 	trx->support_xa = TRUE;
 
 	trx->check_foreigns = TRUE;
@@ -201,7 +203,7 @@ trx_allocate_for_mysql(void)
 
 	mutex_enter(&trx_sys->mutex);
 
-	ut_d(trx->in_mysql_trx_list = TRUE);
+	trx->in_mysql_trx_list = TRUE;
 	UT_LIST_ADD_FIRST(mysql_trx_list, trx_sys->mysql_trx_list, trx);
 
 	mutex_exit(&trx_sys->mutex);
@@ -325,6 +327,9 @@ trx_free_prepared(
 
 	UT_LIST_REMOVE(trx_list, trx_sys->rw_trx_list, trx);
 	ut_d(trx->in_rw_trx_list = FALSE);
+#ifdef TRX_SYS_RW_SLOTS
+	trx_sys_rw_slot_free(trx);
+#endif /* TRX_SYS_RW_SLOTS */
 
 	/* Undo trx_resurrect_table_locks(). */
 	UT_LIST_INIT(trx->lock.trx_locks);
@@ -343,7 +348,7 @@ trx_free_for_mysql(
 	mutex_enter(&trx_sys->mutex);
 
 	ut_ad(trx->in_mysql_trx_list);
-	ut_d(trx->in_mysql_trx_list = FALSE);
+	trx->in_mysql_trx_list = FALSE;
 	UT_LIST_REMOVE(mysql_trx_list, trx_sys->mysql_trx_list, trx);
 
 	ut_ad(trx_sys_validate_trx_list());
@@ -754,6 +759,23 @@ trx_lists_init_at_db_start(void)
 			trx_resurrect_table_locks(trx, undo);
 		}
 	}
+
+#ifdef TRX_SYS_RW_SLOTS
+	/* Register the resurrected transactions now that their state
+	and number are known. */
+	for (trx_t* trx = UT_LIST_GET_FIRST(trx_sys->rw_trx_list);
+	     trx != NULL;
+	     trx = UT_LIST_GET_NEXT(trx_list, trx)) {
+
+		trx_sys_rw_slot_register(trx, trx->id);
+		trx_sys_rw_slot_set_no(trx, trx->no);
+
+		if (trx_state_eq(trx, TRX_STATE_COMMITTED_IN_MEMORY)) {
+			trx_sys_rw_slot_clear_start(trx);
+			trx_sys_rw_slot_clear(trx);
+		}
+	}
+#endif /* TRX_SYS_RW_SLOTS */
 }
 
 /******************************************************************//**
@@ -884,6 +906,12 @@ trx_start_low(
 
 	trx->state = TRX_STATE_ACTIVE;
 
+#ifdef TRX_SYS_RW_SLOTS
+	if (!trx->read_only) {
+		trx_sys_rw_slot_register(trx, trx_sys->max_trx_id);
+	}
+#endif /* TRX_SYS_RW_SLOTS */
+
 	trx->id = trx_sys_get_new_trx_id();
 
 	ut_ad(!trx->in_rw_trx_list);
@@ -939,6 +967,10 @@ trx_serialisation_number_get(
 
 	mutex_enter(&trx_sys->mutex);
 
+#ifdef TRX_SYS_RW_SLOTS
+	trx_sys_rw_slot_set_no(trx, trx_sys->max_trx_id);
+#endif /* TRX_SYS_RW_SLOTS */
+
 	trx->no = trx_sys_get_new_trx_id();
 
 	/* If the rollack segment is not empty then the
@@ -1235,6 +1267,9 @@ trx_commit_in_memory(
 		} else {
 			UT_LIST_REMOVE(trx_list, trx_sys->rw_trx_list, trx);
 			ut_d(trx->in_rw_trx_list = FALSE);
+#ifdef TRX_SYS_RW_SLOTS
+			trx_sys_rw_slot_free(trx);
+#endif /* TRX_SYS_RW_SLOTS */
 			MONITOR_INC(MONITOR_TRX_RW_COMMIT);
 		}
 
@@ -1480,6 +1515,9 @@ trx_cleanup_at_db_startup(
 
 	assert_trx_in_rw_list(trx);
 	ut_d(trx->in_rw_trx_list = FALSE);
+#ifdef TRX_SYS_RW_SLOTS
+	trx_sys_rw_slot_free(trx);
+#endif /* TRX_SYS_RW_SLOTS */
 
 	mutex_exit(&trx_sys->mutex);
 
@@ -1512,10 +1550,7 @@ trx_assign_read_view(
 
 	if (!trx->read_view) {
 
-		trx->read_view = read_view_open_now(
-			trx->id, trx->global_read_view_heap);
-
-		trx->global_read_view = trx->read_view;
+		trx->read_view = read_view_open_for_trx(trx);
 	}
 
 	return(trx->read_view);
@@ -44,6 +44,7 @@ C_MODE_END
 #include "key.h"
 #include "log.h"
 #include "sql_parse.h"
+#include "sql_show.h"
 
 /*
   Note that in future versions, only *transactional* Maria tables can
@@ -58,6 +59,7 @@ C_MODE_END
 #define THD_TRN (*(TRN **)thd_ha_data(thd, maria_hton))
 
 ulong pagecache_division_limit, pagecache_age_threshold, pagecache_file_hash_size;
+ulong pagecache_segments;
 ulonglong pagecache_buffer_size;
 const char *zerofill_error_msg=
   "Table is from another system and must be zerofilled or repaired to be "
@@ -255,6 +257,16 @@ static MYSQL_SYSVAR_ULONG(pagecache_file_hash_size, pagecache_file_hash_size,
        "value is probably 1/10 of number of possible open Aria files.", 0,0,
        512, 128, 16384, 1);
 
+static MYSQL_SYSVAR_ULONG(pagecache_segments, pagecache_segments,
+       PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+       "Number of independent segments of the page cache, each with "
+       "1/pagecache_segments of the buffer and its own lock. A page is "
+       "cached in the segment chosen by its file and page number. More "
+       "segments mean less contention when many threads use Aria tables, "
+       "like internal temporary tables. Fewer segments are used, with a "
+       "warning, if a segment would get less than 128 pages", 0, 0,
+       1, 1, MAX_PAGECACHE_SEGMENTS, 1);
+
 static MYSQL_SYSVAR_SET(recover, maria_recover_options, PLUGIN_VAR_OPCMDARG,
        "Specifies how corrupted tables should be automatically repaired",
        NULL, NULL, HA_RECOVER_DEFAULT, &maria_recover_typelib);
@@ -3573,10 +3585,11 @@ static int ha_maria_init(void *p)
   res= maria_upgrade() || maria_init() || ma_control_file_open(TRUE, TRUE) ||
     ((force_start_after_recovery_failures != 0) &&
      mark_recovery_start(log_dir)) ||
-    !init_pagecache(maria_pagecache,
-                    (size_t) pagecache_buffer_size, pagecache_division_limit,
-                    pagecache_age_threshold, maria_block_size, pagecache_file_hash_size,
-                    0) ||
+    !init_segmented_pagecache(maria_pagecache, pagecache_segments,
+                              (size_t) pagecache_buffer_size,
+                              pagecache_division_limit,
+                              pagecache_age_threshold, maria_block_size,
+                              pagecache_file_hash_size, 0) ||
     !init_pagecache(maria_log_pagecache,
                     TRANSLOG_PAGECACHE_SIZE, 0, 0,
                     TRANSLOG_PAGE_SIZE, 0, 0) ||
@@ -3590,8 +3603,20 @@ static int ha_maria_init(void *p)
   maria_multi_threaded= maria_in_ha_maria= TRUE;
   maria_create_trn_hook= maria_create_trn_for_mysql;
   maria_pagecache->extra_debug= 1;
+  for (uint i= 0; i < maria_pagecache->segments; i++)
+    maria_pagecache->segment[i].extra_debug= 1;
   maria_assert_if_crashed_table= debug_assert_if_crashed_table;
 
+  /* A page cache too small for the segments asked for gets fewer */
+  if (!res && MY_MAX(maria_pagecache->segments, 1) != pagecache_segments)
+  {
+    sql_print_warning("Aria: aria_pagecache_segments is set to %u, the page "
+                      "cache is too small for %lu segments",
+                      MY_MAX(maria_pagecache->segments, 1),
+                      pagecache_segments);
+    pagecache_segments= MY_MAX(maria_pagecache->segments, 1);
+  }
+
 #if defined(HAVE_REALPATH) && !defined(HAVE_valgrind) && !defined(HAVE_BROKEN_REALPATH)
   /*  We can only test for sub paths if my_symlink.c is using realpath */
   maria_test_invalid_symlink= test_if_data_home_dir;
@@ -3696,6 +3721,7 @@ struct st_mysql_sys_var* system_variables[]= {
   MYSQL_SYSVAR(pagecache_buffer_size),
   MYSQL_SYSVAR(pagecache_division_limit),
   MYSQL_SYSVAR(pagecache_file_hash_size),
+  MYSQL_SYSVAR(pagecache_segments),
   MYSQL_SYSVAR(recover),
   MYSQL_SYSVAR(repair_threads),
   MYSQL_SYSVAR(sort_buffer_size),
@@ -3819,18 +3845,142 @@ static void update_log_file_size(MYSQL_THD thd,
 }
 
 
+/**
+  The page cache status variables, summed over the segments of the
+  page cache.  They are computed into buff, which is valid while the
+  returned array is shown.
+*/
+
+static int show_pagecache_vars(THD *thd, SHOW_VAR *var, char *buff,
+                               enum enum_var_type scope)
+{
+  struct st_show_pagecache
+  {
+    PAGECACHE_STATISTICS stats;
+    SHOW_VAR vars[8];
+  } *show= (struct st_show_pagecache*) buff;
+  PAGECACHE_STATISTICS *stats= &show->stats;
+  const SHOW_VAR vars[]= {
+    {"blocks_not_flushed", (char*) &stats->blocks_changed, SHOW_LONGLONG},
+    {"blocks_unused",      (char*) &stats->blocks_unused, SHOW_LONGLONG},
+    {"blocks_used",        (char*) &stats->blocks_used, SHOW_LONGLONG},
+    {"read_requests",      (char*) &stats->read_requests, SHOW_LONGLONG},
+    {"reads",              (char*) &stats->reads, SHOW_LONGLONG},
+    {"write_requests",     (char*) &stats->write_requests, SHOW_LONGLONG},
+    {"writes",             (char*) &stats->writes, SHOW_LONGLONG},
+    {NullS, NullS, SHOW_LONG}
+  };
+  compile_time_assert(sizeof(*show) <= SHOW_VAR_FUNC_BUFF_SIZE);
+  compile_time_assert(sizeof(vars) == sizeof(show->vars));
+
+  get_pagecache_statistics(maria_pagecache, 0, stats);
+  memcpy(show->vars, vars, sizeof(vars));
+  var->type= SHOW_ARRAY;
+  var->value= (char*) show->vars;
+  return 0;
+}
+
 SHOW_VAR status_variables[]= {
-  {"pagecache_blocks_not_flushed", (char*) &maria_pagecache_var.global_blocks_changed, SHOW_LONG},
-  {"pagecache_blocks_unused",      (char*) &maria_pagecache_var.blocks_unused, SHOW_LONG},
-  {"pagecache_blocks_used",        (char*) &maria_pagecache_var.blocks_used, SHOW_LONG},
-  {"pagecache_read_requests",      (char*) &maria_pagecache_var.global_cache_r_requests, SHOW_LONGLONG},
-  {"pagecache_reads",              (char*) &maria_pagecache_var.global_cache_read, SHOW_LONGLONG},
-  {"pagecache_write_requests",     (char*) &maria_pagecache_var.global_cache_w_requests, SHOW_LONGLONG},
-  {"pagecache_writes",             (char*) &maria_pagecache_var.global_cache_write, SHOW_LONGLONG},
+  {"pagecache",                    (char*) &show_pagecache_vars, SHOW_FUNC},
   {"transaction_log_syncs",        (char*) &translog_syncs, SHOW_LONGLONG},
   {NullS, NullS, SHOW_LONG}
 };
 
+
+/****************************************************************************
+ * INFORMATION_SCHEMA.ARIA_PAGECACHE_STATS: the page cache and its segments
+ ***************************************************************************/
+
+static ST_FIELD_INFO pagecache_fields_info[]=
+{
+  {"SEGMENTS", 3, MYSQL_TYPE_LONG, 0,
+   (MY_I_S_MAYBE_NULL | MY_I_S_UNSIGNED), 0, SKIP_OPEN_TABLE},
+  {"SEGMENT_NUMBER", 3, MYSQL_TYPE_LONG, 0,
+   (MY_I_S_MAYBE_NULL | MY_I_S_UNSIGNED), 0, SKIP_OPEN_TABLE},
+  {"FULL_SIZE", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
+   (MY_I_S_UNSIGNED), 0, SKIP_OPEN_TABLE},
+  {"BLOCK_SIZE", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
+   (MY_I_S_UNSIGNED), 0, SKIP_OPEN_TABLE},
+  {"USED_BLOCKS", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
+   (MY_I_S_UNSIGNED), 0, SKIP_OPEN_TABLE},
+  {"UNUSED_BLOCKS", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
+   (MY_I_S_UNSIGNED), 0, SKIP_OPEN_TABLE},
+  {"DIRTY_BLOCKS", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
+   (MY_I_S_UNSIGNED), 0, SKIP_OPEN_TABLE},
+  {"READ_REQUESTS", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
+   (MY_I_S_UNSIGNED), 0, SKIP_OPEN_TABLE},
+  {"READS", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
+   (MY_I_S_UNSIGNED), 0, SKIP_OPEN_TABLE},
+  {"WRITE_REQUESTS", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
+   (MY_I_S_UNSIGNED), 0, SKIP_OPEN_TABLE},
+  {"WRITES", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
+   (MY_I_S_UNSIGNED), 0, SKIP_OPEN_TABLE},
+  {0, 0, MYSQL_TYPE_STRING, 0, 0, 0, SKIP_OPEN_TABLE}
+};
+
+
+static int store_pagecache_record(THD *thd, TABLE *table, uint segment_no)
+{
+  PAGECACHE_STATISTICS stats;
+  uint segments= maria_pagecache->segments;
+
+  get_pagecache_statistics(maria_pagecache, segment_no, &stats);
+  restore_record(table, s->default_values);
+  if (segments)
+  {
+    table->field[0]->set_notnull();
+    table->field[0]->store((long) segments, TRUE);
+  }
+  if (segment_no)
+  {
+    table->field[1]->set_notnull();
+    table->field[1]->store((long) segment_no, TRUE);
+  }
+  table->field[2]->store(stats.mem_size, TRUE);
+  table->field[3]->store(stats.block_size, TRUE);
+  table->field[4]->store(stats.blocks_used, TRUE);
+  table->field[5]->store(stats.blocks_unused, TRUE);
+  table->field[6]->store(stats.blocks_changed, TRUE);
+  table->field[7]->store(stats.read_requests, TRUE);
+  table->field[8]->store(stats.reads, TRUE);
+  table->field[9]->store(stats.write_requests, TRUE);
+  table->field[10]->store(stats.writes, TRUE);
+  return schema_table_store_record(thd, table);
+}
+
+
+/**
+  One row for each segment of the page cache, and one for the whole
+  page cache, as in INFORMATION_SCHEMA.KEY_CACHES
+*/
+
+static int fill_pagecache(THD *thd, TABLE_LIST *tables, COND *cond)
+{
+  TABLE *table= tables->table;
+  DBUG_ENTER("fill_pagecache");
+
+  if (!maria_hton || !maria_pagecache->inited)
+    DBUG_RETURN(0);
+  for (uint i= 1; i <= maria_pagecache->segments; i++)
+  {
+    if (store_pagecache_record(thd, table, i))
+      DBUG_RETURN(1);
+  }
+  DBUG_RETURN(store_pagecache_record(thd, table, 0));
+}
+
+
+static int init_pagecache_schema_table(void *p)
+{
+  ST_SCHEMA_TABLE *schema= (ST_SCHEMA_TABLE*) p;
+  schema->fields_info= pagecache_fields_info;
+  schema->fill_table= fill_pagecache;
+  return 0;
+}
+
+static struct st_mysql_information_schema pagecache_schema_table=
+{ MYSQL_INFORMATION_SCHEMA_INTERFACE_VERSION };
+
 /****************************************************************************
  * Maria MRR implementation: use DS-MRR
  ***************************************************************************/
@@ -3928,5 +4078,20 @@ maria_declare_plugin(aria)
   system_variables,             /* system variables */
   "1.5",                        /* string version   */
   MariaDB_PLUGIN_MATURITY_STABLE /* maturity         */
+},
+{
+  MYSQL_INFORMATION_SCHEMA_PLUGIN,
+  &pagecache_schema_table,
+  "ARIA_PAGECACHE_STATS",
+  "MariaDB Corporation",
+  "Statistics of the Aria page cache and its segments",
+  PLUGIN_LICENSE_GPL,
+  init_pagecache_schema_table,  /* Plugin Init      */
+  NULL,                         /* Plugin Deinit    */
+  0x0100,                       /* 1.0              */
+  NULL,                         /* status variables */
+  NULL,                         /* system variables */
+  "1.0",                        /* string version   */
+  MariaDB_PLUGIN_MATURITY_GAMMA /* maturity         */
 }
 maria_declare_plugin_end;
@@ -6327,12 +6327,15 @@ uint _ma_apply_redo_insert_row_head_or_tail(MARIA_HA *info, LSN lsn,
     unlock_method= PAGECACHE_LOCK_LEFT_WRITELOCKED;
     unpin_method=  PAGECACHE_PIN_LEFT_PINNED;
 
-    share->pagecache->readwrite_flags&= ~MY_WME;
+    pagecache_set_readwrite_flags(share->pagecache,
+                                  share->pagecache->readwrite_flags &
+                                  ~MY_WME);
     buff= pagecache_read(share->pagecache, &info->dfile,
                          page, 0, 0,
                          PAGECACHE_PLAIN_PAGE, PAGECACHE_LOCK_WRITE,
                          &page_link.link);
-    share->pagecache->readwrite_flags= share->pagecache->org_readwrite_flags;
+    pagecache_set_readwrite_flags(share->pagecache,
+                                  share->pagecache->org_readwrite_flags);
     if (!buff)
     {
       /* Skip errors when reading outside of file and uninitialized pages */
@@ -6827,14 +6830,17 @@ uint _ma_apply_redo_insert_row_blobs(MARIA_HA *info,
         }
         else
         {
-          share->pagecache->readwrite_flags&= ~MY_WME;
+          pagecache_set_readwrite_flags(share->pagecache,
+                                        share->pagecache->readwrite_flags &
+                                        ~MY_WME);
           buff= pagecache_read(share->pagecache,
                                &info->dfile,
                                page, 0, 0,
                                PAGECACHE_PLAIN_PAGE,
                                PAGECACHE_LOCK_WRITE, &page_link.link);
-          share->pagecache->readwrite_flags= share->pagecache->
-            org_readwrite_flags;
+          pagecache_set_readwrite_flags(share->pagecache,
+                                        share->pagecache->
+                                        org_readwrite_flags);
           if (!buff)
           {
             if (my_errno != HA_ERR_FILE_TOO_SHORT &&
@@ -522,6 +522,16 @@ filter_flush_file_evenly(enum pagecache_page_type type,
 }
 
 
+/** @brief Number of pages written by the page cache, in all its segments */
+
+static ulonglong pagecache_writes(void)
+{
+  PAGECACHE_STATISTICS stats;
+  get_pagecache_statistics(maria_pagecache, 0, &stats);
+  return stats.writes;
+}
+
+
 /**
    @brief Background thread which does checkpoints and flushes periodically.
 
@@ -551,8 +561,7 @@ pthread_handler_t ma_checkpoint_background(void *arg)
   uint sleeps, sleep_time;
   TRANSLOG_ADDRESS log_horizon_at_last_checkpoint=
     translog_get_horizon();
-  ulonglong pagecache_flushes_at_last_checkpoint=
-    maria_pagecache->global_cache_write;
+  ulonglong pagecache_flushes_at_last_checkpoint= pagecache_writes();
   uint UNINIT_VAR(pages_bunch_size);
   struct st_filter_param filter_param;
   PAGECACHE_FILE *UNINIT_VAR(dfile); /**< data file currently being flushed */
@@ -607,7 +616,7 @@ pthread_handler_t ma_checkpoint_background(void *arg)
         */
         if ((ulonglong) (horizon - log_horizon_at_last_checkpoint) <=
             maria_checkpoint_min_log_activity &&
-            ((ulonglong) (maria_pagecache->global_cache_write -
+            ((ulonglong) (pagecache_writes() -
                           pagecache_flushes_at_last_checkpoint) *
              maria_pagecache->block_size) <=
             maria_checkpoint_min_cache_activity)
@@ -626,8 +635,7 @@ pthread_handler_t ma_checkpoint_background(void *arg)
           below is possibly greater than last_checkpoint_lsn.
         */
         log_horizon_at_last_checkpoint= translog_get_horizon();
-        pagecache_flushes_at_last_checkpoint=
-          maria_pagecache->global_cache_write;
+        pagecache_flushes_at_last_checkpoint= pagecache_writes();
         /*
           If the checkpoint above succeeded it has set d|kfiles and
           d|kfiles_end. If is has failed, it has set
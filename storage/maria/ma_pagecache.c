@@ -129,6 +129,9 @@ my_bool my_disable_flush_pagecache_blocks= 0;
 #define  COND_FOR_WRLOCK    2  /* queue of write lock */
 #define  COND_SIZE          3  /* number of COND_* queues */
 
+/* Minimum number of blocks in a segment of a segmented page cache */
+#define PAGECACHE_MIN_SEGMENT_BLOCKS 128
+
 typedef mysql_cond_t KEYCACHE_CONDVAR;
 
 /* descriptor of the page in the page cache block buffer */
@@ -713,6 +716,33 @@ static inline uint next_power(uint value)
 }
 
 
+/*
+  The segment of a segmented page cache that caches the page, or the
+  page cache itself if it is not segmented.  As in a partitioned key
+  cache, consecutive pages of a file go to different segments.
+*/
+
+static inline PAGECACHE *pagecache_segment(PAGECACHE *pagecache,
+                                           PAGECACHE_FILE *file,
+                                           pgcache_page_no_t pageno)
+{
+  if (!pagecache->segments)
+    return pagecache;
+  return (pagecache->segment +
+          (uint) ((pageno + (uint) file->file) % pagecache->segments));
+}
+
+
+/* The segment of a block that is pinned or locked by the caller */
+
+static inline PAGECACHE *pagecache_block_segment(PAGECACHE *pagecache,
+                                                 PAGECACHE_BLOCK_LINK *block)
+{
+  return pagecache_segment(pagecache, &block->hash_link->file,
+                           block->hash_link->pageno);
+}
+
+
 /*
   Initialize a page cache
 
@@ -906,6 +936,88 @@ ulong init_pagecache(PAGECACHE *pagecache, size_t use_mem,
 }
 
 
+/*
+  Initialize a segmented page cache
+
+  SYNOPSIS
+    init_segmented_pagecache()
+    pagecache			pointer to a page cache data structure
+    segments			number of segments
+    other parameters		as for init_pagecache()
+
+  RETURN VALUE
+    number of blocks in all segments, if successful,
+    0 - otherwise.
+
+  NOTES.
+    use_mem is divided evenly between the segments, each of which is a
+    page cache with its own cache_lock.  Fewer segments are used if a
+    segment would get less than PAGECACHE_MIN_SEGMENT_BLOCKS blocks.
+    With 1 segment this is init_pagecache().
+*/
+
+ulong init_segmented_pagecache(PAGECACHE *pagecache, uint segments,
+                               size_t use_mem, uint division_limit,
+                               uint age_threshold, uint block_size,
+                               uint changed_blocks_hash_size,
+                               myf my_readwrite_flags)
+{
+  ulong blocks= 0;
+  uint i;
+  DBUG_ENTER("init_segmented_pagecache");
+
+  segments= (uint) MY_MIN(MY_MIN(segments, MAX_PAGECACHE_SEGMENTS),
+                          use_mem / ((size_t) block_size *
+                                     PAGECACHE_MIN_SEGMENT_BLOCKS));
+  if (segments <= 1)
+    DBUG_RETURN(init_pagecache(pagecache, use_mem, division_limit,
+                               age_threshold, block_size,
+                               changed_blocks_hash_size, my_readwrite_flags));
+  if (pagecache->inited)
+  {
+    DBUG_PRINT("warning",("key cache already in use"));
+    DBUG_RETURN(0);
+  }
+
+  if (!(pagecache->segment= (PAGECACHE*) my_malloc(sizeof(PAGECACHE) *
+                                                   segments,
+                                                   MYF(MY_WME |
+                                                       MY_ZEROFILL))))
+    DBUG_RETURN(0);
+  for (i= 0; i < segments; i++)
+  {
+    ulong segment_blocks;
+    if (!(segment_blocks= init_pagecache(pagecache->segment + i,
+                                         use_mem / segments, division_limit,
+                                         age_threshold, block_size,
+                                         changed_blocks_hash_size,
+                                         my_readwrite_flags)))
+    {
+      do
+        end_pagecache(pagecache->segment + i, 1);
+      while (i--);
+      my_free(pagecache->segment);
+      pagecache->segment= NULL;
+      DBUG_RETURN(0);
+    }
+    blocks+= segment_blocks;
+  }
+
+  pagecache->segments= segments;
+  pagecache->mem_size= use_mem;
+  pagecache->block_size= block_size;
+  pagecache->shift= my_bit_log2(block_size);
+  pagecache->readwrite_flags= pagecache->segment->readwrite_flags;
+  pagecache->org_readwrite_flags= pagecache->readwrite_flags;
+  pagecache->changed_blocks_hash_size=
+    pagecache->segment->changed_blocks_hash_size;
+  pagecache->disk_blocks= pagecache->blocks= (long) blocks;
+  pagecache->inited= pagecache->can_be_used= 1;
+  DBUG_PRINT("exit", ("segments: %u  blocks: %lu", segments, blocks));
+  DBUG_RETURN(blocks);
+}
+
+
 /*
   Flush all blocks in the key cache to disk
 */
@@ -967,6 +1079,9 @@ static int flush_all_key_blocks(PAGECACHE *pagecache)
     performing operations with the key cache let her to proceed
     (when cnt_for_resize=0).
 
+    Each segment of a segmented page cache is resized on its own, to
+    use_mem divided by the number of segments.
+
      Before being usable, this function needs:
      - to receive fixes for BUG#17332 "changing key_buffer_size on a running
      server can crash under load" similar to those done to the key cache
@@ -987,6 +1102,26 @@ ulong resize_pagecache(PAGECACHE *pagecache,
   if (!pagecache->inited)
     DBUG_RETURN(pagecache->disk_blocks);
 
+  if (pagecache->segments)
+  {
+    uint i;
+    my_bool failed= 0;
+    blocks= 0;
+    for (i= 0; i < pagecache->segments; i++)
+    {
+      ulong segment_blocks= resize_pagecache(pagecache->segment + i,
+                                             use_mem / pagecache->segments,
+                                             division_limit, age_threshold,
+                                             changed_blocks_hash_size);
+      if (!segment_blocks)
+        failed= 1;
+      blocks+= segment_blocks;
+    }
+    pagecache->mem_size= use_mem;
+    pagecache->disk_blocks= pagecache->blocks= (long) blocks;
+    DBUG_RETURN(failed ? 0 : blocks);
+  }
+
   if(use_mem == pagecache->mem_size)
   {
     change_pagecache_param(pagecache, division_limit, age_threshold);
@@ -1095,6 +1230,15 @@ void change_pagecache_param(PAGECACHE *pagecache, uint division_limit,
 {
   DBUG_ENTER("change_pagecache_param");
 
+  if (pagecache->segments)
+  {
+    uint i;
+    for (i= 0; i < pagecache->segments; i++)
+      change_pagecache_param(pagecache->segment + i, division_limit,
+                             age_threshold);
+    DBUG_VOID_RETURN;
+  }
+
   pagecache_pthread_mutex_lock(&pagecache->cache_lock);
   if (division_limit)
     pagecache->min_warm_blocks= (pagecache->disk_blocks *
@@ -1158,6 +1302,20 @@ void end_pagecache(PAGECACHE *pagecache, my_bool cleanup)
   if (!pagecache->inited)
     DBUG_VOID_RETURN;
 
+  if (pagecache->segments)
+  {
+    /* The segments are always freed completely */
+    uint i;
+    for (i= 0; i < pagecache->segments; i++)
+      end_pagecache(pagecache->segment + i, 1);
+    my_free(pagecache->segment);
+    pagecache->segment= NULL;
+    pagecache->segments= 0;
+    pagecache->disk_blocks= -1;
+    pagecache->inited= pagecache->can_be_used= 0;
+    DBUG_VOID_RETURN;
+  }
+
   if (pagecache->disk_blocks > 0)
   {
 #ifndef DBUG_OFF
@@ -2840,6 +2998,7 @@ void pagecache_unlock(PAGECACHE *pagecache,
   DBUG_ASSERT(pin != PAGECACHE_PIN);
   DBUG_ASSERT(lock != PAGECACHE_LOCK_READ && lock != PAGECACHE_LOCK_WRITE);
 
+  pagecache= pagecache_segment(pagecache, file, pageno);
   pagecache_pthread_mutex_lock(&pagecache->cache_lock);
   /*
     As soon as we keep lock cache can be used, and we have lock because want
@@ -2929,6 +3088,7 @@ void pagecache_unpin(PAGECACHE *pagecache,
   DBUG_ENTER("pagecache_unpin");
   DBUG_PRINT("enter", ("fd: %u  page: %lu",
                        (uint) file->file, (ulong) pageno));
+  pagecache= pagecache_segment(pagecache, file, pageno);
   pagecache_pthread_mutex_lock(&pagecache->cache_lock);
   /*
     As soon as we keep lock cache can be used, and we have lock bacause want
@@ -3018,6 +3178,7 @@ void pagecache_unlock_by_link(PAGECACHE *pagecache,
   DBUG_ASSERT(pin != PAGECACHE_PIN_LEFT_UNPINNED);
   DBUG_ASSERT(lock != PAGECACHE_LOCK_READ);
   DBUG_ASSERT(lock != PAGECACHE_LOCK_WRITE);
+  pagecache= pagecache_block_segment(pagecache, block);
   pagecache_pthread_mutex_lock(&pagecache->cache_lock);
   if (pin == PAGECACHE_PIN_LEFT_UNPINNED &&
       lock == PAGECACHE_LOCK_READ_UNLOCK)
@@ -3122,6 +3283,7 @@ void pagecache_unpin_by_link(PAGECACHE *pagecache,
                        (uint) block->hash_link->file.file,
                        (ulong) block->hash_link->pageno));
 
+  pagecache= pagecache_block_segment(pagecache, block);
   pagecache_pthread_mutex_lock(&pagecache->cache_lock);
   /*
     As soon as we keep lock cache can be used, and we have lock because want
@@ -3356,6 +3518,7 @@ uchar *pagecache_read(PAGECACHE *pagecache,
   DBUG_ASSERT(pageno < ((1ULL) << 40));
 #endif
 
+  pagecache= pagecache_segment(pagecache, file, pageno);
   if (!page_link)
     page_link= &fake_link;
   *page_link= 0;                                 /* Catch errors */
@@ -3679,6 +3842,7 @@ my_bool pagecache_delete_by_link(PAGECACHE *pagecache,
               lock == PAGECACHE_LOCK_LEFT_WRITELOCKED);
   DBUG_ASSERT(block->pins != 0); /* should be pinned */
 
+  pagecache= pagecache_block_segment(pagecache, block);
   if (pagecache->can_be_used)
   {
     pagecache_pthread_mutex_lock(&pagecache->cache_lock);
@@ -3791,6 +3955,7 @@ my_bool pagecache_delete(PAGECACHE *pagecache,
               lock == PAGECACHE_LOCK_LEFT_WRITELOCKED);
   DBUG_ASSERT(pin == PAGECACHE_PIN ||
               pin == PAGECACHE_PIN_LEFT_PINNED);
+  pagecache= pagecache_segment(pagecache, file, pageno);
 restart:
 
   DBUG_ASSERT(pageno < ((1ULL) << 40));
@@ -3976,6 +4141,7 @@ my_bool pagecache_write_part(PAGECACHE *pagecache,
   DBUG_ASSERT(pageno < ((1ULL) << 40));
 #endif
 
+  pagecache= pagecache_segment(pagecache, file, pageno);
   if (!page_link)
     page_link= &fake_link;
   *page_link= 0;
@@ -4796,6 +4962,25 @@ int flush_pagecache_blocks_with_filter(PAGECACHE *pagecache,
 
   if (pagecache->disk_blocks <= 0)
     DBUG_RETURN(0);
+  if (pagecache->segments)
+  {
+    /* The pages of the file are in all segments */
+    uint i;
+    int first_errno= 0;
+    res= PCFLUSH_OK;
+    for (i= 0; i < pagecache->segments; i++)
+    {
+      int segment_res= flush_pagecache_blocks_with_filter(pagecache->segment +
+                                                          i, file, type,
+                                                          filter, filter_arg);
+      if ((segment_res & PCFLUSH_ERROR) && !first_errno)
+        first_errno= my_errno;
+      res|= segment_res;
+    }
+    if (first_errno)
+      my_errno= first_errno;                   /* Return first error */
+    DBUG_RETURN(res);
+  }
   pagecache_pthread_mutex_lock(&pagecache->cache_lock);
   inc_counter_for_resize_op(pagecache);
   res= flush_pagecache_blocks_int(pagecache, file, type, filter, filter_arg);
@@ -4832,6 +5017,12 @@ int reset_pagecache_counters(const char *name __attribute__((unused)),
   }
   DBUG_PRINT("info", ("Resetting counters for key cache %s.", name));
 
+  if (pagecache->segments)
+  {
+    uint i;
+    for (i= 0; i < pagecache->segments; i++)
+      reset_pagecache_counters(name, pagecache->segment + i);
+  }
   pagecache->global_blocks_changed= 0;   /* Key_blocks_not_flushed */
   pagecache->global_cache_r_requests= 0; /* Key_read_requests */
   pagecache->global_cache_read= 0;       /* Key_reads */
@@ -4841,6 +5032,75 @@ int reset_pagecache_counters(const char *name __attribute__((unused)),
 }
 
 
+/*
+  Get the statistics of a page cache
+
+  SYNOPSIS
+    get_pagecache_statistics()
+    pagecache           pointer to the page cache
+    segment_no          segment number to get statistics for, counting
+                        from 1, or 0 for the whole page cache
+    stats         OUT   pointer to the structure for the statistics
+
+  NOTES
+    As for the key cache, the counters are read without cache_lock.
+*/
+
+void get_pagecache_statistics(PAGECACHE *pagecache, uint segment_no,
+                              PAGECACHE_STATISTICS *stats)
+{
+  PAGECACHE *segment, *end;
+  DBUG_ENTER("get_pagecache_statistics");
+
+  bzero(stats, sizeof(*stats));
+  stats->mem_size= pagecache->mem_size;
+  stats->block_size= pagecache->block_size;
+  if (!pagecache->segments)
+  {
+    DBUG_ASSERT(segment_no <= 1);
+    segment= pagecache;
+    end= segment + 1;
+  }
+  else if (segment_no)
+  {
+    DBUG_ASSERT(segment_no <= pagecache->segments);
+    segment= pagecache->segment + segment_no - 1;
+    end= segment + 1;
+    stats->mem_size= segment->mem_size;
+  }
+  else
+  {
+    segment= pagecache->segment;
+    end= segment + pagecache->segments;
+  }
+  for (; segment < end; segment++)
+  {
+    stats->blocks_used+= segment->blocks_used;
+    stats->blocks_unused+= segment->blocks_unused;
+    stats->blocks_changed+= segment->global_blocks_changed;
+    stats->read_requests+= segment->global_cache_r_requests;
+    stats->reads+= segment->global_cache_read;
+    stats->write_requests+= segment->global_cache_w_requests;
+    stats->writes+= segment->global_cache_write;
+  }
+  DBUG_VOID_RETURN;
+}
+
+
+/*
+  Change the flags of the pread()/pwrite() calls of a page cache, in all
+  of its segments.  Only used when no other thread uses the page cache.
+*/
+
+void pagecache_set_readwrite_flags(PAGECACHE *pagecache, myf flags)
+{
+  uint i;
+  pagecache->readwrite_flags= flags;
+  for (i= 0; i < pagecache->segments; i++)
+    pagecache->segment[i].readwrite_flags= flags;
+}
+
+
 /**
    @brief Allocates a buffer and stores in it some info about all dirty pages
 
@@ -4861,16 +5121,16 @@ int reset_pagecache_counters(const char *name __attribute__((unused)),
      @retval 1      Error
 */
 
-my_bool pagecache_collect_changed_blocks_with_lsn(PAGECACHE *pagecache,
-                                                  LEX_STRING *str,
-                                                  LSN *min_rec_lsn)
+static my_bool collect_changed_blocks_with_lsn(PAGECACHE *pagecache,
+                                              LEX_STRING *str,
+                                              LSN *min_rec_lsn)
 {
   my_bool error= 0;
   ulong stored_list_size= 0;
   uint file_hash;
   char *ptr;
   LSN minimum_rec_lsn= LSN_MAX;
-  DBUG_ENTER("pagecache_collect_changed_blocks_with_LSN");
+  DBUG_ENTER("collect_changed_blocks_with_lsn");
 
   DBUG_ASSERT(NULL == str->str);
   /*
@@ -4994,6 +5254,71 @@ my_bool pagecache_collect_changed_blocks_with_lsn(PAGECACHE *pagecache,
 }
 
 
+/**
+   @brief Allocates a buffer and stores in it some info about all dirty pages
+
+   See collect_changed_blocks_with_lsn().  The dirty pages of a segmented
+   page cache are collected one segment at a time.  A page that is made
+   dirty in a segment that was already visited has a rec_lsn after the
+   start of the checkpoint, like a page made dirty after the whole
+   (not segmented) page cache was visited.
+*/
+
+my_bool pagecache_collect_changed_blocks_with_lsn(PAGECACHE *pagecache,
+                                                  LEX_STRING *str,
+                                                  LSN *min_rec_lsn)
+{
+  LEX_STRING segment_str[MAX_PAGECACHE_SEGMENTS];
+  ulonglong stored_list_size= 0;
+  LSN minimum_rec_lsn= LSN_MAX;
+  my_bool error= 0;
+  uint i;
+  char *ptr;
+  DBUG_ENTER("pagecache_collect_changed_blocks_with_lsn");
+
+  if (!pagecache->segments)
+    DBUG_RETURN(collect_changed_blocks_with_lsn(pagecache, str,
+                                                min_rec_lsn));
+
+  DBUG_ASSERT(NULL == str->str);
+  str->length= 8;
+  for (i= 0; i < pagecache->segments; i++)
+    segment_str[i].str= NULL;
+  for (i= 0; i < pagecache->segments; i++)
+  {
+    LSN segment_min_rec_lsn;
+    if (collect_changed_blocks_with_lsn(pagecache->segment + i,
+                                        segment_str + i,
+                                        &segment_min_rec_lsn))
+      goto err;
+    stored_list_size+= uint8korr(segment_str[i].str);
+    str->length+= segment_str[i].length - 8;
+    if (cmp_translog_addr(segment_min_rec_lsn, minimum_rec_lsn) < 0)
+      minimum_rec_lsn= segment_min_rec_lsn;
+  }
+  if (NULL == (str->str= my_malloc(str->length, MYF(MY_WME))))
+    goto err;
+  ptr= str->str;
+  int8store(ptr, stored_list_size);
+  ptr+= 8;
+  for (i= 0; i < pagecache->segments; i++)
+  {
+    memcpy(ptr, segment_str[i].str + 8, segment_str[i].length - 8);
+    ptr+= segment_str[i].length - 8;
+  }
+  *min_rec_lsn= minimum_rec_lsn;
+
+end:
+  for (i= 0; i < pagecache->segments; i++)
+    my_free(segment_str[i].str);
+  DBUG_RETURN(error);
+
+err:
+  error= 1;
+  goto end;
+}
+
+
 #ifndef DBUG_OFF
 
 /**
@@ -5004,6 +5329,13 @@ void pagecache_file_no_dirty_page(PAGECACHE *pagecache, PAGECACHE_FILE *file)
 {
   File fd= file->file;
   PAGECACHE_BLOCK_LINK *block;
+  if (pagecache->segments)
+  {
+    uint i;
+    for (i= 0; i < pagecache->segments; i++)
+      pagecache_file_no_dirty_page(pagecache->segment + i, file);
+    return;
+  }
   for (block= pagecache->changed_blocks[FILE_HASH(*file, pagecache)];
        block != NULL;
        block= block->next_changed)
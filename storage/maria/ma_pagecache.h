@@ -107,6 +107,9 @@ typedef struct st_pagecache_hash_link PAGECACHE_HASH_LINK;
 /* Default size of hash for changed files */
 #define MIN_PAGECACHE_CHANGED_BLOCKS_HASH_SIZE 512
 
+/* Maximum number of segments of a page cache */
+#define MAX_PAGECACHE_SEGMENTS 64
+
 #define PAGECACHE_PRIORITY_LOW 0
 #define PAGECACHE_PRIORITY_DEFAULT 3
 #define PAGECACHE_PRIORITY_HIGH 6
@@ -178,8 +181,28 @@ typedef struct st_pagecache
   my_bool in_init;		/* Set to 1 in MySQL during init/resize     */
   my_bool extra_debug;	        /* set to 1 if one wants extra logging */
   HASH    files_in_flush;       /**< files in flush_pagecache_blocks_int() */
+  /*
+    A segmented page cache is split into independent page caches, each
+    with its own cache_lock. Only the parameters above are set in it.
+  */
+  uint segments;                 /* number of segments, 0 if not segmented  */
+  struct st_pagecache *segment;  /* the segments                            */
 } PAGECACHE;
 
+/* Statistics of a page cache or of one of its segments */
+typedef struct st_pagecache_statistics
+{
+  ulonglong mem_size;       /* memory for cache buffers/auxiliary structures */
+  ulonglong block_size;     /* size of the each buffers in the page cache    */
+  ulonglong blocks_used;    /* maximum number of used blocks/buffers         */
+  ulonglong blocks_unused;  /* number of currently unused blocks             */
+  ulonglong blocks_changed; /* number of currently dirty blocks              */
+  ulonglong read_requests;  /* number of read requests (read hits)           */
+  ulonglong reads;        /* number of actual reads from files into buffers  */
+  ulonglong write_requests; /* number of write requests (write hits)         */
+  ulonglong writes;       /* number of actual writes from buffers into files */
+} PAGECACHE_STATISTICS;
+
 /** @brief Return values for PAGECACHE_FLUSH_FILTER */
 enum pagecache_flush_filter_result
 {
@@ -200,6 +223,11 @@ extern ulong init_pagecache(PAGECACHE *pagecache, size_t use_mem,
                             uint division_limit, uint age_threshold,
                             uint block_size, uint changed_blocks_hash_size,
                             myf my_read_flags);
+extern ulong init_segmented_pagecache(PAGECACHE *pagecache, uint segments,
+                                      size_t use_mem, uint division_limit,
+                                      uint age_threshold, uint block_size,
+                                      uint changed_blocks_hash_size,
+                                      myf my_read_flags);
 extern ulong resize_pagecache(PAGECACHE *pagecache,
                               size_t use_mem, uint division_limit,
                               uint age_threshold, uint changed_blocks_hash_size);
@@ -304,6 +332,9 @@ extern my_bool pagecache_collect_changed_blocks_with_lsn(PAGECACHE *pagecache,
                                                          LEX_STRING *str,
                                                          LSN *min_lsn);
 extern int reset_pagecache_counters(const char *name, PAGECACHE *pagecache);
+extern void get_pagecache_statistics(PAGECACHE *pagecache, uint segment_no,
+                                     PAGECACHE_STATISTICS *stats);
+extern void pagecache_set_readwrite_flags(PAGECACHE *pagecache, myf flags);
 extern uchar *pagecache_block_link_to_buffer(PAGECACHE_BLOCK_LINK *block);
 
 extern uint pagecache_pagelevel(PAGECACHE_BLOCK_LINK *block);
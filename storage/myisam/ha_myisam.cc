@@ -671,7 +671,8 @@ ha_myisam::ha_myisam(handlerton *hton, TABLE_SHARE *table_arg)
                   HA_DUPLICATE_POS | HA_CAN_INDEX_BLOBS | HA_AUTO_PART_KEY |
                   HA_FILE_BASED | HA_CAN_GEOMETRY | HA_NO_TRANSACTIONS |
                   HA_CAN_INSERT_DELAYED | HA_CAN_BIT_FIELD | HA_CAN_RTREEKEYS |
-                  HA_HAS_RECORDS | HA_STATS_RECORDS_IS_EXACT | HA_CAN_REPAIR),
+                  HA_HAS_RECORDS | HA_STATS_RECORDS_IS_EXACT | HA_CAN_REPAIR |
+                  HA_CAN_PARALLEL_SCAN),
    can_enable_indexes(1)
 {}
 
@@ -1814,6 +1815,43 @@ int ha_myisam::rnd_next(uchar *buf)
   return error;
 }
 
+/*
+  With fixed length rows and no deleted rows every record slot of the
+  data file holds a row. The rows left out of the sample are skipped
+  by moving the scan position over a geometrically distributed number
+  of slots, without reading them.
+*/
+
+int ha_myisam::sample_next(uchar *buf, double fraction, ha_rows *skipped)
+{
+  int error;
+  THD *thd= ha_thd();
+  MYISAM_SHARE *share= file->s;
+
+  if (share->data_file_type != STATIC_RECORD || file->state->del ||
+      fraction >= 1.0)
+    return handler::sample_next(buf, fraction, skipped);
+
+  do
+  {
+    my_off_t reclength= share->base.pack_reclength;
+    my_off_t end= file->state->data_file_length;
+    ulonglong left= file->nextpos < end ? (end - file->nextpos) / reclength : 0;
+    double gap= floor(log(1.0 - my_rnd(&thd->rand)) / log(1.0 - fraction));
+    if (gap >= (double) left)
+    {
+      *skipped+= left;
+      file->nextpos= end;
+    }
+    else
+    {
+      *skipped+= (ha_rows) gap;
+      file->nextpos+= (ulonglong) gap * reclength;
+    }
+  } while ((error= ha_rnd_next(buf)) == HA_ERR_RECORD_DELETED);
+  return error;
+}
+
 int ha_myisam::remember_rnd_pos()
 {
   position((uchar*) 0);
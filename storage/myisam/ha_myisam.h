@@ -97,6 +97,7 @@ class ha_myisam: public handler
   int ft_read(uchar *buf);
   int rnd_init(bool scan);
   int rnd_next(uchar *buf);
+  int sample_next(uchar *buf, double fraction, ha_rows *skipped);
   int rnd_pos(uchar * buf, uchar *pos);
   int remember_rnd_pos();
   int restart_rnd_next(uchar *buf);
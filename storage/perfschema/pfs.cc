@@ -4787,6 +4787,7 @@ static void end_statement_v1(PSI_statement_locker *locker, void *stmt_da)
   */
   PSI_digest_storage *digest_storage= NULL;
   PFS_statement_stat *digest_stat= NULL;
+  PFS_thread *digest_thread= NULL;
 
   if (flags & STATE_FLAG_THREAD)
   {
@@ -4800,6 +4801,7 @@ static void end_statement_v1(PSI_statement_locker *locker, void *stmt_da)
     {
       digest_storage= &state->m_digest_state.m_digest_storage;
       /* Populate PFS_statements_digest_stat with computed digest information.*/
+      digest_thread= thread;
       digest_stat= find_or_create_digest(thread, digest_storage,
                                          state->m_schema_name,
                                          state->m_schema_name_length);
@@ -4872,6 +4874,7 @@ static void end_statement_v1(PSI_statement_locker *locker, void *stmt_da)
         /* Set digest stat. */
         digest_storage= &state->m_digest_state.m_digest_storage;
         /* Populate statements_digest_stat with computed digest information. */
+        digest_thread= thread;
         digest_stat= find_or_create_digest(thread, digest_storage,
                                            state->m_schema_name,
                                            state->m_schema_name_length);
@@ -4970,6 +4973,9 @@ static void end_statement_v1(PSI_statement_locker *locker, void *stmt_da)
     case Diagnostics_area::DA_DISABLED:
       break;
   }
+
+  if (digest_stat != NULL)
+    release_digest_stat(digest_thread);
 }
 
 /**
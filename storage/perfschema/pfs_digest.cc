@@ -60,9 +60,13 @@
 
 ulong digest_max= 0;
 ulong digest_lost= 0;
+/** Size of the digest caches of all threads. */
+ulong digest_cache_max= 0;
 
 /** EVENTS_STATEMENTS_HISTORY_LONG circular buffer. */
 PFS_statements_digest_stat *statements_digest_stat_array= NULL;
+/** Digest caches of all threads, DIGEST_CACHE_SIZE entries per thread. */
+static PFS_digest_cache_entry *digest_cache_array= NULL;
 /** Consumer flag for table EVENTS_STATEMENTS_SUMMARY_BY_DIGEST. */
 bool flag_statements_digest= true;
 /**
@@ -88,6 +92,7 @@ int init_digest(const PFS_global_param *param)
   */
   digest_max= param->m_digest_sizing;
   digest_lost= 0;
+  digest_cache_max= 0;
 
   if (digest_max == 0)
     return 0;
@@ -103,6 +108,28 @@ int init_digest(const PFS_global_param *param)
     statements_digest_stat_array[index].reset_data();
   }
 
+  /* The threads are allocated by init_instruments(). */
+  digest_cache_max= thread_max * DIGEST_CACHE_SIZE;
+  if (digest_cache_max == 0)
+    return 0;
+
+  digest_cache_array=
+    PFS_MALLOC_ARRAY(digest_cache_max, PFS_digest_cache_entry,
+                     MYF(MY_ZEROFILL));
+  if (unlikely(digest_cache_array == NULL))
+    return 1;
+
+  for (index= 0; index < digest_cache_max; index++)
+  {
+    digest_cache_array[index].m_stat.reset();
+  }
+
+  for (index= 0; index < thread_max; index++)
+  {
+    thread_array[index].m_digest_cache=
+      &digest_cache_array[index * DIGEST_CACHE_SIZE];
+  }
+
   return 0;
 }
 
@@ -112,6 +139,9 @@ void cleanup_digest(void)
   /*  Free memory allocated to statements_digest_stat_array. */
   pfs_free(statements_digest_stat_array);
   statements_digest_stat_array= NULL;
+  pfs_free(digest_cache_array);
+  digest_cache_array= NULL;
+  digest_cache_max= 0;
 }
 
 C_MODE_START
@@ -169,38 +199,51 @@ static LF_PINS* get_digest_hash_pins(PFS_thread *thread)
   return thread->m_digest_hash_pins;
 }
 
-PFS_statement_stat*
-find_or_create_digest(PFS_thread *thread,
-                      PSI_digest_storage *digest_storage,
-                      const char *schema_name,
-                      uint schema_name_length)
+static inline void lock_digest_cache(PFS_thread *thread)
 {
-  if (statements_digest_stat_array == NULL)
-    return NULL;
+  int32 unlocked= 0;
+  while (! PFS_atomic::cas_32(& thread->m_digest_cache_lock, & unlocked, 1))
+  {
+    unlocked= 0;
+    pthread_yield();
+  }
+}
 
-  if (digest_storage->m_byte_count <= 0)
-    return NULL;
+static inline void unlock_digest_cache(PFS_thread *thread)
+{
+  PFS_atomic::store_32(& thread->m_digest_cache_lock, 0);
+}
 
+/**
+  Add the statistics of a digest cache entry to the digest record.
+  The cache of the thread must be locked.
+*/
+static void aggregate_digest_cache_entry(PFS_digest_cache_entry *entry)
+{
+  PFS_statements_digest_stat *pfs= entry->m_digest;
+  if (pfs == NULL)
+    return;
+
+  pfs->m_stat.aggregate(& entry->m_stat);
+  if (pfs->m_last_seen < entry->m_last_seen)
+    pfs->m_last_seen= entry->m_last_seen;
+  entry->m_stat.reset();
+}
+
+/**
+  Find or create the digest record of a statement.
+  @return the digest record, or NULL
+*/
+static PFS_statements_digest_stat*
+find_or_create_digest_stat(PFS_thread *thread,
+                           PFS_digest_key *hash_key,
+                           PSI_digest_storage *digest_storage,
+                           ulonglong now)
+{
   LF_PINS *pins= get_digest_hash_pins(thread);
   if (unlikely(pins == NULL))
     return NULL;
 
-  /*
-    Note: the LF_HASH key is a block of memory,
-    make sure to clean unused bytes,
-    so that memcmp() can compare keys.
-  */
-  PFS_digest_key hash_key;
-  memset(& hash_key, 0, sizeof(hash_key));
-  /* Compute MD5 Hash of the tokens received. */
-  compute_md5_hash(hash_key.m_md5,
-                   (char *) digest_storage->m_token_array,
-                   digest_storage->m_byte_count);
-  /* Add the current schema to the key */
-  hash_key.m_schema_name_length= schema_name_length;
-  if (schema_name_length > 0)
-    memcpy(hash_key.m_schema_name, schema_name, schema_name_length);
-
   int res;
   ulong safe_index;
   uint retry_count= 0;
@@ -208,22 +251,19 @@ find_or_create_digest(PFS_thread *thread,
   PFS_statements_digest_stat **entry;
   PFS_statements_digest_stat *pfs= NULL;
 
-  ulonglong now= my_hrtime().val;
-
 search:
 
   /* Lookup LF_HASH using this new key. */
   entry= reinterpret_cast<PFS_statements_digest_stat**>
     (lf_hash_search(&digest_hash, pins,
-                    &hash_key, sizeof(PFS_digest_key)));
+                    hash_key, sizeof(PFS_digest_key)));
 
   if (entry && (entry != MY_ERRPTR))
   {
-    /* If digest already exists, update stats and return. */
+    /* If digest already exists, return it. */
     pfs= *entry;
-    pfs->m_last_seen= now;
     lf_hash_search_unpin(pins);
-    return & pfs->m_stat;
+    return pfs;
   }
 
   lf_hash_search_unpin(pins);
@@ -238,7 +278,7 @@ find_or_create_digest(PFS_thread *thread,
     if (pfs->m_first_seen == 0)
       pfs->m_first_seen= now;
     pfs->m_last_seen= now;
-    return & pfs->m_stat;
+    return pfs;
   }
 
   safe_index= PFS_atomic::add_u32(& digest_index, 1);
@@ -251,14 +291,14 @@ find_or_create_digest(PFS_thread *thread,
     if (pfs->m_first_seen == 0)
       pfs->m_first_seen= now;
     pfs->m_last_seen= now;
-    return & pfs->m_stat;
+    return pfs;
   }
 
   /* Add a new record in digest stat array. */
   pfs= &statements_digest_stat_array[safe_index];
 
   /* Copy digest hash/LF Hash search key. */
-  memcpy(& pfs->m_digest_key, &hash_key, sizeof(PFS_digest_key));
+  memcpy(& pfs->m_digest_key, hash_key, sizeof(PFS_digest_key));
 
   /*
     Copy digest storage to statement_digest_stat_array so that it could be
@@ -272,7 +312,7 @@ find_or_create_digest(PFS_thread *thread,
   res= lf_hash_insert(&digest_hash, pins, &pfs);
   if (likely(res == 0))
   {
-    return & pfs->m_stat;
+    return pfs;
   }
 
   if (res > 0)
@@ -292,6 +332,124 @@ find_or_create_digest(PFS_thread *thread,
   return NULL;
 }
 
+/**
+  Find the statistics to aggregate a statement to.
+  Statements of a digest are aggregated in the digest cache of the thread,
+  see PFS_digest_cache_entry. The cache stays locked until
+  release_digest_stat() when statistics are returned.
+  @return the statistics, or NULL
+*/
+PFS_statement_stat*
+find_or_create_digest(PFS_thread *thread,
+                      PSI_digest_storage *digest_storage,
+                      const char *schema_name,
+                      uint schema_name_length)
+{
+  if (statements_digest_stat_array == NULL)
+    return NULL;
+
+  if (digest_storage->m_byte_count <= 0)
+    return NULL;
+
+  if (unlikely(thread->m_digest_cache == NULL))
+    return NULL;
+
+  /*
+    Note: the LF_HASH key is a block of memory,
+    make sure to clean unused bytes,
+    so that memcmp() can compare keys.
+  */
+  PFS_digest_key hash_key;
+  memset(& hash_key, 0, sizeof(hash_key));
+  /* Compute MD5 Hash of the tokens received. */
+  compute_md5_hash(hash_key.m_md5,
+                   (char *) digest_storage->m_token_array,
+                   digest_storage->m_byte_count);
+  /* Add the current schema to the key */
+  hash_key.m_schema_name_length= schema_name_length;
+  if (schema_name_length > 0)
+    memcpy(hash_key.m_schema_name, schema_name, schema_name_length);
+
+  ulonglong now= my_hrtime().val;
+  /* The MD5 hash is evenly distributed, so is its first byte. */
+  PFS_digest_cache_entry *entry=
+    &thread->m_digest_cache[hash_key.m_md5[0] % DIGEST_CACHE_SIZE];
+  PFS_statements_digest_stat *pfs;
+
+  lock_digest_cache(thread);
+
+  pfs= entry->m_digest;
+  if (pfs != NULL &&
+      memcmp(& pfs->m_digest_key, & hash_key, sizeof(PFS_digest_key)) == 0)
+  {
+    entry->m_last_seen= now;
+    return & entry->m_stat;
+  }
+
+  aggregate_digest_cache_entry(entry);
+  entry->m_digest= NULL;
+
+  pfs= find_or_create_digest_stat(thread, & hash_key, digest_storage, now);
+  if (pfs == NULL)
+  {
+    unlock_digest_cache(thread);
+    return NULL;
+  }
+
+  if (pfs == &statements_digest_stat_array[0])
+  {
+    /* The digest array is full, aggregate to the record of lost digests. */
+    return & pfs->m_stat;
+  }
+
+  entry->m_digest= pfs;
+  entry->m_last_seen= now;
+  return & entry->m_stat;
+}
+
+/** Unlock the digest cache locked by find_or_create_digest(). */
+void release_digest_stat(PFS_thread *thread)
+{
+  unlock_digest_cache(thread);
+}
+
+/**
+  Add the statistics in the digest cache of a thread to the digest records,
+  and empty the cache. Used when the thread ends.
+*/
+void flush_digest_cache(PFS_thread *thread)
+{
+  if (thread->m_digest_cache == NULL)
+    return;
+
+  lock_digest_cache(thread);
+  for (uint index= 0; index < DIGEST_CACHE_SIZE; index++)
+  {
+    aggregate_digest_cache_entry(&thread->m_digest_cache[index]);
+    thread->m_digest_cache[index].m_digest= NULL;
+  }
+  unlock_digest_cache(thread);
+}
+
+/**
+  Add the statistics in the digest caches of all threads to the digest
+  records. Used before reading EVENTS_STATEMENTS_SUMMARY_BY_DIGEST.
+*/
+void flush_all_digest_caches()
+{
+  if (digest_cache_array == NULL)
+    return;
+
+  for (uint index= 0; index < thread_max; index++)
+  {
+    PFS_thread *thread= &thread_array[index];
+    lock_digest_cache(thread);
+    for (uint i= 0; i < DIGEST_CACHE_SIZE; i++)
+      aggregate_digest_cache_entry(&thread->m_digest_cache[i]);
+    unlock_digest_cache(thread);
+  }
+}
+
 void purge_digest(PFS_thread* thread, PFS_digest_key *hash_key)
 {
   LF_PINS *pins= get_digest_hash_pins(thread);
@@ -342,6 +500,22 @@ void reset_esms_by_digest()
   if (unlikely(thread == NULL))
     return;
 
+  /* Discard the statistics not yet aggregated to the records. */
+  if (digest_cache_array != NULL)
+  {
+    for (index= 0; index < thread_max; index++)
+    {
+      PFS_thread *cache_thread= &thread_array[index];
+      lock_digest_cache(cache_thread);
+      for (uint i= 0; i < DIGEST_CACHE_SIZE; i++)
+      {
+        cache_thread->m_digest_cache[i].m_digest= NULL;
+        cache_thread->m_digest_cache[i].m_stat.reset();
+      }
+      unlock_digest_cache(cache_thread);
+    }
+  }
+
   /* Reset statements_digest_stat_array. */
   for (index= 0; index < digest_max; index++)
   {
@@ -30,6 +30,7 @@
 extern bool flag_statements_digest;
 extern ulong digest_max;
 extern ulong digest_lost;
+extern ulong digest_cache_max;
 struct PFS_thread;
 
 /* Fixed, per MD5 hash. */
@@ -67,6 +68,26 @@ struct PFS_ALIGNED PFS_statements_digest_stat
   void reset_index(PFS_thread *thread);
 };
 
+/** Number of digests each thread keeps statistics for. */
+#define DIGEST_CACHE_SIZE 16
+
+/**
+  Statistics of a statement digest, collected by one thread.
+  They are added to the digest record only when the entry is taken by
+  another digest, when the thread ends, or before
+  EVENTS_STATEMENTS_SUMMARY_BY_DIGEST is read, so that threads running
+  the same statements do not all write to the same record.
+*/
+struct PFS_ALIGNED PFS_digest_cache_entry
+{
+  /** Digest record, NULL if the entry is not used. */
+  PFS_statements_digest_stat *m_digest;
+  /** Last seen timestamp. */
+  ulonglong m_last_seen;
+  /** Statement stat, not yet added to the digest record. */
+  PFS_statement_stat m_stat;
+};
+
 int init_digest(const PFS_global_param *param);
 void cleanup_digest();
 
@@ -76,6 +97,9 @@ PFS_statement_stat* find_or_create_digest(PFS_thread *thread,
                                           PSI_digest_storage *digest_storage,
                                           const char *schema_name,
                                           uint schema_name_length);
+void release_digest_stat(PFS_thread *thread);
+void flush_digest_cache(PFS_thread *thread);
+void flush_all_digest_caches();
 
 void get_digest_text(char *digest_text, PSI_digest_storage *digest_storage);
 
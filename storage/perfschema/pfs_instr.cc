@@ -30,6 +30,7 @@
 #include "pfs_account.h"
 #include "pfs_global.h"
 #include "pfs_instr_class.h"
+#include "pfs_digest.h"
 
 /**
   @addtogroup Performance_schema_buffers
@@ -1124,6 +1125,7 @@ void destroy_thread(PFS_thread *pfs)
     lf_hash_put_pins(pfs->m_digest_hash_pins);
     pfs->m_digest_hash_pins= NULL;
   }
+  flush_digest_cache(pfs);
   pfs->m_lock.allocated_to_free();
   thread_full= false;
 }
@@ -28,6 +28,7 @@ struct PFS_file_class;
 struct PFS_table_share;
 struct PFS_thread_class;
 struct PFS_socket_class;
+struct PFS_digest_cache_entry;
 
 #ifdef __WIN__
 #include <winsock2.h>
@@ -395,6 +396,17 @@ struct PFS_ALIGNED PFS_thread : PFS_connection_slice
   LF_PINS *m_account_hash_pins;
   /** Pins for digest_hash. */
   LF_PINS *m_digest_hash_pins;
+  /**
+    Statistics by digest of the statements of this thread.
+    Array of DIGEST_CACHE_SIZE entries, protected by @c m_digest_cache_lock.
+  */
+  PFS_digest_cache_entry *m_digest_cache;
+  /**
+    Spin lock of @c m_digest_cache.
+    Taken by the thread for every statement, and by other threads
+    to add the statistics to the digest records.
+  */
+  volatile int32 m_digest_cache_lock;
   /** Internal thread identifier, unique. */
   ulonglong m_thread_internal_id;
   /** Parent internal thread identifier. */
@@ -101,6 +101,13 @@ void table_esms_by_digest::reset_position(void)
   m_next_pos= 0;
 }
 
+int table_esms_by_digest::rnd_init(bool scan)
+{
+  /* Collect the statistics still kept by the threads. */
+  flush_all_digest_caches();
+  return 0;
+}
+
 int table_esms_by_digest::rnd_next(void)
 {
   PFS_statements_digest_stat* digest_stat;
@@ -56,6 +56,7 @@ class table_esms_by_digest : public PFS_engine_table
   static PFS_engine_table* create();
   static int delete_all_rows();
 
+  virtual int rnd_init(bool scan);
   virtual int rnd_next();
   virtual int rnd_pos(const void *pos);
   virtual void reset_position(void);
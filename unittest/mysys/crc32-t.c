@@ -0,0 +1,79 @@
+/* Copyright (c) 2015, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include <my_global.h>
+#include <my_sys.h>
+#include <zlib.h>
+#include <tap.h>
+#include <string.h>
+
+/*
+  my_checksum() may use a hardware accelerated CRC32; it must always
+  return the same values as the table driven zlib crc32().
+*/
+
+#define MAX_ALIGN 16
+
+static const size_t sizes[]=
+{
+  0, 1, 3, 15, 16, 17, 31, 48, 63, 64, 65, 79, 80, 127, 128, 129,
+  255, 256, 1000, 1024, 4095, 4096, 8191, 16384, 65535, 100000
+};
+
+#define N_SIZES (sizeof(sizes) / sizeof(sizes[0]))
+#define MAX_SIZE 100000
+
+static uchar buffer[MAX_SIZE + MAX_ALIGN];
+
+int main(int argc __attribute__((unused)), char *argv[])
+{
+  size_t i, j;
+  MY_INIT(argv[0]);
+
+  plan(N_SIZES * 2 + 2);
+
+  ok(my_checksum(0, (const uchar*) "123456789", 9) == 0xCBF43926,
+     "check value of the standard test string");
+  ok(my_checksum(0, NULL, 0) == crc32(0, NULL, 0),
+     "empty buffer");
+
+  for (i= 0; i < sizeof(buffer); i++)
+    buffer[i]= (uchar) rand();
+
+  for (i= 0; i < N_SIZES; i++)
+  {
+    size_t size= sizes[i];
+    my_bool same= TRUE;
+    my_bool same_chained= TRUE;
+
+    for (j= 0; j < MAX_ALIGN; j++)
+    {
+      const uchar *pos= buffer + j;
+      ha_checksum crc= my_checksum(0, pos, size);
+      ha_checksum split= my_checksum(my_checksum(0, pos, size / 3),
+                                     pos + size / 3, size - size / 3);
+
+      if (crc != (ha_checksum) crc32(0, pos, (uint) size))
+        same= FALSE;
+      if (split != crc)
+        same_chained= FALSE;
+    }
+    ok(same, "same as zlib for %u bytes at all alignments", (uint) size);
+    ok(same_chained, "chained checksum of %u bytes", (uint) size);
+  }
+
+  my_end(0);
+  return exit_status();
+}
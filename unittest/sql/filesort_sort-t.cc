@@ -0,0 +1,229 @@
+/* Copyright (c) 2015, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/*
+  Sorting of filesort keys: checks that the radix sorts order the keys
+  like the comparison sort, and prints how long each of them takes.
+
+  The keys are built like make_sortkey() does it for some typical
+  ORDER BY clauses.  Run with a number of keys as argument for a
+  bigger benchmark, e.g. "filesort_sort-t 1000000".
+*/
+
+#include <my_global.h>
+#include <my_sys.h>
+#include <m_string.h>
+#include <tap.h>
+
+struct key_layout
+{
+  const char *name;
+  size_t length;
+  void (*make)(uchar *to, uint row);
+};
+
+static ulonglong random_state= 1;
+
+static uint next_random()
+{
+  random_state= random_state * 6364136223846793005ULL + 1442695040888963407ULL;
+  return (uint) (random_state >> 33);
+}
+
+/* A signed integer stored high byte first with the sign bit flipped */
+static void store_int(uchar *to, uint32 value, uint length)
+{
+  for (uint i= length; i-- > 0; value>>= 8)
+    to[i]= (uchar) value;
+  to[0]^= 128;
+}
+
+/* A nullable string column: null byte and a space padded string */
+static void store_string(uchar *to, const char *str, size_t length)
+{
+  size_t str_length= MY_MIN(strlen(str), length - 1);
+  to[0]= 1;
+  memcpy(to + 1, str, str_length);
+  memset(to + 1 + str_length, ' ', length - 1 - str_length);
+}
+
+/* ORDER BY int_col, bigint_col */
+static void make_ints(uchar *to, uint row __attribute__((unused)))
+{
+  store_int(to, next_random() % 100000, 4);
+  store_int(to + 4, next_random(), 8);
+}
+
+/* ORDER BY country, city, id with varchar(20) latin1 columns */
+static void make_names(uchar *to, uint row)
+{
+  char buff[32];
+  my_snprintf(buff, sizeof(buff), "country%02u", next_random() % 50);
+  store_string(to, buff, 21);
+  my_snprintf(buff, sizeof(buff), "city-%u", next_random() % 5000);
+  store_string(to + 21, buff, 21);
+  store_int(to + 42, row, 4);
+}
+
+/* ORDER BY url, ts with a varchar(200) column with long common prefixes */
+static void make_urls(uchar *to, uint row)
+{
+  char buff[220];
+  my_snprintf(buff, sizeof(buff),
+              "https://www.example.com/catalog/products/category-%u/item-%u",
+              next_random() % 20, next_random() % 100000);
+  store_string(to, buff, 201);
+  store_int(to + 201, next_random(), 4);
+}
+
+static key_layout layouts[]=
+{
+  { "int, bigint", 12, make_ints },
+  { "varchar(20), varchar(20), int", 46, make_names },
+  { "varchar(200), timestamp", 205, make_urls }
+};
+
+#define N_LAYOUTS (sizeof(layouts) / sizeof(layouts[0]))
+
+static const uint default_rows[]= { 100, 5000, 100000 };
+
+#define N_ROWS (sizeof(default_rows) / sizeof(default_rows[0]))
+
+enum sort_method { QSORT, LSD_RADIX, MSD_RADIX };
+
+static const char *method_names[]= { "qsort", "radix", "msd radix" };
+
+
+static ulonglong sort_keys(sort_method method, uchar **keys, uint count,
+                           size_t length, uchar **buffer)
+{
+  ulonglong start= my_interval_timer();
+  switch (method) {
+  case QSORT:
+    my_qsort2(keys, count, sizeof(uchar*), get_ptr_compare(length), &length);
+    break;
+  case LSD_RADIX:
+    radixsort_for_str_ptr(keys, count, length, buffer);
+    break;
+  case MSD_RADIX:
+    msd_radixsort_for_str_ptr(keys, count, length, buffer);
+    break;
+  }
+  return my_interval_timer() - start;
+}
+
+
+static bool same_order(uchar **keys, uchar **expected, uint count,
+                       size_t length)
+{
+  for (uint i= 0; i < count; i++)
+    if (memcmp(keys[i], expected[i], length))
+      return false;
+  return true;
+}
+
+
+static void test_layout(const key_layout *layout, uint count)
+{
+  size_t length= layout->length;
+  uchar *data= (uchar*) my_malloc(count * length, MYF(MY_FAE));
+  uchar **unsorted= (uchar**) my_malloc(count * sizeof(uchar*), MYF(MY_FAE));
+  uchar **expected= (uchar**) my_malloc(count * sizeof(uchar*), MYF(MY_FAE));
+  uchar **keys= (uchar**) my_malloc(count * sizeof(uchar*), MYF(MY_FAE));
+  uchar **buffer= (uchar**) my_malloc(count * sizeof(uchar*), MYF(MY_FAE));
+  ulonglong time[3];
+
+  for (uint i= 0; i < count; i++)
+  {
+    unsorted[i]= data + i * length;
+    layout->make(unsorted[i], i);
+  }
+
+  memcpy(expected, unsorted, count * sizeof(uchar*));
+  time[QSORT]= sort_keys(QSORT, expected, count, length, buffer);
+
+  /* The LSD radix sort does one pass per byte; only try short keys */
+  time[LSD_RADIX]= 0;
+  if (length <= 20)
+  {
+    memcpy(keys, unsorted, count * sizeof(uchar*));
+    time[LSD_RADIX]= sort_keys(LSD_RADIX, keys, count, length, buffer);
+    ok(same_order(keys, expected, count, length),
+       "%s: radix sort of %u keys", layout->name, count);
+  }
+  else
+    skip(1, "%s: radix sort of %u keys", layout->name, count);
+
+  memcpy(keys, unsorted, count * sizeof(uchar*));
+  time[MSD_RADIX]= sort_keys(MSD_RADIX, keys, count, length, buffer);
+  ok(same_order(keys, expected, count, length),
+     "%s: msd radix sort of %u keys", layout->name, count);
+
+  for (uint m= QSORT; m <= MSD_RADIX; m++)
+  {
+    if (time[m])
+      diag("%-30s %8u keys %-10s %10.3f ms", layout->name, count,
+           method_names[m], time[m] / 1e6);
+  }
+
+  my_free(buffer);
+  my_free(keys);
+  my_free(expected);
+  my_free(unsorted);
+  my_free(data);
+}
+
+
+int main(int argc, char **argv)
+{
+  uint rows[N_ROWS];
+  uint n_rows= N_ROWS;
+  MY_INIT(argv[0]);
+
+  if (argc > 1)
+  {
+    rows[0]= (uint) atoi(argv[1]);
+    n_rows= 1;
+  }
+  else
+    memcpy(rows, default_rows, sizeof(rows));
+
+  plan(N_LAYOUTS * n_rows * 2 + 1);
+
+  /* Keys that are all equal, or equal but for the last byte */
+  {
+    uchar data[2000 * 30];
+    uchar *keys[2000], *buffer[2000];
+    bool sorted= true;
+    memset(data, 'a', sizeof(data));
+    for (uint i= 0; i < 2000; i++)
+    {
+      keys[i]= data + i * 30;
+      keys[i][29]= (uchar) (i % 2 ? 255 - i % 7 : 'a');
+    }
+    msd_radixsort_for_str_ptr(keys, 2000, 30, buffer);
+    for (uint i= 1; i < 2000; i++)
+      if (memcmp(keys[i-1], keys[i], 30) > 0)
+        sorted= false;
+    ok(sorted, "keys with a long common prefix");
+  }
+
+  for (uint l= 0; l < N_LAYOUTS; l++)
+    for (uint r= 0; r < n_rows; r++)
+      test_layout(layouts + l, rows[r]);
+
+  my_end(0);
+  return exit_status();
+}